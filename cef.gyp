@@ -222,26 +222,44 @@
         '../base/base.gyp:base',
         '../base/base.gyp:base_i18n',
         '../base/base.gyp:test_support_base',
+        '../net/net.gyp:http_server',
         '../testing/gtest.gyp:gtest',
         '../third_party/icu/icu.gyp:icui18n',
         '../third_party/icu/icu.gyp:icuuc',
         'libcef',
         'libcef_dll_wrapper',
+        'libcef_http_cache',
+        'libcef_image',
+        'libcef_message_loop',
       ],
       'sources': [
+        'tests/unittests/browser_pool_unittest.cc',
+        'tests/unittests/browser_unittest.cc',
         'tests/unittests/content_filter_unittest.cc',
         'tests/unittests/cookie_unittest.cc',
         'tests/unittests/dom_unittest.cc',
+        'tests/unittests/http_cache_size_unittest.cc',
+        'tests/unittests/http_cache_unittest.cc',
+        'tests/unittests/image_capture_unittest.cc',
+        'tests/unittests/message_loop_unittest.cc',
+        'tests/unittests/pixel_convert_unittest.cc',
         'tests/unittests/request_unittest.cc',
         'tests/unittests/run_all_unittests.cc',
+        'tests/unittests/runnable_unittest.cc',
         'tests/unittests/scheme_handler_unittest.cc',
+        'tests/unittests/shutdown_unittest.cc',
+        'tests/unittests/startup_unittest.cc',
+        'tests/unittests/storage_unittest.cc',
         'tests/unittests/stream_unittest.cc',
         'tests/unittests/string_unittest.cc',
         'tests/unittests/test_handler.h',
         'tests/unittests/test_suite.h',
+        'tests/unittests/thread_stats_unittest.cc',
+        'tests/unittests/tracing_unittest.cc',
         'tests/unittests/url_unittest.cc',
         'tests/unittests/v8_unittest.cc',
         'tests/unittests/web_urlrequest_unittest.cc',
+        'tests/unittests/worker_pool_unittest.cc',
         'tests/unittests/xml_reader_unittest.cc',
         'tests/unittests/zip_reader_unittest.cc',
       ],
@@ -327,6 +345,8 @@
         'libcef_dll/cef_logging.h',
         'libcef_dll/cpptoc/browser_cpptoc.cc',
         'libcef_dll/cpptoc/browser_cpptoc.h',
+        'libcef_dll/cpptoc/browser_pool_cpptoc.cc',
+        'libcef_dll/cpptoc/browser_pool_cpptoc.h',
         'libcef_dll/cpptoc/cpptoc.h',
         'libcef_dll/cpptoc/domdocument_cpptoc.cc',
         'libcef_dll/cpptoc/domdocument_cpptoc.h',
@@ -344,10 +364,14 @@
         'libcef_dll/cpptoc/post_data_element_cpptoc.h',
         'libcef_dll/cpptoc/request_cpptoc.cc',
         'libcef_dll/cpptoc/request_cpptoc.h',
+        'libcef_dll/cpptoc/request_context_cpptoc.cc',
+        'libcef_dll/cpptoc/request_context_cpptoc.h',
         'libcef_dll/cpptoc/response_cpptoc.cc',
         'libcef_dll/cpptoc/response_cpptoc.h',
         'libcef_dll/cpptoc/scheme_handler_callback_cpptoc.cc',
         'libcef_dll/cpptoc/scheme_handler_callback_cpptoc.h',
+        'libcef_dll/cpptoc/sequenced_task_runner_cpptoc.cc',
+        'libcef_dll/cpptoc/sequenced_task_runner_cpptoc.h',
         'libcef_dll/cpptoc/stream_reader_cpptoc.cc',
         'libcef_dll/cpptoc/stream_reader_cpptoc.h',
         'libcef_dll/cpptoc/stream_writer_cpptoc.cc',
@@ -366,6 +390,8 @@
         'libcef_dll/ctocpp/client_ctocpp.h',
         'libcef_dll/ctocpp/content_filter_ctocpp.cc',
         'libcef_dll/ctocpp/content_filter_ctocpp.h',
+        'libcef_dll/ctocpp/cookie_batch_visitor_ctocpp.cc',
+        'libcef_dll/ctocpp/cookie_batch_visitor_ctocpp.h',
         'libcef_dll/ctocpp/cookie_visitor_ctocpp.cc',
         'libcef_dll/ctocpp/cookie_visitor_ctocpp.h',
         'libcef_dll/ctocpp/ctocpp.h',
@@ -383,6 +409,8 @@
         'libcef_dll/ctocpp/find_handler_ctocpp.h',
         'libcef_dll/ctocpp/focus_handler_ctocpp.cc',
         'libcef_dll/ctocpp/focus_handler_ctocpp.h',
+        'libcef_dll/ctocpp/image_capture_callback_ctocpp.cc',
+        'libcef_dll/ctocpp/image_capture_callback_ctocpp.h',
         'libcef_dll/ctocpp/jsbinding_handler_ctocpp.cc',
         'libcef_dll/ctocpp/jsbinding_handler_ctocpp.h',
         'libcef_dll/ctocpp/jsdialog_handler_ctocpp.cc',
@@ -393,8 +421,12 @@
         'libcef_dll/ctocpp/life_span_handler_ctocpp.h',
         'libcef_dll/ctocpp/load_handler_ctocpp.cc',
         'libcef_dll/ctocpp/load_handler_ctocpp.h',
+        'libcef_dll/ctocpp/local_storage_visitor_ctocpp.cc',
+        'libcef_dll/ctocpp/local_storage_visitor_ctocpp.h',
         'libcef_dll/ctocpp/menu_handler_ctocpp.cc',
         'libcef_dll/ctocpp/menu_handler_ctocpp.h',
+        'libcef_dll/ctocpp/page_capture_handler_ctocpp.cc',
+        'libcef_dll/ctocpp/page_capture_handler_ctocpp.h',
         'libcef_dll/ctocpp/print_handler_ctocpp.cc',
         'libcef_dll/ctocpp/print_handler_ctocpp.h',
         'libcef_dll/ctocpp/read_handler_ctocpp.cc',
@@ -495,6 +527,8 @@
         'libcef_dll/cpptoc/client_cpptoc.h',
         'libcef_dll/cpptoc/content_filter_cpptoc.cc',
         'libcef_dll/cpptoc/content_filter_cpptoc.h',
+        'libcef_dll/cpptoc/cookie_batch_visitor_cpptoc.cc',
+        'libcef_dll/cpptoc/cookie_batch_visitor_cpptoc.h',
         'libcef_dll/cpptoc/cookie_visitor_cpptoc.cc',
         'libcef_dll/cpptoc/cookie_visitor_cpptoc.h',
         'libcef_dll/cpptoc/cpptoc.h',
@@ -512,6 +546,8 @@
         'libcef_dll/cpptoc/find_handler_cpptoc.h',
         'libcef_dll/cpptoc/focus_handler_cpptoc.cc',
         'libcef_dll/cpptoc/focus_handler_cpptoc.h',
+        'libcef_dll/cpptoc/image_capture_callback_cpptoc.cc',
+        'libcef_dll/cpptoc/image_capture_callback_cpptoc.h',
         'libcef_dll/cpptoc/jsbinding_handler_cpptoc.cc',
         'libcef_dll/cpptoc/jsbinding_handler_cpptoc.h',
         'libcef_dll/cpptoc/jsdialog_handler_cpptoc.cc',
@@ -522,8 +558,12 @@
         'libcef_dll/cpptoc/life_span_handler_cpptoc.h',
         'libcef_dll/cpptoc/load_handler_cpptoc.cc',
         'libcef_dll/cpptoc/load_handler_cpptoc.h',
+        'libcef_dll/cpptoc/local_storage_visitor_cpptoc.cc',
+        'libcef_dll/cpptoc/local_storage_visitor_cpptoc.h',
         'libcef_dll/cpptoc/menu_handler_cpptoc.cc',
         'libcef_dll/cpptoc/menu_handler_cpptoc.h',
+        'libcef_dll/cpptoc/page_capture_handler_cpptoc.cc',
+        'libcef_dll/cpptoc/page_capture_handler_cpptoc.h',
         'libcef_dll/cpptoc/print_handler_cpptoc.cc',
         'libcef_dll/cpptoc/print_handler_cpptoc.h',
         'libcef_dll/cpptoc/read_handler_cpptoc.cc',
@@ -548,6 +588,8 @@
         'libcef_dll/cpptoc/write_handler_cpptoc.h',
         'libcef_dll/ctocpp/browser_ctocpp.cc',
         'libcef_dll/ctocpp/browser_ctocpp.h',
+        'libcef_dll/ctocpp/browser_pool_ctocpp.cc',
+        'libcef_dll/ctocpp/browser_pool_ctocpp.h',
         'libcef_dll/ctocpp/ctocpp.h',
         'libcef_dll/ctocpp/domdocument_ctocpp.cc',
         'libcef_dll/ctocpp/domdocument_ctocpp.h',
@@ -565,10 +607,14 @@
         'libcef_dll/ctocpp/post_data_element_ctocpp.h',
         'libcef_dll/ctocpp/request_ctocpp.cc',
         'libcef_dll/ctocpp/request_ctocpp.h',
+        'libcef_dll/ctocpp/request_context_ctocpp.cc',
+        'libcef_dll/ctocpp/request_context_ctocpp.h',
         'libcef_dll/ctocpp/response_ctocpp.cc',
         'libcef_dll/ctocpp/response_ctocpp.h',
         'libcef_dll/ctocpp/scheme_handler_callback_ctocpp.cc',
         'libcef_dll/ctocpp/scheme_handler_callback_ctocpp.h',
+        'libcef_dll/ctocpp/sequenced_task_runner_ctocpp.cc',
+        'libcef_dll/ctocpp/sequenced_task_runner_ctocpp.h',
         'libcef_dll/ctocpp/stream_reader_ctocpp.cc',
         'libcef_dll/ctocpp/stream_reader_ctocpp.h',
         'libcef_dll/ctocpp/stream_writer_ctocpp.cc',
@@ -591,6 +637,66 @@
         'libcef_dll/wrapper/libcef_dll_wrapper.cc',
       ],
     },
+    {
+      # Built separately so that the pixel conversion and image encoding code
+      # can be tested directly by cef_unittests without compiling it twice.
+      'target_name': 'libcef_image',
+      'type': 'static_library',
+      'msvs_guid': '3C5D8E2A-6B1F-4E7A-9D0C-2F8B4A61E935',
+      'include_dirs': [
+        '.',
+        '..',
+      ],
+      'dependencies': [
+        '../base/base.gyp:base',
+        '../skia/skia.gyp:skia',
+        '../third_party/zlib/zlib.gyp:zlib',
+        '../ui/ui.gyp:ui',
+      ],
+      'sources': [
+        'libcef/image_encoder.cc',
+        'libcef/image_encoder.h',
+        'libcef/pixel_convert.cc',
+        'libcef/pixel_convert.h',
+      ],
+    },
+    {
+      # Built separately so that the HTTP cache size accounting can be tested
+      # directly by cef_unittests with each type of cache backend.
+      'target_name': 'libcef_http_cache',
+      'type': 'static_library',
+      'msvs_guid': 'B4E17A93-2D6C-4F05-8A3E-61C9D0F5B728',
+      'include_dirs': [
+        '.',
+        '..',
+      ],
+      'dependencies': [
+        '../base/base.gyp:base',
+        '../net/net.gyp:net',
+      ],
+      'sources': [
+        'libcef/http_cache_size.cc',
+        'libcef/http_cache_size.h',
+      ],
+    },
+    {
+      # Built separately so that the external UI message loop can be tested
+      # directly by cef_unittests.
+      'target_name': 'libcef_message_loop',
+      'type': 'static_library',
+      'msvs_guid': '7E2B9F41-5C3D-4A86-B1E0-93D6C58A2F17',
+      'include_dirs': [
+        '.',
+        '..',
+      ],
+      'dependencies': [
+        '../base/base.gyp:base',
+      ],
+      'sources': [
+        'libcef/cef_message_loop.cc',
+        'libcef/cef_message_loop.h',
+      ],
+    },
     {
       'target_name': 'libcef_static',
       'type': 'static_library',
@@ -638,6 +744,9 @@
         '../webkit/support/webkit_support.gyp:webkit_gpu',
         '../webkit/support/webkit_support.gyp:webkit_resources',
         '../webkit/support/webkit_support.gyp:webkit_strings',
+        'libcef_http_cache',
+        'libcef_image',
+        'libcef_message_loop',
       ],
       'sources': [
         'include/cef.h',
@@ -655,6 +764,10 @@
         'include/internal/cef_types_wrappers.h',
         'libcef/browser_appcache_system.cc',
         'libcef/browser_appcache_system.h',
+        'libcef/browser_cookie_cache.cc',
+        'libcef/browser_cookie_cache.h',
+        'libcef/browser_cookie_snapshot.cc',
+        'libcef/browser_cookie_snapshot.h',
         'libcef/browser_database_system.cc',
         'libcef/browser_database_system.h',
         'libcef/browser_devtools_agent.cc',
@@ -665,14 +778,21 @@
         'libcef/browser_devtools_client.h',
         'libcef/browser_file_system.cc',
         'libcef/browser_file_system.h',
+        'libcef/browser_http_cache_purger.cc',
+        'libcef/browser_http_cache_purger.h',
+        'libcef/browser_http_cache_writer.cc',
+        'libcef/browser_http_cache_writer.h',
         'libcef/browser_file_writer.cc',
         'libcef/browser_file_writer.h',
         'libcef/browser_impl.cc',
         'libcef/browser_impl.h',
+        'libcef/browser_lazy_cookie_store.cc',
+        'libcef/browser_lazy_cookie_store.h',
         'libcef/browser_navigation_controller.cc',
         'libcef/browser_navigation_controller.h',
         'libcef/browser_persistent_cookie_store.cc',
         'libcef/browser_persistent_cookie_store.h',
+        'libcef/browser_pool_impl.cc',
         'libcef/browser_request_context.cc',
         'libcef/browser_request_context.h',
         'libcef/browser_resource_loader_bridge.cc',
@@ -708,13 +828,21 @@
         'libcef/cef_process_sub_thread.h',
         'libcef/cef_process_ui_thread.cc',
         'libcef/cef_process_ui_thread.h',
+        'libcef/cef_startup_timer.cc',
+        'libcef/cef_startup_timer.h',
         'libcef/cef_string_list.cc',
         'libcef/cef_string_map.cc',
         'libcef/cef_string_types.cc',
         'libcef/cef_thread.cc',
         'libcef/cef_thread.h',
+        'libcef/cef_thread_stats.cc',
+        'libcef/cef_thread_stats.h',
         'libcef/cef_time.cc',
         'libcef/cef_time_util.h',
+        'libcef/cef_trace.cc',
+        'libcef/cef_trace.h',
+        'libcef/cef_worker_pool.cc',
+        'libcef/cef_worker_pool.h',
         'libcef/drag_data_impl.cc',
         'libcef/drag_data_impl.h',
         'libcef/drag_download_file.cc',
@@ -739,9 +867,13 @@
         'libcef/external_protocol_handler.h',
         'libcef/http_header_utils.cc',
         'libcef/http_header_utils.h',
+        'libcef/image_capture.cc',
+        'libcef/image_capture.h',
         'libcef/origin_whitelist_impl.cc',
         'libcef/request_impl.cc',
         'libcef/request_impl.h',
+        'libcef/request_context_impl.cc',
+        'libcef/request_context_impl.h',
         'libcef/response_impl.cc',
         'libcef/response_impl.h',
         'libcef/scheme_impl.cc',
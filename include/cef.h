@@ -58,6 +58,7 @@
 class CefBrowser;
 class CefClient;
 class CefContentFilter;
+class CefCookieBatchVisitor;
 class CefCookieVisitor;
 class CefDOMDocument;
 class CefDOMEvent;
@@ -67,9 +68,13 @@ class CefDOMVisitor;
 class CefDownloadHandler;
 class CefDragData;
 class CefFrame;
+class CefImageCaptureCallback;
+class CefLocalStorageVisitor;
+class CefPageCaptureHandler;
 class CefPostData;
 class CefPostDataElement;
 class CefRequest;
+class CefRequestContext;
 class CefResponse;
 class CefSchemeHandler;
 class CefSchemeHandlerFactory;
@@ -97,6 +102,25 @@ bool CefInitialize(const CefSettings& settings);
 /*--cef()--*/
 void CefShutdown();
 
+///
+// This function may be called on the main application thread instead of
+// CefShutdown() when the application is about to exit and shutdown time
+// matters more than an orderly teardown. Cookies, DOM storage and the HTTP
+// cache index of the global request context and of each CefRequestContext are
+// written to disk in parallel and this function waits at most |timeout_ms|
+// milliseconds for them to finish. When using a single-threaded
+// message loop DOM storage is written while the calling thread is blocked and
+// is reported as timed out if that took longer than |timeout_ms|. Browsers,
+// threads and other objects are not destroyed and their memory is left for
+// the operating system to reclaim, so the application must exit the process
+// soon after this function returns and must not call any other CEF functions,
+// including CefShutdown(). |report| will be filled in with the time taken by each
+// subsystem and the subsystems that did not finish before the deadline.
+// Returns true if all subsystems finished.
+///
+/*--cef()--*/
+bool CefFastShutdown(int timeout_ms, CefShutdownReport& report);
+
 ///
 // Perform a single iteration of CEF message loop processing. This function is
 // used to integrate the CEF message loop into an existing application message
@@ -108,6 +132,34 @@ void CefShutdown();
 /*--cef()--*/
 void CefDoMessageLoopWork();
 
+///
+// Returns a file descriptor that becomes readable when work is scheduled on the
+// CEF message loop. Add the descriptor to an application poll or epoll set and
+// call CefDoMessageLoopWork() when it becomes readable instead of calling
+// CefDoMessageLoopWork() on a timer. CefDoMessageLoopWork() resets the
+// descriptor and the application must not read from it. Use
+// CefGetMessageLoopWorkDelay() to determine the poll timeout. GTK events are
+// not reported by the descriptor. The descriptor is owned by CEF and remains
+// valid until CefShutdown() is called. This function should only be called on
+// the main application thread and only if CefInitialize() is called with a
+// CefSettings.multi_threaded_message_loop value of false. Returns -1 if the
+// current platform does not support a wakeup descriptor.
+///
+/*--cef()--*/
+int CefGetMessageLoopWakeupFd();
+
+///
+// Returns the number of milliseconds until delayed work is due on the CEF
+// message loop, 0 if work is ready now or -1 if no delayed work is scheduled.
+// Call this function after CefDoMessageLoopWork() to determine how long the
+// application may wait for the wakeup descriptor returned by
+// CefGetMessageLoopWakeupFd(). This function should only be called on the main
+// application thread and only if CefInitialize() is called with a
+// CefSettings.multi_threaded_message_loop value of false.
+///
+/*--cef()--*/
+long CefGetMessageLoopWorkDelay();
+
 ///
 // Run the CEF message loop. Use this function instead of an application-
 // provided message loop to get the best balance between performance and CPU
@@ -310,8 +362,13 @@ typedef cef_thread_id_t CefThreadId;
 // UI thread will be the same as the main application thread if CefInitialize()
 // is called with a CefSettings.multi_threaded_message_loop value of false.) The
 // IO thread is used for handling schema and network requests. The FILE thread
-// is used for the application cache and other miscellaneous activities. This
-// function will return true if called on the specified thread.
+// is used for the application cache and other miscellaneous activities. The
+// WORKER pool has one thread per processor core and is used for CPU-bound
+// work such as content filtering and image encoding. Tasks posted to the WORKER
+// pool may run concurrently and in any order; use CefSequencedTaskRunner when
+// tasks must run one at a time in order. Tasks posted to the other threads run
+// in the order they were posted. This function will return true if called on
+// the specified thread or, for TID_WORKER, any thread in the pool.
 ///
 /*--cef()--*/
 bool CefCurrentlyOn(CefThreadId threadId);
@@ -331,6 +388,65 @@ bool CefPostTask(CefThreadId threadId, CefRefPtr<CefTask> task);
 bool CefPostDelayedTask(CefThreadId threadId, CefRefPtr<CefTask> task,
                         long delay_ms);
 
+///
+// Post multiple tasks for execution on the specified thread using a single
+// lock acquisition and thread wakeup. This is more efficient than calling
+// CefPostTask() for each task when posting a large number of small tasks. The
+// tasks run one after the other in the order specified, including for
+// TID_WORKER where they all run on the same pool thread. Returns true without
+// posting anything if |tasks| has no entries. This function may be called on
+// any thread.
+///
+/*--cef()--*/
+bool CefPostTasks(CefThreadId threadId,
+                  const std::vector<CefRefPtr<CefTask> >& tasks);
+
+///
+// Retrieve task queue statistics for the specified thread. Returns false if
+// statistics are not being collected or if the thread is TID_WORKER. This
+// function may be called on any thread.
+///
+/*--cef()--*/
+bool CefGetThreadStats(CefThreadId threadId, CefThreadStats& stats);
+
+///
+// Start or stop collecting task queue statistics for the UI, IO and FILE
+// threads after CefInitialize() has been called. Collection is initially
+// started if CefSettings.thread_stats_enabled is true. Starting collection
+// clears any statistics collected so far and only tasks that are posted while
+// collection is started will be counted. This function may be called on any
+// thread.
+///
+/*--cef()--*/
+void CefSetThreadStatsEnabled(bool enabled);
+
+///
+// Start recording trace events for resource loads, scheme handlers, painting,
+// V8 callbacks and client handler callbacks. Each thread keeps the most recent
+// events in a fixed size buffer. Returns false if tracing is already started.
+// This function may be called on any thread.
+///
+/*--cef()--*/
+bool CefBeginTracing();
+
+///
+// Stop recording trace events and write them to |tracing_file| in the JSON
+// format used by the Chrome about:tracing page. Returns false if tracing was
+// not started or if the file could not be written. This function may be
+// called on any thread and blocks while the file is written.
+///
+/*--cef()--*/
+bool CefEndTracing(const CefString& tracing_file);
+
+///
+// Retrieve the time spent in each phase of CEF startup. Subsystems such as the
+// application cache, Web SQL databases, the FileSystem API and plugins are
+// initialized when first used and report 0 until then. Returns false if CEF
+// is not initialized. This function may be called on any thread.
+///
+/*--cef()--*/
+bool CefGetStartupTimings(CefStartupTimings& timings);
+
 ///
 // Parse the specified |url| into its component parts.
 // Returns false if the URL is empty or invalid.
@@ -350,7 +466,10 @@ bool CefCreateURL(const CefURLParts& parts,
 
 ///
 // Visit all cookies. The returned cookies are ordered by longest path, then by
-// earliest creation date. Returns false if cookies cannot be accessed.
+// earliest creation date. When cookies are loaded on demand the cookies in
+// memory are visited first and the remaining cookies are then read from the
+// cookie database and ordered a few domains at a time. Returns false if
+// cookies cannot be accessed.
 ///
 /*--cef()--*/
 bool CefVisitAllCookies(CefRefPtr<CefCookieVisitor> visitor);
@@ -366,6 +485,18 @@ bool CefVisitAllCookies(CefRefPtr<CefCookieVisitor> visitor);
 bool CefVisitUrlCookies(const CefString& url, bool includeHttpOnly,
                         CefRefPtr<CefCookieVisitor> visitor);
 
+///
+// Visit all cookies in batches of up to |batchSize| cookies. This is more
+// efficient than CefVisitAllCookies() when there are a large number of
+// cookies. The returned cookies are ordered in the same way as for
+// CefVisitAllCookies(). When cookies are loaded on demand they are read from
+// the cookie database while the batches are visited instead of all at once.
+// Returns false if cookies cannot be accessed.
+///
+/*--cef()--*/
+bool CefVisitAllCookiesInBatches(int batchSize,
+                                 CefRefPtr<CefCookieBatchVisitor> visitor);
+
 ///
 // Sets a cookie given a valid URL and explicit user-provided cookie attributes.
 // This function expects each attribute to be well-formed. It will check for
@@ -376,6 +507,27 @@ bool CefVisitUrlCookies(const CefString& url, bool includeHttpOnly,
 /*--cef()--*/
 bool CefSetCookie(const CefString& url, const CefCookie& cookie);
 
+///
+// Import multiple cookies, for example cookies visited in another cookie
+// store. Each cookie must specify a |domain| in the form returned by the
+// cookie visitors and a |creation| time that is unique because it identifies
+// the cookie in the cookie database. A cookie without a |creation| time will
+// be given the current time. An existing cookie with the same name, domain
+// and path will be replaced. The cookies are written to the cookie database
+// in a single transaction. The cookie store holds at most 3300 cookies in
+// memory, so when importing more cookies use an on-demand
+// CefSettings.cookie_load_mode to avoid losing the least recently used
+// cookies. This function may be called on any thread. If called on a thread
+// other than the IO thread the cookies will be imported asynchronously. Each
+// |domain| is canonicalized and a cookie is skipped if its domain is invalid,
+// if it is a domain cookie for an IP address or a public suffix such as
+// ".co.uk", or if its attributes contain disallowed characters. Importing zero
+// cookies does nothing and returns true. Returns false if cookies cannot be
+// accessed or if every cookie was skipped.
+///
+/*--cef()--*/
+bool CefSetCookies(const std::vector<CefCookie>& cookies);
+
 ///
 // Delete all cookies that match the specified parameters. If both |url| and
 // |cookie_name| are specified all host and domain cookies matching both values
@@ -388,6 +540,106 @@ bool CefSetCookie(const CefString& url, const CefCookie& cookie);
 /*--cef()--*/
 bool CefDeleteCookies(const CefString& url, const CefString& cookie_name);
 
+///
+// Retrieve statistics for the cookie database. Returns false if cookies are
+// not persisted because CefSettings.cache_path is not specified. This function
+// may be called on any thread.
+///
+/*--cef()--*/
+bool CefGetCookieStoreStats(CefCookieStoreStats& stats);
+
+///
+// Write pending cookie changes to the cookie database instead of waiting for
+// the next periodic commit. If |completionTask| is non-NULL it will be
+// executed on the FILE thread after the changes have been written. Returns
+// false if cookies are not persisted because CefSettings.cache_path is not
+// specified. This function may be called on any thread.
+///
+/*--cef()--*/
+bool CefFlushCookieStore(CefRefPtr<CefTask> completionTask);
+
+///
+// Write a snapshot of the cookies to |writer| in a compact binary format. If
+// |domain| is specified only cookies for that domain and its subdomains will
+// be written. Returns false if the snapshot could not be written. This function
+// must be called on the IO thread.
+///
+/*--cef()--*/
+bool CefSaveCookies(const CefString& domain, CefRefPtr<CefStreamWriter> writer);
+
+///
+// Replace the cookies with a snapshot read from |reader| that was written by
+// CefSaveCookies(). If the snapshot was saved for a domain only the cookies for
+// that domain and its subdomains will be replaced. Otherwise all cookies will
+// be replaced. Returns false and leaves the cookies unchanged if the snapshot
+// is not valid. This function must be called on the IO thread.
+///
+/*--cef()--*/
+bool CefRestoreCookies(CefRefPtr<CefStreamReader> reader);
+
+// Map of localStorage keys to values.
+typedef std::map<CefString,CefString> CefLocalStorageItemMap;
+
+///
+// Visit all of the localStorage items for |origin|, for example
+// "http://www.example.com". The items are read in a single task on the UI
+// thread and the visitor will be called on the UI thread. Returns false if
+// |origin| is invalid. This function can be called on any thread.
+///
+/*--cef()--*/
+bool CefVisitLocalStorage(const CefString& origin,
+                          CefRefPtr<CefLocalStorageVisitor> visitor);
+
+///
+// Write |items| to the localStorage for |origin|. If |clear| is true the
+// existing items for |origin| will be removed first. The items are written in
+// a single task on the UI thread. Items that exceed the localStorage quota
+// are not written. Returns false if |origin| is invalid. This function can be
+// called on any thread.
+///
+/*--cef()--*/
+bool CefSetLocalStorage(const CefString& origin,
+                        const CefLocalStorageItemMap& items, bool clear);
+
+///
+// Retrieve statistics for the HTTP cache. Returns false if the cache has not
+// been created yet. This function must be called on the IO thread.
+///
+/*--cef()--*/
+bool CefGetHttpCacheStats(CefHttpCacheStats& stats);
+
+///
+// Remove entries from the HTTP cache. If |url_prefix| is specified only the
+// entries for URLs that start with |url_prefix| will be removed. If |max_age|
+// is greater than 0 only the entries that have not been used in the last
+// |max_age| seconds will be removed. The entries are removed asynchronously on
+// the IO thread. If |completionTask| is non-NULL it will be executed on the IO
+// thread after the entries have been removed. This function can be called on
+// any thread.
+///
+/*--cef()--*/
+bool CefPurgeHttpCache(const CefString& url_prefix, int max_age,
+                       CefRefPtr<CefTask> completionTask);
+
+///
+// Add an entry to the HTTP cache as if the response for |url| had been received
+// from the network. |headers| contains the raw response headers starting with
+// the status line, one header per line. Only http and https URLs with a 200
+// status can be imported. |data| is read on the calling thread and contains the
+// response body. The entry replaces any existing entry for |url| and is written
+// asynchronously on the IO thread. The response is treated as having been
+// received when this function is called so the entry will be used without
+// contacting the server while it is fresh according to its Cache-Control or
+// Expires headers. After that the ETag and Last-Modified headers are used to
+// revalidate the entry. If |completionTask| is non-NULL and this function
+// returns true it will be executed on the IO thread after the entry has been
+// written or the write has failed. This function can be called on any thread.
+///
+/*--cef()--*/
+bool CefImportHttpCacheEntry(const CefString& url, const CefString& headers,
+                             CefRefPtr<CefStreamReader> data,
+                             CefRefPtr<CefTask> completionTask);
+
 
 ///
 // Interface defining the reference count implementation methods. All framework
@@ -507,6 +759,45 @@ public:
 };
 
 
+///
+// Class that runs tasks on the WORKER pool one at a time in the order they
+// were posted. Tasks posted to the same runner never run concurrently but may
+// run on different threads in the pool. A delayed task is added to the end of
+// the sequence when its delay expires. The methods of this class may be called
+// on any thread.
+///
+/*--cef(source=library)--*/
+class CefSequencedTaskRunner : public virtual CefBase
+{
+public:
+  ///
+  // Create a new task runner.
+  ///
+  /*--cef()--*/
+  static CefRefPtr<CefSequencedTaskRunner> Create();
+
+  ///
+  // Post a task for execution. Returns false if the task could not be posted.
+  ///
+  /*--cef()--*/
+  virtual bool PostTask(CefRefPtr<CefTask> task) =0;
+
+  ///
+  // Post a task for delayed execution. Returns false if the task could not be
+  // posted.
+  ///
+  /*--cef()--*/
+  virtual bool PostDelayedTask(CefRefPtr<CefTask> task, long delay_ms) =0;
+
+  ///
+  // Returns true if a task from this runner is executing on the current
+  // thread.
+  ///
+  /*--cef()--*/
+  virtual bool RunsTasksOnCurrentThread() =0;
+};
+
+
 ///
 // Interface to implement for visiting cookie values. The methods of this class
 // will always be called on the IO thread.
@@ -528,6 +819,127 @@ public:
 };
 
 
+///
+// Interface to implement for visiting cookie values in batches. The methods of
+// this class will always be called on the IO thread.
+///
+/*--cef(source=client)--*/
+class CefCookieBatchVisitor : public virtual CefBase
+{
+public:
+  ///
+  // Method that will be called once for each batch of cookies. |offset| is the
+  // 0-based index of the first cookie in |cookies|. |total| is the total
+  // number of cookies. Return false to stop visiting cookies. This method may
+  // never be called if no cookies are found.
+  ///
+  /*--cef()--*/
+  virtual bool Visit(const std::vector<CefCookie>& cookies, int offset,
+                     int total) =0;
+};
+
+
+///
+// Interface to implement for visiting localStorage items. The methods of this
+// class will always be called on the UI thread.
+///
+/*--cef(source=client)--*/
+class CefLocalStorageVisitor : public virtual CefBase
+{
+public:
+  ///
+  // Method that will be called once with all of the localStorage items for
+  // |origin|.
+  ///
+  /*--cef()--*/
+  virtual void Visit(const CefString& origin,
+                     const CefLocalStorageItemMap& items) =0;
+};
+
+
+///
+// Interface to implement for receiving the result of CefBrowser::CaptureImage().
+// The methods of this class will be called on a WORKER pool thread.
+///
+/*--cef(source=client)--*/
+class CefImageCaptureCallback : public virtual CefBase
+{
+public:
+  ///
+  // Method that will be called when the capture is complete. |data| contains
+  // |dataSize| bytes of encoded image data. If the capture failed |success|
+  // will be false and |data| will be NULL. |data| is only valid for the
+  // duration of this call.
+  ///
+  /*--cef()--*/
+  virtual void OnImageCaptured(CefRefPtr<CefBrowser> browser, bool success,
+                               const void* data, size_t dataSize) =0;
+};
+
+
+///
+// Interface to implement for receiving tiles from CefBrowser::CapturePage().
+// The methods of this class will be called on the UI thread.
+///
+/*--cef(source=client)--*/
+class CefPageCaptureHandler : public virtual CefBase
+{
+public:
+  ///
+  // Called before the first tile is delivered. |width| and |height| are the
+  // size of the whole page in pixels. Return false to cancel the capture.
+  ///
+  /*--cef()--*/
+  virtual bool OnCaptureStart(CefRefPtr<CefBrowser> browser, int width,
+                              int height) { return true; }
+
+  ///
+  // Called for each tile in top to bottom order. |tileRect| is the tile's
+  // position in page coordinates. |buffer| is tileRect.width*tileRect.height*4
+  // bytes in size and uses the format specified by
+  // CefBrowser::SetPixelFormat() with an upper-left origin. |buffer| is only
+  // valid for the duration of this call. Return false to cancel the capture.
+  ///
+  /*--cef()--*/
+  virtual bool OnCaptureTile(CefRefPtr<CefBrowser> browser,
+                             const CefRect& tileRect,
+                             const void* buffer) =0;
+};
+
+
+///
+// Class representing a separate cookie store and HTTP cache that can be used by
+// one or more browsers. Network connections, the host resolver cache and proxy
+// settings are shared by all request contexts. Cookie functions that are not
+// passed a request context, such as CefVisitAllCookies(), only access the
+// global cookie store. A request context that is still referenced when
+// CefShutdown() is called releases its cookie store and HTTP cache at that
+// time and can no longer be used by new browsers. The methods of this class
+// may be called on any thread.
+///
+/*--cef(source=library)--*/
+class CefRequestContext : public virtual CefBase
+{
+public:
+  ///
+  // Create a new request context. If |cache_path| is specified the HTTP cache
+  // and persistent cookies will be stored in that directory. Otherwise they
+  // will be kept in memory. |cache_path| should not be the same as
+  // CefSettings.cache_path or the path used by another request context.
+  ///
+  /*--cef()--*/
+  static CefRefPtr<CefRequestContext> CreateContext(
+      const CefString& cache_path);
+
+  ///
+  // Returns the cache path for this request context. The path is not set if
+  // the cache is kept in memory.
+  ///
+  /*--cef()--*/
+  virtual CefString GetCachePath() =0;
+};
+
+
 ///
 // Class used to represent a browser window. The methods of this class may be
 // called on any thread unless otherwise indicated in the comments.
@@ -539,6 +951,8 @@ public:
   typedef cef_key_type_t KeyType;
   typedef cef_mouse_button_type_t MouseButtonType;
   typedef cef_paint_element_type_t PaintElementType;
+  typedef cef_pixel_format_t PixelFormat;
+  typedef cef_image_encoding_t ImageEncoding;
 
   ///
   // Create a new browser window using the window parameters specified by
@@ -551,6 +965,19 @@ public:
                             const CefString& url,
                             const CefBrowserSettings& settings);
 
+  ///
+  // Create a new browser window that uses |requestContext| for cookies and the
+  // HTTP cache. If |requestContext| is NULL the global request context will be
+  // used. Popup windows use the same request context as the browser that
+  // opened them. This method call will not block.
+  ///
+  /*--cef(capi_name=cef_browser_create_with_context)--*/
+  static bool CreateBrowser(CefWindowInfo& windowInfo,
+                            CefRefPtr<CefClient> client,
+                            const CefString& url,
+                            const CefBrowserSettings& settings,
+                            CefRefPtr<CefRequestContext> requestContext);
+
   ///
   // Create a new browser window using the window parameters specified by
   // |windowInfo|. This method should only be called on the UI thread.
@@ -561,6 +988,19 @@ public:
                                                  const CefString& url,
                                                  const CefBrowserSettings& settings);
 
+  ///
+  // Create a new browser window that uses |requestContext| for cookies and the
+  // HTTP cache. If |requestContext| is NULL the global request context will be
+  // used. This method should only be called on the UI thread.
+  ///
+  /*--cef(capi_name=cef_browser_create_sync_with_context)--*/
+  static CefRefPtr<CefBrowser> CreateBrowserSync(
+      CefWindowInfo& windowInfo,
+      CefRefPtr<CefClient> client,
+      const CefString& url,
+      const CefBrowserSettings& settings,
+      CefRefPtr<CefRequestContext> requestContext);
+
   ///
   // Call this method before destroying a contained browser window. This method
   // performs any internal cleanup that may be needed before the browser window
@@ -758,17 +1198,89 @@ public:
   /*--cef()--*/
   virtual void Invalidate(const CefRect& dirtyRect) =0;
 
+  ///
+  // Notify the browser that it has been hidden or shown. Call this method when
+  // the browser window is minimized or, if window rendering is disabled, when
+  // the view is no longer displayed. While hidden the browser does not paint,
+  // releases its backing store, reports a hidden page visibility state to the
+  // page and runs JavaScript timers and animations at a reduced rate. The whole
+  // view is repainted when the browser is shown again.
+  ///
+  /*--cef()--*/
+  virtual void WasHidden(bool hidden) =0;
+
+  ///
+  // Returns true if the browser is currently hidden.
+  ///
+  /*--cef()--*/
+  virtual bool IsHidden() =0;
+
   ///
   // Get the raw image data contained in the specified element without
   // performing validation. The specified |width| and |height| dimensions must
   // match the current element size. On Windows |buffer| must be width*height*4
-  // bytes in size and represents a BGRA image with an upper-left origin. This
-  // method should only be called on the UI thread.
+  // bytes in size and represents an image in the format returned by
+  // GetPixelFormat(). This method should only be called on the UI thread.
   ///
   /*--cef()--*/
   virtual bool GetImage(PaintElementType type, int width, int height,
                         void* buffer) =0;
 
+  ///
+  // Set the format of the image data passed to CefRenderHandler::OnPaint() and
+  // returned by GetImage(). |format| is a combination of cef_pixel_format_t
+  // flags. Only the dirty region of each paint is converted. Changing the
+  // format results in a repaint of the whole view. This method is only used
+  // when window rendering is disabled.
+  ///
+  /*--cef()--*/
+  virtual void SetPixelFormat(PixelFormat format) =0;
+
+  ///
+  // Returns the format of the image data passed to CefRenderHandler::OnPaint()
+  // and returned by GetImage().
+  ///
+  /*--cef()--*/
+  virtual PixelFormat GetPixelFormat() =0;
+
+  ///
+  // Capture the contents of the specified element and encode it as an image.
+  // The |srcRect| region of the element is copied on the UI thread and, if
+  // |width| and |height| are non-zero, scaled to that size. Scaling and
+  // encoding are performed on the WORKER pool and the result is delivered to
+  // |callback|. If |srcRect| is empty the whole element is captured. |quality|
+  // is a value from 0 to 100 and is only used for IMAGE_ENCODING_JPEG.
+  ///
+  /*--cef()--*/
+  virtual void CaptureImage(PaintElementType type, const CefRect& srcRect,
+                            int width, int height, ImageEncoding encoding,
+                            int quality,
+                            CefRefPtr<CefImageCaptureCallback> callback) =0;
+
+  ///
+  // Capture the whole page, including content outside of the visible area, by
+  // laying out at the current view width and painting the page in tiles of
+  // |tileHeight| pixels. If |tileHeight| is 0 the current view height is used.
+  // Each tile is delivered to |handler| before the next tile is painted so
+  // memory usage is proportional to the tile size instead of the page size.
+  // The view is repainted when the capture completes. Returns true if all
+  // tiles were delivered. This method should only be called on the UI thread.
+  ///
+  /*--cef()--*/
+  virtual bool CapturePage(int tileHeight,
+                           CefRefPtr<CefPageCaptureHandler> handler) =0;
+
+  ///
+  // Capture the whole page as described for CapturePage() and write the tiles
+  // to |stream| in order. The result is the raw pixel data of the page with
+  // width*4 bytes per row in the format specified by SetPixelFormat() with an
+  // upper-left origin. Returns true if all tiles were written. This method
+  // should only be called on the UI thread.
+  ///
+  /*--cef()--*/
+  virtual bool CapturePageToStream(int tileHeight,
+                                   CefRefPtr<CefStreamWriter> stream) =0;
+
   ///
   // Send a key event to the browser.
   ///
@@ -786,14 +1298,16 @@ public:
 
   ///
   // Send a mouse move event to the browser. The |x| and |y| coordinates are
-  // relative to the upper-left corner of the view.
+  // relative to the upper-left corner of the view. If a mouse move event is
+  // still waiting to be dispatched it will be replaced by this event.
   ///
   /*--cef()--*/
   virtual void SendMouseMoveEvent(int x, int y, bool mouseLeave) =0;
 
   ///
   // Send a mouse wheel event to the browser. The |x| and |y| coordinates are
-  // relative to the upper-left corner of the view.
+  // relative to the upper-left corner of the view. If a mouse wheel event is
+  // still waiting to be dispatched this event's |delta| will be added to it.
   ///
   /*--cef()--*/
   virtual void SendMouseWheelEvent(int x, int y, int delta) =0;
@@ -809,6 +1323,72 @@ public:
   ///
   /*--cef()--*/
   virtual void SendCaptureLostEvent() =0;
+
+  ///
+  // Send multiple input events to the browser in order. This is more efficient
+  // than sending each event individually. Consecutive mouse move events are
+  // merged into the most recent one and consecutive mouse wheel events are
+  // merged by summing their deltas before they are dispatched.
+  ///
+  /*--cef()--*/
+  virtual void SendInputEvents(const std::vector<CefInputEvent>& events) =0;
+};
+
+
+///
+// Class that keeps a number of blank, hidden off-screen browsers ready so that
+// a new browser can be shown without waiting for the WebView to be created.
+// When a browser is no longer needed it can be returned to the pool where its
+// history and page state are cleared so that it can be used again. The methods
+// of this class should only be called on the UI thread.
+///
+/*--cef(source=library)--*/
+class CefBrowserPool : public virtual CefBase
+{
+public:
+  ///
+  // Create a new pool that keeps |size| idle browsers created with
+  // |windowInfo| and |settings|. Window rendering must be disabled in
+  // |windowInfo|. Returns NULL if the pool cannot be created.
+  ///
+  /*--cef()--*/
+  static CefRefPtr<CefBrowserPool> Create(CefWindowInfo& windowInfo,
+                                          int size,
+                                          const CefBrowserSettings& settings);
+
+  ///
+  // Take an idle browser from the pool, attach |client| to it and load |url|.
+  // The client's CefLifeSpanHandler::OnAfterCreated() method will be called
+  // as if the browser had just been created. If no idle browsers are available
+  // a new browser will be created. The pool is refilled asynchronously.
+  ///
+  /*--cef()--*/
+  virtual CefRefPtr<CefBrowser> TakeBrowser(CefRefPtr<CefClient> client,
+                                            const CefString& url) =0;
+
+  ///
+  // Return a browser that was taken from this pool. The client's life span
+  // handler will be notified that the browser is closing and the client will
+  // be detached. The browser's history, sessionStorage, find state and zoom
+  // level are reset and it is navigated to about:blank. If the pool is already
+  // full the browser will be closed instead. Returns false if |browser| was not
+  // taken from this pool or has already been closed.
+  ///
+  /*--cef()--*/
+  virtual bool ReturnBrowser(CefRefPtr<CefBrowser> browser) =0;
+
+  ///
+  // Returns the number of idle browsers in the pool.
+  ///
+  /*--cef()--*/
+  virtual int GetIdleCount() =0;
+
+  ///
+  // Close all idle browsers. Browsers that are in use are not affected and
+  // will be closed when they are returned.
+  ///
+  /*--cef()--*/
+  virtual void Close() =0;
 };
 
 
@@ -1532,7 +2112,10 @@ public:
   // element is the view or the popup widget. |buffer| contains the pixel data
   // for the whole image. |dirtyRect| indicates the portion of the image that
   // has been repainted. On Windows |buffer| will be width*height*4 bytes in
-  // size and represents a BGRA image with an upper-left origin.
+  // size and represents an image in the format specified by
+  // CefBrowser::SetPixelFormat(). By default this is a premultiplied BGRA image
+  // with an upper-left origin. |dirtyRect| is always relative to the upper-left
+  // corner of the view.
   ///
   /*--cef()--*/
   virtual void OnPaint(CefRefPtr<CefBrowser> browser,
@@ -3416,7 +3999,7 @@ public:
 
 ///
 // Interface to implement for filtering response content. The methods of this
-// class will always be called on the UI thread.
+// class will be called on the UI thread unless UseWorkerThread() returns true.
 ///
 /*--cef(source=client)--*/
 class CefContentFilter : public virtual CefBase
@@ -3437,6 +4020,15 @@ public:
   ///
   /*--cef()--*/
   virtual void Drain(CefRefPtr<CefStreamReader>& remainder) {}
+
+  ///
+  // Return true if ProcessData() and Drain() should be called on a WORKER pool
+  // thread instead of the UI thread. Calls for the same filter will still
+  // happen one at a time and in the order that data is received. This method
+  // is called once on the UI thread before any data is processed.
+  ///
+  /*--cef()--*/
+  virtual bool UseWorkerThread() { return false; }
 };
 
 
@@ -61,6 +61,25 @@ CEF_EXPORT int cef_initialize(const struct _cef_settings_t* settings);
 ///
 CEF_EXPORT void cef_shutdown();
 
+///
+// This function may be called on the main application thread instead of
+// cef_shutdown() when the application is about to exit and shutdown time
+// matters more than an orderly teardown. Cookies, DOM storage and the HTTP
+// cache index of the global request context and of each cef_request_context_t
+// are written to disk in parallel and this function waits at most |timeout_ms|
+// milliseconds for them to finish. When using a single-threaded message loop
+// DOM storage is written while the calling thread is blocked and is reported as
+// timed out if that took longer than |timeout_ms|. Browsers, threads and other
+// objects are not destroyed and their memory is left for the operating system
+// to reclaim, so the application must exit the process soon after this function
+// returns and must not call any other CEF functions, including cef_shutdown().
+// |report| will be filled in with the time taken by each subsystem and the
+// subsystems that did not finish before the deadline. Returns true (1) if all
+// subsystems finished.
+///
+CEF_EXPORT int cef_fast_shutdown(int timeout_ms,
+    struct _cef_shutdown_report_t* report);
+
 ///
 // Perform a single iteration of CEF message loop processing. This function is
 // used to integrate the CEF message loop into an existing application message
@@ -71,6 +90,32 @@ CEF_EXPORT void cef_shutdown();
 ///
 CEF_EXPORT void cef_do_message_loop_work();
 
+///
+// Returns a file descriptor that becomes readable when work is scheduled on the
+// CEF message loop. Add the descriptor to an application poll or epoll set and
+// call cef_do_message_loop_work() when it becomes readable instead of calling
+// cef_do_message_loop_work() on a timer. cef_do_message_loop_work() resets the
+// descriptor and the application must not read from it. Use
+// cef_get_message_loop_work_delay() to determine the poll timeout. GTK events
+// are not reported by the descriptor. The descriptor is owned by CEF and
+// remains valid until cef_shutdown() is called. This function should only be
+// called on the main application thread and only if cef_initialize() is called
+// with a CefSettings.multi_threaded_message_loop value of false (0). Returns -1
+// if the current platform does not support a wakeup descriptor.
+///
+CEF_EXPORT int cef_get_message_loop_wakeup_fd();
+
+///
+// Returns the number of milliseconds until delayed work is due on the CEF
+// message loop, 0 if work is ready now or -1 if no delayed work is scheduled.
+// Call this function after cef_do_message_loop_work() to determine how long the
+// application may wait for the wakeup descriptor returned by
+// cef_get_message_loop_wakeup_fd(). This function should only be called on the
+// main application thread and only if cef_initialize() is called with a
+// CefSettings.multi_threaded_message_loop value of false (0).
+///
+CEF_EXPORT long cef_get_message_loop_work_delay();
+
 ///
 // Run the CEF message loop. Use this function instead of an application-
 // provided message loop to get the best balance between performance and CPU
@@ -254,7 +299,12 @@ CEF_EXPORT int cef_clear_cross_origin_whitelist();
 // called with a CefSettings.multi_threaded_message_loop value of false (0).)
 // The IO thread is used for handling schema and network requests. The FILE
 // thread is used for the application cache and other miscellaneous activities.
-// This function will return true (1) if called on the specified thread.
+// The WORKER pool has one thread per processor core and is used for CPU-bound
+// work such as content filtering and image encoding. Tasks posted to the WORKER
+// pool may run concurrently and in any order; use cef_sequenced_task_runner_t
+// when tasks must run one at a time in order. Tasks posted to the other threads
+// run in the order they were posted. This function will return true (1) if
+// called on the specified thread or, for TID_WORKER, any thread in the pool.
 ///
 CEF_EXPORT int cef_currently_on(cef_thread_id_t threadId);
 
@@ -272,6 +322,60 @@ CEF_EXPORT int cef_post_task(cef_thread_id_t threadId,
 CEF_EXPORT int cef_post_delayed_task(cef_thread_id_t threadId,
     struct _cef_task_t* task, long delay_ms);
 
+///
+// Post multiple tasks for execution on the specified thread using a single lock
+// acquisition and thread wakeup. This is more efficient than calling
+// cef_post_task() for each task when posting a large number of small tasks. The
+// tasks run one after the other in the order specified, including for
+// TID_WORKER where they all run on the same pool thread. Returns true (1)
+// without posting anything if |tasks| has no entries. This function may be
+// called on any thread.
+///
+CEF_EXPORT int cef_post_tasks(cef_thread_id_t threadId, size_t taskCount,
+    struct _cef_task_t* const* tasks);
+
+///
+// Retrieve task queue statistics for the specified thread. Returns false (0) if
+// statistics are not being collected or if the thread is TID_WORKER. This
+// function may be called on any thread.
+///
+CEF_EXPORT int cef_get_thread_stats(cef_thread_id_t threadId,
+    struct _cef_thread_stats_t* stats);
+
+///
+// Start or stop collecting task queue statistics for the UI, IO and FILE
+// threads after cef_initialize() has been called. Collection is initially
+// started if CefSettings.thread_stats_enabled is true (1). Starting collection
+// clears any statistics collected so far and only tasks that are posted while
+// collection is started will be counted. This function may be called on any
+// thread.
+///
+CEF_EXPORT void cef_set_thread_stats_enabled(int enabled);
+
+///
+// Start recording trace events for resource loads, scheme handlers, painting,
+// V8 callbacks and client handler callbacks. Each thread keeps the most recent
+// events in a fixed size buffer. Returns false (0) if tracing is already
+// started. This function may be called on any thread.
+///
+CEF_EXPORT int cef_begin_tracing();
+
+///
+// Stop recording trace events and write them to |tracing_file| in the JSON
+// format used by the Chrome about:tracing page. Returns false (0) if tracing
+// was not started or if the file could not be written. This function may be
+// called on any thread and blocks while the file is written.
+///
+CEF_EXPORT int cef_end_tracing(const cef_string_t* tracing_file);
+
+///
+// Retrieve the time spent in each phase of CEF startup. Subsystems such as the
+// application cache, Web SQL databases, the FileSystem API and plugins are
+// initialized when first used and report 0 until then. Returns false (0) if CEF
+// is not initialized. This function may be called on any thread.
+///
+CEF_EXPORT int cef_get_startup_timings(struct _cef_startup_timings_t* timings);
+
 ///
 // Parse the specified |url| into its component parts. Returns false (0) if the
 // URL is NULL or invalid.
@@ -289,7 +393,10 @@ CEF_EXPORT int cef_create_url(const struct _cef_urlparts_t* parts,
 
 ///
 // Visit all cookies. The returned cookies are ordered by longest path, then by
-// earliest creation date. Returns false (0) if cookies cannot be accessed.
+// earliest creation date. When cookies are loaded on demand the cookies in
+// memory are visited first and the remaining cookies are then read from the
+// cookie database and ordered a few domains at a time. Returns false (0) if
+// cookies cannot be accessed.
 ///
 CEF_EXPORT int cef_visit_all_cookies(struct _cef_cookie_visitor_t* visitor);
 
@@ -303,6 +410,17 @@ CEF_EXPORT int cef_visit_all_cookies(struct _cef_cookie_visitor_t* visitor);
 CEF_EXPORT int cef_visit_url_cookies(const cef_string_t* url,
     int includeHttpOnly, struct _cef_cookie_visitor_t* visitor);
 
+///
+// Visit all cookies in batches of up to |batchSize| cookies. This is more
+// efficient than cef_visit_all_cookies() when there are a large number of
+// cookies. The returned cookies are ordered in the same way as for
+// cef_visit_all_cookies(). When cookies are loaded on demand they are read from
+// the cookie database while the batches are visited instead of all at once.
+// Returns false (0) if cookies cannot be accessed.
+///
+CEF_EXPORT int cef_visit_all_cookies_in_batches(int batchSize,
+    struct _cef_cookie_batch_visitor_t* visitor);
+
 ///
 // Sets a cookie given a valid URL and explicit user-provided cookie attributes.
 // This function expects each attribute to be well-formed. It will check for
@@ -313,6 +431,25 @@ CEF_EXPORT int cef_visit_url_cookies(const cef_string_t* url,
 CEF_EXPORT int cef_set_cookie(const cef_string_t* url,
     const struct _cef_cookie_t* cookie);
 
+///
+// Import multiple cookies, for example cookies visited in another cookie store.
+// Each cookie must specify a |domain| in the form returned by the cookie
+// visitors and a |creation| time that is unique because it identifies the
+// cookie in the cookie database. A cookie without a |creation| time will be
+// given the current time. An existing cookie with the same name, domain and
+// path will be replaced. The cookies are written to the cookie database in a
+// single transaction. The cookie store holds at most 3300 cookies in memory, so
+// when importing more cookies use an on-demand CefSettings.cookie_load_mode to
+// avoid losing the least recently used cookies. This function may be called on
+// any thread. If called on a thread other than the IO thread the cookies will
+// be imported asynchronously. Each |domain| is canonicalized and a cookie is
+// skipped if its domain is invalid, if it is a domain cookie for an IP address
+// or a public suffix such as ".co.uk", or if its attributes contain disallowed
+// characters. Importing zero cookies does nothing and returns true (1). Returns
+// false (0) if cookies cannot be accessed or if every cookie was skipped.
+///
+CEF_EXPORT int cef_set_cookies(size_t cookieCount, const cef_cookie_t* cookies);
+
 ///
 // Delete all cookies that match the specified parameters. If both |url| and
 // |cookie_name| are specified all host and domain cookies matching both values
@@ -325,6 +462,97 @@ CEF_EXPORT int cef_set_cookie(const cef_string_t* url,
 CEF_EXPORT int cef_delete_cookies(const cef_string_t* url,
     const cef_string_t* cookie_name);
 
+///
+// Retrieve statistics for the cookie database. Returns false (0) if cookies are
+// not persisted because CefSettings.cache_path is not specified. This function
+// may be called on any thread.
+///
+CEF_EXPORT int cef_get_cookie_store_stats(
+    struct _cef_cookie_store_stats_t* stats);
+
+///
+// Write pending cookie changes to the cookie database instead of waiting for
+// the next periodic commit. If |completionTask| is non-NULL it will be executed
+// on the FILE thread after the changes have been written. Returns false (0) if
+// cookies are not persisted because CefSettings.cache_path is not specified.
+// This function may be called on any thread.
+///
+CEF_EXPORT int cef_flush_cookie_store(struct _cef_task_t* completionTask);
+
+///
+// Write a snapshot of the cookies to |writer| in a compact binary format. If
+// |domain| is specified only cookies for that domain and its subdomains will be
+// written. Returns false (0) if the snapshot could not be written. This
+// function must be called on the IO thread.
+///
+CEF_EXPORT int cef_save_cookies(const cef_string_t* domain,
+    struct _cef_stream_writer_t* writer);
+
+///
+// Replace the cookies with a snapshot read from |reader| that was written by
+// cef_save_cookies(). If the snapshot was saved for a domain only the cookies
+// for that domain and its subdomains will be replaced. Otherwise all cookies
+// will be replaced. Returns false (0) and leaves the cookies unchanged if the
+// snapshot is not valid. This function must be called on the IO thread.
+///
+CEF_EXPORT int cef_restore_cookies(struct _cef_stream_reader_t* reader);
+
+///
+// Visit all of the localStorage items for |origin|, for example
+// "http://www.example.com". The items are read in a single task on the UI
+// thread and the visitor will be called on the UI thread. Returns false (0) if
+// |origin| is invalid. This function can be called on any thread.
+///
+CEF_EXPORT int cef_visit_local_storage(const cef_string_t* origin,
+    struct _cef_local_storage_visitor_t* visitor);
+
+///
+// Write |items| to the localStorage for |origin|. If |clear| is true (1) the
+// existing items for |origin| will be removed first. The items are written in a
+// single task on the UI thread. Items that exceed the localStorage quota are
+// not written. Returns false (0) if |origin| is invalid. This function can be
+// called on any thread.
+///
+CEF_EXPORT int cef_set_local_storage(const cef_string_t* origin,
+    cef_string_map_t items, int clear);
+
+///
+// Retrieve statistics for the HTTP cache. Returns false (0) if the cache has
+// not been created yet. This function must be called on the IO thread.
+///
+CEF_EXPORT int cef_get_http_cache_stats(struct _cef_http_cache_stats_t* stats);
+
+///
+// Remove entries from the HTTP cache. If |url_prefix| is specified only the
+// entries for URLs that start with |url_prefix| will be removed. If |max_age|
+// is greater than 0 only the entries that have not been used in the last
+// |max_age| seconds will be removed. The entries are removed asynchronously on
+// the IO thread. If |completionTask| is non-NULL it will be executed on the IO
+// thread after the entries have been removed. This function can be called on
+// any thread.
+///
+CEF_EXPORT int cef_purge_http_cache(const cef_string_t* url_prefix, int max_age,
+    struct _cef_task_t* completionTask);
+
+///
+// Add an entry to the HTTP cache as if the response for |url| had been received
+// from the network. |headers| contains the raw response headers starting with
+// the status line, one header per line. Only http and https URLs with a 200
+// status can be imported. |data| is read on the calling thread and contains the
+// response body. The entry replaces any existing entry for |url| and is written
+// asynchronously on the IO thread. The response is treated as having been
+// received when this function is called so the entry will be used without
+// contacting the server while it is fresh according to its Cache-Control or
+// Expires headers. After that the ETag and Last-Modified headers are used to
+// revalidate the entry. If |completionTask| is non-NULL and this function
+// returns true (1) it will be executed on the IO thread after the entry has
+// been written or the write has failed. This function can be called on any
+// thread.
+///
+CEF_EXPORT int cef_import_http_cache_entry(const cef_string_t* url,
+    const cef_string_t* headers, struct _cef_stream_reader_t* data,
+    struct _cef_task_t* completionTask);
+
 typedef struct _cef_base_t
 {
   // Size of the data structure.
@@ -367,6 +595,49 @@ typedef struct _cef_task_t
 } cef_task_t;
 
 
+///
+// Structure that runs tasks on the WORKER pool one at a time in the order they
+// were posted. Tasks posted to the same runner never run concurrently but may
+// run on different threads in the pool. A delayed task is added to the end of
+// the sequence when its delay expires. The functions of this structure may be
+// called on any thread.
+///
+typedef struct _cef_sequenced_task_runner_t
+{
+  // Base structure.
+  cef_base_t base;
+
+  ///
+  // Post a task for execution. Returns false (0) if the task could not be
+  // posted.
+  ///
+  int (CEF_CALLBACK *post_task)(struct _cef_sequenced_task_runner_t* self,
+      struct _cef_task_t* task);
+
+  ///
+  // Post a task for delayed execution. Returns false (0) if the task could not
+  // be posted.
+  ///
+  int (CEF_CALLBACK *post_delayed_task)(
+      struct _cef_sequenced_task_runner_t* self, struct _cef_task_t* task,
+      long delay_ms);
+
+  ///
+  // Returns true (1) if a task from this runner is executing on the current
+  // thread.
+  ///
+  int (CEF_CALLBACK *runs_tasks_on_current_thread)(
+      struct _cef_sequenced_task_runner_t* self);
+
+} cef_sequenced_task_runner_t;
+
+
+///
+// Create a new task runner.
+///
+CEF_EXPORT cef_sequenced_task_runner_t* cef_sequenced_task_runner_create();
+
+
 ///
 // Structure to implement for visiting cookie values. The functions of this
 // structure will always be called on the IO thread.
@@ -390,6 +661,138 @@ typedef struct _cef_cookie_visitor_t
 } cef_cookie_visitor_t;
 
 
+///
+// Structure to implement for visiting cookie values in batches. The functions
+// of this structure will always be called on the IO thread.
+///
+typedef struct _cef_cookie_batch_visitor_t
+{
+  // Base structure.
+  cef_base_t base;
+
+  ///
+  // Method that will be called once for each batch of cookies. |offset| is the
+  // 0-based index of the first cookie in |cookies|. |total| is the total number
+  // of cookies. Return false (0) to stop visiting cookies. This function may
+  // never be called if no cookies are found.
+  ///
+  int (CEF_CALLBACK *visit)(struct _cef_cookie_batch_visitor_t* self,
+      size_t cookieCount, const cef_cookie_t* cookies, int offset, int total);
+
+} cef_cookie_batch_visitor_t;
+
+
+///
+// Structure to implement for visiting localStorage items. The functions of this
+// structure will always be called on the UI thread.
+///
+typedef struct _cef_local_storage_visitor_t
+{
+  // Base structure.
+  cef_base_t base;
+
+  ///
+  // Method that will be called once with all of the localStorage items for
+  // |origin|.
+  ///
+  void (CEF_CALLBACK *visit)(struct _cef_local_storage_visitor_t* self,
+      const cef_string_t* origin, cef_string_map_t items);
+
+} cef_local_storage_visitor_t;
+
+
+///
+// Structure to implement for receiving the result of
+// cef_browser_t::capture_image(). The functions of this structure will be
+// called on a WORKER pool thread.
+///
+typedef struct _cef_image_capture_callback_t
+{
+  // Base structure.
+  cef_base_t base;
+
+  ///
+  // Method that will be called when the capture is complete. |data| contains
+  // |dataSize| bytes of encoded image data. If the capture failed |success|
+  // will be false (0) and |data| will be NULL. |data| is only valid for the
+  // duration of this call.
+  ///
+  void (CEF_CALLBACK *on_image_captured)(
+      struct _cef_image_capture_callback_t* self,
+      struct _cef_browser_t* browser, int success, const void* data,
+      size_t dataSize);
+
+} cef_image_capture_callback_t;
+
+
+///
+// Structure to implement for receiving tiles from
+// cef_browser_t::capture_page(). The functions of this structure will be called
+// on the UI thread.
+///
+typedef struct _cef_page_capture_handler_t
+{
+  // Base structure.
+  cef_base_t base;
+
+  ///
+  // Called before the first tile is delivered. |width| and |height| are the
+  // size of the whole page in pixels. Return false (0) to cancel the capture.
+  ///
+  int (CEF_CALLBACK *on_capture_start)(struct _cef_page_capture_handler_t* self,
+      struct _cef_browser_t* browser, int width, int height);
+
+  ///
+  // Called for each tile in top to bottom order. |tileRect| is the tile's
+  // position in page coordinates. |buffer| is tileRect.width*tileRect.height*4
+  // bytes in size and uses the format specified by
+  // cef_browser_t::set_pixel_format() with an upper-left origin. |buffer| is
+  // only valid for the duration of this call. Return false (0) to cancel the
+  // capture.
+  ///
+  int (CEF_CALLBACK *on_capture_tile)(struct _cef_page_capture_handler_t* self,
+      struct _cef_browser_t* browser, const cef_rect_t* tileRect,
+      const void* buffer);
+
+} cef_page_capture_handler_t;
+
+
+///
+// Structure representing a separate cookie store and HTTP cache that can be
+// used by one or more browsers. Network connections, the host resolver cache
+// and proxy settings are shared by all request contexts. Cookie functions that
+// are not passed a request context, such as cef_visit_all_cookies(), only
+// access the global cookie store. A request context that is still referenced
+// when cef_shutdown() is called releases its cookie store and HTTP cache at
+// that time and can no longer be used by new browsers. The functions of this
+// structure may be called on any thread.
+///
+typedef struct _cef_request_context_t
+{
+  // Base structure.
+  cef_base_t base;
+
+  ///
+  // Returns the cache path for this request context. The path is not set if the
+  // cache is kept in memory.
+  ///
+  // The resulting string must be freed by calling cef_string_userfree_free().
+  cef_string_userfree_t (CEF_CALLBACK *get_cache_path)(
+      struct _cef_request_context_t* self);
+
+} cef_request_context_t;
+
+
+///
+// Create a new request context. If |cache_path| is specified the HTTP cache and
+// persistent cookies will be stored in that directory. Otherwise they will be
+// kept in memory. |cache_path| should not be the same as CefSettings.cache_path
+// or the path used by another request context.
+///
+CEF_EXPORT cef_request_context_t* cef_request_context_create_context(
+    const cef_string_t* cache_path);
+
+
 ///
 // Structure used to represent a browser window. The functions of this structure
 // may be called on any thread unless otherwise indicated in the comments.
@@ -583,17 +986,84 @@ typedef struct _cef_browser_t
   void (CEF_CALLBACK *invalidate)(struct _cef_browser_t* self,
       const cef_rect_t* dirtyRect);
 
+  ///
+  // Notify the browser that it has been hidden or shown. Call this function
+  // when the browser window is minimized or, if window rendering is disabled,
+  // when the view is no longer displayed. While hidden the browser does not
+  // paint, releases its backing store, reports a hidden page visibility state
+  // to the page and runs JavaScript timers and animations at a reduced rate.
+  // The whole view is repainted when the browser is shown again.
+  ///
+  void (CEF_CALLBACK *was_hidden)(struct _cef_browser_t* self, int hidden);
+
+  ///
+  // Returns true (1) if the browser is currently hidden.
+  ///
+  int (CEF_CALLBACK *is_hidden)(struct _cef_browser_t* self);
+
   ///
   // Get the raw image data contained in the specified element without
   // performing validation. The specified |width| and |height| dimensions must
   // match the current element size. On Windows |buffer| must be width*height*4
-  // bytes in size and represents a BGRA image with an upper-left origin. This
-  // function should only be called on the UI thread.
+  // bytes in size and represents an image in the format returned by
+  // get_pixel_format(). This function should only be called on the UI thread.
   ///
   int (CEF_CALLBACK *get_image)(struct _cef_browser_t* self,
       enum cef_paint_element_type_t type, int width, int height,
       void* buffer);
 
+  ///
+  // Set the format of the image data passed to cef_render_handler_t::on_paint()
+  // and returned by get_image(). |format| is a combination of
+  // cef_pixel_format_t flags. Only the dirty region of each paint is converted.
+  // Changing the format results in a repaint of the whole view. This function
+  // is only used when window rendering is disabled.
+  ///
+  void (CEF_CALLBACK *set_pixel_format)(struct _cef_browser_t* self,
+      enum cef_pixel_format_t format);
+
+  ///
+  // Returns the format of the image data passed to
+  // cef_render_handler_t::on_paint() and returned by get_image().
+  ///
+  enum cef_pixel_format_t (CEF_CALLBACK *get_pixel_format)(
+      struct _cef_browser_t* self);
+
+  ///
+  // Capture the contents of the specified element and encode it as an image.
+  // The |srcRect| region of the element is copied on the UI thread and, if
+  // |width| and |height| are non-zero, scaled to that size. Scaling and
+  // encoding are performed on the WORKER pool and the result is delivered to
+  // |callback|. If |srcRect| is NULL the whole element is captured. |quality|
+  // is a value from 0 to 100 and is only used for IMAGE_ENCODING_JPEG.
+  ///
+  void (CEF_CALLBACK *capture_image)(struct _cef_browser_t* self,
+      enum cef_paint_element_type_t type, const cef_rect_t* srcRect, int width,
+      int height, enum cef_image_encoding_t encoding, int quality,
+      struct _cef_image_capture_callback_t* callback);
+
+  ///
+  // Capture the whole page, including content outside of the visible area, by
+  // laying out at the current view width and painting the page in tiles of
+  // |tileHeight| pixels. If |tileHeight| is 0 the current view height is used.
+  // Each tile is delivered to |handler| before the next tile is painted so
+  // memory usage is proportional to the tile size instead of the page size. The
+  // view is repainted when the capture completes. Returns true (1) if all tiles
+  // were delivered. This function should only be called on the UI thread.
+  ///
+  int (CEF_CALLBACK *capture_page)(struct _cef_browser_t* self, int tileHeight,
+      struct _cef_page_capture_handler_t* handler);
+
+  ///
+  // Capture the whole page as described for capture_page() and write the tiles
+  // to |stream| in order. The result is the raw pixel data of the page with
+  // width*4 bytes per row in the format specified by set_pixel_format() with an
+  // upper-left origin. Returns true (1) if all tiles were written. This
+  // function should only be called on the UI thread.
+  ///
+  int (CEF_CALLBACK *capture_page_to_stream)(struct _cef_browser_t* self,
+      int tileHeight, struct _cef_stream_writer_t* stream);
+
   ///
   // Send a key event to the browser.
   ///
@@ -611,14 +1081,16 @@ typedef struct _cef_browser_t
 
   ///
   // Send a mouse move event to the browser. The |x| and |y| coordinates are
-  // relative to the upper-left corner of the view.
+  // relative to the upper-left corner of the view. If a mouse move event is
+  // still waiting to be dispatched it will be replaced by this event.
   ///
   void (CEF_CALLBACK *send_mouse_move_event)(struct _cef_browser_t* self, int x,
       int y, int mouseLeave);
 
   ///
   // Send a mouse wheel event to the browser. The |x| and |y| coordinates are
-  // relative to the upper-left corner of the view.
+  // relative to the upper-left corner of the view. If a mouse wheel event is
+  // still waiting to be dispatched this event's |delta| will be added to it.
   ///
   void (CEF_CALLBACK *send_mouse_wheel_event)(struct _cef_browser_t* self,
       int x, int y, int delta);
@@ -634,6 +1106,15 @@ typedef struct _cef_browser_t
   ///
   void (CEF_CALLBACK *send_capture_lost_event)(struct _cef_browser_t* self);
 
+  ///
+  // Send multiple input events to the browser in order. This is more efficient
+  // than sending each event individually. Consecutive mouse move events are
+  // merged into the most recent one and consecutive mouse wheel events are
+  // merged by summing their deltas before they are dispatched.
+  ///
+  void (CEF_CALLBACK *send_input_events)(struct _cef_browser_t* self,
+      size_t eventCount, const cef_input_event_t* events);
+
 } cef_browser_t;
 
 
@@ -646,6 +1127,17 @@ CEF_EXPORT int cef_browser_create(cef_window_info_t* windowInfo,
     struct _cef_client_t* client, const cef_string_t* url,
     const struct _cef_browser_settings_t* settings);
 
+///
+// Create a new browser window that uses |requestContext| for cookies and the
+// HTTP cache. If |requestContext| is NULL the global request context will be
+// used. Popup windows use the same request context as the browser that opened
+// them. This function call will not block.
+///
+CEF_EXPORT int cef_browser_create_with_context(cef_window_info_t* windowInfo,
+    struct _cef_client_t* client, const cef_string_t* url,
+    const struct _cef_browser_settings_t* settings,
+    cef_request_context_t* requestContext);
+
 ///
 // Create a new browser window using the window parameters specified by
 // |windowInfo|. This function should only be called on the UI thread.
@@ -654,6 +1146,74 @@ CEF_EXPORT cef_browser_t* cef_browser_create_sync(cef_window_info_t* windowInfo,
     struct _cef_client_t* client, const cef_string_t* url,
     const struct _cef_browser_settings_t* settings);
 
+///
+// Create a new browser window that uses |requestContext| for cookies and the
+// HTTP cache. If |requestContext| is NULL the global request context will be
+// used. This function should only be called on the UI thread.
+///
+CEF_EXPORT cef_browser_t* cef_browser_create_sync_with_context(
+    cef_window_info_t* windowInfo, struct _cef_client_t* client,
+    const cef_string_t* url, const struct _cef_browser_settings_t* settings,
+    cef_request_context_t* requestContext);
+
+
+///
+// Structure that keeps a number of blank, hidden off-screen browsers ready so
+// that a new browser can be shown without waiting for the WebView to be
+// created. When a browser is no longer needed it can be returned to the pool
+// where its history and page state are cleared so that it can be used again.
+// The functions of this structure should only be called on the UI thread.
+///
+typedef struct _cef_browser_pool_t
+{
+  // Base structure.
+  cef_base_t base;
+
+  ///
+  // Take an idle browser from the pool, attach |client| to it and load |url|.
+  // The client's cef_life_span_handler_t::on_after_created() function will be
+  // called as if the browser had just been created. If no idle browsers are
+  // available a new browser will be created. The pool is refilled
+  // asynchronously.
+  ///
+  struct _cef_browser_t* (CEF_CALLBACK *take_browser)(
+      struct _cef_browser_pool_t* self, struct _cef_client_t* client,
+      const cef_string_t* url);
+
+  ///
+  // Return a browser that was taken from this pool. The client's life span
+  // handler will be notified that the browser is closing and the client will be
+  // detached. The browser's history, sessionStorage, find state and zoom level
+  // are reset and it is navigated to about:blank. If the pool is already full
+  // the browser will be closed instead. Returns false (0) if |browser| was not
+  // taken from this pool or has already been closed.
+  ///
+  int (CEF_CALLBACK *return_browser)(struct _cef_browser_pool_t* self,
+      struct _cef_browser_t* browser);
+
+  ///
+  // Returns the number of idle browsers in the pool.
+  ///
+  int (CEF_CALLBACK *get_idle_count)(struct _cef_browser_pool_t* self);
+
+  ///
+  // Close all idle browsers. Browsers that are in use are not affected and will
+  // be closed when they are returned.
+  ///
+  void (CEF_CALLBACK *close)(struct _cef_browser_pool_t* self);
+
+} cef_browser_pool_t;
+
+
+///
+// Create a new pool that keeps |size| idle browsers created with |windowInfo|
+// and |settings|. Window rendering must be disabled in |windowInfo|. Returns
+// NULL if the pool cannot be created.
+///
+CEF_EXPORT cef_browser_pool_t* cef_browser_pool_create(
+    cef_window_info_t* windowInfo, int size,
+    const struct _cef_browser_settings_t* settings);
+
 
 ///
 // Structure used to represent a frame in the browser window. The functions of
@@ -1323,7 +1883,10 @@ typedef struct _cef_render_handler_t
   // element is the view or the popup widget. |buffer| contains the pixel data
   // for the whole image. |dirtyRect| indicates the portion of the image that
   // has been repainted. On Windows |buffer| will be width*height*4 bytes in
-  // size and represents a BGRA image with an upper-left origin.
+  // size and represents an image in the format specified by
+  // cef_browser_t::set_pixel_format(). By default this is a premultiplied BGRA
+  // image with an upper-left origin. |dirtyRect| is always relative to the
+  // upper-left corner of the view.
   ///
   void (CEF_CALLBACK *on_paint)(struct _cef_render_handler_t* self,
       struct _cef_browser_t* browser, enum cef_paint_element_type_t type,
@@ -3205,7 +3768,8 @@ typedef struct _cef_domevent_listener_t
 
 ///
 // Structure to implement for filtering response content. The functions of this
-// structure will always be called on the UI thread.
+// structure will be called on the UI thread unless use_worker_thread() returns
+// true (1).
 ///
 typedef struct _cef_content_filter_t
 {
@@ -3228,6 +3792,14 @@ typedef struct _cef_content_filter_t
   void (CEF_CALLBACK *drain)(struct _cef_content_filter_t* self,
       struct _cef_stream_reader_t** remainder);
 
+  ///
+  // Return true (1) if process_data() and drain() should be called on a WORKER
+  // pool thread instead of the UI thread. Calls for the same filter will still
+  // happen one at a time and in the order that data is received. This function
+  // is called once on the UI thread before any data is processed.
+  ///
+  int (CEF_CALLBACK *use_worker_thread)(struct _cef_content_filter_t* self);
+
 } cef_content_filter_t;
 
 
@@ -41,6 +41,9 @@
 #include "internal/cef_tuple.h"
 #endif
 
+#include <algorithm>
+#include <utility>
+
 // CefRunnableMethodTraits -----------------------------------------------------
 //
 // This traits-class is used by CefRunnableMethod to manage the lifetime of the
@@ -102,6 +105,69 @@ struct CefRunnableMethodTraits {
     void ReleaseCallee(TypeName* manager) {}       \
   }
 
+// CefPassed and CefPass ------------------------------------------------------
+//
+// Bound arguments are copied into the task when it is created. To transfer a
+// large value such as a string, vector or map to the task instead of copying
+// it wrap the value with CefPass():
+//
+//   CefRequest::HeaderMap headers;
+//   ...
+//   CefPostTask(TID_IO, NewCefRunnableFunction(&IOT_SetHeaders,
+//                                              CefPass(&headers)));
+//
+// The contents of |headers| are moved or swapped into the task and |headers|
+// is left empty. The called function receives a reference to the value owned
+// by the task so it should accept the argument by const reference, or by
+// non-const reference if it wants to swap the value out in turn:
+//
+//   void IOT_SetHeaders(const CefRequest::HeaderMap& headers);
+//
+// The value type must be default constructible. When rvalue references are not
+// available the value is transferred with swap() so the type should provide an
+// efficient swap specialization or overload, as the standard containers and
+// CefString do. A CefString that references data it does not own, such as one
+// attached to a caller's cef_string_t, is copied into the task instead so that
+// the task never refers to the caller's buffer.
+
+template <class T>
+class CefPassed {
+ public:
+  explicit CefPassed(T* value) {
+    Transfer(value);
+  }
+
+  // Copying a CefPassed transfers the value, which allows it to be stored in
+  // a Tuple and in the task without copying the underlying data.
+  CefPassed(const CefPassed& other) {
+    Transfer(&other.value_);
+  }
+
+  operator T&() const {
+    return value_;
+  }
+
+ private:
+  void Transfer(T* value) const {
+#if defined(CEF_HAS_RVALUE_REFERENCES)
+    value_ = std::move(*value);
+    *value = T();
+#else
+    using std::swap;
+    swap(value_, *value);
+#endif
+  }
+
+  CefPassed& operator=(const CefPassed&);
+
+  mutable T value_;
+};
+
+template <class T>
+inline CefPassed<T> CefPass(T* value) {
+  return CefPassed<T>(value);
+}
+
 // CefRunnableMethod and CefRunnableFunction ----------------------------------
 //
 // CefRunnable methods are a type of task that call a function on an object
@@ -132,10 +198,17 @@ struct CefRunnableMethodTraits {
 template <class T, class Method, class Params>
 class CefRunnableMethod : public CefTask {
  public:
+#if defined(CEF_HAS_RVALUE_REFERENCES)
+  CefRunnableMethod(T* obj, Method meth, Params&& params)
+      : obj_(obj), meth_(meth), params_(std::move(params)) {
+    traits_.RetainCallee(obj_);
+  }
+#else
   CefRunnableMethod(T* obj, Method meth, const Params& params)
       : obj_(obj), meth_(meth), params_(params) {
     traits_.RetainCallee(obj_);
   }
+#endif
 
   ~CefRunnableMethod() {
     T* obj = obj_;
@@ -245,9 +318,15 @@ inline CefRefPtr<CefTask> NewCefRunnableMethod(T* object, Method method,
 template <class Function, class Params>
 class CefRunnableFunction : public CefTask {
  public:
+#if defined(CEF_HAS_RVALUE_REFERENCES)
+  CefRunnableFunction(Function function, Params&& params)
+      : function_(function), params_(std::move(params)) {
+  }
+#else
   CefRunnableFunction(Function function, const Params& params)
       : function_(function), params_(params) {
   }
+#endif
 
   ~CefRunnableFunction() {
   }
@@ -282,6 +282,17 @@ public:
   ///
   size_t Load(CefRefPtr<CefStreamReader> stream, bool overwriteExisting);
 
+  ///
+  // Load the contents of the specified zip archive stream into this object on
+  // a WORKER pool thread. Decompression of large archives will not block the
+  // calling thread. Other methods of this object will block while the load is
+  // in progress. When the load completes |callback|, if non-NULL, will be
+  // posted to the thread identified by |callbackThreadId|. Returns false if
+  // the load could not be started.
+  ///
+  bool LoadAsync(CefRefPtr<CefStreamReader> stream, bool overwriteExisting,
+                 CefThreadId callbackThreadId, CefRefPtr<CefTask> callback);
+
   ///
   // Clears the contents of this object.
   ///
@@ -319,4 +330,32 @@ private:
   IMPLEMENT_LOCKING(CefZipArchive);
 };
 
+///
+// Import HTTP cache entries from |archive| using CefImportHttpCacheEntry(). The
+// entries are described by the archive file named |manifestName|. Each entry
+// consists of a line containing the URL and the name of the archive file that
+// contains the response body separated by a space, followed by the raw response
+// headers starting with the status line. Entries are separated by a blank line.
+// For example:
+// <pre>
+//   http://www.example.com/app.js scripts/app.js
+//   HTTP/1.1 200 OK
+//   Content-Type: application/javascript
+//   Cache-Control: max-age=86400
+//   ETag: "1a2b3c"
+//
+//   http://www.example.com/logo.png images/logo.png
+//   HTTP/1.1 200 OK
+//   Content-Type: image/png
+//   Last-Modified: Mon, 03 Oct 2011 12:00:00 GMT
+// </pre>
+// The entries are written asynchronously on the IO thread. If |completionTask|
+// is non-NULL it will be executed on the IO thread after all of the entries
+// have been written, including when no entries were imported. Returns the
+// number of entries that were accepted for import.
+///
+size_t CefImportHttpCache(CefRefPtr<CefZipArchive> archive,
+                          const CefString& manifestName,
+                          CefRefPtr<CefTask> completionTask);
+
 #endif // _CEF_WRAPPER_H
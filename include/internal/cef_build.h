@@ -109,4 +109,14 @@
 
 #endif // !BUILDING_CEF_SHARED
 
+// Rvalue reference detection. Types that support move semantics will be moved
+// instead of copied or swapped when this is defined.
+#if !defined(CEF_HAS_RVALUE_REFERENCES)
+#if defined(__GXX_EXPERIMENTAL_CXX0X__) || \
+    (defined(__cplusplus) && __cplusplus >= 201103L) || \
+    (defined(_MSC_VER) && _MSC_VER >= 1600)
+#define CEF_HAS_RVALUE_REFERENCES 1
+#endif
+#endif
+
 #endif // _CEF_BUILD_H
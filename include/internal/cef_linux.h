@@ -88,6 +88,7 @@ struct CefWindowInfoTraits {
   {
     target->m_Widget = src->m_Widget;
     target->m_ParentWidget = src->m_ParentWidget;
+    target->m_bWindowRenderingDisabled = src->m_bWindowRenderingDisabled;
   }
 };
 
@@ -105,6 +106,12 @@ public:
   {
     m_ParentWidget = ParentWidget;
   }
+
+  void SetAsOffScreen(CefWindowHandle ParentWidget)
+  {
+    m_bWindowRenderingDisabled = true;
+    m_ParentWidget = ParentWidget;
+  }
 };
 
 struct CefPrintInfoTraits {
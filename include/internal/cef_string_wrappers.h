@@ -310,6 +310,16 @@ public:
   ///
   CefStringBase(const CefStringBase& str) : string_(NULL), owner_(false)
     { FromString(str.c_str(), str.length(), true); }
+
+#if defined(CEF_HAS_RVALUE_REFERENCES)
+  ///
+  // Create a new string that takes over the structure and data of |str|. If
+  // |str| references data that it does not own the data will be copied. |str|
+  // will be left empty.
+  ///
+  CefStringBase(CefStringBase&& str) : string_(NULL), owner_(false)
+    { TakeFrom(str); }
+#endif
   
   ///
   // Create a new string from an existing std::string. Data will be always
@@ -501,6 +511,23 @@ public:
     owner_ = false;
   }
 
+  ///
+  // Exchange the underlying string structure and data with |str|. String data
+  // will only be copied if either string references data that it does not own,
+  // so that neither string is left referencing the other's borrowed data.
+  ///
+  void swap(CefStringBase& str)
+  {
+    TakeOwnership();
+    str.TakeOwnership();
+    struct_type* tmp_string = string_;
+    bool tmp_owner = owner_;
+    string_ = str.string_;
+    owner_ = str.owner_;
+    str.string_ = tmp_string;
+    str.owner_ = tmp_owner;
+  }
+
   ///
   // Create a userfree structure and give it ownership of this class' string
   // data. This class will be disassociated from the data. May return NULL if
@@ -653,6 +680,10 @@ public:
   ///
   CefStringBase& operator=(const CefStringBase& str)
     { FromString(str.c_str(), str.length(), true); return *this; }
+#if defined(CEF_HAS_RVALUE_REFERENCES)
+  CefStringBase& operator=(CefStringBase&& str)
+    { if (this != &str) { ClearAndFree(); TakeFrom(str); } return *this; }
+#endif
   operator std::string() const { return ToString(); }
   CefStringBase& operator=(const std::string& str)
     { FromString(str); return *this; }
@@ -672,6 +703,44 @@ public:
 #endif // BUILDING_CEF_SHARED && WCHAR_T_IS_UTF32
 
 private:
+  // Returns true if this class owns the underlying string structure and data
+  // or if there is no data.
+  bool OwnsData() const
+  {
+    return (string_ == NULL || string_->str == NULL ||
+            (owner_ && string_->dtor != NULL));
+  }
+
+  // Copy the string data if this class references data that it does not own.
+  // A referenced structure is left unchanged.
+  void TakeOwnership()
+  {
+    if (OwnsData())
+      return;
+    struct_type* str = string_;
+    bool owner = owner_;
+    Detach();
+    FromString(str->str, str->length, true);
+    // The structure was allocated by this class but the data was not.
+    if (owner)
+      delete str;
+  }
+
+#if defined(CEF_HAS_RVALUE_REFERENCES)
+  // Take over the structure and data of |str|, which will be left empty. Data
+  // that |str| references but does not own is copied so that it remains valid
+  // after the referenced data is freed. This class must be empty.
+  void TakeFrom(CefStringBase& str)
+  {
+    if (str.OwnsData()) {
+      swap(str);
+    } else {
+      FromString(str.c_str(), str.length(), true);
+      str.ClearAndFree();
+    }
+  }
+#endif
+
   // Allocate the string structure if it doesn't already exist.
   void AllocIfNeeded()
   {
@@ -687,6 +756,16 @@ private:
 };
 
 
+// Exchange two CEF strings without copying owned string data. Found by
+// argument-dependent lookup from generic code that calls swap(a, b) after
+// "using std::swap;".
+template <class traits>
+inline void swap(CefStringBase<traits>& a, CefStringBase<traits>& b)
+{
+  a.swap(b);
+}
+
+
 typedef CefStringBase<CefStringTraitsWide> CefStringWide;
 typedef CefStringBase<CefStringTraitsUTF8> CefStringUTF8;
 typedef CefStringBase<CefStringTraitsUTF16> CefStringUTF16;
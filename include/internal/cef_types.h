@@ -73,6 +73,49 @@ enum cef_log_severity_t
   LOGSEVERITY_DISABLE = 99
 };
 
+///
+// Controls when persistent cookies are read from the cookie database.
+///
+enum cef_cookie_load_mode_t
+{
+  // Read all cookies the first time any cookie is accessed.
+  COOKIE_LOAD_ALL = 0,
+  // Read the cookies for a domain (the registered domain plus one label, for
+  // example "example.com") the first time cookies for that domain are
+  // accessed.
+  COOKIE_LOAD_ON_DEMAND,
+  // Same as COOKIE_LOAD_ON_DEMAND but also read the cookies for the remaining
+  // domains on the FILE thread until the memory limit is reached.
+  COOKIE_LOAD_ON_DEMAND_WITH_BACKGROUND_FILL,
+};
+
+///
+// Journal modes for the cookie database.
+///
+enum cef_cookie_journal_mode_t
+{
+  // Use the SQLite default rollback journal.
+  COOKIE_JOURNAL_DEFAULT = 0,
+  // Use a write-ahead log. Commits append to the log instead of rewriting the
+  // database pages, which requires fewer syncs.
+  COOKIE_JOURNAL_WAL,
+};
+
+///
+// Synchronous levels for the cookie database. These correspond to the SQLite
+// "PRAGMA synchronous" values.
+///
+enum cef_cookie_sync_mode_t
+{
+  // Use the SQLite default, which is full synchronization.
+  COOKIE_SYNC_DEFAULT = 0,
+  // Sync less often. With COOKIE_JOURNAL_WAL the database cannot be corrupted
+  // but the most recent commits may be lost if the system crashes.
+  COOKIE_SYNC_NORMAL,
+  // Never sync. The database may be corrupted if the system crashes.
+  COOKIE_SYNC_OFF,
+};
+
 ///
 // Initialization settings. Specify NULL or 0 to get the recommended default
 // values.
@@ -87,7 +130,11 @@ typedef struct _cef_settings_t
   ///
   // Set to true (1) to have the message loop run in a separate thread. If
   // false (0) than the CefDoMessageLoopWork() function must be called from
-  // your application message loop.
+  // your application message loop. On Linux the separate thread initializes
+  // GTK and runs the default GLib main context so the application must not
+  // run its own GTK or GLib main loop or call GTK functions on other threads.
+  // Parent widgets passed to CefWindowInfo must be created on the UI thread
+  // or window rendering must be disabled.
   ///
   bool multi_threaded_message_loop;
   
@@ -141,6 +188,83 @@ typedef struct _cef_settings_t
   // content like WebGL, accelerated layers and 3D CSS.
   ///
   cef_graphics_implementation_t graphics_implementation;
+
+  ///
+  // Set to true (1) to collect task queue statistics for the UI, IO and FILE
+  // threads. Use CefGetThreadStats() to retrieve the statistics and
+  // CefSetThreadStatsEnabled() to start or stop collection later.
+  ///
+  bool thread_stats_enabled;
+
+  ///
+  // Tasks that run for longer than this number of milliseconds are logged
+  // along with the location that posted them. Only used if
+  // |thread_stats_enabled| is true. If 0 a value of 100 will be used.
+  ///
+  int slow_task_threshold;
+
+  ///
+  // If greater than 0 the statistics for each thread, broken down by the
+  // location that posted the tasks, will be written to the log file at this
+  // interval in seconds. Only used if |thread_stats_enabled| is true.
+  ///
+  int thread_stats_dump_interval;
+
+  ///
+  // Controls when persistent cookies are read from the cookie database in
+  // |cache_path|. Loading cookies on demand avoids reading the whole database
+  // before the first request when the database is large.
+  ///
+  cef_cookie_load_mode_t cookie_load_mode;
+
+  ///
+  // Maximum number of cookies kept in memory when |cookie_load_mode| is not
+  // COOKIE_LOAD_ALL. When the limit is exceeded the cookies for the least
+  // recently used domains are released from memory and read from the
+  // database again the next time they are accessed. If 0 or greater than 3000
+  // a value of 3000 will be used because cookies beyond that number are
+  // permanently deleted by the cookie store's own garbage collection.
+  ///
+  int cookie_memory_limit;
+
+  ///
+  // Interval in milliseconds at which changed cookies are committed to the
+  // cookie database. If 0 a value of 30000 will be used.
+  ///
+  int cookie_commit_interval;
+
+  ///
+  // Number of pending cookie changes that causes an immediate commit. If 0 a
+  // value of 512 will be used.
+  ///
+  int cookie_commit_batch_size;
+
+  ///
+  // The journal mode and synchronous level used for the cookie database.
+  ///
+  cef_cookie_journal_mode_t cookie_journal_mode;
+  cef_cookie_sync_mode_t cookie_sync_mode;
+
+  ///
+  // Maximum estimated size in bytes of the localStorage data kept in memory.
+  // When the limit is exceeded the localStorage areas are released from memory
+  // and read from |cache_path| again the next time they are accessed. If 0
+  // there is no limit.
+  ///
+  int local_storage_memory_limit;
+
+  ///
+  // Maximum size in bytes of the HTTP disk cache in |cache_path|. If 0 the
+  // size will be chosen based on the free disk space.
+  ///
+  int disk_cache_size;
+
+  ///
+  // Maximum size in bytes of the HTTP memory cache that is used when
+  // |cache_path| is not specified. If 0 the size will be chosen based on the
+  // amount of physical memory.
+  ///
+  int memory_cache_size;
 } cef_settings_t;
 
 ///
@@ -489,6 +613,65 @@ enum cef_key_type_t
   KT_CHAR,
 };
 
+///
+// Input event types.
+///
+enum cef_input_event_type_t
+{
+  IET_KEY = 0,
+  IET_MOUSE_CLICK,
+  IET_MOUSE_MOVE,
+  IET_MOUSE_WHEEL,
+  IET_FOCUS,
+  IET_CAPTURE_LOST,
+};
+
+///
+// Structure representing an input event. Only the members used by |type| need
+// to be set.
+///
+typedef struct _cef_input_event_t
+{
+  enum cef_input_event_type_t type;
+
+  ///
+  // Mouse event location relative to the upper-left corner of the view.
+  ///
+  int x;
+  int y;
+
+  ///
+  // IET_KEY values.
+  ///
+  enum cef_key_type_t key_type;
+  int key;
+  int modifiers;
+  bool sys_char;
+  bool ime_char;
+
+  ///
+  // IET_MOUSE_CLICK values.
+  ///
+  enum cef_mouse_button_type_t button_type;
+  bool mouse_up;
+  int click_count;
+
+  ///
+  // IET_MOUSE_MOVE value.
+  ///
+  bool mouse_leave;
+
+  ///
+  // IET_MOUSE_WHEEL value.
+  ///
+  int delta;
+
+  ///
+  // IET_FOCUS value.
+  ///
+  bool set_focus;
+} cef_input_event_t;
+
 ///
 // Various browser navigation types supported by chrome.
 ///
@@ -751,6 +934,31 @@ enum cef_paint_element_type_t
   PET_POPUP,
 };
 
+///
+// Pixel format flags for image buffers passed to CefRenderHandler::OnPaint()
+// and returned by CefBrowser::GetImage(). Flags may be combined. The default
+// format is a premultiplied BGRA image with an upper-left origin.
+///
+enum cef_pixel_format_t
+{
+  PF_DEFAULT        = 0,
+  // Swap the red and blue channels to produce an RGBA image.
+  PF_RGBA           = 1 << 0,
+  // Divide the color channels by alpha to produce straight alpha values.
+  PF_UNPREMULTIPLY  = 1 << 1,
+  // Store rows in reverse order to produce an image with a lower-left origin.
+  PF_BOTTOM_UP      = 1 << 2,
+};
+
+///
+// Image encodings supported by CefBrowser::CaptureImage().
+///
+enum cef_image_encoding_t
+{
+  IMAGE_ENCODING_PNG = 0,
+  IMAGE_ENCODING_JPEG,
+};
+
 ///
 // Post data elements may represent either bytes or files.
 ///
@@ -824,8 +1032,226 @@ enum cef_thread_id_t
   TID_UI      = 0,
   TID_IO      = 1,
   TID_FILE    = 2,
+  ///
+  // Pool of threads for CPU-bound work. Tasks posted to the pool may run
+  // concurrently and in any order.
+  ///
+  TID_WORKER  = 3,
+};
+
+///
+// Number of buckets in the cef_thread_stats_t histograms. Bucket 0 counts
+// values less than 1 millisecond, bucket N counts values of at least 2^(N-1)
+// and less than 2^N milliseconds and the last bucket counts all larger values.
+///
+#define CEF_THREAD_STATS_BUCKET_COUNT 12
+
+///
+// Task queue statistics for a thread. Statistics only include tasks posted
+// through CEF and are collected from the time CefInitialize() is called.
+///
+typedef struct _cef_thread_stats_t
+{
+  ///
+  // Number of tasks currently waiting to run, including delayed tasks.
+  ///
+  int queue_depth;
+
+  ///
+  // Largest value of |queue_depth| observed.
+  ///
+  int max_queue_depth;
+
+  ///
+  // Number of tasks that have run.
+  ///
+  int64 task_count;
+
+  ///
+  // Number of tasks that ran for longer than CefSettings.slow_task_threshold.
+  ///
+  int64 slow_task_count;
+
+  ///
+  // Total and largest time in milliseconds that tasks spent waiting in the
+  // queue after they became due.
+  ///
+  double total_queue_latency;
+  double max_queue_latency;
+
+  ///
+  // Total and largest time in milliseconds that tasks spent running.
+  ///
+  double total_run_time;
+  double max_run_time;
+
+  ///
+  // Histograms of task queue latency and run time.
+  ///
+  int64 queue_latency_histogram[CEF_THREAD_STATS_BUCKET_COUNT];
+  int64 run_time_histogram[CEF_THREAD_STATS_BUCKET_COUNT];
+} cef_thread_stats_t;
+
+///
+// Cookie database statistics, collected from the time CefInitialize() is
+// called.
+///
+typedef struct _cef_cookie_store_stats_t
+{
+  ///
+  // Number of cookie changes currently waiting to be committed.
+  ///
+  int pending_operations;
+
+  ///
+  // Largest value of |pending_operations| observed.
+  ///
+  int max_pending_operations;
+
+  ///
+  // Number of commits and the total number of changes they wrote.
+  ///
+  int64 commit_count;
+  int64 committed_operations;
+
+  ///
+  // Time in milliseconds spent in the most recent commit, and the total and
+  // largest time spent in commits.
+  ///
+  double last_commit_time;
+  double total_commit_time;
+  double max_commit_time;
+} cef_cookie_store_stats_t;
+
+///
+// HTTP cache statistics. The request counts are collected from the time
+// CefInitialize() is called.
+///
+typedef struct _cef_http_cache_stats_t
+{
+  ///
+  // Number of entries in the cache.
+  ///
+  int entry_count;
+
+  ///
+  // Number of bytes used by the cache. For the in-memory cache this is the
+  // size of the stored responses without the cache's own bookkeeping.
+  ///
+  int64 bytes_used;
+
+  ///
+  // Number of HTTP responses that were read from the cache without contacting
+  // the server, that were read from the network, and that were read from the
+  // cache after the server confirmed that the entry was still valid.
+  ///
+  int64 hit_count;
+  int64 miss_count;
+  int64 validation_count;
+} cef_http_cache_stats_t;
+
+///
+// Time in milliseconds spent in each phase of CEF startup. Subsystems that are
+// initialized when first used report 0 until then.
+///
+typedef struct _cef_startup_timings_t
+{
+  ///
+  // Total time spent in CefInitialize(), including the thread phases below.
+  ///
+  double initialize;
+
+  ///
+  // Time spent initializing the UI thread, including WebKit.
+  ///
+  double ui_thread_init;
+
+  ///
+  // Time spent initializing WebKit.
+  ///
+  double webkit_init;
+
+  ///
+  // Time spent initializing the IO thread, including the request context.
+  ///
+  double io_thread_init;
+
+  ///
+  // Time spent on the UI thread initializing the application cache when the
+  // first document was loaded. The IO thread side is initialized
+  // asynchronously and is not included.
+  ///
+  double appcache_init;
+
+  ///
+  // Time spent initializing the Web SQL database system when it was first
+  // used.
+  ///
+  double database_init;
+
+  ///
+  // Time spent initializing the FileSystem API when it was first used.
+  ///
+  double file_system_init;
+
+  ///
+  // Time spent loading the plugin list when it was first used.
+  ///
+  double plugin_init;
+} cef_startup_timings_t;
+
+///
+// Subsystems that are written to disk by CefFastShutdown(). These values are
+// used as bit flags.
+///
+enum cef_shutdown_subsystem_t
+{
+  SHUTDOWN_COOKIES     = 1 << 0,
+  SHUTDOWN_DOM_STORAGE = 1 << 1,
+  SHUTDOWN_CACHE       = 1 << 2,
 };
 
+///
+// Results of CefFastShutdown(). Times are in milliseconds from the start of
+// shutdown and are -1 for subsystems that did not finish before the deadline.
+///
+typedef struct _cef_shutdown_report_t
+{
+  ///
+  // Combination of cef_shutdown_subsystem_t values for the subsystems that did
+  // not finish before the deadline.
+  ///
+  int timed_out;
+
+  ///
+  // Time taken to commit pending cookie changes to the cookie databases.
+  ///
+  double cookies;
+
+  ///
+  // Time taken to write localStorage data.
+  ///
+  double dom_storage;
+
+  ///
+  // Time taken to close the disk caches, which writes the cache indexes.
+  ///
+  double cache;
+
+  ///
+  // Total time spent in CefFastShutdown().
+  ///
+  double total;
+
+  ///
+  // Number of CefRequestContext objects whose cookie stores and HTTP caches
+  // were written in addition to those of the global request context. Request
+  // contexts that were never used by a browser have nothing to write and are
+  // not counted. -1 if the HTTP caches were not closed before the deadline.
+  ///
+  int request_contexts;
+} cef_shutdown_report_t;
+
 ///
 // Paper type for printing.
 ///
@@ -62,6 +62,11 @@ typedef struct _cef_window_info_t
   
   // Pointer for the new browser widget.
   cef_window_handle_t m_Widget;
+
+  // If window rendering is disabled no widgets will be created for the browser
+  // and all rendering will occur via the CefRenderHandler interface. GTK does
+  // not need to be initialized by the application in this mode.
+  int m_bWindowRenderingDisabled;
 } cef_window_info_t;
 
 ///
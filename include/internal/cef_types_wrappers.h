@@ -190,6 +190,24 @@ inline bool operator!=(const CefRect& a, const CefRect& b)
 }
 
 
+struct CefInputEventTraits {
+  typedef cef_input_event_t struct_type;
+
+  static inline void init(struct_type* s) {}
+  static inline void clear(struct_type* s) {}
+
+  static inline void set(const struct_type* src, struct_type* target, bool copy)
+  {
+    *target = *src;
+  }
+};
+
+///
+// Class representing an input event.
+///
+typedef CefStructBase<CefInputEventTraits> CefInputEvent;
+
+
 struct CefPopupFeaturesTraits {
   typedef cef_popup_features_t struct_type;
 
@@ -281,6 +299,18 @@ struct CefSettingsTraits {
         copy);
     target->log_severity = src->log_severity;
     target->graphics_implementation = src->graphics_implementation;
+    target->thread_stats_enabled = src->thread_stats_enabled;
+    target->slow_task_threshold = src->slow_task_threshold;
+    target->thread_stats_dump_interval = src->thread_stats_dump_interval;
+    target->cookie_load_mode = src->cookie_load_mode;
+    target->cookie_memory_limit = src->cookie_memory_limit;
+    target->cookie_commit_interval = src->cookie_commit_interval;
+    target->cookie_commit_batch_size = src->cookie_commit_batch_size;
+    target->cookie_journal_mode = src->cookie_journal_mode;
+    target->cookie_sync_mode = src->cookie_sync_mode;
+    target->local_storage_memory_limit = src->local_storage_memory_limit;
+    target->disk_cache_size = src->disk_cache_size;
+    target->memory_cache_size = src->memory_cache_size;
   }
 };
 
@@ -514,4 +544,94 @@ struct CefCookieTraits {
 ///
 typedef CefStructBase<CefCookieTraits> CefCookie;
 
+
+struct CefThreadStatsTraits {
+  typedef cef_thread_stats_t struct_type;
+
+  static inline void init(struct_type* s) {}
+  static inline void clear(struct_type* s) {}
+
+  static inline void set(const struct_type* src, struct_type* target, bool copy)
+  {
+    *target = *src;
+  }
+};
+
+///
+// Class representing task queue statistics for a thread.
+///
+typedef CefStructBase<CefThreadStatsTraits> CefThreadStats;
+
+
+struct CefCookieStoreStatsTraits {
+  typedef cef_cookie_store_stats_t struct_type;
+
+  static inline void init(struct_type* s) {}
+  static inline void clear(struct_type* s) {}
+
+  static inline void set(const struct_type* src, struct_type* target, bool copy)
+  {
+    *target = *src;
+  }
+};
+
+///
+// Class representing cookie database statistics.
+///
+typedef CefStructBase<CefCookieStoreStatsTraits> CefCookieStoreStats;
+
+
+struct CefHttpCacheStatsTraits {
+  typedef cef_http_cache_stats_t struct_type;
+
+  static inline void init(struct_type* s) {}
+  static inline void clear(struct_type* s) {}
+
+  static inline void set(const struct_type* src, struct_type* target, bool copy)
+  {
+    *target = *src;
+  }
+};
+
+///
+// Class representing HTTP cache statistics.
+///
+typedef CefStructBase<CefHttpCacheStatsTraits> CefHttpCacheStats;
+
+
+struct CefStartupTimingsTraits {
+  typedef cef_startup_timings_t struct_type;
+
+  static inline void init(struct_type* s) {}
+  static inline void clear(struct_type* s) {}
+
+  static inline void set(const struct_type* src, struct_type* target, bool copy)
+  {
+    *target = *src;
+  }
+};
+
+///
+// Class representing startup phase timings.
+///
+typedef CefStructBase<CefStartupTimingsTraits> CefStartupTimings;
+
+
+struct CefShutdownReportTraits {
+  typedef cef_shutdown_report_t struct_type;
+
+  static inline void init(struct_type* s) {}
+  static inline void clear(struct_type* s) {}
+
+  static inline void set(const struct_type* src, struct_type* target, bool copy)
+  {
+    *target = *src;
+  }
+};
+
+///
+// Class representing the results of CefFastShutdown().
+///
+typedef CefStructBase<CefShutdownReportTraits> CefShutdownReport;
+
 #endif // _CEF_TYPES_WRAPPERS_H
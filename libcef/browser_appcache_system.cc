@@ -4,6 +4,8 @@
 
 #include "browser_appcache_system.h"
 #include "browser_resource_loader_bridge.h"
+#include "cef_context.h"
+#include "cef_startup_timer.h"
 
 #include "base/callback.h"
 #include "base/synchronization/lock.h"
@@ -177,7 +179,7 @@ class BrowserBackendProxy
 
   virtual void RegisterHost(int host_id) {
     if (system_->is_ui_thread()) {
-      system_->io_message_loop()->PostTask(FROM_HERE, NewRunnableMethod(
+      PostToIOThread(NewRunnableMethod(
           this, &BrowserBackendProxy::RegisterHost, host_id));
     } else if (system_->is_io_thread()) {
       system_->backend_impl_->RegisterHost(host_id);
@@ -188,7 +190,7 @@ class BrowserBackendProxy
 
   virtual void UnregisterHost(int host_id) {
     if (system_->is_ui_thread()) {
-      system_->io_message_loop()->PostTask(FROM_HERE, NewRunnableMethod(
+      PostToIOThread(NewRunnableMethod(
           this, &BrowserBackendProxy::UnregisterHost, host_id));
     } else if (system_->is_io_thread()) {
       system_->backend_impl_->UnregisterHost(host_id);
@@ -199,7 +201,7 @@ class BrowserBackendProxy
 
   virtual void SetSpawningHostId(int host_id, int spawning_host_id) {
     if (system_->is_ui_thread()) {
-      system_->io_message_loop()->PostTask(FROM_HERE, NewRunnableMethod(
+      PostToIOThread(NewRunnableMethod(
           this, &BrowserBackendProxy::SetSpawningHostId,
           host_id, spawning_host_id));
     } else if (system_->is_io_thread()) {
@@ -214,7 +216,7 @@ class BrowserBackendProxy
                            const int64 cache_document_was_loaded_from,
                            const GURL& manifest_url) {
     if (system_->is_ui_thread()) {
-      system_->io_message_loop()->PostTask(FROM_HERE, NewRunnableMethod(
+      PostToIOThread(NewRunnableMethod(
           this, &BrowserBackendProxy::SelectCache, host_id, document_url,
               cache_document_was_loaded_from, manifest_url));
     } else if (system_->is_io_thread()) {
@@ -230,7 +232,7 @@ class BrowserBackendProxy
       int host_id,
       std::vector<appcache::AppCacheResourceInfo>* resource_infos) {
     if (system_->is_ui_thread()) {
-      system_->io_message_loop()->PostTask(FROM_HERE, NewRunnableMethod(
+      PostToIOThread(NewRunnableMethod(
           this, &BrowserBackendProxy::GetResourceList,
           host_id, resource_infos));
     } else if (system_->is_io_thread()) {
@@ -256,7 +258,7 @@ class BrowserBackendProxy
   virtual void MarkAsForeignEntry(int host_id, const GURL& document_url,
                                   int64 cache_document_was_loaded_from) {
     if (system_->is_ui_thread()) {
-      system_->io_message_loop()->PostTask(FROM_HERE, NewRunnableMethod(
+      PostToIOThread(NewRunnableMethod(
           this, &BrowserBackendProxy::MarkAsForeignEntry, host_id, document_url,
           cache_document_was_loaded_from));
     } else if (system_->is_io_thread()) {
@@ -272,9 +274,10 @@ class BrowserBackendProxy
     if (system_->is_ui_thread()) {
       status_result_ = appcache::UNCACHED;
       event_.Reset();
-      system_->io_message_loop()->PostTask(FROM_HERE, NewRunnableMethod(
-          this, &BrowserBackendProxy::GetStatus, host_id));
-      event_.Wait();
+      if (PostToIOThread(NewRunnableMethod(
+              this, &BrowserBackendProxy::GetStatus, host_id))) {
+        event_.Wait();
+      }
     } else if (system_->is_io_thread()) {
       system_->backend_impl_->GetStatusWithCallback(
           host_id, get_status_callback_.get(), NULL);
@@ -288,9 +291,10 @@ class BrowserBackendProxy
     if (system_->is_ui_thread()) {
       bool_result_ = false;
       event_.Reset();
-      system_->io_message_loop()->PostTask(FROM_HERE, NewRunnableMethod(
-          this, &BrowserBackendProxy::StartUpdate, host_id));
-      event_.Wait();
+      if (PostToIOThread(NewRunnableMethod(
+              this, &BrowserBackendProxy::StartUpdate, host_id))) {
+        event_.Wait();
+      }
     } else if (system_->is_io_thread()) {
       system_->backend_impl_->StartUpdateWithCallback(
           host_id, start_update_callback_.get(), NULL);
@@ -304,9 +308,10 @@ class BrowserBackendProxy
     if (system_->is_ui_thread()) {
       bool_result_ = false;
       event_.Reset();
-      system_->io_message_loop()->PostTask(FROM_HERE, NewRunnableMethod(
-          this, &BrowserBackendProxy::SwapCache, host_id));
-      event_.Wait();
+      if (PostToIOThread(NewRunnableMethod(
+              this, &BrowserBackendProxy::SwapCache, host_id))) {
+        event_.Wait();
+      }
     } else if (system_->is_io_thread()) {
       system_->backend_impl_->SwapCacheWithCallback(
           host_id, swap_cache_callback_.get(), NULL);
@@ -340,6 +345,13 @@ class BrowserBackendProxy
 
   ~BrowserBackendProxy() {}
 
+  // The IO thread side may still be initializing when the system is
+  // initialized lazily. Tasks posted through CefThread run after that
+  // initialization. Returns false if the IO thread no longer exists.
+  bool PostToIOThread(Task* task) {
+    return CefThread::PostTask(CefThread::IO, FROM_HERE, task);
+  }
+
   BrowserAppCacheSystem* system_;
   base::WaitableEvent event_;
   bool bool_result_;
@@ -364,8 +376,8 @@ BrowserAppCacheSystem::BrowserAppCacheSystem()
           backend_proxy_(new BrowserBackendProxy(this))),
       ALLOW_THIS_IN_INITIALIZER_LIST(
           frontend_proxy_(new BrowserFrontendProxy(this))),
-      backend_impl_(NULL), service_(NULL), db_thread_("AppCacheDBThread"),
-      thread_provider_(NULL) {
+      backend_impl_(NULL), service_(NULL), io_init_posted_(false),
+      db_thread_("AppCacheDBThread"), thread_provider_(NULL) {
   DCHECK(!instance_);
   instance_ = this;
 }
@@ -396,6 +408,31 @@ void BrowserAppCacheSystem::InitOnUIThread(const FilePath& cache_directory) {
   cache_directory_ = cache_directory;
 }
 
+void BrowserAppCacheSystem::InitLazily() {
+  DCHECK(CefThread::CurrentlyOn(CefThread::UI));
+  CefStartupTimer timer(CefStartupTimer::APPCACHE_INIT);
+
+  // A new empty temp directory is created to house any cached content during
+  // the run. Upon exit that directory is deleted. If we can't create a tempdir,
+  // we'll use in-memory storage.
+  if (!temp_cache_directory_.CreateUniqueTempDir()) {
+    LOG(WARNING) << "Failed to create a temp dir for the appcache, "
+                    "using in-memory storage.";
+    DCHECK(temp_cache_directory_.path().empty());
+  }
+  InitOnUIThread(temp_cache_directory_.path());
+
+  // Don't wait for the IO thread side. The backend proxy posts the messages
+  // of the hosts created in the meantime to the IO thread after this task.
+  io_init_posted_ = CefThread::PostTask(CefThread::IO, FROM_HERE,
+      NewRunnableFunction(&BrowserAppCacheSystem::InitLazilyOnIOThread));
+}
+
+// static
+void BrowserAppCacheSystem::InitLazilyOnIOThread() {
+  InitializeOnIOThread(_Context->request_context());
+}
+
 void BrowserAppCacheSystem::InitOnIOThread(
     net::URLRequestContext* request_context) {
   if (!is_initailized_on_ui_thread())
@@ -419,6 +456,14 @@ void BrowserAppCacheSystem::InitOnIOThread(
 }
 
 void BrowserAppCacheSystem::CleanupIOThread() {
+  // Just in case the main thread is waiting on it. This includes a wait that
+  // was started before the lazy IO thread side initialization ran.
+  backend_proxy_->SignalEvent();
+
+  // Nothing to do if no document was loaded while the IO thread existed.
+  if (!io_message_loop_)
+    return;
+
   DCHECK(is_io_thread());
 
   delete backend_impl_;
@@ -426,19 +471,16 @@ void BrowserAppCacheSystem::CleanupIOThread() {
   backend_impl_ = NULL;
   service_ = NULL;
   io_message_loop_ = NULL;
-
-  // Just in case the main thread is waiting on it.
-  backend_proxy_->SignalEvent();
 }
 
 WebApplicationCacheHost* BrowserAppCacheSystem::CreateCacheHostForWebKit(
     WebApplicationCacheHostClient* client) {
   if (!is_initailized_on_ui_thread())
-    return NULL;
+    InitLazily();
 
   DCHECK(is_ui_thread());
 
-  if (!is_initialized())
+  if (!is_initialized() && !io_init_posted_)
     return NULL;
   return new WebApplicationCacheHostImpl(client, backend_proxy_.get());
 }
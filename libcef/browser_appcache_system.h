@@ -7,6 +7,7 @@
 
 #include "base/file_path.h"
 #include "base/message_loop.h"
+#include "base/scoped_temp_dir.h"
 #include "base/threading/thread.h"
 #include "webkit/appcache/appcache_backend_impl.h"
 #include "webkit/appcache/appcache_frontend_impl.h"
@@ -60,7 +61,10 @@ class BrowserAppCacheSystem {
       instance_->CleanupIOThread();
   }
 
-  // Called by TestShellWebKitInit to manufacture a 'host' for webcore.
+  // Called by BrowserWebViewDelegate to manufacture a 'host' for webcore. The
+  // system is initialized on the UI thread when the first host is created if
+  // InitializeOnUIThread() has not been called. The IO thread side is then
+  // initialized asynchronously.
   static WebKit::WebApplicationCacheHost* CreateApplicationCacheHost(
       WebKit::WebApplicationCacheHostClient* client) {
     return instance_ ? instance_->CreateCacheHostForWebKit(client) : NULL;
@@ -116,6 +120,8 @@ class BrowserAppCacheSystem {
 
   // Instance methods called by our static public methods
   void InitOnUIThread(const FilePath& cache_directory);
+  void InitLazily();
+  static void InitLazilyOnIOThread();
   void InitOnIOThread(net::URLRequestContext* request_context);
   void CleanupIOThread();
   WebKit::WebApplicationCacheHost* CreateCacheHostForWebKit(
@@ -162,6 +168,13 @@ class BrowserAppCacheSystem {
   appcache::AppCacheBackendImpl* backend_impl_;
   appcache::AppCacheService* service_;
 
+  // True if the IO thread side initialization was posted by InitLazily().
+  // Accessed only on the UI thread.
+  bool io_init_posted_;
+
+  // Temp directory that houses cached content when initialized lazily.
+  ScopedTempDir temp_cache_directory_;
+
   // We start a thread for use as the DB thread.
   base::Thread db_thread_;
 
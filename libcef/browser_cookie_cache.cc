@@ -0,0 +1,110 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "browser_cookie_cache.h"
+
+#include "base/string_util.h"
+#include "googleurl/src/gurl.h"
+#include "net/base/registry_controlled_domain.h"
+
+namespace {
+
+// Entries are discarded when the cache grows beyond this size.
+const size_t kMaxEntries = 256;
+
+std::string GetEntryKey(const GURL& url) {
+  GURL::Replacements replacements;
+  replacements.ClearQuery();
+  replacements.ClearRef();
+  return url.ReplaceComponents(replacements).spec();
+}
+
+}  // namespace
+
+BrowserCookieCache::BrowserCookieCache()
+    : generation_(0) {
+}
+
+BrowserCookieCache::~BrowserCookieCache() {
+}
+
+bool BrowserCookieCache::Lookup(const GURL& url, std::string* cookie_line,
+                                int64* generation) {
+  base::AutoLock lock_scope(lock_);
+  EntryMap::iterator it = entries_.find(GetEntryKey(url));
+  if (it != entries_.end()) {
+    if (it->second.expires.is_null() ||
+        it->second.expires > base::Time::Now()) {
+      *cookie_line = it->second.cookie_line;
+      return true;
+    }
+    entries_.erase(it);
+  }
+
+  *generation = generation_;
+  return false;
+}
+
+void BrowserCookieCache::Store(const GURL& url,
+                               const std::string& cookie_line,
+                               const base::Time& expires, int64 generation) {
+  if (!url.has_host())
+    return;
+
+  base::AutoLock lock_scope(lock_);
+  if (generation != generation_)
+    return;
+
+  if (entries_.size() >= kMaxEntries)
+    entries_.clear();
+
+  Entry& entry = entries_[GetEntryKey(url)];
+  entry.host = url.host();
+  entry.cookie_line = cookie_line;
+  entry.expires = expires;
+}
+
+void BrowserCookieCache::InvalidateURL(const GURL& url) {
+  // The cookie may name any parent domain up to the registrable domain.
+  // Hosts without one, such as IP addresses, can only set host cookies.
+  std::string domain =
+      net::RegistryControlledDomainService::GetDomainAndRegistry(url);
+  if (domain.empty())
+    domain = url.host();
+
+  base::AutoLock lock_scope(lock_);
+  generation_++;
+  InvalidateDomain(domain);
+}
+
+void BrowserCookieCache::OnCookieChanged(
+    const net::CookieMonster::CanonicalCookie& cookie,
+    bool removed,
+    ChangeCause cause) {
+  base::AutoLock lock_scope(lock_);
+  generation_++;
+  InvalidateDomain(cookie.Domain());
+}
+
+void BrowserCookieCache::InvalidateDomain(const std::string& domain) {
+  lock_.AssertAcquired();
+
+  // Treat host cookies like domain cookies. This may remove entries for
+  // subdomains unnecessarily but never keeps a stale entry.
+  std::string host_suffix(domain);
+  if (!host_suffix.empty() && host_suffix[0] == '.')
+    host_suffix.erase(0, 1);
+  if (host_suffix.empty())
+    return;
+  std::string dot_suffix = "." + host_suffix;
+
+  EntryMap::iterator it = entries_.begin();
+  while (it != entries_.end()) {
+    const std::string& host = it->second.host;
+    if (host == host_suffix || EndsWith(host, dot_suffix, false))
+      entries_.erase(it++);
+    else
+      ++it;
+  }
+}
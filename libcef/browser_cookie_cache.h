@@ -0,0 +1,81 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#ifndef _BROWSER_COOKIE_CACHE_H
+#define _BROWSER_COOKIE_CACHE_H
+#pragma once
+
+#include <map>
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/compiler_specific.h"
+#include "base/synchronization/lock.h"
+#include "base/time.h"
+#include "net/base/cookie_monster.h"
+
+class GURL;
+
+// Caches the cookie line returned for document.cookie so that repeated reads
+// on the UI thread do not wait for the IO thread. Installed as the cookie
+// monster delegate so that entries are invalidated when a cookie for the
+// entry's host changes. Entries also expire with the first cookie that they
+// contain.
+//
+// Lookup(), Store() and InvalidateURL() may be called on any thread.
+// OnCookieChanged() is called on the IO thread.
+class BrowserCookieCache : public net::CookieMonster::Delegate {
+ public:
+  BrowserCookieCache();
+
+  // Returns true and sets |cookie_line| if a valid entry exists for |url|.
+  // Otherwise sets |generation| to the value that must be passed to Store().
+  bool Lookup(const GURL& url, std::string* cookie_line, int64* generation);
+
+  // Cache |cookie_line| for |url| until |expires|, which may be null. The
+  // entry is discarded if any cookie has changed since |generation| was
+  // returned by Lookup().
+  void Store(const GURL& url, const std::string& cookie_line,
+             const base::Time& expires, int64 generation);
+
+  // Remove the entries for the registrable domain of |url| and its
+  // subdomains, which includes every host that a cookie set by |url| can be
+  // visible to. Called when a cookie is set from the UI thread so that the
+  // next read waits for the change.
+  void InvalidateURL(const GURL& url);
+
+  // net::CookieMonster::Delegate methods.
+  virtual void OnCookieChanged(
+      const net::CookieMonster::CanonicalCookie& cookie,
+      bool removed,
+      ChangeCause cause) OVERRIDE;
+
+ private:
+  virtual ~BrowserCookieCache();
+
+  struct Entry {
+    std::string host;
+    std::string cookie_line;
+    base::Time expires;
+  };
+
+  // Remove the entries whose host matches |domain| using cookie domain
+  // matching rules. Called with |lock_| held.
+  void InvalidateDomain(const std::string& domain);
+
+  // Entries keyed by the URL without the query and ref, which do not affect
+  // the cookie line.
+  typedef std::map<std::string, Entry> EntryMap;
+  EntryMap entries_;
+
+  // Incremented for each change so that a cookie line read before a change
+  // is not stored after it.
+  int64 generation_;
+
+  base::Lock lock_;
+
+  DISALLOW_COPY_AND_ASSIGN(BrowserCookieCache);
+};
+
+#endif  // _BROWSER_COOKIE_CACHE_H
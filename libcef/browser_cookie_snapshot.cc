@@ -0,0 +1,143 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "browser_cookie_snapshot.h"
+
+#include "base/pickle.h"
+#include "base/string_util.h"
+#include "base/time.h"
+#include "googleurl/src/gurl.h"
+
+namespace CookieSnapshot {
+
+namespace {
+
+// Increment when the snapshot format changes. Snapshots with a different
+// version are rejected.
+const int kSnapshotVersion = 1;
+
+// Size of the Pickle header, which contains the payload size.
+const size_t kPickleHeaderSize = sizeof(uint32);
+
+bool ReadTime(const Pickle& pickle, void** iter, base::Time* time) {
+  int64 value;
+  if (!pickle.ReadInt64(iter, &value))
+    return false;
+  *time = base::Time::FromInternalValue(value);
+  return true;
+}
+
+}  // namespace
+
+bool MatchesDomain(const net::CookieMonster::CanonicalCookie& cookie,
+                   const std::string& domain) {
+  if (domain.empty())
+    return true;
+
+  std::string cookie_domain = cookie.Domain();
+  if (!cookie_domain.empty() && cookie_domain[0] == '.')
+    cookie_domain.erase(0, 1);
+
+  if (cookie_domain == domain)
+    return true;
+
+  // Match subdomains of |domain|.
+  return cookie_domain.size() > domain.size() &&
+         cookie_domain[cookie_domain.size() - domain.size() - 1] == '.' &&
+         cookie_domain.compare(cookie_domain.size() - domain.size(),
+                               domain.size(), domain) == 0;
+}
+
+void Write(const std::string& domain, const net::CookieList& cookies,
+           std::string* data) {
+  net::CookieList matching;
+  for (net::CookieList::const_iterator it = cookies.begin();
+       it != cookies.end(); ++it) {
+    if (MatchesDomain(*it, domain))
+      matching.push_back(*it);
+  }
+
+  Pickle pickle;
+  pickle.WriteInt(kSnapshotVersion);
+  pickle.WriteString(domain);
+  pickle.WriteInt(static_cast<int>(matching.size()));
+
+  for (net::CookieList::const_iterator it = matching.begin();
+       it != matching.end(); ++it) {
+    pickle.WriteString(it->Name());
+    pickle.WriteString(it->Value());
+    pickle.WriteString(it->Domain());
+    pickle.WriteString(it->Path());
+    pickle.WriteInt64(it->CreationDate().ToInternalValue());
+    pickle.WriteInt64(it->ExpiryDate().ToInternalValue());
+    pickle.WriteInt64(it->LastAccessDate().ToInternalValue());
+    pickle.WriteBool(it->IsSecure());
+    pickle.WriteBool(it->IsHttpOnly());
+    pickle.WriteBool(it->DoesExpire());
+  }
+
+  data->assign(static_cast<const char*>(pickle.data()), pickle.size());
+}
+
+bool Read(const std::string& data, std::string* domain,
+          net::CookieList* cookies) {
+  // Pickle does not validate the header size before using it.
+  if (data.size() < kPickleHeaderSize)
+    return false;
+  const char* start = data.data();
+  const char* end = start + data.size();
+  if (Pickle::FindNext(kPickleHeaderSize, start, end) != end)
+    return false;
+
+  Pickle pickle(start, static_cast<int>(data.size()));
+  void* iter = NULL;
+
+  int version, count;
+  if (!pickle.ReadInt(&iter, &version) || version != kSnapshotVersion ||
+      !pickle.ReadString(&iter, domain) ||
+      !pickle.ReadInt(&iter, &count) || count < 0) {
+    return false;
+  }
+
+  // Write() is only passed canonical domains.
+  if (!domain->empty() &&
+      ((*domain)[0] == '.' || StringToLowerASCII(*domain) != *domain)) {
+    return false;
+  }
+
+  net::CookieList list;
+  for (int i = 0; i < count; ++i) {
+    std::string name, value, cookie_domain, path;
+    base::Time creation_time, expiration_time, last_access_time;
+    bool secure, httponly, has_expires;
+    if (!pickle.ReadString(&iter, &name) ||
+        !pickle.ReadString(&iter, &value) ||
+        !pickle.ReadString(&iter, &cookie_domain) ||
+        !pickle.ReadString(&iter, &path) ||
+        !ReadTime(pickle, &iter, &creation_time) ||
+        !ReadTime(pickle, &iter, &expiration_time) ||
+        !ReadTime(pickle, &iter, &last_access_time) ||
+        !pickle.ReadBool(&iter, &secure) ||
+        !pickle.ReadBool(&iter, &httponly) ||
+        !pickle.ReadBool(&iter, &has_expires)) {
+      return false;
+    }
+
+    if (cookie_domain.empty())
+      return false;
+
+    list.push_back(net::CookieMonster::CanonicalCookie(GURL(), name, value,
+        cookie_domain, path, std::string(), std::string(), creation_time,
+        expiration_time, last_access_time, secure, httponly, has_expires));
+
+    // Restoring the snapshot only replaces the cookies for its domain.
+    if (!MatchesDomain(list.back(), *domain))
+      return false;
+  }
+
+  cookies->swap(list);
+  return true;
+}
+
+}  // namespace CookieSnapshot
@@ -0,0 +1,37 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#ifndef _BROWSER_COOKIE_SNAPSHOT_H
+#define _BROWSER_COOKIE_SNAPSHOT_H
+#pragma once
+
+#include <string>
+
+#include "net/base/cookie_monster.h"
+
+// Serialization of cookie snapshots for CefSaveCookies() and
+// CefRestoreCookies(). A snapshot is a Pickle that contains a format version,
+// the domain that the snapshot was taken for and the cookies. Times are
+// stored as internal values so that cookies are restored exactly.
+namespace CookieSnapshot {
+
+// Returns true if |cookie| belongs to |domain| or one of its subdomains.
+// |domain| must be canonical (lower case without a leading dot). All cookies
+// match an empty |domain|.
+bool MatchesDomain(const net::CookieMonster::CanonicalCookie& cookie,
+                   const std::string& domain);
+
+// Serialize the cookies from |cookies| that match |domain| into |data|.
+void Write(const std::string& domain, const net::CookieList& cookies,
+           std::string* data);
+
+// Parse a snapshot created by Write(). Returns false if |data| is not a valid
+// snapshot, including when the domain is not canonical or a cookie does not
+// match the domain.
+bool Read(const std::string& data, std::string* domain,
+          net::CookieList* cookies);
+
+}  // namespace CookieSnapshot
+
+#endif  // _BROWSER_COOKIE_SNAPSHOT_H
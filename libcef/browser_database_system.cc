@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #include "browser_database_system.h"
+#include "cef_startup_timer.h"
 
 #include "base/auto_reset.h"
 #include "base/file_util.h"
@@ -32,27 +33,40 @@ BrowserDatabaseSystem* BrowserDatabaseSystem::GetInstance() {
 BrowserDatabaseSystem::BrowserDatabaseSystem()
     : db_thread_("BrowserDBThread"),
       quota_per_origin_(5 * 1024 * 1024),
-      open_connections_(new webkit_database::DatabaseConnectionsWrapper) {
+      open_connections_(new webkit_database::DatabaseConnectionsWrapper),
+      initialized_(false) {
   DCHECK(!instance_);
   instance_ = this;
+}
+
+BrowserDatabaseSystem::~BrowserDatabaseSystem() {
+  if (initialized_) {
+    base::WaitableEvent done_event(false, false);
+    db_thread_proxy_->PostTask(FROM_HERE,
+        NewRunnableMethod(this, &BrowserDatabaseSystem::ThreadCleanup,
+                          &done_event));
+    done_event.Wait();
+  }
+  instance_ = NULL;
+}
+
+void BrowserDatabaseSystem::EnsureInitialized() {
+  base::AutoLock lock_scope(init_lock_);
+  if (initialized_)
+    return;
+
+  CefStartupTimer timer(CefStartupTimer::DATABASE_INIT);
   CHECK(temp_dir_.CreateUniqueTempDir());
   db_tracker_ =
       new DatabaseTracker(temp_dir_.path(), false, false, NULL, NULL, NULL);
   db_tracker_->AddObserver(this);
   db_thread_.Start();
   db_thread_proxy_ = db_thread_.message_loop_proxy();
-}
-
-BrowserDatabaseSystem::~BrowserDatabaseSystem() {
-  base::WaitableEvent done_event(false, false);
-  db_thread_proxy_->PostTask(FROM_HERE,
-      NewRunnableMethod(this, &BrowserDatabaseSystem::ThreadCleanup,
-                        &done_event));
-  done_event.Wait();
-  instance_ = NULL;
+  initialized_ = true;
 }
 
 void BrowserDatabaseSystem::databaseOpened(const WebKit::WebDatabase& database) {
+  EnsureInitialized();
   string16 origin_identifier = database.securityOrigin().databaseIdentifier();
   string16 database_name = database.name();
   open_connections_->AddOpenConnection(origin_identifier, database_name);
@@ -65,6 +79,7 @@ void BrowserDatabaseSystem::databaseOpened(const WebKit::WebDatabase& database)
 
 void BrowserDatabaseSystem::databaseModified(
     const WebKit::WebDatabase& database) {
+  EnsureInitialized();
   db_thread_proxy_->PostTask(FROM_HERE,
       NewRunnableMethod(this, &BrowserDatabaseSystem::DatabaseModified,
                         database.securityOrigin().databaseIdentifier(),
@@ -72,6 +87,7 @@ void BrowserDatabaseSystem::databaseModified(
 }
 
 void BrowserDatabaseSystem::databaseClosed(const WebKit::WebDatabase& database) {
+  EnsureInitialized();
   string16 origin_identifier = database.securityOrigin().databaseIdentifier();
   string16 database_name = database.name();
   db_thread_proxy_->PostTask(FROM_HERE,
@@ -81,6 +97,7 @@ void BrowserDatabaseSystem::databaseClosed(const WebKit::WebDatabase& database)
 
 base::PlatformFile BrowserDatabaseSystem::OpenFile(
     const string16& vfs_file_name, int desired_flags) {
+  EnsureInitialized();
   base::PlatformFile result = base::kInvalidPlatformFileValue;
   base::WaitableEvent done_event(false, false);
   db_thread_proxy_->PostTask(FROM_HERE,
@@ -93,6 +110,7 @@ base::PlatformFile BrowserDatabaseSystem::OpenFile(
 
 int BrowserDatabaseSystem::DeleteFile(
     const string16& vfs_file_name, bool sync_dir) {
+  EnsureInitialized();
   int result = SQLITE_OK;
   base::WaitableEvent done_event(false, false);
   db_thread_proxy_->PostTask(FROM_HERE,
@@ -104,6 +122,7 @@ int BrowserDatabaseSystem::DeleteFile(
 }
 
 uint32 BrowserDatabaseSystem::GetFileAttributes(const string16& vfs_file_name) {
+  EnsureInitialized();
   uint32 result = 0;
   base::WaitableEvent done_event(false, false);
   db_thread_proxy_->PostTask(FROM_HERE,
@@ -114,6 +133,7 @@ uint32 BrowserDatabaseSystem::GetFileAttributes(const string16& vfs_file_name) {
 }
 
 int64 BrowserDatabaseSystem::GetFileSize(const string16& vfs_file_name) {
+  EnsureInitialized();
   int64 result = 0;
   base::WaitableEvent done_event(false, false);
   db_thread_proxy_->PostTask(FROM_HERE,
@@ -125,6 +145,7 @@ int64 BrowserDatabaseSystem::GetFileSize(const string16& vfs_file_name) {
 
 int64 BrowserDatabaseSystem::GetSpaceAvailable(
     const string16& origin_identifier) {
+  EnsureInitialized();
   int64 result = 0;
   base::WaitableEvent done_event(false, false);
   db_thread_proxy_->PostTask(FROM_HERE,
@@ -135,12 +156,14 @@ int64 BrowserDatabaseSystem::GetSpaceAvailable(
 }
 
 void BrowserDatabaseSystem::ClearAllDatabases() {
+  EnsureInitialized();
   open_connections_->WaitForAllDatabasesToClose();
   db_thread_proxy_->PostTask(FROM_HERE,
       NewRunnableMethod(this, &BrowserDatabaseSystem::ResetTracker));
 }
 
 void BrowserDatabaseSystem::SetDatabaseQuota(int64 quota) {
+  EnsureInitialized();
   if (!db_thread_proxy_->BelongsToCurrentThread()) {
     db_thread_proxy_->PostTask(FROM_HERE,
         NewRunnableMethod(this, &BrowserDatabaseSystem::SetDatabaseQuota,
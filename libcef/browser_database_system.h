@@ -85,6 +85,10 @@ class BrowserDatabaseSystem : public webkit_database::DatabaseTracker::Observer,
   void ResetTracker();
   void ThreadCleanup(base::WaitableEvent* done_event);
 
+  // Create the temp directory, the tracker and the db_thread the first time
+  // any database method is called. May be called on any thread.
+  void EnsureInitialized();
+
   // Where the tracker database file and per origin database files reside.
   ScopedTempDir temp_dir_;
 
@@ -98,6 +102,11 @@ class BrowserDatabaseSystem : public webkit_database::DatabaseTracker::Observer,
   // Data members to support waiting for all connections to be closed.
   scoped_refptr<webkit_database::DatabaseConnectionsWrapper> open_connections_;
 
+  // Protects |initialized_|, which is set once the members above have been
+  // created by EnsureInitialized().
+  base::Lock init_lock_;
+  bool initialized_;
+
   static BrowserDatabaseSystem* instance_;
 };
 
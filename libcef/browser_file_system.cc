@@ -4,6 +4,8 @@
 
 #include "browser_file_system.h"
 #include "browser_file_writer.h"
+#include "cef_startup_timer.h"
+#include "cef_thread.h"
 
 #include "base/file_path.h"
 #include "base/memory/scoped_callback_factory.h"
@@ -121,11 +123,27 @@ class BrowserFileSystemCallbackDispatcher
 
 }  // namespace
 
-BrowserFileSystem::BrowserFileSystem() {
+BrowserFileSystem::BrowserFileSystem()
+    : initialized_(false) {
+}
+
+BrowserFileSystem::~BrowserFileSystem() {
+}
+
+FileSystemContext* BrowserFileSystem::file_system_context() {
+  base::AutoLock lock_scope(lock_);
+  if (initialized_)
+    return file_system_context_.get();
+  initialized_ = true;
+
+  CefStartupTimer timer(CefStartupTimer::FILE_SYSTEM_INIT);
   if (file_system_dir_.CreateUniqueTempDir()) {
+    // File operations run on the UI thread where WebKit calls this object.
+    scoped_refptr<base::MessageLoopProxy> ui_proxy =
+        CefThread::GetMessageLoopProxyForThread(CefThread::UI);
     file_system_context_ = new FileSystemContext(
-        base::MessageLoopProxy::current(),
-        base::MessageLoopProxy::current(),
+        ui_proxy,
+        ui_proxy,
         NULL /* special storage policy */,
         NULL /* quota manager */,
         file_system_dir_.path(),
@@ -137,16 +155,14 @@ BrowserFileSystem::BrowserFileSystem() {
     LOG(WARNING) << "Failed to create a temp dir for the filesystem."
                     "FileSystem feature will be disabled.";
   }
-}
-
-BrowserFileSystem::~BrowserFileSystem() {
+  return file_system_context_.get();
 }
 
 void BrowserFileSystem::OpenFileSystem(
     WebFrame* frame, WebFileSystem::Type web_filesystem_type,
     long long, bool create,
     WebFileSystemCallbacks* callbacks) {
-  if (!frame || !file_system_context_.get()) {
+  if (!frame || !file_system_context()) {
     // The FileSystem temp directory was not initialized successfully.
     callbacks->didFail(WebKit::WebFileErrorSecurity);
     return;
@@ -223,7 +239,7 @@ void BrowserFileSystem::readDirectory(
 
 WebFileWriter* BrowserFileSystem::createFileWriter(
     const WebURL& path, WebFileWriterClient* client) {
-  return new BrowserFileWriter(path, client, file_system_context_.get());
+  return new BrowserFileWriter(path, client, file_system_context());
 }
 
 FileSystemOperation* BrowserFileSystem::GetNewOperation(
@@ -232,6 +248,6 @@ FileSystemOperation* BrowserFileSystem::GetNewOperation(
       new BrowserFileSystemCallbackDispatcher(AsWeakPtr(), callbacks);
   FileSystemOperation* operation = new FileSystemOperation(
       dispatcher, base::MessageLoopProxy::current(),
-      file_system_context_.get(), NULL);
+      file_system_context(), NULL);
   return operation;
 }
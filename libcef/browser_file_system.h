@@ -9,6 +9,7 @@
 #include "base/id_map.h"
 #include "base/memory/weak_ptr.h"
 #include "base/scoped_temp_dir.h"
+#include "base/synchronization/lock.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebFileSystem.h"
 #include "webkit/fileapi/file_system_types.h"
 #include <vector>
@@ -37,9 +38,10 @@ class BrowserFileSystem
                       bool create,
                       WebKit::WebFileSystemCallbacks* callbacks);
 
-  fileapi::FileSystemContext* file_system_context() {
-    return file_system_context_.get();
-  }
+  // Returns the context, creating it and its temp directory the first time
+  // this method is called. Returns NULL if the temp directory could not be
+  // created. May be called on any thread.
+  fileapi::FileSystemContext* file_system_context();
 
   // WebKit::WebFileSystem implementation.
   virtual void move(
@@ -89,6 +91,10 @@ class BrowserFileSystem
 
   scoped_refptr<fileapi::FileSystemContext> file_system_context_;
 
+  // Protects |file_system_dir_|, |file_system_context_| and |initialized_|.
+  base::Lock lock_;
+  bool initialized_;
+
   DISALLOW_COPY_AND_ASSIGN(BrowserFileSystem);
 };
 
@@ -0,0 +1,125 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "browser_http_cache_purger.h"
+#include "cef_thread.h"
+
+#include "base/logging.h"
+#include "base/task.h"
+#include "net/base/net_errors.h"
+#include "net/disk_cache/disk_cache.h"
+#include "net/http/http_cache.h"
+
+BrowserHttpCachePurger::BrowserHttpCachePurger(net::HttpCache* cache,
+                                               const std::string& url_prefix,
+                                               const base::Time& cutoff,
+                                               Task* completion_task)
+    : cache_(cache),
+      url_prefix_(url_prefix),
+      cutoff_(cutoff),
+      completion_task_(completion_task),
+      backend_(NULL),
+      entry_(NULL),
+      iter_(NULL),
+      ALLOW_THIS_IN_INITIALIZER_LIST(
+          backend_callback_(this, &BrowserHttpCachePurger::OnGotBackend)),
+      ALLOW_THIS_IN_INITIALIZER_LIST(
+          entry_callback_(this, &BrowserHttpCachePurger::OnEntryOpened)),
+      ALLOW_THIS_IN_INITIALIZER_LIST(
+          doom_callback_(this, &BrowserHttpCachePurger::OnDoomComplete)) {
+}
+
+BrowserHttpCachePurger::~BrowserHttpCachePurger() {
+  DCHECK(!entry_);
+  DCHECK(!completion_task_);
+}
+
+void BrowserHttpCachePurger::Start() {
+  DCHECK(CefThread::CurrentlyOn(CefThread::IO));
+  int rv = cache_->GetBackend(&backend_, &backend_callback_);
+  if (rv != net::ERR_IO_PENDING)
+    OnGotBackend(rv);
+}
+
+void BrowserHttpCachePurger::OnGotBackend(int rv) {
+  if (rv != net::OK || !backend_) {
+    Done();
+    return;
+  }
+
+  // The backend can remove entries by time without enumerating them.
+  if (url_prefix_.empty()) {
+    if (cutoff_.is_null())
+      rv = backend_->DoomAllEntries(&doom_callback_);
+    else
+      rv = backend_->DoomEntriesBetween(base::Time(), cutoff_, &doom_callback_);
+    if (rv != net::ERR_IO_PENDING)
+      OnDoomComplete(rv);
+    return;
+  }
+
+  OpenNextEntry();
+}
+
+void BrowserHttpCachePurger::OpenNextEntry() {
+  // Entries may be opened synchronously so loop until the enumeration is
+  // pending or finished.
+  for (;;) {
+    int rv = backend_->OpenNextEntry(&iter_, &entry_, &entry_callback_);
+    if (rv == net::ERR_IO_PENDING || !HandleEntry(rv))
+      return;
+  }
+}
+
+void BrowserHttpCachePurger::OnEntryOpened(int rv) {
+  if (HandleEntry(rv))
+    OpenNextEntry();
+}
+
+void BrowserHttpCachePurger::DoomNextEntry() {
+  // Entries may be removed synchronously so loop until a removal is pending
+  // or all keys have been removed.
+  while (!keys_.empty()) {
+    std::string key = keys_.back();
+    keys_.pop_back();
+    if (backend_->DoomEntry(key, &doom_callback_) == net::ERR_IO_PENDING)
+      return;
+  }
+  Done();
+}
+
+void BrowserHttpCachePurger::OnDoomComplete(int rv) {
+  DoomNextEntry();
+}
+
+bool BrowserHttpCachePurger::HandleEntry(int rv) {
+  if (rv != net::OK) {
+    // There are no more entries.
+    entry_ = NULL;
+    if (iter_)
+      backend_->EndEnumeration(&iter_);
+    DoomNextEntry();
+    return false;
+  }
+
+  // The key is the URL of the cached response.
+  if (entry_->GetKey().compare(0, url_prefix_.size(), url_prefix_) == 0 &&
+      (cutoff_.is_null() || entry_->GetLastUsed() < cutoff_)) {
+    keys_.push_back(entry_->GetKey());
+  }
+  entry_->Close();
+  entry_ = NULL;
+  return true;
+}
+
+void BrowserHttpCachePurger::Done() {
+  if (iter_)
+    backend_->EndEnumeration(&iter_);
+  if (completion_task_) {
+    completion_task_->Run();
+    delete completion_task_;
+    completion_task_ = NULL;
+  }
+  delete this;
+}
@@ -0,0 +1,77 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#ifndef _BROWSER_HTTP_CACHE_PURGER_H
+#define _BROWSER_HTTP_CACHE_PURGER_H
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "base/basictypes.h"
+#include "base/time.h"
+#include "net/base/completion_callback.h"
+
+class Task;
+
+namespace disk_cache {
+class Backend;
+class Entry;
+}
+
+namespace net {
+class HttpCache;
+}
+
+// Removes the entries from an HTTP cache whose URL starts with a prefix and
+// that were last used before a cutoff time. The entries are enumerated and
+// removed asynchronously and the object deletes itself when done. Only use on
+// the IO thread.
+class BrowserHttpCachePurger {
+ public:
+  // If |url_prefix| is empty all URLs match. If |cutoff| is null all entries
+  // match regardless of when they were last used. |completion_task|, if
+  // non-NULL, is run on the IO thread after the entries have been removed.
+  BrowserHttpCachePurger(net::HttpCache* cache, const std::string& url_prefix,
+                         const base::Time& cutoff, Task* completion_task);
+
+  // Start removing entries.
+  void Start();
+
+ private:
+  ~BrowserHttpCachePurger();
+
+  void OnGotBackend(int rv);
+  void OpenNextEntry();
+  void OnEntryOpened(int rv);
+  void DoomNextEntry();
+  void OnDoomComplete(int rv);
+
+  // Remember the key of the opened entry if it matches. Returns false if the
+  // enumeration has finished.
+  bool HandleEntry(int rv);
+
+  void Done();
+
+  net::HttpCache* cache_;
+  std::string url_prefix_;
+  base::Time cutoff_;
+  Task* completion_task_;
+
+  // Keys of the matching entries. They are removed after the enumeration so
+  // that the completion of each removal can be observed.
+  std::vector<std::string> keys_;
+
+  disk_cache::Backend* backend_;
+  disk_cache::Entry* entry_;
+  void* iter_;
+
+  net::CompletionCallbackImpl<BrowserHttpCachePurger> backend_callback_;
+  net::CompletionCallbackImpl<BrowserHttpCachePurger> entry_callback_;
+  net::CompletionCallbackImpl<BrowserHttpCachePurger> doom_callback_;
+
+  DISALLOW_COPY_AND_ASSIGN(BrowserHttpCachePurger);
+};
+
+#endif  // _BROWSER_HTTP_CACHE_PURGER_H
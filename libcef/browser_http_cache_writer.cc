@@ -0,0 +1,146 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "browser_http_cache_writer.h"
+#include "cef_thread.h"
+
+#include "base/logging.h"
+#include "base/pickle.h"
+#include "base/task.h"
+#include "base/time.h"
+#include "googleurl/src/gurl.h"
+#include "net/base/io_buffer.h"
+#include "net/base/net_errors.h"
+#include "net/disk_cache/disk_cache.h"
+#include "net/http/http_cache.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_response_info.h"
+#include "net/http/http_util.h"
+
+namespace {
+
+// Stream indices used by net::HttpCache::Transaction.
+const int kResponseInfoIndex = 0;
+const int kResponseContentIndex = 1;
+
+} // namespace
+
+BrowserHttpCacheWriter::BrowserHttpCacheWriter(
+    net::HttpCache* cache, const GURL& url, net::HttpResponseHeaders* headers,
+    const std::string& data, Task* completion_task)
+    : cache_(cache),
+      // Matches the key used by the cache for GET requests.
+      key_(net::HttpUtil::SpecForRequest(url)),
+      completion_task_(completion_task),
+      info_size_(0),
+      data_size_(static_cast<int>(data.size())),
+      backend_(NULL),
+      entry_(NULL),
+      ALLOW_THIS_IN_INITIALIZER_LIST(
+          backend_callback_(this, &BrowserHttpCacheWriter::OnGotBackend)),
+      ALLOW_THIS_IN_INITIALIZER_LIST(
+          doom_callback_(this, &BrowserHttpCacheWriter::OnDoomComplete)),
+      ALLOW_THIS_IN_INITIALIZER_LIST(
+          entry_callback_(this, &BrowserHttpCacheWriter::OnEntryCreated)),
+      ALLOW_THIS_IN_INITIALIZER_LIST(
+          info_callback_(this, &BrowserHttpCacheWriter::OnInfoWritten)),
+      ALLOW_THIS_IN_INITIALIZER_LIST(
+          data_callback_(this, &BrowserHttpCacheWriter::OnDataWritten)) {
+  net::HttpResponseInfo info;
+  info.request_time = base::Time::Now();
+  info.response_time = info.request_time;
+  info.headers = headers;
+
+  Pickle pickle;
+  info.Persist(&pickle, true, false);
+  info_size_ = static_cast<int>(pickle.size());
+  info_buffer_ = new net::StringIOBuffer(
+      std::string(static_cast<const char*>(pickle.data()), pickle.size()));
+
+  if (data_size_ > 0)
+    data_buffer_ = new net::StringIOBuffer(data);
+}
+
+BrowserHttpCacheWriter::~BrowserHttpCacheWriter() {
+  DCHECK(!entry_);
+  DCHECK(!completion_task_);
+}
+
+void BrowserHttpCacheWriter::Start() {
+  DCHECK(CefThread::CurrentlyOn(CefThread::IO));
+  int rv = cache_->GetBackend(&backend_, &backend_callback_);
+  if (rv != net::ERR_IO_PENDING)
+    OnGotBackend(rv);
+}
+
+void BrowserHttpCacheWriter::OnGotBackend(int rv) {
+  if (rv != net::OK || !backend_) {
+    Done(false);
+    return;
+  }
+
+  rv = backend_->DoomEntry(key_, &doom_callback_);
+  if (rv != net::ERR_IO_PENDING)
+    OnDoomComplete(rv);
+}
+
+void BrowserHttpCacheWriter::OnDoomComplete(int rv) {
+  // Fails if there is no existing entry.
+  rv = backend_->CreateEntry(key_, &entry_, &entry_callback_);
+  if (rv != net::ERR_IO_PENDING)
+    OnEntryCreated(rv);
+}
+
+void BrowserHttpCacheWriter::OnEntryCreated(int rv) {
+  if (rv != net::OK) {
+    entry_ = NULL;
+    Done(false);
+    return;
+  }
+
+  rv = entry_->WriteData(kResponseInfoIndex, 0, info_buffer_, info_size_,
+                         &info_callback_, true);
+  if (rv != net::ERR_IO_PENDING)
+    OnInfoWritten(rv);
+}
+
+void BrowserHttpCacheWriter::OnInfoWritten(int rv) {
+  if (rv != info_size_) {
+    Done(false);
+    return;
+  }
+
+  if (data_size_ == 0) {
+    Done(true);
+    return;
+  }
+
+  rv = entry_->WriteData(kResponseContentIndex, 0, data_buffer_, data_size_,
+                         &data_callback_, true);
+  if (rv != net::ERR_IO_PENDING)
+    OnDataWritten(rv);
+}
+
+void BrowserHttpCacheWriter::OnDataWritten(int rv) {
+  Done(rv == data_size_);
+}
+
+void BrowserHttpCacheWriter::Done(bool success) {
+  if (!success)
+    LOG(WARNING) << "Failed to import the HTTP cache entry for " << key_;
+
+  if (entry_) {
+    // Don't leave a partial response in the cache.
+    if (!success)
+      entry_->Doom();
+    entry_->Close();
+    entry_ = NULL;
+  }
+  if (completion_task_) {
+    completion_task_->Run();
+    delete completion_task_;
+    completion_task_ = NULL;
+  }
+  delete this;
+}
@@ -0,0 +1,79 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#ifndef _BROWSER_HTTP_CACHE_WRITER_H
+#define _BROWSER_HTTP_CACHE_WRITER_H
+#pragma once
+
+#include <string>
+
+#include "base/basictypes.h"
+#include "base/memory/ref_counted.h"
+#include "net/base/completion_callback.h"
+
+class GURL;
+class Task;
+
+namespace disk_cache {
+class Backend;
+class Entry;
+}
+
+namespace net {
+class HttpCache;
+class HttpResponseHeaders;
+class IOBuffer;
+}
+
+// Writes a response to an HTTP cache in the same format as a response that
+// was received from the network. Any existing entry for the URL is replaced.
+// The entry is written asynchronously and the object deletes itself when done.
+// Only use on the IO thread.
+class BrowserHttpCacheWriter {
+ public:
+  // The response is treated as having been received now. |completion_task|,
+  // if non-NULL, is run on the IO thread after the entry has been written or
+  // the write has failed.
+  BrowserHttpCacheWriter(net::HttpCache* cache, const GURL& url,
+                         net::HttpResponseHeaders* headers,
+                         const std::string& data, Task* completion_task);
+
+  // Start writing the entry.
+  void Start();
+
+ private:
+  ~BrowserHttpCacheWriter();
+
+  void OnGotBackend(int rv);
+  void OnDoomComplete(int rv);
+  void OnEntryCreated(int rv);
+  void OnInfoWritten(int rv);
+  void OnDataWritten(int rv);
+
+  // Close the entry and delete this object. The entry is removed unless
+  // |success| is true.
+  void Done(bool success);
+
+  net::HttpCache* cache_;
+  std::string key_;
+  Task* completion_task_;
+
+  scoped_refptr<net::IOBuffer> info_buffer_;
+  int info_size_;
+  scoped_refptr<net::IOBuffer> data_buffer_;
+  int data_size_;
+
+  disk_cache::Backend* backend_;
+  disk_cache::Entry* entry_;
+
+  net::CompletionCallbackImpl<BrowserHttpCacheWriter> backend_callback_;
+  net::CompletionCallbackImpl<BrowserHttpCacheWriter> doom_callback_;
+  net::CompletionCallbackImpl<BrowserHttpCacheWriter> entry_callback_;
+  net::CompletionCallbackImpl<BrowserHttpCacheWriter> info_callback_;
+  net::CompletionCallbackImpl<BrowserHttpCacheWriter> data_callback_;
+
+  DISALLOW_COPY_AND_ASSIGN(BrowserHttpCacheWriter);
+};
+
+#endif  // _BROWSER_HTTP_CACHE_WRITER_H
@@ -4,10 +4,12 @@
 // found in the LICENSE file.
 
 #include "cef_context.h"
+#include "cef_trace.h"
 #include "browser_impl.h"
 #include "browser_webkit_glue.h"
 #include "browser_zoom_map.h"
 #include "dom_document_impl.h"
+#include "image_capture.h"
 #include "request_impl.h"
 #include "stream_impl.h"
 
@@ -19,11 +21,13 @@
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebDocument.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebFrame.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebHTTPBody.h"
+#include "third_party/WebKit/Source/WebKit/chromium/public/WebPageVisibilityState.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebPlugin.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebPluginDocument.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebRange.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebRect.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebScriptSource.h"
+#include "third_party/WebKit/Source/WebKit/chromium/public/WebSettings.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebString.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebURL.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebURLRequest.h"
@@ -41,6 +45,7 @@ using WebKit::WebPluginDocument;
 using WebKit::WebRange;
 using WebKit::WebRect;
 using WebKit::WebScriptSource;
+using WebKit::WebSettings;
 using WebKit::WebString;
 using WebKit::WebURL;
 using WebKit::WebURLRequest;
@@ -48,28 +53,36 @@ using WebKit::WebView;
 
 namespace {
 
+// Minimum interval between JavaScript timer callbacks in seconds. These match
+// the values used by Chromium for foreground and background tabs.
+const double kVisibleTimerInterval = 0.004;
+const double kHiddenTimerInterval = 1.0;
+
 class CreateBrowserHelper
 {
 public:
   CreateBrowserHelper(CefWindowInfo& windowInfo,
                       CefRefPtr<CefClient> client,
                       const CefString& url,
-                      const CefBrowserSettings& settings)
+                      const CefBrowserSettings& settings,
+                      CefRefPtr<CefRequestContext> request_context)
                       : window_info_(windowInfo),
                         client_(client),
                         url_(url),
-                        settings_(settings) {}
+                        settings_(settings),
+                        request_context_(request_context) {}
 
   CefWindowInfo window_info_;
   CefRefPtr<CefClient> client_;
   CefString url_;
   CefBrowserSettings settings_;
+  CefRefPtr<CefRequestContext> request_context_;
 };
 
 void UIT_CreateBrowserWithHelper(CreateBrowserHelper* helper)
 {
   CefBrowser::CreateBrowserSync(helper->window_info_, helper->client_,
-      helper->url_, helper->settings_);
+      helper->url_, helper->settings_, helper->request_context_);
   delete helper;
 }
 
@@ -97,6 +110,8 @@ void CefBrowserImpl::PaintDelegate::Paint(bool popup,
 
   CefRect rect(dirtyRect.x(), dirtyRect.y(), dirtyRect.width(),
                dirtyRect.height());
+  CEF_TRACE_EVENT1("client", "CefRenderHandler::OnPaint", "pixels",
+                   dirtyRect.width() * dirtyRect.height());
   handler->OnPaint(browser_, (popup?PET_POPUP:PET_VIEW), rect, buffer);
 }
 
@@ -106,6 +121,16 @@ bool CefBrowser::CreateBrowser(CefWindowInfo& windowInfo,
                                CefRefPtr<CefClient> client,
                                const CefString& url,
                                const CefBrowserSettings& settings)
+{
+  return CreateBrowser(windowInfo, client, url, settings, NULL);
+}
+
+// static
+bool CefBrowser::CreateBrowser(CefWindowInfo& windowInfo,
+                               CefRefPtr<CefClient> client,
+                               const CefString& url,
+                               const CefBrowserSettings& settings,
+                               CefRefPtr<CefRequestContext> requestContext)
 {
   // Verify that the context is in a valid state.
   if (!CONTEXT_STATE_VALID()) {
@@ -121,7 +146,8 @@ bool CefBrowser::CreateBrowser(CefWindowInfo& windowInfo,
 
   // Create the browser on the UI thread.
   CreateBrowserHelper* helper =
-      new CreateBrowserHelper(windowInfo, client, url, settings);
+      new CreateBrowserHelper(windowInfo, client, url, settings,
+                              requestContext);
   CefThread::PostTask(CefThread::UI, FROM_HERE, NewRunnableFunction(
       UIT_CreateBrowserWithHelper, helper));
   return true;
@@ -131,6 +157,15 @@ bool CefBrowser::CreateBrowser(CefWindowInfo& windowInfo,
 CefRefPtr<CefBrowser> CefBrowser::CreateBrowserSync(
     CefWindowInfo& windowInfo, CefRefPtr<CefClient> client,
     const CefString& url, const CefBrowserSettings& settings)
+{
+  return CreateBrowserSync(windowInfo, client, url, settings, NULL);
+}
+
+// static
+CefRefPtr<CefBrowser> CefBrowser::CreateBrowserSync(
+    CefWindowInfo& windowInfo, CefRefPtr<CefClient> client,
+    const CefString& url, const CefBrowserSettings& settings,
+    CefRefPtr<CefRequestContext> requestContext)
 {
   // Verify that the context is in a valid state.
   if (!CONTEXT_STATE_VALID()) {
@@ -150,8 +185,12 @@ CefRefPtr<CefBrowser> CefBrowser::CreateBrowserSync(
     return NULL;
   }
 
+  // CefRequestContextImpl is the only implementation.
+  CefRefPtr<CefRequestContextImpl> request_context(
+      static_cast<CefRequestContextImpl*>(requestContext.get()));
+
   CefRefPtr<CefBrowser> browser(
-      new CefBrowserImpl(windowInfo, settings, NULL, client));
+      new CefBrowserImpl(windowInfo, settings, NULL, client, request_context));
   static_cast<CefBrowserImpl*>(browser.get())->UIT_CreateBrowser(url);
 
   return browser;
@@ -161,10 +200,14 @@ CefRefPtr<CefBrowser> CefBrowser::CreateBrowserSync(
 CefBrowserImpl::CefBrowserImpl(const CefWindowInfo& windowInfo,
                                const CefBrowserSettings& settings,
                                gfx::NativeView opener,
-                               CefRefPtr<CefClient> client)
+                               CefRefPtr<CefClient> client,
+                               CefRefPtr<CefRequestContextImpl> request_context)
   : window_info_(windowInfo), settings_(settings), opener_(opener),
-    is_modal_(false), client_(client), webviewhost_(NULL), popuphost_(NULL),
-    zoom_level_(0.0), can_go_back_(false), can_go_forward_(false),
+    is_modal_(false), client_(client), request_context_(request_context),
+    webviewhost_(NULL), popuphost_(NULL),
+    zoom_level_(0.0), pixel_format_(PF_DEFAULT), is_hidden_(false),
+    can_go_back_(false),
+    can_go_forward_(false),
     has_document_(false), main_frame_(NULL), unique_id_(0)
 #if defined(OS_WIN)
     , opener_was_disabled_by_modal_loop_(false),
@@ -397,56 +440,148 @@ bool CefBrowserImpl::GetImage(PaintElementType type, int width, int height,
   return false;
 }
 
+void CefBrowserImpl::SetPixelFormat(PixelFormat format)
+{
+  {
+    AutoLock lock_scope(this);
+    pixel_format_ = format;
+  }
+
+  CefThread::PostTask(CefThread::UI, FROM_HERE, NewRunnableMethod(this,
+      &CefBrowserImpl::UIT_SetPixelFormat, format));
+}
+
+CefBrowser::PixelFormat CefBrowserImpl::GetPixelFormat()
+{
+  AutoLock lock_scope(this);
+  return pixel_format_;
+}
+
+void CefBrowserImpl::WasHidden(bool hidden)
+{
+  {
+    AutoLock lock_scope(this);
+    if (is_hidden_ == hidden)
+      return;
+    is_hidden_ = hidden;
+  }
+
+  CefThread::PostTask(CefThread::UI, FROM_HERE, NewRunnableMethod(this,
+      &CefBrowserImpl::UIT_WasHidden, hidden));
+}
+
+bool CefBrowserImpl::IsHidden()
+{
+  AutoLock lock_scope(this);
+  return is_hidden_;
+}
+
+void CefBrowserImpl::CaptureImage(PaintElementType type,
+                                  const CefRect& srcRect,
+                                  int width, int height,
+                                  ImageEncoding encoding, int quality,
+                                  CefRefPtr<CefImageCaptureCallback> callback)
+{
+  DCHECK(callback.get());
+  if (!callback.get())
+    return;
+
+  // Always post the capture task so that the canvas is copied between paints.
+  CefThread::PostTask(CefThread::UI, FROM_HERE, NewRunnableMethod(this,
+      &CefBrowserImpl::UIT_CaptureImage, type, srcRect, width, height,
+      encoding, quality, callback));
+}
+
+bool CefBrowserImpl::CapturePage(int tileHeight,
+                                 CefRefPtr<CefPageCaptureHandler> handler)
+{
+  if (!CefThread::CurrentlyOn(CefThread::UI)) {
+    NOTREACHED();
+    return false;
+  }
+
+  DCHECK(handler.get());
+  WebViewHost* host = UIT_GetWebViewHost();
+  if (!host || !handler.get())
+    return false;
+
+  return ImageCapture::CapturePage(this, host, tileHeight, GetPixelFormat(),
+                                   handler);
+}
+
+bool CefBrowserImpl::CapturePageToStream(int tileHeight,
+                                         CefRefPtr<CefStreamWriter> stream)
+{
+  DCHECK(stream.get());
+  if (!stream.get())
+    return false;
+
+  return CapturePage(tileHeight,
+                     ImageCapture::CreateStreamCaptureHandler(stream));
+}
+
 void CefBrowserImpl::SendKeyEvent(KeyType type, int key, int modifiers,
                                   bool sysChar, bool imeChar)
 {
-  // Intentially post event tasks in all cases so that painting tasks can be
-  // handled at sane times.
-  CefThread::PostTask(CefThread::UI, FROM_HERE, NewRunnableMethod(this,
-      &CefBrowserImpl::UIT_SendKeyEvent, type, key, modifiers, sysChar,
-      imeChar));
+  cef_input_event_t event = {IET_KEY};
+  event.key_type = type;
+  event.key = key;
+  event.modifiers = modifiers;
+  event.sys_char = sysChar;
+  event.ime_char = imeChar;
+  QueueInputEvents(&event, 1);
 }
 
 void CefBrowserImpl::SendMouseClickEvent(int x, int y, MouseButtonType type,
                                          bool mouseUp, int clickCount)
 {
-  // Intentially post event tasks in all cases so that painting tasks can be
-  // handled at sane times.
-  CefThread::PostTask(CefThread::UI, FROM_HERE, NewRunnableMethod(this,
-      &CefBrowserImpl::UIT_SendMouseClickEvent, x, y, type, mouseUp,
-      clickCount));
+  cef_input_event_t event = {IET_MOUSE_CLICK};
+  event.x = x;
+  event.y = y;
+  event.button_type = type;
+  event.mouse_up = mouseUp;
+  event.click_count = clickCount;
+  QueueInputEvents(&event, 1);
 }
 
 void CefBrowserImpl::SendMouseMoveEvent(int x, int y, bool mouseLeave)
 {
-  // Intentially post event tasks in all cases so that painting tasks can be
-  // handled at sane times.
-  CefThread::PostTask(CefThread::UI, FROM_HERE, NewRunnableMethod(this,
-      &CefBrowserImpl::UIT_SendMouseMoveEvent, x, y, mouseLeave));
+  cef_input_event_t event = {IET_MOUSE_MOVE};
+  event.x = x;
+  event.y = y;
+  event.mouse_leave = mouseLeave;
+  QueueInputEvents(&event, 1);
 }
 
 void CefBrowserImpl::SendMouseWheelEvent(int x, int y, int delta)
 {
-  // Intentially post event tasks in all cases so that painting tasks can be
-  // handled at sane times.
-  CefThread::PostTask(CefThread::UI, FROM_HERE, NewRunnableMethod(this,
-      &CefBrowserImpl::UIT_SendMouseWheelEvent, x, y, delta));
+  cef_input_event_t event = {IET_MOUSE_WHEEL};
+  event.x = x;
+  event.y = y;
+  event.delta = delta;
+  QueueInputEvents(&event, 1);
 }
 
 void CefBrowserImpl::SendFocusEvent(bool setFocus)
 {
-  // Intentially post event tasks in all cases so that painting tasks can be
-  // handled at sane times.
-  CefThread::PostTask(CefThread::UI, FROM_HERE, NewRunnableMethod(this,
-      &CefBrowserImpl::UIT_SendFocusEvent, setFocus));
+  cef_input_event_t event = {IET_FOCUS};
+  event.set_focus = setFocus;
+  QueueInputEvents(&event, 1);
 }
 
 void CefBrowserImpl::SendCaptureLostEvent()
 {
-  // Intentially post event tasks in all cases so that painting tasks can be
-  // handled at sane times.
-  CefThread::PostTask(CefThread::UI, FROM_HERE, NewRunnableMethod(this,
-      &CefBrowserImpl::UIT_SendCaptureLostEvent));
+  cef_input_event_t event = {IET_CAPTURE_LOST};
+  QueueInputEvents(&event, 1);
+}
+
+void CefBrowserImpl::SendInputEvents(const std::vector<CefInputEvent>& events)
+{
+  if (events.empty())
+    return;
+
+  std::vector<cef_input_event_t> eventList(events.begin(), events.end());
+  QueueInputEvents(&eventList[0], eventList.size());
 }
 
 void CefBrowserImpl::Undo(CefRefPtr<CefFrame> frame)
@@ -740,6 +875,79 @@ void CefBrowserImpl::UIT_CloseBrowser()
   }
 }
 
+void CefBrowserImpl::UIT_AdoptFromPool(CefRefPtr<CefClient> client,
+                                       const CefString& url)
+{
+  REQUIRE_UIT();
+  DCHECK(!client_.get());
+
+  WebView* view = UIT_GetWebView();
+  if (view)
+    view->mainFrame()->stopLoading();
+
+  // Discard the about:blank entry added by UIT_ScrubForPool().
+  nav_controller_->Reset();
+  set_nav_state(false, false);
+
+  Lock();
+  client_ = client;
+  Unlock();
+
+  if (client.get()) {
+    CefRefPtr<CefLifeSpanHandler> handler = client->GetLifeSpanHandler();
+    if (handler.get())
+      handler->OnAfterCreated(this);
+  }
+
+  UIT_WasHidden(false);
+
+  if (!url.empty())
+    UIT_LoadURL(GetMainFrame(), url);
+}
+
+void CefBrowserImpl::UIT_ScrubForPool()
+{
+  REQUIRE_UIT();
+
+  if (client_.get()) {
+    CefRefPtr<CefLifeSpanHandler> handler = client_->GetLifeSpanHandler();
+    if (handler.get()) {
+      // Notify the handler that the browser is no longer available to it.
+      handler->OnBeforeClose(this);
+    }
+  }
+
+  Lock();
+  client_ = NULL;
+  Unlock();
+
+  // Hiding the browser also closes any popup widget.
+  UIT_WasHidden(true);
+  UIT_CloseDevTools();
+  UIT_StopFinding(true);
+
+  WebView* view = UIT_GetWebView();
+  if (view) {
+    view->mainFrame()->stopLoading();
+    // Don't use UIT_SetZoomLevel() because it would also change the zoom
+    // level remembered for the current URL.
+    view->setZoomLevel(false, 0.0);
+  }
+  set_zoom_level(0.0);
+
+  nav_controller_->Reset();
+  set_nav_state(false, false);
+  UIT_SetTitle(CefString());
+
+  // Release the sessionStorage namespace so that the next client starts with
+  // empty sessionStorage.
+  if (view)
+    webkit_glue::ResetSessionStorage(view);
+
+  // Unload the current document so that scripts, plugins and media stop.
+  UIT_LoadURL(GetMainFrame(), "about:blank");
+}
+
 void CefBrowserImpl::UIT_LoadURL(CefRefPtr<CefFrame> frame,
                                  const CefString& url)
 {
@@ -883,6 +1091,7 @@ bool CefBrowserImpl::UIT_Navigate(const BrowserNavigationEntry& entry,
                                   bool ignoreCache)
 {
   REQUIRE_UIT();
+  CEF_TRACE_EVENT0("cef", "CefBrowserImpl::UIT_Navigate");
 
   WebView* view = UIT_GetWebView();
   if (!view)
@@ -992,6 +1201,104 @@ void CefBrowserImpl::UIT_Invalidate(const CefRect& dirtyRect)
   }
 }
 
+void CefBrowserImpl::UIT_SetPixelFormat(PixelFormat format)
+{
+  REQUIRE_UIT();
+  WebViewHost* host = UIT_GetWebViewHost();
+  if (host)
+    host->SetPixelFormat(format);
+  if (popuphost_)
+    popuphost_->SetPixelFormat(format);
+}
+
+void CefBrowserImpl::UIT_WasHidden(bool hidden)
+{
+  REQUIRE_UIT();
+
+  // Hide the popup along with the browser.
+  if (hidden && popuphost_)
+    UIT_ClosePopupWidget();
+
+  WebViewHost* host = UIT_GetWebViewHost();
+  if (!host)
+    return;
+
+  host->SetHidden(hidden);
+
+  WebView* view = UIT_GetWebView();
+  if (view) {
+    view->settings()->setMinimumTimerInterval(
+        hidden ? kHiddenTimerInterval : kVisibleTimerInterval);
+    view->setVisibilityState(hidden ? WebKit::WebPageVisibilityStateHidden :
+                                      WebKit::WebPageVisibilityStateVisible,
+                             false);
+  }
+}
+
+void CefBrowserImpl::UIT_CaptureImage(PaintElementType type,
+    const CefRect& srcRect, int width, int height, ImageEncoding encoding,
+    int quality, CefRefPtr<CefImageCaptureCallback> callback)
+{
+  REQUIRE_UIT();
+
+  WebWidgetHost* host = NULL;
+  if (type == PET_VIEW)
+    host = UIT_GetWebViewHost();
+  else if (type == PET_POPUP)
+    host = popuphost_;
+
+  // Only the copy happens on the UI thread. Scaling and encoding happen on the
+  // worker pool so that they don't compete with rendering.
+  SkBitmap bitmap;
+  if (host) {
+    bitmap = ImageCapture::CopyCanvas(host->canvas(),
+        gfx::Rect(srcRect.x, srcRect.y, srcRect.width, srcRect.height));
+  }
+  ImageCapture::PostEncodeTask(this, bitmap, width, height, encoding, quality,
+                               callback);
+}
+
+void CefBrowserImpl::UIT_DispatchInputEvents()
+{
+  REQUIRE_UIT();
+
+  std::vector<cef_input_event_t> events;
+  {
+    AutoLock lock_scope(this);
+    events.swap(pending_input_events_);
+  }
+
+  std::vector<cef_input_event_t>::const_iterator it = events.begin();
+  for (; it != events.end(); ++it) {
+    const cef_input_event_t& event = *it;
+    switch (event.type) {
+      case IET_KEY:
+        UIT_SendKeyEvent(event.key_type, event.key, event.modifiers,
+                         event.sys_char, event.ime_char);
+        break;
+      case IET_MOUSE_CLICK:
+        UIT_SendMouseClickEvent(event.x, event.y, event.button_type,
+                                event.mouse_up, event.click_count);
+        break;
+      case IET_MOUSE_MOVE:
+        UIT_SendMouseMoveEvent(event.x, event.y, event.mouse_leave);
+        break;
+      case IET_MOUSE_WHEEL:
+        UIT_SendMouseWheelEvent(event.x, event.y, event.delta);
+        break;
+      case IET_FOCUS:
+        UIT_SendFocusEvent(event.set_focus);
+        break;
+      case IET_CAPTURE_LOST:
+        UIT_SendCaptureLostEvent();
+        break;
+      default:
+        NOTREACHED() << "invalid input event type";
+        break;
+    }
+  }
+}
+
 void CefBrowserImpl::UIT_SendKeyEvent(KeyType type, int key, int modifiers,
                                       bool sysChar, bool imeChar)
 {
@@ -1105,7 +1412,8 @@ CefRefPtr<CefBrowserImpl> CefBrowserImpl::UIT_CreatePopupWindow(
   // Modal windows need to know which window is being suspended (the opener)
   // so that it can be disabled while the modal window is open. 
   CefRefPtr<CefBrowserImpl> browser(
-      new CefBrowserImpl(info, settings, UIT_GetMainWndHandle(), client));
+      new CefBrowserImpl(info, settings, UIT_GetMainWndHandle(), client,
+                         request_context_));
 
   // Don't pass the URL to UIT_CreateBrowser for popup windows or the URL will
   // be loaded twice.
@@ -1123,6 +1431,7 @@ WebKit::WebWidget* CefBrowserImpl::UIT_CreatePopupWidget()
       (IsWindowRenderingDisabled()?NULL:UIT_GetMainWndHandle()),
       popup_delegate_.get(), paint_delegate_.get());
   popuphost_->set_popup(true);
+  popuphost_->SetPixelFormat(GetPixelFormat());
 
   return popuphost_->webwidget();
 }
@@ -1549,6 +1858,44 @@ bool CefBrowserImpl::has_document()
   return has_document_;
 }
 
+void CefBrowserImpl::QueueInputEvents(const cef_input_event_t* events,
+                                      size_t count)
+{
+  bool post_task;
+  {
+    AutoLock lock_scope(this);
+    post_task = pending_input_events_.empty();
+
+    for (size_t i = 0; i < count; ++i) {
+      const cef_input_event_t& event = events[i];
+      if (!pending_input_events_.empty()) {
+        cef_input_event_t& last = pending_input_events_.back();
+        if (event.type == IET_MOUSE_MOVE && last.type == IET_MOUSE_MOVE &&
+            !last.mouse_leave) {
+          // Only the most recent mouse position is dispatched.
+          last = event;
+          continue;
+        }
+        if (event.type == IET_MOUSE_WHEEL && last.type == IET_MOUSE_WHEEL) {
+          last.x = event.x;
+          last.y = event.y;
+          last.delta += event.delta;
+          continue;
+        }
+      }
+      pending_input_events_.push_back(event);
+    }
+  }
+
+  // Intentially post event tasks in all cases so that painting tasks can be
+  // handled at sane times. Events queued before the task runs are dispatched
+  // by the same task.
+  if (post_task) {
+    CefThread::PostTask(CefThread::UI, FROM_HERE, NewRunnableMethod(this,
+        &CefBrowserImpl::UIT_DispatchInputEvents));
+  }
+}
+
 void CefBrowserImpl::UIT_CreateDevToolsClient(BrowserDevToolsAgent *agent)
 {
   dev_tools_client_.reset(new BrowserDevToolsClient(this, agent));
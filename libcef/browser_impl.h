@@ -14,6 +14,7 @@
 #include "browser_webview_delegate.h"
 #include "browser_navigation_controller.h"
 #include "cef_thread.h"
+#include "request_context_impl.h"
 #include "tracker.h"
 #if defined(OS_WIN)
 #include "printing/win_printing_context.h"
@@ -52,7 +53,8 @@ public:
   CefBrowserImpl(const CefWindowInfo& windowInfo,
                  const CefBrowserSettings& settings,
                  gfx::NativeView opener,
-                 CefRefPtr<CefClient> client);
+                 CefRefPtr<CefClient> client,
+                 CefRefPtr<CefRequestContextImpl> request_context);
   virtual ~CefBrowserImpl() {}
 
 #if defined(OS_WIN)
@@ -77,7 +79,10 @@ public:
       { return opener_window(); }
   virtual bool IsPopup() OVERRIDE { return is_popup(); }
   virtual bool HasDocument() OVERRIDE { return has_document(); }
-  virtual CefRefPtr<CefClient> GetClient() OVERRIDE { return client_; }
+  virtual CefRefPtr<CefClient> GetClient() OVERRIDE {
+    AutoLock lock_scope(this);
+    return client_;
+  }
   virtual CefRefPtr<CefFrame> GetMainFrame() OVERRIDE
       { return GetMainCefFrame(); }
   virtual CefRefPtr<CefFrame> GetFocusedFrame() OVERRIDE;
@@ -98,6 +103,19 @@ public:
   virtual void Invalidate(const CefRect& dirtyRect) OVERRIDE;
   virtual bool GetImage(PaintElementType type, int width, int height,
                         void* buffer) OVERRIDE;
+  virtual void SetPixelFormat(PixelFormat format) OVERRIDE;
+  virtual PixelFormat GetPixelFormat() OVERRIDE;
+  virtual void WasHidden(bool hidden) OVERRIDE;
+  virtual bool IsHidden() OVERRIDE;
+  virtual void CaptureImage(PaintElementType type, const CefRect& srcRect,
+                            int width, int height, ImageEncoding encoding,
+                            int quality,
+                            CefRefPtr<CefImageCaptureCallback> callback)
+                            OVERRIDE;
+  virtual bool CapturePage(int tileHeight,
+                           CefRefPtr<CefPageCaptureHandler> handler) OVERRIDE;
+  virtual bool CapturePageToStream(int tileHeight,
+                                   CefRefPtr<CefStreamWriter> stream) OVERRIDE;
   virtual void SendKeyEvent(KeyType type, int key, int modifiers, bool sysChar,
                             bool imeChar) OVERRIDE;
   virtual void SendMouseClickEvent(int x, int y, MouseButtonType type,
@@ -106,6 +124,8 @@ public:
   virtual void SendMouseWheelEvent(int x, int y, int delta) OVERRIDE;
   virtual void SendFocusEvent(bool setFocus) OVERRIDE;
   virtual void SendCaptureLostEvent() OVERRIDE;
+  virtual void SendInputEvents(const std::vector<CefInputEvent>& events)
+      OVERRIDE;
 
   // Frame-related methods
   void Undo(CefRefPtr<CefFrame> frame);
@@ -230,6 +250,14 @@ public:
   // UIT_DestroyBrowser will be called after the native window has closed.
   void UIT_CloseBrowser();
 
+  // Attach |client| to an idle browser taken from a CefBrowserPool and load
+  // |url|. The browser history is cleared before |url| is loaded.
+  void UIT_AdoptFromPool(CefRefPtr<CefClient> client, const CefString& url);
+
+  // Detach the client and reset the page state so that the browser can be
+  // returned to a CefBrowserPool.
+  void UIT_ScrubForPool();
+
   void UIT_LoadURL(CefRefPtr<CefFrame> frame,
                    const CefString& url);
   void UIT_LoadURLForRequest(CefRefPtr<CefFrame> frame,
@@ -257,6 +285,12 @@ public:
   void UIT_SetFocus(WebWidgetHost* host, bool enable);
   void UIT_SetSize(PaintElementType type, int width, int height);
   void UIT_Invalidate(const CefRect& dirtyRect);
+  void UIT_SetPixelFormat(PixelFormat format);
+  void UIT_WasHidden(bool hidden);
+  void UIT_CaptureImage(PaintElementType type, const CefRect& srcRect,
+                        int width, int height, ImageEncoding encoding,
+                        int quality,
+                        CefRefPtr<CefImageCaptureCallback> callback);
   void UIT_SendKeyEvent(KeyType type, int key, int modifiers, bool sysChar,
                         bool imeChar);
   void UIT_SendMouseClickEvent(int x, int y, MouseButtonType type,
@@ -265,6 +299,7 @@ public:
   void UIT_SendMouseWheelEvent(int x, int y, int delta);
   void UIT_SendFocusEvent(bool setFocus);
   void UIT_SendCaptureLostEvent();
+  void UIT_DispatchInputEvents();
 
   CefRefPtr<CefBrowserImpl> UIT_CreatePopupWindow(const CefString& url,
       const CefPopupFeatures& features);
@@ -293,6 +328,12 @@ public:
   void UIT_SetUniqueID(int id) { unique_id_ = id; }
   int UIT_GetUniqueID() { return unique_id_; }
 
+  // Returns the request context used by this browser or NULL if the global
+  // request context is used. May be called on any thread.
+  CefRefPtr<CefRequestContextImpl> request_context() {
+    return request_context_;
+  }
+
   void UIT_Find(int identifier, const CefString& search_text,
                 const WebKit::WebFindOptions& options);
   void UIT_StopFinding(bool clear_selection);
@@ -348,6 +389,10 @@ protected:
   void UIT_CreateDevToolsClient(BrowserDevToolsAgent* agent);
   void UIT_DestroyDevToolsClient();
 
+  // Add input events to the pending queue and schedule dispatch on the UI
+  // thread if necessary.
+  void QueueInputEvents(const cef_input_event_t* events, size_t count);
+
 protected:
   CefWindowInfo window_info_;
   CefBrowserSettings settings_;
@@ -355,6 +400,7 @@ protected:
   gfx::NativeView opener_;
   bool is_modal_;
   CefRefPtr<CefClient> client_;
+  CefRefPtr<CefRequestContextImpl> request_context_;
   scoped_ptr<WebViewHost> webviewhost_;
   WebWidgetHost* popuphost_;
   gfx::Rect popup_rect_;
@@ -369,10 +415,16 @@ protected:
   CefString title_;
 
   double zoom_level_;
+  PixelFormat pixel_format_;
+  bool is_hidden_;
   bool can_go_back_;
   bool can_go_forward_;
   bool has_document_;
 
+  // Input events waiting to be dispatched on the UI thread. Consecutive mouse
+  // move and mouse wheel events are merged.
+  std::vector<cef_input_event_t> pending_input_events_;
+
 #if defined(OS_WIN)
   // Context object used to manage printing.
   printing::PrintingContext print_context_;
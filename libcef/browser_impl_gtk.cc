@@ -31,13 +31,13 @@ CefWindowHandle CefBrowserImpl::GetWindowHandle()
 
 bool CefBrowserImpl::IsWindowRenderingDisabled()
 {
-  // TODO(port): Add support for off-screen rendering.
-  return false;
+  return (window_info_.m_bWindowRenderingDisabled ? true : false);
 }
 
 gfx::NativeView CefBrowserImpl::UIT_GetMainWndHandle() {
   REQUIRE_UIT();
-  return window_info_.m_Widget;
+  return window_info_.m_bWindowRenderingDisabled ?
+      window_info_.m_ParentWidget : window_info_.m_Widget;
 }
 
 void CefBrowserImpl::UIT_CreateBrowser(const CefString& url)
@@ -57,7 +57,10 @@ void CefBrowserImpl::UIT_CreateBrowser(const CefString& url)
   GtkWidget *window;
   GtkWidget* parentView = window_info_.m_ParentWidget;
 
-  if(parentView == NULL)
+  if (window_info_.m_bWindowRenderingDisabled) {
+    // Create a new paint delegate. No widgets are created.
+    paint_delegate_.reset(new PaintDelegate(this));
+  } else if(parentView == NULL)
   {
 	  // Create a new window.
 	  window = gtk_window_new(GTK_WINDOW_TOPLEVEL);
@@ -73,13 +76,14 @@ void CefBrowserImpl::UIT_CreateBrowser(const CefString& url)
   }
 
   WebPreferences prefs;
-    BrowserToWebSettings(settings_, prefs);
+  BrowserToWebSettings(settings_, prefs);
 
-    // Create the webview host object
-    webviewhost_.reset(
-        WebViewHost::Create(window_info_.m_ParentWidget, gfx::Rect(),
-                            delegate_.get(), NULL, dev_tools_agent_.get(),
-                            prefs));
+  // Create the webview host object
+  webviewhost_.reset(
+      WebViewHost::Create(window_info_.m_ParentWidget, gfx::Rect(),
+                          delegate_.get(), paint_delegate_.get(),
+                          dev_tools_agent_.get(), prefs));
+  webviewhost_->SetPixelFormat(pixel_format_);
 
   if (!settings_.developer_tools_disabled)
     dev_tools_agent_->SetWebView(webviewhost_->webview());
@@ -106,6 +110,12 @@ void CefBrowserImpl::UIT_SetFocus(WebWidgetHost* host, bool enable)
   if (!host)
     return;
 
+  if (!host->view_handle()) {
+    // Window rendering is disabled.
+    host->SendFocusEvent(enable);
+    return;
+  }
+
   if(enable)
     gtk_widget_grab_focus(host->view_handle());
 }
@@ -173,6 +173,7 @@ void CefBrowserImpl::UIT_CreateBrowser(const CefString& url)
       WebViewHost::Create(window_info_.m_hWnd, gfx::Rect(), delegate_.get(),
                           paint_delegate_.get(), dev_tools_agent_.get(),
                           prefs));
+  webviewhost_->SetPixelFormat(pixel_format_);
 
   if (!settings_.developer_tools_disabled)
     dev_tools_agent_->SetWebView(webviewhost_->webview());
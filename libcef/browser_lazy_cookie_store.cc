@@ -0,0 +1,366 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "browser_lazy_cookie_store.h"
+#include "browser_persistent_cookie_store.h"
+#include "cef_thread.h"
+
+#include <set>
+
+#include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/stl_util.h"
+#include "googleurl/src/gurl.h"
+
+namespace {
+
+// Used when CefSettings.cookie_memory_limit is 0. The cookie monster
+// permanently deletes the least recently used cookies when it holds more than
+// 3300 so the limit plus kInsertChunkSize must stay below that.
+const size_t kMaxMemoryLimit = 3000;
+
+// Maximum number of cookies inserted into the cookie monster at once, unless
+// a single key has more.
+const size_t kInsertChunkSize = 256;
+
+}  // namespace
+
+BrowserLazyCookieStore::BrowserLazyCookieStore(
+    net::CookieMonster* cookie_monster,
+    BrowserPersistentCookieStore* persistent_store,
+    bool background_load,
+    int memory_limit)
+    : cookie_monster_(cookie_monster),
+      persistent_store_(persistent_store),
+      background_load_(background_load),
+      memory_limit_(kMaxMemoryLimit),
+      loaded_count_(0) {
+  if (memory_limit > 0 && static_cast<size_t>(memory_limit) < kMaxMemoryLimit)
+    memory_limit_ = memory_limit;
+
+  if (background_load_)
+    persistent_store_->StartBackgroundLoad();
+}
+
+BrowserLazyCookieStore::~BrowserLazyCookieStore() {
+}
+
+void BrowserLazyCookieStore::LoadCookiesForURL(const GURL& url) {
+  DCHECK(CefThread::CurrentlyOn(CefThread::IO));
+
+  TakeBackgroundCookies();
+
+  std::string key = BrowserPersistentCookieStore::GetCookieKey(url.host());
+  KeyMap::iterator it = loaded_keys_.find(key);
+  if (it != loaded_keys_.end()) {
+    lru_keys_.splice(lru_keys_.end(), lru_keys_, it->second.lru_position);
+    return;
+  }
+
+  LoadKeys(std::vector<std::string>(1, key), NULL);
+  EnforceMemoryLimit(0);
+}
+
+void BrowserLazyCookieStore::VisitAllCookies(Visitor* visitor) {
+  DCHECK(CefThread::CurrentlyOn(CefThread::IO));
+
+  TakeBackgroundCookies();
+
+  std::map<std::string, int> counts;
+  if (!persistent_store_->GetCookieCounts(&counts))
+    LOG(WARNING) << "Failed to read cookies from the cookie database";
+
+  net::CookieList in_memory = cookie_monster_->GetAllCookies();
+  int total = static_cast<int>(in_memory.size());
+  std::map<std::string, int>::iterator it = counts.begin();
+  while (it != counts.end()) {
+    if (loaded_keys_.find(it->first) == loaded_keys_.end()) {
+      total += it->second;
+      ++it;
+    } else {
+      counts.erase(it++);
+    }
+  }
+
+  if (!in_memory.empty() && !visitor->Visit(in_memory, total))
+    return;
+  in_memory.clear();
+
+  // Read as many keys at a time as are inserted into the cookie monster at
+  // once so that they all stay in memory while they are visited.
+  it = counts.begin();
+  while (it != counts.end()) {
+    std::vector<std::string> keys;
+    size_t count = 0;
+    do {
+      keys.push_back(it->first);
+      count += it->second;
+      ++it;
+    } while (it != counts.end() &&
+             count + static_cast<size_t>(it->second) <= kInsertChunkSize);
+
+    net::CookieList cookies;
+    LoadKeys(keys, &cookies);
+    if (!cookies.empty() && !visitor->Visit(cookies, total))
+      break;
+  }
+
+  EnforceMemoryLimit(0);
+}
+
+void BrowserLazyCookieStore::DeleteAllCookies() {
+  DCHECK(CefThread::CurrentlyOn(CefThread::IO));
+
+  // Cookies that were read in the background would be inserted again.
+  if (background_load_) {
+    persistent_store_->CancelBackgroundLoad();
+    background_load_ = false;
+  }
+  std::vector<net::CookieMonster::CanonicalCookie*> cookies;
+  persistent_store_->TakeBackgroundCookies(&cookies);
+  STLDeleteElements(&cookies);
+
+  // The database is cleared with a single statement instead of deleting the
+  // cookies in memory one at a time and reading the rest to delete them.
+  persistent_store_->set_suppress_writes(true);
+  cookie_monster_->DeleteAll(true);
+  persistent_store_->set_suppress_writes(false);
+  persistent_store_->DeleteAllCookies();
+
+  lru_keys_.clear();
+  loaded_keys_.clear();
+  loaded_count_ = 0;
+}
+
+void BrowserLazyCookieStore::ImportCookies(const net::CookieList& cookies) {
+  DCHECK(CefThread::CurrentlyOn(CefThread::IO));
+
+  TakeBackgroundCookies();
+
+  // Group the cookies by key so that each key is read from the database once.
+  CookiesByKey cookies_by_key;
+  for (net::CookieList::const_iterator it = cookies.begin();
+       it != cookies.end(); ++it) {
+    cookies_by_key[BrowserPersistentCookieStore::GetCookieKey(it->Domain())].
+        push_back(*it);
+  }
+
+  CookiesByKey::const_iterator it = cookies_by_key.begin();
+  while (it != cookies_by_key.end()) {
+    CookiesByKey::const_iterator chunk_end = it;
+    std::vector<std::string> keys;
+    size_t count = 0;
+    do {
+      if (loaded_keys_.find(chunk_end->first) == loaded_keys_.end())
+        keys.push_back(chunk_end->first);
+      count += chunk_end->second.size();
+      ++chunk_end;
+    } while (chunk_end != cookies_by_key.end() &&
+             count + chunk_end->second.size() <= kInsertChunkSize);
+
+    // Existing cookies must be in memory so that they are replaced.
+    if (!keys.empty())
+      LoadKeys(keys, NULL);
+
+    for (; it != chunk_end; ++it) {
+      // Reading or inserting other keys of the chunk may have released this
+      // one. Reading it makes it the most recently used key so it is not
+      // released before its cookies are inserted.
+      if (loaded_keys_.find(it->first) == loaded_keys_.end())
+        LoadKeys(std::vector<std::string>(1, it->first), NULL);
+      else
+        TouchKey(it->first, 0);
+
+      EnforceMemoryLimit(it->second.size());
+      cookie_monster_->InitializeFrom(it->second);
+      TouchKey(it->first, it->second.size());
+    }
+  }
+
+  EnforceMemoryLimit(0);
+}
+
+bool BrowserLazyCookieStore::SetCookieWithOptions(
+    const GURL& url,
+    const std::string& cookie_line,
+    const net::CookieOptions& options) {
+  LoadCookiesForURL(url);
+  return cookie_monster_->SetCookieWithOptions(url, cookie_line, options);
+}
+
+std::string BrowserLazyCookieStore::GetCookiesWithOptions(
+    const GURL& url,
+    const net::CookieOptions& options) {
+  LoadCookiesForURL(url);
+  return cookie_monster_->GetCookiesWithOptions(url, options);
+}
+
+void BrowserLazyCookieStore::GetCookiesWithInfo(
+    const GURL& url,
+    const net::CookieOptions& options,
+    std::string* cookie_line,
+    std::vector<CookieInfo>* cookie_infos) {
+  LoadCookiesForURL(url);
+  cookie_monster_->GetCookiesWithInfo(url, options, cookie_line, cookie_infos);
+}
+
+void BrowserLazyCookieStore::DeleteCookie(const GURL& url,
+                                          const std::string& cookie_name) {
+  LoadCookiesForURL(url);
+  cookie_monster_->DeleteCookie(url, cookie_name);
+}
+
+net::CookieMonster* BrowserLazyCookieStore::GetCookieMonster() {
+  return cookie_monster_;
+}
+
+void BrowserLazyCookieStore::LoadKeys(const std::vector<std::string>& keys,
+                                      net::CookieList* cookies) {
+  std::vector<net::CookieMonster::CanonicalCookie*> read_cookies;
+  if (!persistent_store_->LoadCookiesForKeys(keys, &read_cookies))
+    LOG(WARNING) << "Failed to read cookies from the cookie database";
+
+  CookiesByKey cookies_by_key;
+  GroupCookies(&read_cookies, &cookies_by_key);
+
+  // Keys without cookies are still considered to be in memory. Keys with
+  // cookies are only marked when their cookies are inserted.
+  for (size_t i = 0; i < keys.size(); ++i) {
+    if (cookies_by_key.find(keys[i]) == cookies_by_key.end() &&
+        loaded_keys_.find(keys[i]) == loaded_keys_.end()) {
+      TouchKey(keys[i], 0);
+    }
+  }
+
+  InsertCookies(cookies_by_key, cookies);
+}
+
+void BrowserLazyCookieStore::GroupCookies(
+    std::vector<net::CookieMonster::CanonicalCookie*>* cookies,
+    CookiesByKey* cookies_by_key) {
+  base::Time now = base::Time::Now();
+  for (size_t i = 0; i < cookies->size(); ++i) {
+    scoped_ptr<net::CookieMonster::CanonicalCookie> cc((*cookies)[i]);
+    if (cc->IsExpired(now))
+      continue;
+    std::string key = BrowserPersistentCookieStore::GetCookieKey(cc->Domain());
+    if (loaded_keys_.find(key) != loaded_keys_.end())
+      continue;
+    (*cookies_by_key)[key].push_back(*cc);
+  }
+  cookies->clear();
+}
+
+void BrowserLazyCookieStore::InsertCookies(const CookiesByKey& cookies_by_key,
+                                           net::CookieList* inserted) {
+  CookiesByKey::const_iterator it = cookies_by_key.begin();
+  while (it != cookies_by_key.end()) {
+    CookiesByKey::const_iterator chunk_begin = it;
+    net::CookieList chunk;
+    do {
+      chunk.insert(chunk.end(), it->second.begin(), it->second.end());
+      ++it;
+    } while (it != cookies_by_key.end() &&
+             chunk.size() + it->second.size() <= kInsertChunkSize);
+
+    // Release other keys first. If the cookie monster garbage collected the
+    // cookies instead they would be removed from memory without their key
+    // being released, and writes are suppressed so they would stay in the
+    // database without ever being read again.
+    EnforceMemoryLimit(chunk.size());
+
+    // The cookies are already in the database.
+    persistent_store_->set_suppress_writes(true);
+    cookie_monster_->InitializeFrom(chunk);
+    persistent_store_->set_suppress_writes(false);
+
+    for (CookiesByKey::const_iterator key = chunk_begin; key != it; ++key)
+      TouchKey(key->first, key->second.size());
+
+    if (inserted)
+      inserted->insert(inserted->end(), chunk.begin(), chunk.end());
+  }
+}
+
+void BrowserLazyCookieStore::TakeBackgroundCookies() {
+  if (!background_load_)
+    return;
+
+  std::vector<net::CookieMonster::CanonicalCookie*> cookies;
+  persistent_store_->TakeBackgroundCookies(&cookies);
+  if (cookies.empty())
+    return;
+
+  CookiesByKey cookies_by_key;
+  GroupCookies(&cookies, &cookies_by_key);
+  InsertCookies(cookies_by_key, NULL);
+}
+
+void BrowserLazyCookieStore::TouchKey(const std::string& key, size_t count) {
+  KeyMap::iterator it = loaded_keys_.find(key);
+  if (it != loaded_keys_.end()) {
+    lru_keys_.splice(lru_keys_.end(), lru_keys_, it->second.lru_position);
+    it->second.count += count;
+  } else {
+    KeyInfo& info = loaded_keys_[key];
+    info.lru_position = lru_keys_.insert(lru_keys_.end(), key);
+    info.count = count;
+  }
+  loaded_count_ += count;
+}
+
+void BrowserLazyCookieStore::EnforceMemoryLimit(size_t reserve) {
+  if (loaded_count_ + reserve <= memory_limit_)
+    return;
+
+  // Stop reading cookies that would only be released again. Cookies that were
+  // already read in the background are freed when the store is closed.
+  if (background_load_) {
+    persistent_store_->CancelBackgroundLoad();
+    background_load_ = false;
+  }
+
+  // The counts drift as cookies are set and expire so recount them.
+  net::CookieList all_cookies = cookie_monster_->GetAllCookies();
+  std::vector<std::string> cookie_keys(all_cookies.size());
+  std::map<std::string, size_t> counts;
+  for (size_t i = 0; i < all_cookies.size(); ++i) {
+    cookie_keys[i] =
+        BrowserPersistentCookieStore::GetCookieKey(all_cookies[i].Domain());
+    counts[cookie_keys[i]]++;
+  }
+
+  loaded_count_ = all_cookies.size();
+  for (KeyMap::iterator it = loaded_keys_.begin(); it != loaded_keys_.end();
+       ++it) {
+    std::map<std::string, size_t>::const_iterator count =
+        counts.find(it->first);
+    it->second.count = (count != counts.end() ? count->second : 0);
+  }
+
+  // Release down to 90% of the limit so that the next read does not
+  // immediately exceed it again. The most recently used key is always kept.
+  const size_t target = memory_limit_ - memory_limit_ / 10;
+  std::set<std::string> released_keys;
+  while (loaded_count_ + reserve > target && lru_keys_.size() > 1) {
+    KeyMap::iterator it = loaded_keys_.find(lru_keys_.front());
+    DCHECK(it != loaded_keys_.end());
+    loaded_count_ -= it->second.count;
+    released_keys.insert(it->first);
+    loaded_keys_.erase(it);
+    lru_keys_.pop_front();
+  }
+
+  if (released_keys.empty())
+    return;
+
+  // Pending changes to the released cookies are committed before they are
+  // read again.
+  persistent_store_->set_suppress_writes(true);
+  for (size_t i = 0; i < all_cookies.size(); ++i) {
+    if (released_keys.find(cookie_keys[i]) != released_keys.end())
+      cookie_monster_->DeleteCanonicalCookie(all_cookies[i]);
+  }
+  persistent_store_->set_suppress_writes(false);
+}
@@ -0,0 +1,143 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#ifndef _BROWSER_LAZY_COOKIE_STORE_H
+#define _BROWSER_LAZY_COOKIE_STORE_H
+#pragma once
+
+#include <list>
+#include <map>
+#include <string>
+#include <vector>
+
+#include "base/compiler_specific.h"
+#include "base/memory/ref_counted.h"
+#include "net/base/cookie_monster.h"
+#include "net/base/cookie_store.h"
+
+class BrowserPersistentCookieStore;
+
+// A cookie store that reads persistent cookies into the cookie monster one
+// key (see BrowserPersistentCookieStore::GetCookieKey) at a time, the first
+// time cookies for the key are accessed. When more than |memory_limit|
+// cookies are in memory the cookies for the least recently used keys are
+// released without removing them from the database.
+//
+// Cookies are inserted one or more whole keys at a time and other keys are
+// released first if needed, so the cookie monster never holds enough cookies to
+// garbage collect them itself.
+//
+// Code that uses the cookie monster directly must first call
+// LoadCookiesForURL() or use VisitAllCookies(). All methods must be called on
+// the IO thread.
+class BrowserLazyCookieStore : public net::CookieStore {
+ public:
+  // Receives the cookies from VisitAllCookies().
+  class Visitor {
+   public:
+    // |cookies| stay in memory until this method returns so they may be
+    // deleted from the cookie monster. |total| is the number of cookies that
+    // will be visited. Return false to stop visiting.
+    virtual bool Visit(const net::CookieList& cookies, int total) = 0;
+
+   protected:
+    virtual ~Visitor() {}
+  };
+
+  BrowserLazyCookieStore(net::CookieMonster* cookie_monster,
+                         BrowserPersistentCookieStore* persistent_store,
+                         bool background_load,
+                         int memory_limit);
+
+  // Read the cookies for |url| if they are not already in memory.
+  void LoadCookiesForURL(const GURL& url);
+
+  // Visit all cookies. The cookies that are already in memory are visited
+  // first. The rest are read from the database and visited a few keys at a
+  // time while the memory limit is enforced.
+  void VisitAllCookies(Visitor* visitor);
+
+  // Delete all cookies from the cookie monster and the database.
+  void DeleteAllCookies();
+
+  // Insert |cookies| into the cookie monster and the database. The cookies are
+  // inserted one key at a time and the memory limit is enforced in between so
+  // that any number of cookies can be imported.
+  void ImportCookies(const net::CookieList& cookies);
+
+  // net::CookieStore methods.
+  virtual bool SetCookieWithOptions(const GURL& url,
+                                    const std::string& cookie_line,
+                                    const net::CookieOptions& options) OVERRIDE;
+  virtual std::string GetCookiesWithOptions(
+      const GURL& url,
+      const net::CookieOptions& options) OVERRIDE;
+  virtual void GetCookiesWithInfo(const GURL& url,
+                                  const net::CookieOptions& options,
+                                  std::string* cookie_line,
+                                  std::vector<CookieInfo>* cookie_infos)
+                                  OVERRIDE;
+  virtual void DeleteCookie(const GURL& url,
+                            const std::string& cookie_name) OVERRIDE;
+  virtual net::CookieMonster* GetCookieMonster() OVERRIDE;
+
+ private:
+  virtual ~BrowserLazyCookieStore();
+
+  typedef std::map<std::string, net::CookieList> CookiesByKey;
+
+  // Read |keys| from the database and insert the cookies. If |cookies| is
+  // non-NULL the inserted cookies are appended to it.
+  void LoadKeys(const std::vector<std::string>& keys,
+                net::CookieList* cookies);
+
+  // Group cookies read from the database by key. Expired cookies and cookies
+  // for keys that are already in memory are discarded. Takes ownership of the
+  // cookies.
+  void GroupCookies(
+      std::vector<net::CookieMonster::CanonicalCookie*>* cookies,
+      CookiesByKey* cookies_by_key);
+
+  // Insert cookies that are already in the database into the cookie monster.
+  // If |inserted| is non-NULL the cookies are appended to it.
+  void InsertCookies(const CookiesByKey& cookies_by_key,
+                     net::CookieList* inserted);
+
+  // Insert the cookies that have been read in the background.
+  void TakeBackgroundCookies();
+
+  // Mark |key| as in memory and most recently used and add |count| cookies to
+  // it.
+  void TouchKey(const std::string& key, size_t count);
+
+  // Release the cookies for the least recently used keys if the limit is
+  // exceeded, or would be exceeded by inserting |reserve| more cookies. The
+  // most recently used key is never released.
+  void EnforceMemoryLimit(size_t reserve);
+
+  scoped_refptr<net::CookieMonster> cookie_monster_;
+  scoped_refptr<BrowserPersistentCookieStore> persistent_store_;
+  bool background_load_;
+  size_t memory_limit_;
+
+  // Keys in memory ordered from least to most recently used.
+  typedef std::list<std::string> KeyList;
+  KeyList lru_keys_;
+
+  struct KeyInfo {
+    KeyList::iterator lru_position;
+    // Number of cookies when the key was read. Updated when the limit is
+    // enforced.
+    size_t count;
+  };
+  typedef std::map<std::string, KeyInfo> KeyMap;
+  KeyMap loaded_keys_;
+
+  // Approximate number of cookies in memory.
+  size_t loaded_count_;
+
+  DISALLOW_COPY_AND_ASSIGN(BrowserLazyCookieStore);
+};
+
+#endif  // _BROWSER_LAZY_COOKIE_STORE_H
@@ -5,15 +5,24 @@
 
 #include "browser_persistent_cookie_store.h"
 
+#include <algorithm>
+#include <deque>
 #include <list>
+#include <map>
+#include <set>
 
 #include "cef_thread.h"
+#include "cef_trace.h"
 #include "sql/meta_table.h"
 #include "sql/statement.h"
 #include "sql/transaction.h"
 #include "base/file_path.h"
 #include "base/file_util.h"
+#include "base/stl_util.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/time.h"
 #include "googleurl/src/gurl.h"
+#include "net/base/registry_controlled_domain.h"
 
 using base::Time;
 
@@ -22,16 +31,33 @@ using base::Time;
 class BrowserPersistentCookieStore::Backend
     : public base::RefCountedThreadSafe<BrowserPersistentCookieStore::Backend> {
  public:
-  explicit Backend(const FilePath& path)
+  Backend(const FilePath& path, const Options& options)
       : path_(path),
+        options_(options),
         db_(NULL),
         num_pending_(0),
-        clear_local_state_on_exit_(false) {
+        delete_all_pending_(false),
+        clear_local_state_on_exit_(false),
+        batch_depth_(0),
+        key_index_loaded_(false),
+        background_load_id_(0) {
+    memset(&stats_, 0, sizeof(stats_));
   }
 
   // Creates or load the SQLite database.
   bool Load(std::vector<net::CookieMonster::CanonicalCookie*>* cookies);
 
+  // Lazy loading. See the BrowserPersistentCookieStore methods.
+  bool LoadCookiesForKeys(
+      const std::vector<std::string>& keys,
+      std::vector<net::CookieMonster::CanonicalCookie*>* cookies);
+  bool GetCookieCounts(std::map<std::string, int>* counts);
+  void DeleteAllCookies();
+  void StartBackgroundLoad();
+  void CancelBackgroundLoad();
+  void TakeBackgroundCookies(
+      std::vector<net::CookieMonster::CanonicalCookie*>* cookies);
+
   // Batch a cookie addition.
   void AddCookie(const net::CookieMonster::CanonicalCookie& cc);
 
@@ -44,12 +70,18 @@ class BrowserPersistentCookieStore::Backend
   // Commit pending operations as soon as possible.
   void Flush(Task* completion_task);
 
+  // Defer commits until the outermost EndBatch().
+  void BeginBatch();
+  void EndBatch();
+
   // Commit any pending operations and close the database.  This must be called
   // before the object is destructed.
   void Close();
 
   void SetClearLocalStateOnExit(bool clear_local_state);
 
+  void GetStats(cef_cookie_store_stats_t* stats);
+
  private:
   friend class base::RefCountedThreadSafe<BrowserPersistentCookieStore::Backend>;
 
@@ -59,9 +91,47 @@ class BrowserPersistentCookieStore::Backend
     DCHECK(num_pending_ == 0 && pending_.empty());
   }
 
+  // Open the database and create the cookies table if necessary.
+  bool OpenDatabase();
+
   // Database upgrade statements.
   bool EnsureDatabaseVersion();
 
+  // A blocking read of the cookies for |keys| or of the number of cookies for
+  // each key. Lives on the stack of the thread that is waiting for it.
+  struct LoadRequest {
+    LoadRequest(const std::vector<std::string>& keys,
+                std::vector<net::CookieMonster::CanonicalCookie*>* cookies,
+                std::map<std::string, int>* counts)
+        : keys(keys), cookies(cookies), counts(counts), result(false),
+          event(false, false) {}
+
+    const std::vector<std::string>& keys;
+    std::vector<net::CookieMonster::CanonicalCookie*>* cookies;
+    std::map<std::string, int>* counts;
+    bool result;
+    base::WaitableEvent event;
+  };
+
+  // Queue |request| for the FILE thread and wait for it to be served.
+  bool ServeLoadRequest(LoadRequest* request);
+
+  // Open the database and read the key for each host in it. Only the first
+  // call does any work. Returns false if the database could not be opened.
+  bool EnsureKeyIndex();
+  // Read the cookies for |key| from the database.
+  bool ReadCookiesForKey(
+      const std::string& key,
+      std::vector<net::CookieMonster::CanonicalCookie*>* cookies);
+  // Count the unexpired cookies in the database for each key.
+  bool ReadCookieCounts(std::map<std::string, int>* counts);
+  // Serve all pending blocking reads on the FILE thread.
+  void ProcessLoadRequests();
+  // Queue all keys for background reads on the FILE thread.
+  void QueueBackgroundKeys();
+  // Read the cookies for the next background key on the FILE thread.
+  void LoadNextBackgroundKey();
+
   class PendingOperation {
    public:
     typedef enum {
@@ -86,21 +156,46 @@ class BrowserPersistentCookieStore::Backend
   // Batch a cookie operation (add or delete)
   void BatchOperation(PendingOperation::OperationType op,
                       const net::CookieMonster::CanonicalCookie& cc);
-  // Commit our pending operations to the database.
+  // Commit our pending operations to the database. Does nothing during a
+  // batch unless |ignore_batch| is true.
   void Commit();
+  void InternalCommit(bool ignore_batch);
   // Close() executed on the background thread.
   void InternalBackgroundClose();
 
   FilePath path_;
+  Options options_;
   scoped_ptr<sql::Connection> db_;
   sql::MetaTable meta_table_;
 
   typedef std::list<PendingOperation*> PendingOperationsList;
   PendingOperationsList pending_;
   PendingOperationsList::size_type num_pending_;
+  // True if all cookies are deleted before |pending_| is committed.
+  bool delete_all_pending_;
   // True if the persistent store should be deleted upon destruction.
   bool clear_local_state_on_exit_;
-  // Guard |pending_|, |num_pending_| and |clear_local_state_on_exit_|.
+  // Number of BeginBatch() calls without a matching EndBatch().
+  int batch_depth_;
+
+  // Lazy loading state. Maps each key to the host_key values in the database
+  // that belong to it.
+  typedef std::map<std::string, std::set<std::string> > KeyIndex;
+  KeyIndex key_index_;
+  bool key_index_loaded_;
+  // Blocking reads, which are served before |background_keys_|.
+  std::deque<LoadRequest*> load_requests_;
+  std::deque<std::string> background_keys_;
+  std::vector<net::CookieMonster::CanonicalCookie*> background_cookies_;
+  // Incremented when the background load is cancelled so that a read that is
+  // in progress is discarded.
+  int background_load_id_;
+
+  // |num_pending_| is tracked in |stats_| when it is retrieved.
+  cef_cookie_store_stats_t stats_;
+
+  // Guard |pending_|, |num_pending_|, |clear_local_state_on_exit_|,
+  // |batch_depth_|, |stats_| and the lazy loading state.
   base::Lock lock_;
 
   DISALLOW_COPY_AND_ASSIGN(Backend);
@@ -139,16 +234,39 @@ bool InitTable(sql::Connection* db) {
   // Try to create the index every time. Older versions did not have this index,
   // so we want those people to get it. Ignore errors, since it may exist.
   db->Execute("CREATE INDEX cookie_times ON cookies (creation_utc)");
+  // Used to read the cookies for a single domain when loading lazily.
+  db->Execute("CREATE INDEX domain ON cookies (host_key)");
   return true;
 }
 
-}  // namespace
+// Create a cookie from a row selected with the columns in the order used by
+// the SELECT statements below.
+net::CookieMonster::CanonicalCookie* CookieFromStatement(
+    const sql::Statement& smt) {
+  net::CookieMonster::CanonicalCookie* cc =
+      new net::CookieMonster::CanonicalCookie(
+          // The "source" URL is not used with persisted cookies.
+          GURL(),                                         // Source
+          smt.ColumnString(2),                            // name
+          smt.ColumnString(3),                            // value
+          smt.ColumnString(1),                            // domain
+          smt.ColumnString(4),                            // path
+          std::string(),  // TODO(abarth): Persist mac_key
+          std::string(),  // TODO(abarth): Persist mac_algorithm
+          Time::FromInternalValue(smt.ColumnInt64(0)),    // creation_utc
+          Time::FromInternalValue(smt.ColumnInt64(5)),    // expires_utc
+          Time::FromInternalValue(smt.ColumnInt64(8)),    // last_access_utc
+          smt.ColumnInt(6) != 0,                          // secure
+          smt.ColumnInt(7) != 0,                          // httponly
+          true);                                          // has_
+  DLOG_IF(WARNING,
+          cc->CreationDate() > Time::Now()) << L"CreationDate too recent";
+  return cc;
+}
 
-bool BrowserPersistentCookieStore::Backend::Load(
-    std::vector<net::CookieMonster::CanonicalCookie*>* cookies) {
-  // This function should be called only once per instance.
-  DCHECK(!db_.get());
+}  // namespace
 
+bool BrowserPersistentCookieStore::Backend::OpenDatabase() {
   db_.reset(new sql::Connection);
   if (!db_->Open(path_)) {
     NOTREACHED() << "Unable to open cookie DB.";
@@ -158,12 +276,36 @@ bool BrowserPersistentCookieStore::Backend::Load(
 
   //db_->set_error_delegate(GetErrorHandlerForCookieDb());
 
+  // The journal mode must be set before any statements are executed. WAL mode
+  // persists in the database file. Older SQLite versions ignore the pragma.
+  if (options_.journal_mode == COOKIE_JOURNAL_WAL)
+    db_->Execute("PRAGMA journal_mode=WAL");
+  if (options_.sync_mode == COOKIE_SYNC_NORMAL)
+    db_->Execute("PRAGMA synchronous=NORMAL");
+  else if (options_.sync_mode == COOKIE_SYNC_OFF)
+    db_->Execute("PRAGMA synchronous=OFF");
+
   if (!EnsureDatabaseVersion() || !InitTable(db_.get())) {
     NOTREACHED() << "Unable to open cookie DB.";
     db_.reset();
     return false;
   }
 
+  return true;
+}
+
+bool BrowserPersistentCookieStore::Backend::Load(
+    std::vector<net::CookieMonster::CanonicalCookie*>* cookies) {
+  // Cookies are read on demand by LoadCookiesForKeys().
+  if (options_.lazy_load)
+    return true;
+
+  // This function should be called only once per instance.
+  DCHECK(!db_.get());
+
+  if (!OpenDatabase())
+    return false;
+
   db_->Preload();
 
   // Slurp all the cookies into the out-vector.
@@ -176,31 +318,279 @@ bool BrowserPersistentCookieStore::Backend::Load(
     return false;
   }
 
-  while (smt.Step()) {
-    scoped_ptr<net::CookieMonster::CanonicalCookie> cc(
-        new net::CookieMonster::CanonicalCookie(
-            // The "source" URL is not used with persisted cookies.
-            GURL(),                                         // Source
-            smt.ColumnString(2),                            // name
-            smt.ColumnString(3),                            // value
-            smt.ColumnString(1),                            // domain
-            smt.ColumnString(4),                            // path
-            std::string(),  // TODO(abarth): Persist mac_key
-            std::string(),  // TODO(abarth): Persist mac_algorithm
-            Time::FromInternalValue(smt.ColumnInt64(0)),    // creation_utc
-            Time::FromInternalValue(smt.ColumnInt64(5)),    // expires_utc
-            Time::FromInternalValue(smt.ColumnInt64(8)),    // last_access_utc
-            smt.ColumnInt(6) != 0,                          // secure
-            smt.ColumnInt(7) != 0,                          // httponly
-            true));                                         // has_
-    DLOG_IF(WARNING,
-            cc->CreationDate() > Time::Now()) << L"CreationDate too recent";
-    cookies->push_back(cc.release());
+  while (smt.Step())
+    cookies->push_back(CookieFromStatement(smt));
+
+  return true;
+}
+
+bool BrowserPersistentCookieStore::Backend::LoadCookiesForKeys(
+    const std::vector<std::string>& keys,
+    std::vector<net::CookieMonster::CanonicalCookie*>* cookies) {
+  LoadRequest request(keys, cookies, NULL);
+  return ServeLoadRequest(&request);
+}
+
+bool BrowserPersistentCookieStore::Backend::GetCookieCounts(
+    std::map<std::string, int>* counts) {
+  LoadRequest request(std::vector<std::string>(), NULL, counts);
+  return ServeLoadRequest(&request);
+}
+
+bool BrowserPersistentCookieStore::Backend::ServeLoadRequest(
+    LoadRequest* request) {
+  DCHECK(options_.lazy_load);
+  DCHECK(!CefThread::CurrentlyOn(CefThread::FILE));
+
+  {
+    base::AutoLock locked(lock_);
+    load_requests_.push_back(request);
+  }
+
+  if (!CefThread::PostTask(
+          CefThread::FILE, FROM_HERE,
+          NewRunnableMethod(this, &Backend::ProcessLoadRequests))) {
+    base::AutoLock locked(lock_);
+    load_requests_.erase(std::find(load_requests_.begin(),
+                                   load_requests_.end(), request));
+    return false;
+  }
+
+  request->event.Wait();
+  return request->result;
+}
+
+void BrowserPersistentCookieStore::Backend::DeleteAllCookies() {
+  DCHECK(options_.lazy_load);
+  DCHECK(!CefThread::CurrentlyOn(CefThread::FILE));
+
+  bool batching;
+  {
+    base::AutoLock locked(lock_);
+    // The earlier changes are replaced by deleting everything. Later changes
+    // are committed after the deletion.
+    STLDeleteElements(&pending_);
+    num_pending_ = 1;
+    delete_all_pending_ = true;
+    batching = (batch_depth_ > 0);
+
+    key_index_.clear();
+    background_keys_.clear();
+    STLDeleteElements(&background_cookies_);
+    ++background_load_id_;
+  }
+
+  // EndBatch() will commit.
+  if (!batching) {
+    CefThread::PostTask(
+        CefThread::FILE, FROM_HERE, NewRunnableMethod(this, &Backend::Commit));
+  }
+}
+
+void BrowserPersistentCookieStore::Backend::StartBackgroundLoad() {
+  DCHECK(options_.lazy_load);
+  CefThread::PostTask(
+      CefThread::FILE, FROM_HERE,
+      NewRunnableMethod(this, &Backend::QueueBackgroundKeys));
+}
+
+void BrowserPersistentCookieStore::Backend::CancelBackgroundLoad() {
+  base::AutoLock locked(lock_);
+  background_keys_.clear();
+  ++background_load_id_;
+}
+
+void BrowserPersistentCookieStore::Backend::TakeBackgroundCookies(
+    std::vector<net::CookieMonster::CanonicalCookie*>* cookies) {
+  base::AutoLock locked(lock_);
+  if (cookies->empty())
+    cookies->swap(background_cookies_);
+  else
+    cookies->insert(cookies->end(), background_cookies_.begin(),
+                    background_cookies_.end());
+  background_cookies_.clear();
+}
+
+bool BrowserPersistentCookieStore::Backend::EnsureKeyIndex() {
+  DCHECK(CefThread::CurrentlyOn(CefThread::FILE));
+
+  // |key_index_loaded_| is only modified on the FILE thread.
+  if (key_index_loaded_)
+    return db_.get() != NULL;
+
+  if (!OpenDatabase()) {
+    base::AutoLock locked(lock_);
+    key_index_loaded_ = true;
+    return false;
+  }
+
+  KeyIndex key_index;
+  sql::Statement smt(db_->GetUniqueStatement(
+      "SELECT DISTINCT host_key FROM cookies"));
+  if (!smt) {
+    NOTREACHED() << "select statement prep failed";
+  } else {
+    while (smt.Step()) {
+      std::string host_key = smt.ColumnString(0);
+      key_index[BrowserPersistentCookieStore::GetCookieKey(host_key)].insert(
+          host_key);
+    }
+  }
+
+  base::AutoLock locked(lock_);
+  // Merge the hosts of cookies that were added before the index was read.
+  for (KeyIndex::const_iterator it = key_index_.begin();
+       it != key_index_.end(); ++it) {
+    key_index[it->first].insert(it->second.begin(), it->second.end());
+  }
+  key_index_.swap(key_index);
+  key_index_loaded_ = true;
+  return true;
+}
+
+bool BrowserPersistentCookieStore::Backend::ReadCookiesForKey(
+    const std::string& key,
+    std::vector<net::CookieMonster::CanonicalCookie*>* cookies) {
+  DCHECK(CefThread::CurrentlyOn(CefThread::FILE));
+
+  std::set<std::string> host_keys;
+  {
+    base::AutoLock locked(lock_);
+    KeyIndex::const_iterator it = key_index_.find(key);
+    if (it == key_index_.end())
+      return true;
+    host_keys = it->second;
   }
 
+  sql::Statement smt(db_->GetCachedStatement(SQL_FROM_HERE,
+      "SELECT creation_utc, host_key, name, value, path, expires_utc, secure, "
+      "httponly, last_access_utc FROM cookies WHERE host_key = ?"));
+  if (!smt) {
+    NOTREACHED() << "select statement prep failed";
+    return false;
+  }
+
+  for (std::set<std::string>::const_iterator it = host_keys.begin();
+       it != host_keys.end(); ++it) {
+    smt.Reset();
+    smt.BindString(0, *it);
+    while (smt.Step())
+      cookies->push_back(CookieFromStatement(smt));
+  }
   return true;
 }
 
+bool BrowserPersistentCookieStore::Backend::ReadCookieCounts(
+    std::map<std::string, int>* counts) {
+  DCHECK(CefThread::CurrentlyOn(CefThread::FILE));
+
+  sql::Statement smt(db_->GetCachedStatement(SQL_FROM_HERE,
+      "SELECT host_key, COUNT(*) FROM cookies WHERE expires_utc > ? "
+      "GROUP BY host_key"));
+  if (!smt) {
+    NOTREACHED() << "select statement prep failed";
+    return false;
+  }
+
+  smt.BindInt64(0, Time::Now().ToInternalValue());
+  while (smt.Step()) {
+    (*counts)[BrowserPersistentCookieStore::GetCookieKey(
+        smt.ColumnString(0))] += smt.ColumnInt(1);
+  }
+  return true;
+}
+
+void BrowserPersistentCookieStore::Backend::ProcessLoadRequests() {
+  DCHECK(CefThread::CurrentlyOn(CefThread::FILE));
+
+  std::deque<LoadRequest*> requests;
+  {
+    base::AutoLock locked(lock_);
+    requests.swap(load_requests_);
+  }
+  if (requests.empty())
+    return;
+
+  bool valid = EnsureKeyIndex();
+
+  // Changes to cookies that were released from memory by the reader may still
+  // be pending. They are committed even during a batch because the reader
+  // would otherwise see the old values.
+  if (valid)
+    InternalCommit(true);
+
+  for (size_t i = 0; i < requests.size(); ++i) {
+    LoadRequest* request = requests[i];
+    request->result = valid;
+    if (valid && request->cookies) {
+      for (size_t j = 0; j < request->keys.size(); ++j) {
+        if (!ReadCookiesForKey(request->keys[j], request->cookies))
+          request->result = false;
+      }
+    }
+    if (valid && request->counts && !ReadCookieCounts(request->counts))
+      request->result = false;
+    request->event.Signal();
+  }
+}
+
+void BrowserPersistentCookieStore::Backend::QueueBackgroundKeys() {
+  DCHECK(CefThread::CurrentlyOn(CefThread::FILE));
+
+  if (!EnsureKeyIndex())
+    return;
+
+  {
+    base::AutoLock locked(lock_);
+    for (KeyIndex::const_iterator it = key_index_.begin();
+         it != key_index_.end(); ++it) {
+      background_keys_.push_back(it->first);
+    }
+  }
+
+  LoadNextBackgroundKey();
+}
+
+void BrowserPersistentCookieStore::Backend::LoadNextBackgroundKey() {
+  DCHECK(CefThread::CurrentlyOn(CefThread::FILE));
+
+  std::string key;
+  int load_id;
+  {
+    base::AutoLock locked(lock_);
+    if (background_keys_.empty())
+      return;
+    key = background_keys_.front();
+    background_keys_.pop_front();
+    load_id = background_load_id_;
+  }
+
+  if (!db_.get())
+    return;
+
+  std::vector<net::CookieMonster::CanonicalCookie*> cookies;
+  ReadCookiesForKey(key, &cookies);
+
+  bool more;
+  {
+    base::AutoLock locked(lock_);
+    if (load_id == background_load_id_) {
+      background_cookies_.insert(background_cookies_.end(), cookies.begin(),
+                                 cookies.end());
+    } else {
+      STLDeleteElements(&cookies);
+    }
+    more = !background_keys_.empty();
+  }
+
+  // Read one key per task so that blocking reads and commits are not delayed.
+  if (more) {
+    CefThread::PostTask(
+        CefThread::FILE, FROM_HERE,
+        NewRunnableMethod(this, &Backend::LoadNextBackgroundKey));
+  }
+}
+
 bool BrowserPersistentCookieStore::Backend::EnsureDatabaseVersion() {
   // Version check.
   if (!meta_table_.Init(
@@ -293,28 +683,41 @@ void BrowserPersistentCookieStore::Backend::DeleteCookie(
 void BrowserPersistentCookieStore::Backend::BatchOperation(
     PendingOperation::OperationType op,
     const net::CookieMonster::CanonicalCookie& cc) {
-  // Commit every 30 seconds.
-  static const int kCommitIntervalMs = 30 * 1000;
-  // Commit right away if we have more than 512 outstanding operations.
-  static const size_t kCommitAfterBatchSize = 512;
   DCHECK(!CefThread::CurrentlyOn(CefThread::FILE));
 
   // We do a full copy of the cookie here, and hopefully just here.
   scoped_ptr<PendingOperation> po(new PendingOperation(op, cc));
 
   PendingOperationsList::size_type num_pending;
+  bool batching;
   {
     base::AutoLock locked(lock_);
     pending_.push_back(po.release());
     num_pending = ++num_pending_;
+    batching = (batch_depth_ > 0);
+    if (static_cast<int>(num_pending) > stats_.max_pending_operations)
+      stats_.max_pending_operations = static_cast<int>(num_pending);
+
+    // Cookies for a new key may be released from memory and read back once
+    // they have been committed.
+    if (options_.lazy_load && op == PendingOperation::COOKIE_ADD) {
+      key_index_[BrowserPersistentCookieStore::GetCookieKey(cc.Domain())].
+          insert(cc.Domain());
+    }
   }
 
+  CEF_TRACE_COUNTER1("cef", "CookieStorePendingOperations", num_pending);
+
+  // EndBatch() will commit.
+  if (batching)
+    return;
+
   if (num_pending == 1) {
     // We've gotten our first entry for this batch, fire off the timer.
     CefThread::PostDelayedTask(
       CefThread::FILE, FROM_HERE,
-      NewRunnableMethod(this, &Backend::Commit), kCommitIntervalMs);
-  } else if (num_pending == kCommitAfterBatchSize) {
+      NewRunnableMethod(this, &Backend::Commit), options_.commit_interval_ms);
+  } else if (num_pending == options_.commit_batch_size) {
     // We've reached a big enough batch, fire off a commit now.
     CefThread::PostTask(
       CefThread::FILE, FROM_HERE,
@@ -323,18 +726,41 @@ void BrowserPersistentCookieStore::Backend::BatchOperation(
 }
 
 void BrowserPersistentCookieStore::Backend::Commit() {
+  InternalCommit(false);
+}
+
+void BrowserPersistentCookieStore::Backend::InternalCommit(bool ignore_batch) {
   DCHECK(CefThread::CurrentlyOn(CefThread::FILE));
 
+  // The database is opened on the FILE thread when loading lazily.
+  if (options_.lazy_load)
+    EnsureKeyIndex();
+
   PendingOperationsList ops;
+  bool delete_all;
   {
     base::AutoLock locked(lock_);
+    // A timer may fire during a batch. EndBatch() will commit.
+    if (batch_depth_ > 0 && !ignore_batch)
+      return;
     pending_.swap(ops);
     num_pending_ = 0;
+    delete_all = delete_all_pending_;
+    delete_all_pending_ = false;
   }
 
   // Maybe an old timer fired or we are already Close()'ed.
-  if (!db_.get() || ops.empty())
+  if (!db_.get() || (ops.empty() && !delete_all)) {
+    STLDeleteElements(&ops);
     return;
+  }
+
+  // Deleting all cookies counts as a single operation.
+  int64 op_count = static_cast<int64>(ops.size()) + (delete_all ? 1 : 0);
+  CEF_TRACE_EVENT1("cef", "BrowserPersistentCookieStore::Commit",
+                   "operations", op_count);
+  CEF_TRACE_COUNTER1("cef", "CookieStorePendingOperations", 0);
+  base::TimeTicks start = base::TimeTicks::Now();
 
   sql::Statement add_smt(db_->GetCachedStatement(SQL_FROM_HERE,
       "INSERT INTO cookies (creation_utc, host_key, name, value, path, "
@@ -364,6 +790,8 @@ void BrowserPersistentCookieStore::Backend::Commit() {
     NOTREACHED();
     return;
   }
+  if (delete_all && !db_->Execute("DELETE FROM cookies"))
+    NOTREACHED() << "Could not delete all cookies from the DB.";
   for (PendingOperationsList::iterator it = ops.begin();
        it != ops.end(); ++it) {
     // Free the cookies as we commit them to the database.
@@ -408,6 +836,16 @@ void BrowserPersistentCookieStore::Backend::Commit() {
   }
 
   transaction.Commit();
+
+  double commit_time = (base::TimeTicks::Now() - start).InMillisecondsF();
+
+  base::AutoLock locked(lock_);
+  stats_.commit_count++;
+  stats_.committed_operations += op_count;
+  stats_.last_commit_time = commit_time;
+  stats_.total_commit_time += commit_time;
+  if (commit_time > stats_.max_commit_time)
+    stats_.max_commit_time = commit_time;
 }
 
 void BrowserPersistentCookieStore::Backend::Flush(Task* completion_task) {
@@ -422,6 +860,23 @@ void BrowserPersistentCookieStore::Backend::Flush(Task* completion_task) {
   }
 }
 
+void BrowserPersistentCookieStore::Backend::BeginBatch() {
+  base::AutoLock locked(lock_);
+  batch_depth_++;
+}
+
+void BrowserPersistentCookieStore::Backend::EndBatch() {
+  {
+    base::AutoLock locked(lock_);
+    DCHECK_GT(batch_depth_, 0);
+    if (--batch_depth_ > 0 || num_pending_ == 0)
+      return;
+  }
+
+  CefThread::PostTask(
+      CefThread::FILE, FROM_HERE, NewRunnableMethod(this, &Backend::Commit));
+}
+
 // Fire off a close message to the background thread.  We could still have a
 // pending commit timer that will be holding a reference on us, but if/when
 // this fires we will already have been cleaned up and it will be ignored.
@@ -440,6 +895,12 @@ void BrowserPersistentCookieStore::Backend::InternalBackgroundClose() {
 
   db_.reset();
 
+  {
+    base::AutoLock locked(lock_);
+    background_keys_.clear();
+    STLDeleteElements(&background_cookies_);
+  }
+
   if (clear_local_state_on_exit_)
     file_util::Delete(path_, false);
 }
@@ -449,8 +910,28 @@ void BrowserPersistentCookieStore::Backend::SetClearLocalStateOnExit(
   base::AutoLock locked(lock_);
   clear_local_state_on_exit_ = clear_local_state;
 }
-BrowserPersistentCookieStore::BrowserPersistentCookieStore(const FilePath& path)
-    : backend_(new Backend(path)) {
+
+void BrowserPersistentCookieStore::Backend::GetStats(
+    cef_cookie_store_stats_t* stats) {
+  base::AutoLock locked(lock_);
+  *stats = stats_;
+  stats->pending_operations = static_cast<int>(num_pending_);
+}
+
+BrowserPersistentCookieStore::Options::Options()
+    : lazy_load(false),
+      // Commit every 30 seconds.
+      commit_interval_ms(30 * 1000),
+      // Commit right away if we have more than 512 outstanding operations.
+      commit_batch_size(512),
+      journal_mode(COOKIE_JOURNAL_DEFAULT),
+      sync_mode(COOKIE_SYNC_DEFAULT) {
+}
+
+BrowserPersistentCookieStore::BrowserPersistentCookieStore(
+    const FilePath& path, const Options& options)
+    : backend_(new Backend(path, options)),
+      suppress_writes_(false) {
 }
 
 BrowserPersistentCookieStore::~BrowserPersistentCookieStore() {
@@ -467,9 +948,22 @@ bool BrowserPersistentCookieStore::Load(
   return backend_->Load(cookies);
 }
 
+// static
+std::string BrowserPersistentCookieStore::GetCookieKey(
+    const std::string& domain) {
+  std::string effective_domain(
+      net::RegistryControlledDomainService::GetDomainAndRegistry(domain));
+  if (effective_domain.empty())
+    effective_domain = domain;
+
+  if (!effective_domain.empty() && effective_domain[0] == '.')
+    return effective_domain.substr(1);
+  return effective_domain;
+}
+
 void BrowserPersistentCookieStore::AddCookie(
     const net::CookieMonster::CanonicalCookie& cc) {
-  if (backend_.get())
+  if (backend_.get() && !suppress_writes_)
     backend_->AddCookie(cc);
 }
 
@@ -481,7 +975,7 @@ void BrowserPersistentCookieStore::UpdateCookieAccessTime(
 
 void BrowserPersistentCookieStore::DeleteCookie(
     const net::CookieMonster::CanonicalCookie& cc) {
-  if (backend_.get())
+  if (backend_.get() && !suppress_writes_)
     backend_->DeleteCookie(cc);
 }
 
@@ -497,3 +991,50 @@ void BrowserPersistentCookieStore::Flush(Task* completion_task) {
   else if (completion_task)
     MessageLoop::current()->PostTask(FROM_HERE, completion_task);
 }
+
+void BrowserPersistentCookieStore::GetStats(cef_cookie_store_stats_t* stats) {
+  if (backend_.get())
+    backend_->GetStats(stats);
+}
+
+void BrowserPersistentCookieStore::BeginBatch() {
+  if (backend_.get())
+    backend_->BeginBatch();
+}
+
+void BrowserPersistentCookieStore::EndBatch() {
+  if (backend_.get())
+    backend_->EndBatch();
+}
+
+bool BrowserPersistentCookieStore::LoadCookiesForKeys(
+    const std::vector<std::string>& keys,
+    std::vector<net::CookieMonster::CanonicalCookie*>* cookies) {
+  return backend_.get() && backend_->LoadCookiesForKeys(keys, cookies);
+}
+
+bool BrowserPersistentCookieStore::GetCookieCounts(
+    std::map<std::string, int>* counts) {
+  return backend_.get() && backend_->GetCookieCounts(counts);
+}
+
+void BrowserPersistentCookieStore::DeleteAllCookies() {
+  if (backend_.get())
+    backend_->DeleteAllCookies();
+}
+
+void BrowserPersistentCookieStore::StartBackgroundLoad() {
+  if (backend_.get())
+    backend_->StartBackgroundLoad();
+}
+
+void BrowserPersistentCookieStore::CancelBackgroundLoad() {
+  if (backend_.get())
+    backend_->CancelBackgroundLoad();
+}
+
+void BrowserPersistentCookieStore::TakeBackgroundCookies(
+    std::vector<net::CookieMonster::CanonicalCookie*>* cookies) {
+  if (backend_.get())
+    backend_->TakeBackgroundCookies(cookies);
+}
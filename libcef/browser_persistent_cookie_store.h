@@ -9,14 +9,17 @@
 // with the following modifications for use in the cef:
 // - BrowserThread has been replaced with CefThread
 // - Performance diagnostic code has been removed (UMA_HISTOGRAM_ENUMERATION)
+// - The commit thresholds, journal mode and synchronous level are configurable
 
 #ifndef _BROWSER_PERSISTENT_COOKIE_STORE_H
 #define _BROWSER_PERSISTENT_COOKIE_STORE_H
 #pragma once
 
+#include <map>
 #include <string>
 #include <vector>
 
+#include "include/internal/cef_types.h"
 #include "base/memory/ref_counted.h"
 #include "net/base/cookie_monster.h"
 
@@ -25,12 +28,35 @@ class FilePath;
 // Implements the PersistentCookieStore interface in terms of a SQLite database.
 // For documentation about the actual member functions consult the documentation
 // of the parent class |net::CookieMonster::PersistentCookieStore|.
+//
+// When created with |lazy_load| true Load() does not read any cookies. The
+// cookies are instead read one domain key at a time using
+// LoadCookiesForKeys() or in the background using StartBackgroundLoad(). See
+// BrowserLazyCookieStore.
 class BrowserPersistentCookieStore
     : public net::CookieMonster::PersistentCookieStore {
  public:
-  explicit BrowserPersistentCookieStore(const FilePath& path);
+  struct Options {
+    Options();
+
+    // Read cookies on demand instead of in Load().
+    bool lazy_load;
+    // Maximum time in milliseconds that a change waits before it is committed.
+    int commit_interval_ms;
+    // Number of pending changes that triggers an immediate commit.
+    size_t commit_batch_size;
+    cef_cookie_journal_mode_t journal_mode;
+    cef_cookie_sync_mode_t sync_mode;
+  };
+
+  BrowserPersistentCookieStore(const FilePath& path, const Options& options);
   virtual ~BrowserPersistentCookieStore();
 
+  // Returns the key used to group the cookies for |domain|. This matches the
+  // key used by the cookie monster, which is the registered domain plus one
+  // label or the host name if there is no registered domain.
+  static std::string GetCookieKey(const std::string& domain);
+
   virtual bool Load(std::vector<net::CookieMonster::CanonicalCookie*>* cookies);
 
   virtual void AddCookie(const net::CookieMonster::CanonicalCookie& cc);
@@ -42,10 +68,49 @@ class BrowserPersistentCookieStore
 
   virtual void Flush(Task* completion_task);
 
+  // Defer commits between BeginBatch() and EndBatch() so that all changes made
+  // in between are committed in a single transaction. Calls may be nested.
+  void BeginBatch();
+  void EndBatch();
+
+  // Retrieve the pending operation and commit statistics. May be called on
+  // any thread.
+  void GetStats(cef_cookie_store_stats_t* stats);
+
+  // The following methods may only be used with |lazy_load| true.
+
+  // Read the cookies for |keys| from the database. Blocks until the read
+  // completes on the FILE thread. These reads are performed before any
+  // pending background reads.
+  bool LoadCookiesForKeys(
+      const std::vector<std::string>& keys,
+      std::vector<net::CookieMonster::CanonicalCookie*>* cookies);
+
+  // Retrieve the number of unexpired cookies in the database for each key.
+  // Blocks until the cookies have been counted on the FILE thread.
+  bool GetCookieCounts(std::map<std::string, int>* counts);
+
+  // Delete all cookies from the database, including the pending changes. The
+  // deletion is committed with the changes that follow it.
+  void DeleteAllCookies();
+
+  // Read the cookies for all keys on the FILE thread, one key per task. Use
+  // TakeBackgroundCookies() to retrieve the cookies that have been read.
+  void StartBackgroundLoad();
+  void CancelBackgroundLoad();
+  void TakeBackgroundCookies(
+      std::vector<net::CookieMonster::CanonicalCookie*>* cookies);
+
+  // While true AddCookie() and DeleteCookie() are ignored. Used when cookies
+  // that are already in the database are inserted into or released from the
+  // cookie monster.
+  void set_suppress_writes(bool suppress) { suppress_writes_ = suppress; }
+
  private:
   class Backend;
 
   scoped_refptr<Backend> backend_;
+  bool suppress_writes_;
 
   DISALLOW_COPY_AND_ASSIGN(BrowserPersistentCookieStore);
 };
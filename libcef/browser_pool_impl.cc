@@ -0,0 +1,230 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "include/cef.h"
+#include "browser_impl.h"
+#include "cef_context.h"
+#include "cef_thread.h"
+
+#include <set>
+#include <vector>
+
+#include "base/logging.h"
+
+namespace {
+
+// Implementation of CefBrowserPool. All members are only accessed on the UI
+// thread.
+class CefBrowserPoolImpl : public CefBrowserPool
+{
+public:
+  CefBrowserPoolImpl(const CefWindowInfo& windowInfo, int size,
+                     const CefBrowserSettings& settings)
+    : window_info_(windowInfo), settings_(settings), size_(size),
+      closed_(false), fill_pending_(false)
+  {
+  }
+
+  virtual ~CefBrowserPoolImpl()
+  {
+    // The pool may be released on any thread so close the remaining idle
+    // browsers asynchronously.
+    for (size_t i = 0; i < idle_.size(); ++i)
+      idle_[i]->CloseBrowser();
+  }
+
+  virtual CefRefPtr<CefBrowser> TakeBrowser(CefRefPtr<CefClient> client,
+                                            const CefString& url)
+  {
+    if (!CefThread::CurrentlyOn(CefThread::UI)) {
+      NOTREACHED() << "called on invalid thread";
+      return NULL;
+    }
+
+    UIT_ForgetClosedBrowsers();
+
+    CefRefPtr<CefBrowserImpl> browser;
+    if (!idle_.empty()) {
+      browser = idle_.back();
+      idle_.pop_back();
+    } else {
+      browser = UIT_CreateIdleBrowser();
+    }
+
+    in_use_.insert(browser->UIT_GetUniqueID());
+
+    browser->UIT_AdoptFromPool(client, url);
+    UIT_ScheduleFill();
+    return browser.get();
+  }
+
+  virtual bool ReturnBrowser(CefRefPtr<CefBrowser> browser)
+  {
+    if (!CefThread::CurrentlyOn(CefThread::UI)) {
+      NOTREACHED() << "called on invalid thread";
+      return false;
+    }
+
+    UIT_ForgetClosedBrowsers();
+
+    CefRefPtr<CefBrowserImpl> impl =
+        static_cast<CefBrowserImpl*>(browser.get());
+    std::set<int>::iterator it = in_use_.find(impl->UIT_GetUniqueID());
+    if (it == in_use_.end())
+      return false;
+    in_use_.erase(it);
+
+    // The browser was closed while it was in use.
+    if (!impl->UIT_GetWebViewHost())
+      return false;
+
+    if (closed_ || static_cast<int>(idle_.size()) >= size_) {
+      impl->UIT_CloseBrowser();
+      return true;
+    }
+
+    impl->UIT_ScrubForPool();
+    idle_.push_back(impl);
+    return true;
+  }
+
+  virtual int GetIdleCount()
+  {
+    if (!CefThread::CurrentlyOn(CefThread::UI)) {
+      NOTREACHED() << "called on invalid thread";
+      return 0;
+    }
+
+    return static_cast<int>(idle_.size());
+  }
+
+  virtual void Close()
+  {
+    if (!CefThread::CurrentlyOn(CefThread::UI)) {
+      NOTREACHED() << "called on invalid thread";
+      return;
+    }
+
+    closed_ = true;
+
+    BrowserList browsers;
+    browsers.swap(idle_);
+    for (size_t i = 0; i < browsers.size(); ++i)
+      browsers[i]->UIT_CloseBrowser();
+  }
+
+  // Create idle browsers until the pool is full.
+  void UIT_Fill()
+  {
+    REQUIRE_UIT();
+    while (!closed_ && static_cast<int>(idle_.size()) < size_)
+      idle_.push_back(UIT_CreateIdleBrowser());
+  }
+
+private:
+  typedef std::vector<CefRefPtr<CefBrowserImpl> > BrowserList;
+
+  CefRefPtr<CefBrowserImpl> UIT_CreateIdleBrowser()
+  {
+    CefRefPtr<CefBrowserImpl> browser(
+        new CefBrowserImpl(window_info_, settings_, NULL, NULL, NULL));
+    browser->UIT_CreateBrowser(CefString());
+    browser->UIT_WasHidden(true);
+    return browser;
+  }
+
+  // Forget the browsers that were closed by their clients instead of being
+  // returned to the pool.
+  void UIT_ForgetClosedBrowsers()
+  {
+    std::set<int>::iterator it = in_use_.begin();
+    while (it != in_use_.end()) {
+      if (_Context->GetBrowserByID(*it).get())
+        ++it;
+      else
+        in_use_.erase(it++);
+    }
+  }
+
+  // Refill the pool after the current task so that the browser being taken is
+  // not delayed.
+  void UIT_ScheduleFill()
+  {
+    if (closed_ || fill_pending_)
+      return;
+    fill_pending_ = true;
+    CefThread::PostTask(CefThread::UI, FROM_HERE,
+        NewRunnableMethod(this, &CefBrowserPoolImpl::UIT_FillPending));
+  }
+
+  void UIT_FillPending()
+  {
+    fill_pending_ = false;
+    // Stop refilling if the pool is being shut down.
+    if (CONTEXT_STATE_VALID())
+      UIT_Fill();
+  }
+
+  CefWindowInfo window_info_;
+  CefBrowserSettings settings_;
+  int size_;
+  bool closed_;
+  bool fill_pending_;
+
+  BrowserList idle_;
+
+  // Unique IDs of the browsers that have been taken from the pool and not yet
+  // returned or closed.
+  std::set<int> in_use_;
+
+  IMPLEMENT_REFCOUNTING(CefBrowserPoolImpl);
+};
+
+} // namespace
+
+// static
+CefRefPtr<CefBrowserPool> CefBrowserPool::Create(
+    CefWindowInfo& windowInfo, int size, const CefBrowserSettings& settings)
+{
+  // Verify that the context is in a valid state.
+  if (!CONTEXT_STATE_VALID()) {
+    NOTREACHED();
+    return NULL;
+  }
+
+  // Verify that the settings structure is a valid size.
+  if (settings.size != sizeof(cef_browser_settings_t)) {
+    NOTREACHED();
+    return NULL;
+  }
+
+  // Verify that this method is being called on the UI thread.
+  if (!CefThread::CurrentlyOn(CefThread::UI)) {
+    NOTREACHED();
+    return NULL;
+  }
+
+  if (size <= 0) {
+    NOTREACHED() << "invalid pool size";
+    return NULL;
+  }
+
+  // Windowed browsers would need to be reparented when they are taken from the
+  // pool so only off-screen browsers are supported.
+#if defined(OS_MACOSX)
+  bool window_rendering_disabled = false;
+#else
+  bool window_rendering_disabled =
+      windowInfo.m_bWindowRenderingDisabled ? true : false;
+#endif
+  if (!window_rendering_disabled) {
+    NOTREACHED() << "window rendering must be disabled";
+    return NULL;
+  }
+
+  CefRefPtr<CefBrowserPoolImpl> pool(
+      new CefBrowserPoolImpl(windowInfo, size, settings));
+  pool->UIT_Fill();
+  return pool.get();
+}
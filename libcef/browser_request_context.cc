@@ -4,21 +4,35 @@
 // found in the LICENSE file.
 
 #include "browser_request_context.h"
+#include "browser_cookie_cache.h"
+#include "browser_cookie_snapshot.h"
 #include "browser_file_system.h"
+#include "browser_http_cache_purger.h"
+#include "browser_http_cache_writer.h"
+#include "browser_lazy_cookie_store.h"
 #include "browser_persistent_cookie_store.h"
 #include "browser_resource_loader_bridge.h"
+#include "cef_context.h"
 #include "cef_thread.h"
+#include "http_cache_size.h"
+
+#include <algorithm>
+#include <vector>
 
 #include "base/compiler_specific.h"
 #include "base/file_path.h"
 #include "base/file_util.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/task.h"
 #include "build/build_config.h"
 #include "net/base/cert_verifier.h"
 #include "net/base/cookie_monster.h"
 #include "net/base/default_origin_bound_cert_store.h"
 #include "net/base/host_resolver.h"
 #include "net/base/origin_bound_cert_service.h"
+#include "net/base/registry_controlled_domain.h"
 #include "net/base/ssl_config_service_defaults.h"
+#include "net/disk_cache/disk_cache.h"
 #include "net/ftp/ftp_network_layer.h"
 #include "net/http/http_auth_handler_factory.h"
 #include "net/proxy/proxy_config_service.h"
@@ -56,9 +70,81 @@ public:
 
 #endif // defined(OS_WIN)
 
+namespace {
+
+// Creates the FileSystem protocol handler when the first filesystem: URL is
+// requested so that the FileSystem context is not created at startup.
+class LazyFileSystemProtocolHandler
+    : public net::URLRequestJobFactory::ProtocolHandler {
+ public:
+  LazyFileSystemProtocolHandler() {}
+
+  virtual net::URLRequestJob* MaybeCreateJob(
+      net::URLRequest* request) const OVERRIDE {
+    if (!handler_.get()) {
+      context_ = static_cast<BrowserFileSystem*>(
+          WebKit::webKitPlatformSupport()->fileSystem())->
+              file_system_context();
+      if (!context_.get())
+        return NULL;
+      handler_.reset(fileapi::CreateFileSystemProtocolHandler(context_.get(),
+          CefThread::GetMessageLoopProxyForThread(CefThread::FILE)));
+    }
+    return handler_->MaybeCreateJob(request);
+  }
+
+ private:
+  // Only accessed on the IO thread.
+  mutable scoped_refptr<fileapi::FileSystemContext> context_;
+  mutable scoped_ptr<net::URLRequestJobFactory::ProtocolHandler> handler_;
+
+  DISALLOW_COPY_AND_ASSIGN(LazyFileSystemProtocolHandler);
+};
+
+// Copies the visited cookies.
+class CookieCollector : public BrowserLazyCookieStore::Visitor {
+ public:
+  explicit CookieCollector(net::CookieList* cookies) : cookies_(cookies) {}
+
+  virtual bool Visit(const net::CookieList& cookies, int total) OVERRIDE {
+    cookies_->insert(cookies_->end(), cookies.begin(), cookies.end());
+    return true;
+  }
+
+ private:
+  net::CookieList* cookies_;
+};
+
+// Deletes the visited cookies that belong to a domain or its subdomains.
+class DomainCookieDeleter : public BrowserLazyCookieStore::Visitor {
+ public:
+  DomainCookieDeleter(net::CookieMonster* cookie_monster,
+                      const std::string& domain)
+      : cookie_monster_(cookie_monster), domain_(domain) {}
+
+  virtual bool Visit(const net::CookieList& cookies, int total) OVERRIDE {
+    for (net::CookieList::const_iterator it = cookies.begin();
+         it != cookies.end(); ++it) {
+      if (CookieSnapshot::MatchesDomain(*it, domain_))
+        cookie_monster_->DeleteCanonicalCookie(*it);
+    }
+    return true;
+  }
+
+ private:
+  net::CookieMonster* cookie_monster_;
+  std::string domain_;
+};
+
+} // namespace
+
 BrowserRequestContext::BrowserRequestContext() 
     : ALLOW_THIS_IN_INITIALIZER_LIST(storage_(this)),
-      accept_all_cookies_(true) {
+      accept_all_cookies_(true),
+      http_cache_type_(net::MEMORY_CACHE),
+      http_cache_hit_count_(0),
+      http_cache_miss_count_(0),
+      http_cache_validation_count_(0) {
   Init(FilePath(), net::HttpCache::NORMAL, false);
 }
 
@@ -67,14 +153,30 @@ BrowserRequestContext::BrowserRequestContext(
     net::HttpCache::Mode cache_mode,
     bool no_proxy)
     : ALLOW_THIS_IN_INITIALIZER_LIST(storage_(this)),
-      accept_all_cookies_(true) {
+      accept_all_cookies_(true),
+      http_cache_type_(net::MEMORY_CACHE),
+      http_cache_hit_count_(0),
+      http_cache_miss_count_(0),
+      http_cache_validation_count_(0) {
   Init(cache_path, cache_mode, no_proxy);
 }
 
-void BrowserRequestContext::Init(
+BrowserRequestContext::BrowserRequestContext(
     const FilePath& cache_path,
-    net::HttpCache::Mode cache_mode,
-    bool no_proxy) {
+    BrowserRequestContext* parent,
+    BrowserCookieCache* cookie_cache)
+    : ALLOW_THIS_IN_INITIALIZER_LIST(storage_(this)),
+      parent_(parent),
+      cookie_cache_(cookie_cache),
+      accept_all_cookies_(true),
+      http_cache_type_(net::MEMORY_CACHE),
+      http_cache_hit_count_(0),
+      http_cache_miss_count_(0),
+      http_cache_validation_count_(0) {
+  InitIsolated(cache_path);
+}
+
+bool BrowserRequestContext::InitCookieStore(const FilePath& cache_path) {
   // Create the |cache_path| directory if necessary.
   bool cache_path_valid = false;
   if (!cache_path.empty()) {
@@ -84,14 +186,50 @@ void BrowserRequestContext::Init(
       NOTREACHED() << "The cache_path directory could not be created";
   }
 
-  scoped_refptr<BrowserPersistentCookieStore> persistent_store;
+  const CefSettings& settings = _Context->settings();
+  bool lazy_cookie_load =
+      (cache_path_valid && settings.cookie_load_mode != COOKIE_LOAD_ALL);
+
   if (cache_path_valid) {
+    BrowserPersistentCookieStore::Options options;
+    options.lazy_load = lazy_cookie_load;
+    if (settings.cookie_commit_interval > 0)
+      options.commit_interval_ms = settings.cookie_commit_interval;
+    if (settings.cookie_commit_batch_size > 0)
+      options.commit_batch_size = settings.cookie_commit_batch_size;
+    options.journal_mode = settings.cookie_journal_mode;
+    options.sync_mode = settings.cookie_sync_mode;
+
     const FilePath& cookie_path = cache_path.AppendASCII("Cookies");
-    persistent_store = new BrowserPersistentCookieStore(cookie_path);
+    persistent_cookie_store_ =
+        new BrowserPersistentCookieStore(cookie_path, options);
   }
 
-  storage_.set_cookie_store(
-      new net::CookieMonster(persistent_store.get(), NULL));
+  // The cookie cache is notified of every change to the cookie monster.
+  if (!cookie_cache_.get())
+    cookie_cache_ = new BrowserCookieCache();
+  net::CookieMonster* cookie_monster =
+      new net::CookieMonster(persistent_cookie_store_.get(),
+                             cookie_cache_.get());
+  if (lazy_cookie_load) {
+    lazy_cookie_store_ = new BrowserLazyCookieStore(cookie_monster,
+        persistent_cookie_store_.get(),
+        settings.cookie_load_mode == COOKIE_LOAD_ON_DEMAND_WITH_BACKGROUND_FILL,
+        settings.cookie_memory_limit);
+    storage_.set_cookie_store(lazy_cookie_store_.get());
+  } else {
+    storage_.set_cookie_store(cookie_monster);
+  }
+
+  return cache_path_valid;
+}
+
+void BrowserRequestContext::Init(
+    const FilePath& cache_path,
+    net::HttpCache::Mode cache_mode,
+    bool no_proxy) {
+  bool cache_path_valid = InitCookieStore(cache_path);
+
   storage_.set_origin_bound_cert_service(new net::OriginBoundCertService(
       new net::DefaultOriginBoundCertStore(NULL)));
 
@@ -170,16 +308,8 @@ void BrowserRequestContext::Init(
                                                   false,
                                                   false));
 
-  net::HttpCache::DefaultBackend* backend = new net::HttpCache::DefaultBackend(
-      cache_path_valid ? net::DISK_CACHE : net::MEMORY_CACHE,
-      cache_path, 0, BrowserResourceLoaderBridge::GetCacheThread());
-
   net::HttpCache* cache =
-      new net::HttpCache(host_resolver(), cert_verifier(),
-                         origin_bound_cert_service(), NULL, NULL,
-                         proxy_service(), ssl_config_service(),
-                         http_auth_handler_factory(), NULL, NULL, backend);
-
+      CreateHttpCache(CreateHttpCacheBackend(cache_path, cache_path_valid));
   cache->set_mode(cache_mode);
   storage_.set_http_transaction_factory(cache);
 
@@ -187,8 +317,6 @@ void BrowserRequestContext::Init(
       new net::FtpNetworkLayer(host_resolver()));
 
   blob_storage_controller_.reset(new webkit_blob::BlobStorageController());
-  file_system_context_ = static_cast<BrowserFileSystem*>(
-      WebKit::webKitPlatformSupport()->fileSystem())->file_system_context();
 
   net::URLRequestJobFactory* job_factory = new net::URLRequestJobFactory;
   job_factory->SetProtocolHandler(
@@ -196,17 +324,219 @@ void BrowserRequestContext::Init(
       new webkit_blob::BlobProtocolHandler(
           blob_storage_controller_.get(),
           CefThread::GetMessageLoopProxyForThread(CefThread::FILE)));
-  job_factory->SetProtocolHandler(
-      "filesystem",
-      fileapi::CreateFileSystemProtocolHandler(
-          file_system_context_.get(),
-          CefThread::GetMessageLoopProxyForThread(CefThread::FILE)));
+  job_factory->SetProtocolHandler("filesystem",
+                                  new LazyFileSystemProtocolHandler());
   storage_.set_job_factory(job_factory);
 }
 
+void BrowserRequestContext::InitIsolated(const FilePath& cache_path) {
+  bool cache_path_valid = InitCookieStore(cache_path);
+
+  set_accept_language(parent_->accept_language());
+  set_accept_charset(parent_->accept_charset());
+
+  // Share everything except the cookie store and the HTTP cache with the
+  // parent context. |parent_| keeps these objects alive.
+  set_host_resolver(parent_->host_resolver());
+  set_cert_verifier(parent_->cert_verifier());
+  set_origin_bound_cert_service(parent_->origin_bound_cert_service());
+  set_proxy_service(parent_->proxy_service());
+  set_ssl_config_service(parent_->ssl_config_service());
+  set_http_auth_handler_factory(parent_->http_auth_handler_factory());
+  set_ftp_transaction_factory(parent_->ftp_transaction_factory());
+  set_job_factory(parent_->job_factory());
+
+  // The new cache uses the parent's network session so that connection pools
+  // are shared.
+  storage_.set_http_transaction_factory(new net::HttpCache(
+      parent_->http_transaction_factory()->GetSession(),
+      CreateHttpCacheBackend(cache_path, cache_path_valid)));
+}
+
 BrowserRequestContext::~BrowserRequestContext() {
 }
 
+net::HttpCache* BrowserRequestContext::CreateHttpCache(
+    net::HttpCache::BackendFactory* backend) {
+  return new net::HttpCache(host_resolver(), cert_verifier(),
+                            origin_bound_cert_service(), NULL, NULL,
+                            proxy_service(), ssl_config_service(),
+                            http_auth_handler_factory(), NULL, NULL, backend);
+}
+
+net::HttpCache::DefaultBackend* BrowserRequestContext::CreateHttpCacheBackend(
+    const FilePath& cache_path, bool cache_path_valid) {
+  // A size of 0 lets the backend choose.
+  const CefSettings& settings = _Context->settings();
+  int max_bytes = cache_path_valid ? settings.disk_cache_size :
+                                     settings.memory_cache_size;
+  http_cache_type_ = cache_path_valid ? net::DISK_CACHE : net::MEMORY_CACHE;
+  return new net::HttpCache::DefaultBackend(
+      http_cache_type_, cache_path, std::max(max_bytes, 0),
+      BrowserResourceLoaderBridge::GetCacheThread());
+}
+
+void BrowserRequestContext::FlushCookieStore(Task* completion_task) {
+  if (persistent_cookie_store_.get()) {
+    persistent_cookie_store_->Flush(completion_task);
+  } else if (completion_task) {
+    completion_task->Run();
+    delete completion_task;
+  }
+}
+
+bool BrowserRequestContext::GetCookieStoreStats(
+    cef_cookie_store_stats_t* stats) {
+  if (!persistent_cookie_store_.get())
+    return false;
+  persistent_cookie_store_->GetStats(stats);
+  return true;
+}
+
+void BrowserRequestContext::LoadCookiesForURL(const GURL& url) {
+  if (lazy_cookie_store_.get())
+    lazy_cookie_store_->LoadCookiesForURL(url);
+}
+
+void BrowserRequestContext::VisitAllCookies(
+    BrowserLazyCookieStore::Visitor* visitor) {
+  DCHECK(CefThread::CurrentlyOn(CefThread::IO));
+
+  if (lazy_cookie_store_.get()) {
+    lazy_cookie_store_->VisitAllCookies(visitor);
+    return;
+  }
+
+  net::CookieList cookies = cookie_store()->GetCookieMonster()->GetAllCookies();
+  if (!cookies.empty())
+    visitor->Visit(cookies, static_cast<int>(cookies.size()));
+}
+
+void BrowserRequestContext::GetAllCookies(net::CookieList* cookies) {
+  CookieCollector collector(cookies);
+  VisitAllCookies(&collector);
+}
+
+void BrowserRequestContext::DeleteAllCookies() {
+  DCHECK(CefThread::CurrentlyOn(CefThread::IO));
+
+  if (lazy_cookie_store_.get())
+    lazy_cookie_store_->DeleteAllCookies();
+  else
+    cookie_store()->GetCookieMonster()->DeleteAll(true);
+}
+
+void BrowserRequestContext::ImportCookies(const net::CookieList& cookies) {
+  DCHECK(CefThread::CurrentlyOn(CefThread::IO));
+
+  if (persistent_cookie_store_.get())
+    persistent_cookie_store_->BeginBatch();
+
+  if (lazy_cookie_store_.get())
+    lazy_cookie_store_->ImportCookies(cookies);
+  else
+    cookie_store()->GetCookieMonster()->InitializeFrom(cookies);
+
+  if (persistent_cookie_store_.get())
+    persistent_cookie_store_->EndBatch();
+}
+
+void BrowserRequestContext::ReplaceCookies(const std::string& domain,
+                                           const net::CookieList& cookies) {
+  DCHECK(CefThread::CurrentlyOn(CefThread::IO));
+
+  net::CookieMonster* cookie_monster = cookie_store()->GetCookieMonster();
+
+  // Batches nest so the deletions and the import share one transaction.
+  if (persistent_cookie_store_.get())
+    persistent_cookie_store_->BeginBatch();
+
+  DomainCookieDeleter deleter(cookie_monster, domain);
+  if (domain.empty()) {
+    DeleteAllCookies();
+  } else if (!net::RegistryControlledDomainService::GetDomainAndRegistry(
+                 domain).empty()) {
+    // The domain and its subdomains share the database key of their
+    // registered domain so only that key needs to be read.
+    LoadCookiesForURL(GURL("http://" + domain + "/"));
+    deleter.Visit(cookie_monster->GetAllCookies(), 0);
+  } else {
+    // Subdomains of a host without a registry, such as "localhost", have
+    // their own keys.
+    VisitAllCookies(&deleter);
+  }
+
+  if (!cookies.empty())
+    ImportCookies(cookies);
+
+  if (persistent_cookie_store_.get())
+    persistent_cookie_store_->EndBatch();
+}
+
+void BrowserRequestContext::RecordHttpCacheResponse(bool was_cached,
+                                                    bool validated) {
+  DCHECK(CefThread::CurrentlyOn(CefThread::IO));
+  if (!was_cached)
+    ++http_cache_miss_count_;
+  else if (validated)
+    ++http_cache_validation_count_;
+  else
+    ++http_cache_hit_count_;
+}
+
+bool BrowserRequestContext::GetHttpCacheStats(cef_http_cache_stats_t* stats) {
+  DCHECK(CefThread::CurrentlyOn(CefThread::IO));
+
+  disk_cache::Backend* backend =
+      http_transaction_factory()->GetCache()->GetCurrentBackend();
+  if (!backend)
+    return false;
+
+  stats->entry_count = backend->GetEntryCount();
+  stats->bytes_used = HttpCacheSize::GetBytesUsed(backend, http_cache_type_);
+
+  stats->hit_count = http_cache_hit_count_;
+  stats->miss_count = http_cache_miss_count_;
+  stats->validation_count = http_cache_validation_count_;
+  return true;
+}
+
+void BrowserRequestContext::PurgeHttpCache(const std::string& url_prefix,
+                                           const base::Time& cutoff,
+                                           Task* completion_task) {
+  DCHECK(CefThread::CurrentlyOn(CefThread::IO));
+
+  // The purger deletes itself when done.
+  BrowserHttpCachePurger* purger = new BrowserHttpCachePurger(
+      http_transaction_factory()->GetCache(), url_prefix, cutoff,
+      completion_task);
+  purger->Start();
+}
+
+void BrowserRequestContext::ImportHttpCacheEntry(
+    const GURL& url, net::HttpResponseHeaders* headers,
+    const std::string& data, Task* completion_task) {
+  DCHECK(CefThread::CurrentlyOn(CefThread::IO));
+
+  // The writer deletes itself when done.
+  BrowserHttpCacheWriter* writer = new BrowserHttpCacheWriter(
+      http_transaction_factory()->GetCache(), url, headers, data,
+      completion_task);
+  writer->Start();
+}
+
+void BrowserRequestContext::CloseDiskCache() {
+  DCHECK(CefThread::CurrentlyOn(CefThread::IO));
+
+  // Deleting the current cache closes its backend on the cache thread and
+  // waits for the index to be written.
+  net::HttpCache* cache =
+      CreateHttpCache(net::HttpCache::DefaultBackend::InMemory(0));
+  cache->set_mode(net::HttpCache::DISABLE);
+  storage_.set_http_transaction_factory(cache);
+  http_cache_type_ = net::MEMORY_CACHE;
+}
+
 void BrowserRequestContext::SetAcceptAllCookies(bool accept_all_cookies) {
   accept_all_cookies_ = accept_all_cookies;
 }
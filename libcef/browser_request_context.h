@@ -6,15 +6,28 @@
 #ifndef _BROWSER_REQUEST_CONTEXT_H
 #define _BROWSER_REQUEST_CONTEXT_H
 
+#include "include/internal/cef_types.h"
+#include "browser_lazy_cookie_store.h"
+#include "base/memory/ref_counted.h"
+#include "net/base/cache_type.h"
+#include "net/base/cookie_monster.h"
 #include "net/http/http_cache.h"
 #include "net/http/url_security_manager.h"
 #include "net/url_request/url_request_context.h"
 #include "net/url_request/url_request_context_storage.h"
 
+class BrowserCookieCache;
+class BrowserPersistentCookieStore;
 class FilePath;
+class GURL;
+class Task;
 
-namespace fileapi {
-class FileSystemContext;
+namespace base {
+class Time;
+}
+
+namespace net {
+class HttpResponseHeaders;
 }
 
 namespace webkit_blob {
@@ -34,28 +47,122 @@ class BrowserRequestContext : public net::URLRequestContext {
                         net::HttpCache::Mode cache_mode,
                         bool no_proxy);
 
+  // Use a separate cookie store and HTTP cache at the specified location, or
+  // in memory if |cache_path| is empty, and share all other state with
+  // |parent|. |cookie_cache| will be notified of cookie changes.
+  BrowserRequestContext(const FilePath& cache_path,
+                        BrowserRequestContext* parent,
+                        BrowserCookieCache* cookie_cache);
+
   virtual const std::string& GetUserAgent(const GURL& url) const;
 
   void SetAcceptAllCookies(bool accept_all_cookies);
   bool AcceptAllCookies();
 
   webkit_blob::BlobStorageController* blob_storage_controller() const {
+    if (parent_.get())
+      return parent_->blob_storage_controller();
     return blob_storage_controller_.get();
   }
 
-  fileapi::FileSystemContext* file_system_context() const {
-    return file_system_context_.get();
-  }
+  // Cache of document.cookie values. May be used on any thread.
+  BrowserCookieCache* cookie_cache() const { return cookie_cache_.get(); }
+
+  // Commit pending cookie changes to the cookie database. |completion_task|
+  // will be run on the FILE thread after the commit, or immediately if cookies
+  // are not persisted.
+  void FlushCookieStore(Task* completion_task);
+
+  // Retrieve the cookie database statistics. Returns false if cookies are not
+  // persisted. May be called on any thread.
+  bool GetCookieStoreStats(cef_cookie_store_stats_t* stats);
+
+  // Read the cookies for |url| from the cookie database if cookies are loaded
+  // on demand. Must be called on the IO thread before the cookie monster is
+  // used directly.
+  void LoadCookiesForURL(const GURL& url);
+
+  // Visit all cookies. If cookies are loaded on demand they are read and
+  // visited a few keys at a time. Must be called on the IO thread.
+  void VisitAllCookies(BrowserLazyCookieStore::Visitor* visitor);
+
+  // Copy all cookies to |cookies|. Must be called on the IO thread.
+  void GetAllCookies(net::CookieList* cookies);
+
+  // Delete all cookies from memory and the cookie database. Must be called on
+  // the IO thread.
+  void DeleteAllCookies();
+
+  // Insert |cookies| into the cookie store. The changes are committed to the
+  // cookie database in a single transaction. Must be called on the IO thread.
+  void ImportCookies(const net::CookieList& cookies);
+
+  // Replace the cookies for |domain| and its subdomains, or all cookies if
+  // |domain| is not specified, with |cookies|. The changes are committed to the
+  // cookie database in a single transaction. Must be called on the IO thread.
+  void ReplaceCookies(const std::string& domain,
+                      const net::CookieList& cookies);
+
+  // Count a response to an HTTP request as a cache hit, miss or validation.
+  // Must be called on the IO thread.
+  void RecordHttpCacheResponse(bool was_cached, bool validated);
+
+  // Retrieve the HTTP cache statistics. Returns false if the cache backend has
+  // not been created. Must be called on the IO thread.
+  bool GetHttpCacheStats(cef_http_cache_stats_t* stats);
+
+  // Remove the HTTP cache entries for URLs that start with |url_prefix| and
+  // that were last used before |cutoff|. Either may be unspecified.
+  // |completion_task|, if non-NULL, is run on the IO thread when done. Must be
+  // called on the IO thread.
+  void PurgeHttpCache(const std::string& url_prefix, const base::Time& cutoff,
+                      Task* completion_task);
+
+  // Write a response for |url| to the HTTP cache, replacing any existing
+  // entry. |completion_task|, if non-NULL, is run on the IO thread when done.
+  // Must be called on the IO thread.
+  void ImportHttpCacheEntry(const GURL& url, net::HttpResponseHeaders* headers,
+                            const std::string& data, Task* completion_task);
+
+  // Close the disk cache, which writes the cache index, and replace it with a
+  // disabled in-memory cache. Blocks until the backend has been closed on the
+  // cache thread. Must be called on the IO thread.
+  void CloseDiskCache();
 
  private:
   void Init(const FilePath& cache_path, net::HttpCache::Mode cache_mode,
             bool no_proxy);
+  void InitIsolated(const FilePath& cache_path);
+
+  // Create the cookie store, which is persisted in |cache_path| if specified.
+  // Returns true if |cache_path| is valid.
+  bool InitCookieStore(const FilePath& cache_path);
+
+  net::HttpCache* CreateHttpCache(net::HttpCache::BackendFactory* backend);
+
+  // Create the backend for the HTTP cache, which is stored in |cache_path| if
+  // specified. The size is limited by CefSettings.
+  net::HttpCache::DefaultBackend* CreateHttpCacheBackend(
+      const FilePath& cache_path, bool cache_path_valid);
 
   net::URLRequestContextStorage storage_;
+  // Only set for isolated contexts.
+  scoped_refptr<BrowserRequestContext> parent_;
+  scoped_refptr<BrowserPersistentCookieStore> persistent_cookie_store_;
+  // Only set if cookies are loaded on demand.
+  scoped_refptr<BrowserLazyCookieStore> lazy_cookie_store_;
+  scoped_refptr<BrowserCookieCache> cookie_cache_;
   scoped_ptr<webkit_blob::BlobStorageController> blob_storage_controller_;
-  scoped_refptr<fileapi::FileSystemContext> file_system_context_;
   scoped_ptr<net::URLSecurityManager> url_security_manager_;
   bool accept_all_cookies_;
+
+  // Type of the current HTTP cache backend. Only accessed on the IO thread.
+  net::CacheType http_cache_type_;
+
+  // HTTP cache response counts. Only accessed on the IO thread.
+  int64 http_cache_hit_count_;
+  int64 http_cache_miss_count_;
+  int64 http_cache_validation_count_;
 };
 
 #endif  // _BROWSER_REQUEST_CONTEXT_H
@@ -32,19 +32,24 @@
 // alternate implementation that defers fetching to another process.
 
 #include "browser_appcache_system.h"
+#include "browser_cookie_cache.h"
 #include "browser_resource_loader_bridge.h"
 #include "browser_request_context.h"
 #include "browser_socket_stream_bridge.h"
 #include "browser_webkit_glue.h"
 #include "browser_impl.h"
 #include "cef_context.h"
+#include "cef_worker_pool.h"
 #include "cef_process.h"
 #include "cef_process_io_thread.h"
+#include "cef_trace.h"
 #include "external_protocol_handler.h"
+#include "request_context_impl.h"
 #include "request_impl.h"
 #include "response_impl.h"
 #include "http_header_utils.h"
 
+#include "base/atomicops.h"
 #include "base/file_path.h"
 #include "base/file_util.h"
 #include "base/memory/ref_counted.h"
@@ -56,6 +61,7 @@
 #include "base/threading/thread.h"
 #include "base/utf_string_conversions.h"
 #include "net/base/auth.h"
+#include "net/base/cookie_monster.h"
 #include "net/base/cookie_store.h"
 #include "net/base/file_stream.h"
 #include "net/base/io_buffer.h"
@@ -108,6 +114,36 @@ struct RequestParams {
 // The interval for calls to RequestProxy::MaybeUpdateUploadProgress
 static const int kUpdateUploadProgressIntervalMsec = 100;
 
+// Number of RequestProxy objects that currently exist. Recorded as a trace
+// counter.
+base::subtle::Atomic32 g_request_proxy_count = 0;
+
+// Returns the network state for |context|, or the global request context if
+// |context| is NULL. Must be called on the IO thread.
+BrowserRequestContext* GetRequestContext(CefRequestContextImpl* context) {
+  if (context)
+    return context->GetBrowserRequestContext();
+  return _Context->request_context().get();
+}
+
+// Returns the network state used by |browser|, which may be NULL.
+BrowserRequestContext* GetBrowserRequestContext(CefRefPtr<CefBrowser> browser) {
+  CefRefPtr<CefRequestContextImpl> context;
+  if (browser.get())
+    context = static_cast<CefBrowserImpl*>(browser.get())->request_context();
+  return GetRequestContext(context.get());
+}
+
+// Returns the document.cookie cache for |context|, or for the global request
+// context if |context| is NULL. May be called on any thread.
+BrowserCookieCache* GetCookieCache(CefRequestContextImpl* context) {
+  if (context)
+    return context->cookie_cache();
+  scoped_refptr<BrowserRequestContext> request_context =
+      _Context->request_context();
+  return request_context.get() ? request_context->cookie_cache() : NULL;
+}
+
 class ExtraRequestInfo : public net::URLRequest::UserData {
 public:
   ExtraRequestInfo(ResourceType::Type resource_type)
@@ -138,6 +174,8 @@ class RequestProxy : public net::URLRequest::Delegate,
       browser_(browser),
       last_upload_position_(0)
   {
+    CEF_TRACE_COUNTER1("net", "RequestProxies",
+        base::subtle::NoBarrier_AtomicIncrement(&g_request_proxy_count, 1));
   }
 
   void DropPeer() {
@@ -148,6 +186,9 @@ class RequestProxy : public net::URLRequest::Delegate,
     peer_ = peer;
     owner_loop_ = MessageLoop::current();
 
+    CEF_TRACE_ASYNC_BEGIN0("net", "RequestProxy::Load",
+                           reinterpret_cast<intptr_t>(this));
+
     InitializeParams(params);
 
     // proxy over to the io thread
@@ -172,6 +213,9 @@ class RequestProxy : public net::URLRequest::Delegate,
   virtual ~RequestProxy() {
     // If we have a request, then we'd better be on the io thread!
     DCHECK(!request_.get() || CefThread::CurrentlyOn(CefThread::IO));
+
+    CEF_TRACE_COUNTER1("net", "RequestProxies",
+        base::subtle::NoBarrier_AtomicIncrement(&g_request_proxy_count, -1));
   }
 
   virtual void InitializeParams(RequestParams* params) {
@@ -224,8 +268,13 @@ class RequestProxy : public net::URLRequest::Delegate,
           response->SetStatus(info.headers->response_code());
         }
         response->SetMimeType(info.mime_type);
-        handler->OnResourceResponse(browser_, url.spec(), response,
-            content_filter_);
+        {
+          CEF_TRACE_EVENT0("client", "CefRequestHandler::OnResourceResponse");
+          handler->OnResourceResponse(browser_, url.spec(), response,
+              content_filter_);
+        }
+        if (content_filter_.get() && content_filter_->UseWorkerThread())
+          filter_sequence_ = new CefWorkerSequence();
 
         std::string content_disposition;
         info.headers->GetNormalizedHeader("Content-Disposition",
@@ -251,6 +300,8 @@ class RequestProxy : public net::URLRequest::Delegate,
   }
 
   void NotifyReceivedData(int bytes_read) {
+    CEF_TRACE_EVENT1("net", "RequestProxy::NotifyReceivedData", "bytes",
+                     bytes_read);
     if (!peer_)
       return;
 
@@ -268,29 +319,39 @@ class RequestProxy : public net::URLRequest::Delegate,
     CefThread::PostTask(CefThread::IO, FROM_HERE, NewRunnableMethod(
         this, &RequestProxy::AsyncReadData));
 
-    CefRefPtr<CefStreamReader> resourceStream;
+    if (content_filter_.get()) {
+      // Filter the data on the worker pool if the filter allows it, otherwise
+      // on this thread. The result is delivered to NotifyFilteredData in the
+      // order it was received.
+      std::string data(buf_copy.get(), bytes_read);
+      if (!filter_sequence_.get() ||
+          !filter_sequence_->PostTask(FROM_HERE, NewRunnableMethod(
+              this, &RequestProxy::FilterData, data))) {
+        FilterData(data);
+      }
+      return;
+    }
 
-    if(content_filter_.get())
-      content_filter_->ProcessData(buf_copy.get(), bytes_read, resourceStream);
-    
-    if (resourceStream.get()) {
-      // The filter made some changes to the data in the buffer.
-      resourceStream->Seek(0, SEEK_END);
-      bytes_read = resourceStream->Tell();
-      resourceStream->Seek(0, SEEK_SET);
+    DeliverData(buf_copy.get(), bytes_read);
+  }
 
-      buf_copy.reset(new char[bytes_read]);
-      resourceStream->Read(buf_copy.get(), 1, bytes_read);
-    }
+  void NotifyFilteredData(const std::string& data) {
+    if (!peer_)
+      return;
+
+    DeliverData(data.data(), static_cast<int>(data.size()));
+  }
 
+  void DeliverData(const char* data, int size) {
     if (download_handler_.get() &&
-        !download_handler_->ReceivedData(buf_copy.get(), bytes_read)) {
+        !download_handler_->ReceivedData(data, size)) {
       // Cancel loading by proxying over to the io thread.
       CefThread::PostTask(CefThread::IO, FROM_HERE, NewRunnableMethod(
           this, &RequestProxy::AsyncCancel));
     }
 
-    peer_->OnReceivedData(buf_copy.get(), bytes_read, -1);
+    if (peer_)
+      peer_->OnReceivedData(data, size, -1);
   }
 
   void NotifyDownloadedData(int bytes_read) {
@@ -308,33 +369,39 @@ class RequestProxy : public net::URLRequest::Delegate,
                               const std::string& security_info,
                               const base::Time& complete_time) {
 
-    // Drain the content filter of all remaining data 
     if (content_filter_.get()) {
-      CefRefPtr<CefStreamReader> remainder;
-      content_filter_->Drain(remainder);
-
-      if(remainder.get()) {
-        remainder->Seek(0, SEEK_END);
-        long size = remainder->Tell();
-        if (size) {
-          remainder->Seek(0, SEEK_SET);
-          scoped_array<char> buf(new char[size]);
-          remainder->Read(buf.get(), 1, size);
-
-          if (download_handler_.get() &&
-              !download_handler_->ReceivedData(buf.get(), size)) {
-            // Cancel loading by proxying over to the io thread.
-            CefThread::PostTask(CefThread::IO, FROM_HERE, NewRunnableMethod(
-                this, &RequestProxy::AsyncCancel));
-          }
-
-          if (peer_)
-            peer_->OnReceivedData(buf.get(), size, -1);
-        }
+      // Drain the content filter after any data that is still being filtered.
+      if (!filter_sequence_.get() ||
+          !filter_sequence_->PostTask(FROM_HERE, NewRunnableMethod(
+              this, &RequestProxy::DrainFilter, status, security_info,
+              complete_time))) {
+        DrainFilter(status, security_info, complete_time);
       }
-      content_filter_ = NULL;
+      return;
     }
 
+    CompleteRequest(status, security_info, complete_time);
+  }
+
+  void NotifyFilterDrained(const std::string& remainder,
+                           const net::URLRequestStatus& status,
+                           const std::string& security_info,
+                           const base::Time& complete_time) {
+    content_filter_ = NULL;
+    filter_sequence_ = NULL;
+
+    if (!remainder.empty())
+      DeliverData(remainder.data(), static_cast<int>(remainder.size()));
+
+    CompleteRequest(status, security_info, complete_time);
+  }
+
+  void CompleteRequest(const net::URLRequestStatus& status,
+                       const std::string& security_info,
+                       const base::Time& complete_time) {
+    CEF_TRACE_ASYNC_END0("net", "RequestProxy::Load",
+                         reinterpret_cast<intptr_t>(this));
+
     if (download_handler_.get()) {
       download_handler_->Complete();
       download_handler_ = NULL;
@@ -351,11 +418,72 @@ class RequestProxy : public net::URLRequest::Delegate,
       peer_->OnUploadProgress(position, size);
   }
 
+  // --------------------------------------------------------------------------
+  // The following methods are called one at a time and in order for requests
+  // that have a content filter, on the worker pool if the filter uses it and
+  // otherwise on the owner's thread. The results are posted back to the
+  // owner's thread.
+
+  static void ReadStream(CefRefPtr<CefStreamReader> stream,
+                         std::string* data) {
+    stream->Seek(0, SEEK_END);
+    long size = stream->Tell();
+    stream->Seek(0, SEEK_SET);
+
+    data->resize(size);
+    if (size > 0)
+      data->resize(stream->Read(&(*data)[0], 1, size));
+  }
+
+  void FilterData(const std::string& data) {
+    CEF_TRACE_EVENT1("client", "CefContentFilter::ProcessData", "bytes",
+                     data.size());
+    CefRefPtr<CefStreamReader> resourceStream;
+    content_filter_->ProcessData(data.data(), static_cast<int>(data.size()),
+                                 resourceStream);
+
+    if (resourceStream.get()) {
+      // The filter made some changes to the data in the buffer.
+      std::string filtered;
+      ReadStream(resourceStream, &filtered);
+      DeliverFilteredData(filtered);
+    } else {
+      DeliverFilteredData(data);
+    }
+  }
+
+  void DeliverFilteredData(const std::string& data) {
+    // Filters that don't run on the worker pool run on the owner's thread and
+    // can deliver the data without another trip through the message loop.
+    if (MessageLoop::current() == owner_loop_) {
+      NotifyFilteredData(data);
+    } else {
+      owner_loop_->PostTask(FROM_HERE, NewRunnableMethod(
+          this, &RequestProxy::NotifyFilteredData, data));
+    }
+  }
+
+  void DrainFilter(const net::URLRequestStatus& status,
+                   const std::string& security_info,
+                   const base::Time& complete_time) {
+    CefRefPtr<CefStreamReader> remainder;
+    content_filter_->Drain(remainder);
+
+    std::string data;
+    if (remainder.get())
+      ReadStream(remainder, &data);
+
+    owner_loop_->PostTask(FROM_HERE, NewRunnableMethod(
+        this, &RequestProxy::NotifyFilterDrained, data, status, security_info,
+        complete_time));
+  }
+
   // --------------------------------------------------------------------------
   // The following methods are called on the io thread.  They correspond to
   // actions performed on the owner's thread.
 
   void AsyncStart(RequestParams* params) {
+    CEF_TRACE_EVENT0("net", "RequestProxy::AsyncStart");
     bool handled = false;
 
     if (browser_.get()) {
@@ -395,8 +523,12 @@ class RequestProxy : public net::URLRequest::Delegate,
         CefRefPtr<CefStreamReader> resourceStream;
         CefRefPtr<CefResponse> response(new CefResponseImpl());
 
-        handled = handler->OnBeforeResourceLoad(browser_, request, redirectUrl,
-            resourceStream, response, loadFlags);
+        {
+          CEF_TRACE_EVENT0("client",
+                           "CefRequestHandler::OnBeforeResourceLoad");
+          handled = handler->OnBeforeResourceLoad(browser_, request,
+              redirectUrl, resourceStream, response, loadFlags);
+        }
         if (!handled) {
           // Observe URL from request.
           const std::string requestUrl(request->GetURL());
@@ -512,7 +644,7 @@ class RequestProxy : public net::URLRequest::Delegate,
       request_->SetExtraRequestHeaders(headers);
       request_->set_load_flags(params->load_flags);
       request_->set_upload(params->upload.get());
-      request_->set_context(_Context->request_context());
+      request_->set_context(GetBrowserRequestContext(browser_));
       request_->SetUserData(NULL, new ExtraRequestInfo(params->request_type));
       BrowserAppCacheSystem::SetExtraRequestInfo(
           request_.get(), params->appcache_host_id, params->request_type);
@@ -528,6 +660,7 @@ class RequestProxy : public net::URLRequest::Delegate,
         }
       }
 
+      start_time_ = base::Time::Now();
       request_->Start();
 
       if (request_.get() && request_->has_upload() &&
@@ -663,6 +796,17 @@ class RequestProxy : public net::URLRequest::Delegate,
 
   virtual void OnResponseStarted(net::URLRequest* request) OVERRIDE {
     if (request->status().is_success()) {
+      if (request->url().SchemeIs("http") || request->url().SchemeIs("https")) {
+        // The cache sets the request time of a revalidated entry to when the
+        // conditional request was sent, after this request started. An entry
+        // served without contacting the server keeps the request time of an
+        // earlier request.
+        bool validated = request->was_cached() &&
+                         request->request_time() >= start_time_;
+        static_cast<BrowserRequestContext*>(request->context())->
+            RecordHttpCacheResponse(request->was_cached(), validated);
+      }
+
       ResourceResponseInfo info;
       PopulateResponseInfo(request, &info);
       OnReceivedResponse(info, GURL::EmptyGURL());
@@ -839,8 +983,15 @@ class RequestProxy : public net::URLRequest::Delegate,
   uint64 last_upload_position_;
   base::TimeTicks last_upload_ticks_;
 
+  // Time that the request was started. Used to detect cache validations.
+  base::Time start_time_;
+
   CefRefPtr<CefDownloadHandler> download_handler_;
   CefRefPtr<CefContentFilter> content_filter_;
+
+  // Runs the content filter on the worker pool. Only set if |content_filter_|
+  // is non-NULL and its UseWorkerThread() method returned true.
+  scoped_refptr<CefWorkerSequence> filter_sequence_;
 };
 
 //-----------------------------------------------------------------------------
@@ -894,6 +1045,9 @@ class SyncRequestProxy : public RequestProxy {
     if (download_to_file_)
       file_stream_.Close();
     
+    CEF_TRACE_ASYNC_END0("net", "RequestProxy::Load",
+                         reinterpret_cast<intptr_t>(this));
+
     result_->status = status;
     event_.Signal();
   }
@@ -1026,10 +1180,12 @@ class ResourceLoaderBridgeImpl : public ResourceLoaderBridge {
 
 class CookieSetter : public base::RefCountedThreadSafe<CookieSetter> {
  public:
-  void Set(const GURL& url, const std::string& cookie) {
+  void Set(CefRefPtr<CefRequestContextImpl> context, const GURL& url,
+           const std::string& cookie) {
     REQUIRE_IOT();
+    BrowserRequestContext* request_context = GetRequestContext(context.get());
     net::CookieStore* cookie_store =
-        _Context->request_context()->cookie_store();
+        request_context ? request_context->cookie_store() : NULL;
     if (cookie_store)
       cookie_store->SetCookie(url, cookie);
   }
@@ -1045,11 +1201,28 @@ class CookieGetter : public base::RefCountedThreadSafe<CookieGetter> {
   CookieGetter() : event_(false, false) {
   }
 
-  void Get(const GURL& url) {
+  void Get(CefRefPtr<CefRequestContextImpl> context, const GURL& url) {
+    BrowserRequestContext* request_context = GetRequestContext(context.get());
     net::CookieStore* cookie_store =
-        _Context->request_context()->cookie_store();
-    if (cookie_store)
+        request_context ? request_context->cookie_store() : NULL;
+    if (cookie_store) {
       result_ = cookie_store->GetCookies(url);
+
+      // The result can be cached until the first of its cookies expires.
+      // GetCookies() has already read the cookies if they are loaded on
+      // demand.
+      net::CookieMonster* cookie_monster = cookie_store->GetCookieMonster();
+      if (cookie_monster && !result_.empty()) {
+        net::CookieList list = cookie_monster->GetAllCookiesForURL(url);
+        for (net::CookieList::const_iterator it = list.begin();
+             it != list.end(); ++it) {
+          if (!it->DoesExpire())
+            continue;
+          if (expires_.is_null() || it->ExpiryDate() < expires_)
+            expires_ = it->ExpiryDate();
+        }
+      }
+    }
     event_.Signal();
   }
 
@@ -1059,6 +1232,9 @@ class CookieGetter : public base::RefCountedThreadSafe<CookieGetter> {
     return result_;
   }
 
+  // Only valid after GetResult() returns.
+  const base::Time& expires() const { return expires_; }
+
  private:
   friend class base::RefCountedThreadSafe<CookieGetter>;
 
@@ -1066,6 +1242,7 @@ class CookieGetter : public base::RefCountedThreadSafe<CookieGetter> {
 
   base::WaitableEvent event_;
   std::string result_;
+  base::Time expires_;
 };
 
 }  // anonymous namespace
@@ -1087,25 +1264,47 @@ ResourceLoaderBridge* ResourceLoaderBridge::Create(
 //-----------------------------------------------------------------------------
 
 // static
-void BrowserResourceLoaderBridge::SetCookie(const GURL& url,
+void BrowserResourceLoaderBridge::SetCookie(CefRequestContextImpl* context,
+                                            const GURL& url,
                                             const GURL& first_party_for_cookies,
                                             const std::string& cookie) {
+  // The next read must wait for the change.
+  BrowserCookieCache* cookie_cache = GetCookieCache(context);
+  if (cookie_cache)
+    cookie_cache->InvalidateURL(url);
+
   // Proxy to IO thread to synchronize w/ network loading.
   scoped_refptr<CookieSetter> cookie_setter = new CookieSetter();
   CefThread::PostTask(CefThread::IO, FROM_HERE, NewRunnableMethod(
-      cookie_setter.get(), &CookieSetter::Set, url, cookie));
+      cookie_setter.get(), &CookieSetter::Set,
+      CefRefPtr<CefRequestContextImpl>(context), url, cookie));
 }
 
 // static
 std::string BrowserResourceLoaderBridge::GetCookies(
-    const GURL& url, const GURL& first_party_for_cookies) {
+    CefRequestContextImpl* context, const GURL& url,
+    const GURL& first_party_for_cookies) {
+  // Serve repeated reads from the cache. Entries are invalidated by the cookie
+  // monster when cookies change.
+  BrowserCookieCache* cookie_cache = GetCookieCache(context);
+  std::string cookie_line;
+  int64 generation = 0;
+  if (cookie_cache && cookie_cache->Lookup(url, &cookie_line, &generation))
+    return cookie_line;
+
   // Proxy to IO thread to synchronize w/ network loading.
   scoped_refptr<CookieGetter> cookie_getter = new CookieGetter();
   CefThread::PostTask(CefThread::IO, FROM_HERE, NewRunnableMethod(
-      cookie_getter.get(), &CookieGetter::Get, url));
+      cookie_getter.get(), &CookieGetter::Get,
+      CefRefPtr<CefRequestContextImpl>(context), url));
 
   // Blocks until the result is available.
-  return cookie_getter->GetResult();
+  cookie_line = cookie_getter->GetResult();
+  if (cookie_cache) {
+    cookie_cache->Store(url, cookie_line, cookie_getter->expires(),
+                        generation);
+  }
+  return cookie_line;
 }
 
 // static
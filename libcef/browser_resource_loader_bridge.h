@@ -9,15 +9,19 @@
 #include <string>
 #include "base/message_loop_proxy.h"
 
+class CefRequestContextImpl;
 class GURL;
 
 class BrowserResourceLoaderBridge {
  public:
-  // May only be called after Init.
-  static void SetCookie(const GURL& url,
+  // May only be called after Init. |context| is NULL for the global request
+  // context.
+  static void SetCookie(CefRequestContextImpl* context,
+                        const GURL& url,
                         const GURL& first_party_for_cookies,
                         const std::string& cookie);
-  static std::string GetCookies(const GURL& url,
+  static std::string GetCookies(CefRequestContextImpl* context,
+                                const GURL& url,
                                 const GURL& first_party_for_cookies);
   static void SetAcceptAllCookies(bool accept_all_cookies);
 
@@ -4,22 +4,35 @@
 
 #include "browser_webcookiejar_impl.h"
 #include "browser_resource_loader_bridge.h"
+#include "request_context_impl.h"
 
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebURL.h"
 
 using WebKit::WebString;
 using WebKit::WebURL;
 
+BrowserWebCookieJarImpl::BrowserWebCookieJarImpl() {
+}
+
+BrowserWebCookieJarImpl::BrowserWebCookieJarImpl(
+    CefRequestContextImpl* context)
+    : context_(context) {
+}
+
+BrowserWebCookieJarImpl::~BrowserWebCookieJarImpl() {
+}
+
 void BrowserWebCookieJarImpl::setCookie(const WebURL& url,
                                        const WebURL& first_party_for_cookies,
                                        const WebString& value) {
   BrowserResourceLoaderBridge::SetCookie(
-      url, first_party_for_cookies, value.utf8());
+      context_.get(), url, first_party_for_cookies, value.utf8());
 }
 
 WebString BrowserWebCookieJarImpl::cookies(
     const WebURL& url,
     const WebURL& first_party_for_cookies) {
   return WebString::fromUTF8(
-      BrowserResourceLoaderBridge::GetCookies(url, first_party_for_cookies));
+      BrowserResourceLoaderBridge::GetCookies(context_.get(), url,
+                                              first_party_for_cookies));
 }
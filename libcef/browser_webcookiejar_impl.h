@@ -8,15 +8,27 @@
 // TODO(darin): WebCookieJar.h is missing a WebString.h include!
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebString.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebCookieJar.h"
+#include "include/cef.h"
+
+class CefRequestContextImpl;
 
 class BrowserWebCookieJarImpl : public WebKit::WebCookieJar {
  public:
+  // Use the global request context.
+  BrowserWebCookieJarImpl();
+  // Use the cookie store of |context|.
+  explicit BrowserWebCookieJarImpl(CefRequestContextImpl* context);
+  virtual ~BrowserWebCookieJarImpl();
+
   // WebKit::WebCookieJar methods:
   virtual void setCookie(
       const WebKit::WebURL& url, const WebKit::WebURL& first_party_for_cookies,
       const WebKit::WebString& cookie);
   virtual WebKit::WebString cookies(
       const WebKit::WebURL& url, const WebKit::WebURL& first_party_for_cookies);
+
+ private:
+  CefRefPtr<CefRequestContextImpl> context_;
 };
 
 #endif  // _BROWSER_SIMPLE_WEBCOOKIEJAR_IMPL_H
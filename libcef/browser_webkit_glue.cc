@@ -11,14 +11,19 @@ MSVC_PUSH_WARNING_LEVEL(0);
 #include "CrossOriginPreflightResultCache.h"
 #include "DocumentLoader.h"
 #include "MemoryCache.h"
+#include "Page.h"
+#include "StorageNamespace.h"
 #include "TextEncoding.h"
 #include "third_party/WebKit/Source/WebKit/chromium/src/WebFrameImpl.h"
+#include "third_party/WebKit/Source/WebKit/chromium/src/WebViewImpl.h"
 MSVC_POP_WARNING();
 #undef LOG
 
 #include "browser_webkit_glue.h"
 #include "cef_context.h"
+#include "cef_startup_timer.h"
 
+#include "base/file_path.h"
 #include "base/logging.h"
 #include "base/path_service.h"
 #include "base/scoped_ptr.h"
@@ -45,8 +50,8 @@ bool IsMediaPlayerAvailable() {
 void GetPlugins(bool refresh,
                 std::vector<webkit::WebPluginInfo>* plugins) {
   if (refresh)
-    webkit::npapi::PluginList::Singleton()->RefreshPlugins();
-  webkit::npapi::PluginList::Singleton()->GetPlugins(plugins);
+    GetPluginList()->RefreshPlugins();
+  GetLoadedPluginList()->GetPlugins(plugins);
 }
 
 bool IsProtocolSupportedForMedia(const GURL& url) {
@@ -94,6 +99,62 @@ void ClearCache()
   WebCore::CrossOriginPreflightResultCache::shared().empty();
 }
 
+void ResetSessionStorage(WebKit::WebView* view)
+{
+  WebCore::Page* page = static_cast<WebKit::WebViewImpl*>(view)->page();
+  if (page)
+    page->setSessionStorage(NULL);
+}
+
+webkit::npapi::PluginList* GetPluginList()
+{
+  REQUIRE_UIT();
+
+  webkit::npapi::PluginList* plugin_list =
+      webkit::npapi::PluginList::Singleton();
+
+  static bool initialized = false;
+  if (!initialized) {
+    initialized = true;
+
+    const CefSettings& settings = _Context->settings();
+    if (settings.extra_plugin_paths) {
+      cef_string_t str;
+      memset(&str, 0, sizeof(str));
+
+      FilePath path;
+      int size = cef_string_list_size(settings.extra_plugin_paths);
+      for(int i = 0; i < size; ++i) {
+        if (!cef_string_list_value(settings.extra_plugin_paths, i, &str))
+          continue;
+        path = FilePath(CefString(&str));
+        plugin_list->AddExtraPluginPath(path);
+      }
+      cef_string_clear(&str);
+    }
+  }
+
+  return plugin_list;
+}
+
+webkit::npapi::PluginList* GetLoadedPluginList()
+{
+  webkit::npapi::PluginList* plugin_list = GetPluginList();
+
+  static bool loaded = false;
+  if (!loaded) {
+    loaded = true;
+    CefStartupTimer timer(CefStartupTimer::PLUGIN_INIT);
+
+    // Load the plugins now so that the time is included in the startup
+    // timings instead of the first query.
+    std::vector<webkit::WebPluginInfo> plugins;
+    plugin_list->GetPlugins(&plugins);
+  }
+
+  return plugin_list;
+}
+
 std::string BuildUserAgent(bool mimic_windows) {
   std::string product_version;
 
@@ -173,7 +234,7 @@ bool ShouldDownload(const std::string& content_disposition,
   // Finally, check the plugin list.
   bool allow_wildcard = false;
   std::vector<webkit::WebPluginInfo> plugins;
-  webkit::npapi::PluginList::Singleton()->GetPluginInfoArray(
+  GetLoadedPluginList()->GetPluginInfoArray(
       GURL(), type, allow_wildcard, NULL, &plugins, NULL);
   
   // If any associated plugins exist and are enabled don't allow the download.
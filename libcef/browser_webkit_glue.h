@@ -19,6 +19,12 @@ class WebView;
 class FilePath;
 #endif
 
+namespace webkit {
+namespace npapi {
+class PluginList;
+}
+}
+
 namespace webkit_glue {
 
 #if defined(OS_WIN)
@@ -51,6 +57,20 @@ v8::Handle<v8::Context> GetV8Context(WebKit::WebFrame* frame);
 // Clear all cached data.
 void ClearCache();
 
+// Release the sessionStorage namespace used by |view|. A new, empty namespace
+// will be created the next time a document in |view| uses sessionStorage.
+void ResetSessionStorage(WebKit::WebView* view);
+
+// Returns the plugin list. The first call adds the extra plugin paths from
+// CefSettings. The plugins are not loaded so this may be used to register
+// internal plugins before the first query. Must be called on the UI thread.
+webkit::npapi::PluginList* GetPluginList();
+
+// Returns the plugin list after loading it. Use this method instead of
+// GetPluginList() before querying the plugins so that the load time is
+// recorded in the startup timings. Must be called on the UI thread.
+webkit::npapi::PluginList* GetLoadedPluginList();
+
 // Returns true if the request represents a download based on
 // the supplied Content-Type and Content-Disposition headers.
 bool ShouldDownload(const std::string& content_disposition,
@@ -48,16 +48,8 @@ BrowserWebKitInit::BrowserWebKitInit() {
       PathService::Get(base::DIR_MODULE, &module_path) &&
       media::InitializeMediaLibrary(module_path));
 
-  // Construct and initialize an appcache system for this scope.
-  // A new empty temp directory is created to house any cached
-  // content during the run. Upon exit that directory is deleted.
-  // If we can't create a tempdir, we'll use in-memory storage.
-  if (!appcache_dir_.CreateUniqueTempDir()) {
-    LOG(WARNING) << "Failed to create a temp dir for the appcache, "
-                    "using in-memory storage.";
-    DCHECK(appcache_dir_.path().empty());
-  }
-  BrowserAppCacheSystem::InitializeOnUIThread(appcache_dir_.path());
+  // The appcache system, the database system and the file system are
+  // initialized when first used.
 
   WebKit::WebDatabase::setObserver(&database_system_);
 
@@ -12,7 +12,6 @@
 #include "browser_webblobregistry_impl.h"
 #include "browser_webcookiejar_impl.h"
 
-#include "base/scoped_temp_dir.h"
 #include "webkit/glue/simple_webmimeregistry_impl.h"
 #include "webkit/glue/webclipboard_impl.h"
 #include "webkit/glue/webfileutilities_impl.h"
@@ -79,7 +78,6 @@ class BrowserWebKitInit : public webkit_glue::WebKitPlatformSupportImpl {
   webkit_glue::SimpleWebMimeRegistryImpl mime_registry_;
   webkit_glue::WebClipboardImpl clipboard_;
   webkit_glue::WebFileUtilitiesImpl file_utilities_;
-  ScopedTempDir appcache_dir_;
   BrowserAppCacheSystem appcache_system_;
   BrowserDatabaseSystem database_system_;
   BrowserWebCookieJarImpl cookie_jar_;
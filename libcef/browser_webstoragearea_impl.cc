@@ -17,39 +17,64 @@ using WebKit::WebURL;
 using WebKit::WebView;
 
 BrowserWebStorageAreaImpl::BrowserWebStorageAreaImpl(
-    int64 namespace_id, const WebString& origin) {
-  area_ = _Context->storage_context()->GetStorageNamespace(namespace_id, true)->
-      GetStorageArea(origin);
-  DCHECK(area_ != NULL);
+    int64 namespace_id, const WebString& origin)
+    : namespace_id_(namespace_id),
+      origin_(origin) {
+  // Create the namespace and the area on first use.
+  DOMStorageNamespace* storage_namespace =
+      _Context->storage_context()->GetStorageNamespace(namespace_id, true);
+  DCHECK(storage_namespace != NULL);
+  storage_namespace->GetStorageArea(origin_);
 }
 
 BrowserWebStorageAreaImpl::~BrowserWebStorageAreaImpl() {
 }
 
 unsigned BrowserWebStorageAreaImpl::length() {
-  return area_->Length();
+  DOMStorageArea* area = GetArea();
+  return area ? area->Length() : 0;
 }
 
 WebString BrowserWebStorageAreaImpl::key(unsigned index) {
-  return area_->Key(index);
+  DOMStorageArea* area = GetArea();
+  return area ? area->Key(index) : WebString();
 }
 
 WebString BrowserWebStorageAreaImpl::getItem(const WebString& key) {
-  return area_->GetItem(key);
+  DOMStorageArea* area = GetArea();
+  return area ? area->GetItem(key) : WebString();
 }
 
 void BrowserWebStorageAreaImpl::setItem(
     const WebString& key, const WebString& value, const WebURL& url,
     WebStorageArea::Result& result, WebString& old_value_webkit) {
-  old_value_webkit = area_->SetItem(key, value, &result);
+  DOMStorageArea* area = GetArea();
+  if (!area) {
+    result = ResultBlockedByPolicy;
+    old_value_webkit = WebString();
+    return;
+  }
+  old_value_webkit = area->SetItem(key, value, &result);
 }
 
 void BrowserWebStorageAreaImpl::removeItem(
     const WebString& key, const WebURL& url, WebString& old_value_webkit) {
-  old_value_webkit = area_->RemoveItem(key);
+  DOMStorageArea* area = GetArea();
+  old_value_webkit = area ? area->RemoveItem(key) : WebString();
 }
 
 void BrowserWebStorageAreaImpl::clear(
     const WebURL& url, bool& cleared_something) {
-  cleared_something = area_->Clear();
+  DOMStorageArea* area = GetArea();
+  cleared_something = area ? area->Clear() : false;
+}
+
+DOMStorageArea* BrowserWebStorageAreaImpl::GetArea() {
+  if (!_Context.get() || !_Context->storage_context())
+    return NULL;
+  DOMStorageNamespace* storage_namespace =
+      _Context->storage_context()->GetStorageNamespace(namespace_id_, false);
+  if (!storage_namespace)
+    return NULL;
+  return storage_namespace->GetStorageArea(origin_);
 }
@@ -6,6 +6,7 @@
 #define _BROWSER_WEBSTORAGEAREA_IMPL_H
 
 #include "base/basictypes.h"
+#include "base/string16.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebStorageArea.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebString.h"
 
@@ -30,8 +31,13 @@ class BrowserWebStorageAreaImpl : public WebKit::WebStorageArea {
   virtual void clear(const WebKit::WebURL& url, bool& cleared_something);
 
  private:
-  // The object is owned by DOMStorageNamespace.
-  DOMStorageArea* area_;
+  // Returns the area or NULL if the namespace has been deleted. The area is
+  // owned by DOMStorageNamespace and looked up on each call because WebKit may
+  // keep this object after the namespace is deleted.
+  DOMStorageArea* GetArea();
+
+  int64 namespace_id_;
+  string16 origin_;
 };
 
 #endif  // _BROWSER_WEBSTORAGEAREA_IMPL_H
@@ -27,6 +27,11 @@ BrowserWebStorageNamespaceImpl::BrowserWebStorageNamespaceImpl(
 }
 
 BrowserWebStorageNamespaceImpl::~BrowserWebStorageNamespaceImpl() {
+  // The sessionStorage namespace is released with the page that owns it.
+  if (storage_type_ == DOM_STORAGE_SESSION && _Context.get() &&
+      IsStorageActive()) {
+    _Context->storage_context()->DeleteSessionStorageNamespace(namespace_id_);
+  }
 }
 
 WebStorageArea* BrowserWebStorageNamespaceImpl::createStorageArea(
@@ -39,11 +44,14 @@ WebStorageArea* BrowserWebStorageNamespaceImpl::createStorageArea(
 }
 
 WebStorageNamespace* BrowserWebStorageNamespaceImpl::copy() {
-  // By returning NULL, we're telling WebKit to lazily fetch it the next time
-  // session storage is used.  In the WebViewClient::createView, we do the
-  // book-keeping necessary to make it a true copy-on-write despite not doing
-  // anything here, now.
-  return NULL;
+  // Called when a popup is opened. The copy shares the items with this
+  // namespace until either side changes them.
+  if (storage_type_ != DOM_STORAGE_SESSION || !IsStorageActive())
+    return NULL;
+
+  int64 clone_id =
+      _Context->storage_context()->CopySessionStorage(namespace_id_);
+  return new BrowserWebStorageNamespaceImpl(DOM_STORAGE_SESSION, clone_id);
 }
 
 void BrowserWebStorageNamespaceImpl::close() {
@@ -13,9 +13,12 @@
 #include "browser_impl.h"
 #include "browser_navigation_controller.h"
 #include "browser_web_worker.h"
+#include "browser_webcookiejar_impl.h"
 #include "browser_webkit_glue.h"
+#include "browser_webstoragenamespace_impl.h"
 #include "browser_zoom_map.h"
 #include "cef_context.h"
+#include "cef_trace.h"
 #include "request_impl.h"
 #include "v8_impl.h"
 
@@ -180,9 +183,14 @@ WebWidget* BrowserWebViewDelegate::createPopupMenu(WebPopupType popup_type) {
 
 WebStorageNamespace* BrowserWebViewDelegate::createSessionStorageNamespace(
     unsigned quota) {
-  // Enforce quota, ignoring the parameter from WebCore as in Chrome. We could
-  // potentially use DOMStorageContext to manage session storage but there's
-  // currently no need since session storage data is not written to disk.
+  // Use DOMStorageContext so that the namespace is copied without copying its
+  // items when a popup is opened.
+  if (BrowserWebStorageNamespaceImpl::IsStorageActive()) {
+    return new BrowserWebStorageNamespaceImpl(DOM_STORAGE_SESSION,
+        _Context->storage_context()->AllocateSessionStorageNamespaceId());
+  }
+
+  // Enforce quota, ignoring the parameter from WebCore as in Chrome.
   return WebKit::WebStorageNamespace::createSessionStorageNamespace(
       WebStorageNamespace::m_sessionStorageQuota);
 }
@@ -483,7 +491,7 @@ int BrowserWebViewDelegate::historyForwardListCount() {
 // WebPluginPageDelegate -----------------------------------------------------
 
 WebCookieJar* BrowserWebViewDelegate::GetCookieJar() {
-  return WebKit::webKitPlatformSupport()->cookieJar();
+  return cookieJar(NULL);
 }
 
 // WebWidgetClient -----------------------------------------------------------
@@ -578,7 +586,7 @@ WebPlugin* BrowserWebViewDelegate::createPlugin(
   bool allow_wildcard = true;
   std::vector<webkit::WebPluginInfo> plugins;
   std::vector<std::string> mime_types;
-  webkit::npapi::PluginList::Singleton()->GetPluginInfoArray(
+  webkit_glue::GetLoadedPluginList()->GetPluginInfoArray(
       params.url, params.mimeType.utf8(), allow_wildcard,
       NULL, &plugins, &mime_types);
   if (plugins.empty())
@@ -667,6 +675,16 @@ WebApplicationCacheHost* BrowserWebViewDelegate::createApplicationCacheHost(
   return BrowserAppCacheSystem::CreateApplicationCacheHost(client);
 }
 
+WebCookieJar* BrowserWebViewDelegate::cookieJar(WebFrame* frame) {
+  CefRefPtr<CefRequestContextImpl> context = browser_->request_context();
+  if (!context.get())
+    return WebKit::webKitPlatformSupport()->cookieJar();
+
+  if (!cookie_jar_.get())
+    cookie_jar_.reset(new BrowserWebCookieJarImpl(context.get()));
+  return cookie_jar_.get();
+}
+
 void BrowserWebViewDelegate::willClose(WebFrame* frame) {
   browser_->UIT_BeforeFrameClosed(frame);
 }
@@ -834,6 +852,7 @@ void BrowserWebViewDelegate::didCommitProvisionalLoad(
     CefRefPtr<CefLoadHandler> handler = client->GetLoadHandler();
     if (handler.get()) {
       // Notify the handler that loading has started.
+      CEF_TRACE_EVENT0("client", "CefLoadHandler::OnLoadStart");
       handler->OnLoadStart(browser_, browser_->UIT_GetCefFrame(frame));
     }
   }
@@ -1025,6 +1044,7 @@ void BrowserWebViewDelegate::LocationChangeDone(WebFrame* frame) {
   if (handler.get()) {
     // Notify the handler that loading has ended.
     int httpStatusCode = frame->dataSource()->response().httpStatusCode();
+    CEF_TRACE_EVENT0("client", "CefLoadHandler::OnLoadEnd");
     handler->OnLoadEnd(browser_, browser_->UIT_GetCefFrame(frame),
         httpStatusCode);
   }
@@ -34,6 +34,7 @@
 
 #if defined(OS_WIN)
 class BrowserDragDelegate;
+class BrowserWebCookieJarImpl;
 class WebDropTarget;
 #endif
 
@@ -147,6 +148,7 @@ class BrowserWebViewDelegate : public WebKit::WebViewClient,
   virtual WebKit::WebApplicationCacheHost* createApplicationCacheHost(
     WebKit::WebFrame* frame, WebKit::WebApplicationCacheHostClient* client)
     OVERRIDE;
+  virtual WebKit::WebCookieJar* cookieJar(WebKit::WebFrame*) OVERRIDE;
   virtual void willClose(WebKit::WebFrame*) OVERRIDE;
   virtual void loadURLExternally(
       WebKit::WebFrame*, const WebKit::WebURLRequest&,
@@ -313,6 +315,9 @@ class BrowserWebViewDelegate : public WebKit::WebViewClient,
 
   scoped_ptr<BrowserExtraData> pending_extra_data_;
 
+  // Only created if the browser uses its own request context.
+  scoped_ptr<BrowserWebCookieJarImpl> cookie_jar_;
+
   WebCursor current_cursor_;
 #if defined(OS_WIN)
   // Classes needed by drag and drop.
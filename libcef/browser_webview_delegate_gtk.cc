@@ -282,6 +282,10 @@ void BrowserWebViewDelegate::showContextMenu(WebKit::WebFrame* frame, const WebK
       goto end;
   }
 
+  // The default context menu requires a window.
+  if (browser_->IsWindowRenderingDisabled())
+    goto end;
+
   // Build the correct default context menu
   if (type_flags &  MENUTYPE_EDITABLE) {
     menu = gtk_menu_new();
@@ -385,6 +389,19 @@ void BrowserWebViewDelegate::handleContextMenu(int selected_id)
 // WebWidgetClient ------------------------------------------------------------
 
 void BrowserWebViewDelegate::show(WebNavigationPolicy policy) {
+  if (browser_->IsWindowRenderingDisabled()) {
+    if (this == browser_->UIT_GetPopupDelegate()) {
+      // Notify the handler of popup visibility change.
+      CefRefPtr<CefClient> client = browser_->GetClient();
+      if (client.get()) {
+        CefRefPtr<CefRenderHandler> handler = client->GetRenderHandler();
+        if (handler.get())
+          handler->OnPopupShow(browser_, true);
+      }
+    }
+    return;
+  }
+
   WebWidgetHost* host = GetWidgetHost();
   GtkWidget* drawing_area = host->view_handle();
   GtkWidget* window =
@@ -414,10 +431,36 @@ void BrowserWebViewDelegate::didChangeCursor(const WebCursorInfo& cursor_info) {
       gdk_cursor = gfx::GetCursor(cursor_type);
   }
   cursor_type_ = cursor_type;
+
+  if (browser_->IsWindowRenderingDisabled()) {
+    // Notify the handler of cursor change.
+    CefRefPtr<CefClient> client = browser_->GetClient();
+    if (client.get()) {
+      CefRefPtr<CefRenderHandler> handler = client->GetRenderHandler();
+      if (handler.get())
+        handler->OnCursorChange(browser_, gdk_cursor);
+    }
+    return;
+  }
+
   gdk_window_set_cursor(browser_->UIT_GetWebViewWndHandle()->window, gdk_cursor);
 }
 
 WebRect BrowserWebViewDelegate::windowRect() {
+  if (browser_->IsWindowRenderingDisabled()) {
+    // Retrieve the view rectangle from the handler.
+    CefRefPtr<CefClient> client = browser_->GetClient();
+    if (client.get()) {
+      CefRefPtr<CefRenderHandler> handler = client->GetRenderHandler();
+      if (handler.get()) {
+        CefRect rect(0, 0, 0, 0);
+        if (handler->GetViewRect(browser_, rect))
+          return WebRect(rect.x, rect.y, rect.width, rect.height);
+      }
+    }
+    return WebRect();
+  }
+
   WebWidgetHost* host = GetWidgetHost();
   GtkWidget* drawing_area = host->view_handle();
   GtkWidget* vbox = gtk_widget_get_parent(drawing_area);
@@ -437,6 +480,22 @@ void BrowserWebViewDelegate::setWindowRect(const WebRect& rect) {
 	if (this == browser_->UIT_GetWebViewDelegate()) {
 		// TODO(port): Set the window rectangle.
   	} else if (this == browser_->UIT_GetPopupDelegate()) {
+    if (browser_->IsWindowRenderingDisabled()) {
+      browser_->set_popup_rect(rect);
+      browser_->UIT_GetPopupHost()->SetSize(rect.width, rect.height);
+
+      // Notify the handler of popup size change.
+      CefRefPtr<CefClient> client = browser_->GetClient();
+      if (client.get()) {
+        CefRefPtr<CefRenderHandler> handler = client->GetRenderHandler();
+        if (handler.get()) {
+          handler->OnPopupSize(browser_,
+              CefRect(rect.x, rect.y, rect.width, rect.height));
+        }
+      }
+      return;
+    }
+
     	WebWidgetHost* host = GetWidgetHost();
     	GtkWidget* drawing_area = host->view_handle();
     	GtkWidget* window =
@@ -447,6 +506,10 @@ void BrowserWebViewDelegate::setWindowRect(const WebRect& rect) {
 }
 
 WebRect BrowserWebViewDelegate::rootWindowRect() {
+  // There is no browser window when window rendering is disabled.
+  if (browser_->IsWindowRenderingDisabled())
+    return windowRect();
+
   if (WebWidgetHost* host = GetWidgetHost()) {
     // We are being asked for the x/y and width/height of the entire browser
     // window.  This means the x/y is the distance from the corner of the
@@ -487,8 +550,11 @@ webkit::npapi::WebPluginDelegate* BrowserWebViewDelegate::CreatePluginDelegate(
     const std::string& mime_type) {
   // TODO(evanm): we probably shouldn't be doing this mapping to X ids at
   // this level.
-  GdkNativeWindow plugin_parent =
-      GDK_WINDOW_XWINDOW(browser_->UIT_GetWebViewHost()->view_handle()->window);
+  // Windowed plugins are not supported when window rendering is disabled.
+  GdkNativeWindow plugin_parent = 0;
+  GtkWidget* view = browser_->UIT_GetWebViewHost()->view_handle();
+  if (view)
+    plugin_parent = GDK_WINDOW_XWINDOW(view->window);
 
   return webkit::npapi::WebPluginDelegateImpl::Create(path, mime_type,
       plugin_parent);
@@ -506,6 +572,9 @@ void BrowserWebViewDelegate::WillDestroyPluginWindow(
 
 void BrowserWebViewDelegate::DidMovePlugin(
     const webkit::npapi::WebPluginGeometry& move) {
+  if (browser_->IsWindowRenderingDisabled())
+    return;
+
   WebWidgetHost* host = GetWidgetHost();
   webkit::npapi::GtkPluginContainerManager* plugin_container_manager =
       static_cast<WebViewHost*>(host)->plugin_container_manager();
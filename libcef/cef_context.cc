@@ -4,16 +4,36 @@
 
 #include "cef_context.h"
 #include "browser_impl.h"
+#include "browser_cookie_snapshot.h"
+#include "browser_lazy_cookie_store.h"
+#include "browser_request_context.h"
 #include "browser_webkit_glue.h"
+#include "cef_startup_timer.h"
 #include "cef_thread.h"
+#include "cef_thread_stats.h"
 #include "cef_time_util.h"
+#include "cef_trace.h"
 #include "cef_process.h"
+#include "cef_worker_pool.h"
+#include "request_context_impl.h"
 #include "../include/cef_nplugin.h"
 
+#include <algorithm>
+
+#include "base/atomic_ref_count.h"
+#include "base/compiler_specific.h"
 #include "base/file_util.h"
+#include "base/string_util.h"
+#include "base/utf_string_conversions.h"
 #include "base/stringprintf.h"
 #include "base/synchronization/waitable_event.h"
+#include "base/time.h"
+#include "googleurl/src/url_canon.h"
 #include "net/base/cookie_monster.h"
+#include "net/base/net_util.h"
+#include "net/base/registry_controlled_domain.h"
+#include "net/http/http_response_headers.h"
+#include "net/http/http_util.h"
 #include "webkit/plugins/npapi/plugin_list.h"
 
 #if defined(OS_MACOSX) || defined(OS_WIN)
@@ -47,7 +67,7 @@ void UIT_RegisterPlugin(CefPluginInfo* plugin_info)
   entry_points.np_initialize = plugin_info->np_initialize;
   entry_points.np_shutdown = plugin_info->np_shutdown;
 
-  webkit::npapi::PluginList::Singleton()->RegisterInternalPlugin(filename,
+  webkit_glue::GetPluginList()->RegisterInternalPlugin(filename,
       name, description, mime_type, entry_points);
 
   delete plugin_info;
@@ -59,55 +79,179 @@ int GetThreadId(CefThreadId threadId)
   case TID_UI: return CefThread::UI;
   case TID_IO: return CefThread::IO;
   case TID_FILE: return CefThread::FILE;
+  case TID_WORKER: break;
   };
   NOTREACHED();
   return -1;
 }
 
-void IOT_VisitCookies(net::CookieMonster* cookie_monster,
-                      const net::CookieList& list,
+// Canonicalize the |domain| of an imported cookie as
+// CookieMonster::SetCookieWithDetails() does for a URL. A leading dot
+// identifies a domain cookie. Returns false if the domain is not a valid host,
+// or if it is an IP address or a public suffix such as "co.uk" for a domain
+// cookie.
+bool CanonicalizeCookieDomain(const std::string& domain, std::string* result)
+{
+  bool is_domain_cookie = (!domain.empty() && domain[0] == '.');
+  std::string host = is_domain_cookie ? domain.substr(1) : domain;
+
+  url_canon::CanonHostInfo host_info;
+  std::string canon_host = net::CanonicalizeHost(host, &host_info);
+  if (canon_host.empty())
+    return false;
+
+  if (is_domain_cookie) {
+    if (host_info.IsIPAddress())
+      return false;
+    if (net::RegistryControlledDomainService::GetDomainAndRegistry(
+            canon_host).empty()) {
+      return false;
+    }
+    *result = "." + canon_host;
+  } else {
+    *result = canon_host;
+  }
+  return true;
+}
+
+void SetCefCookie(const net::CookieMonster::CanonicalCookie& cc,
+                  CefCookie& cookie)
+{
+  CefString(&cookie.name).FromString(cc.Name());
+  CefString(&cookie.value).FromString(cc.Value());
+  CefString(&cookie.domain).FromString(cc.Domain());
+  CefString(&cookie.path).FromString(cc.Path());
+  cookie.secure = cc.IsSecure();
+  cookie.httponly = cc.IsHttpOnly();
+  cef_time_from_basetime(cc.CreationDate(), cookie.creation);
+  cef_time_from_basetime(cc.LastAccessDate(), cookie.last_access);
+  cookie.has_expires = cc.DoesExpire();
+  if (cookie.has_expires)
+    cef_time_from_basetime(cc.ExpiryDate(), cookie.expires);
+}
+
+// Visit the cookies in |list|. |count| is the number of cookies already
+// visited and is incremented for each cookie. Returns false if the visitor
+// stopped the loop.
+bool IOT_VisitCookies(net::CookieMonster* cookie_monster,
+                      const net::CookieList& list, int* count, int total,
                       CefRefPtr<CefCookieVisitor> visitor)
 {
-  int total = list.size(), count = 0;
-  
   net::CookieList::const_iterator it = list.begin();
-  for (; it != list.end(); ++it, ++count) {
+  for (; it != list.end(); ++it, ++(*count)) {
     CefCookie cookie;
     const net::CookieMonster::CanonicalCookie& cc = *(it);
-    
-    CefString(&cookie.name).FromString(cc.Name());
-    CefString(&cookie.value).FromString(cc.Value());
-    CefString(&cookie.domain).FromString(cc.Domain());
-    CefString(&cookie.path).FromString(cc.Path());
-    cookie.secure = cc.IsSecure();
-    cookie.httponly = cc.IsHttpOnly();
-    cef_time_from_basetime(cc.CreationDate(), cookie.creation);
-    cef_time_from_basetime(cc.LastAccessDate(), cookie.last_access);
-    cookie.has_expires = cc.DoesExpire();
-    if (cookie.has_expires)
-      cef_time_from_basetime(cc.ExpiryDate(), cookie.expires);
+    SetCefCookie(cc, cookie);
 
     bool deleteCookie = false;
-    bool keepLooping = visitor->Visit(cookie, count, total, deleteCookie);
+    bool keepLooping = visitor->Visit(cookie, *count, total, deleteCookie);
     if (deleteCookie)
       cookie_monster->DeleteCanonicalCookie(cc);
     if (!keepLooping)
-      break;
+      return false;
   }
+  return true;
 }
 
+// Passes the cookies read by BrowserRequestContext::VisitAllCookies() to a
+// CefCookieVisitor.
+class CookieVisitorAdapter : public BrowserLazyCookieStore::Visitor {
+ public:
+  CookieVisitorAdapter(net::CookieMonster* cookie_monster,
+                       CefRefPtr<CefCookieVisitor> visitor)
+      : cookie_monster_(cookie_monster), visitor_(visitor), count_(0) {}
+
+  virtual bool Visit(const net::CookieList& cookies, int total) OVERRIDE {
+    return IOT_VisitCookies(cookie_monster_, cookies, &count_, total,
+                            visitor_);
+  }
+
+ private:
+  net::CookieMonster* cookie_monster_;
+  CefRefPtr<CefCookieVisitor> visitor_;
+  int count_;
+};
+
 void IOT_VisitAllCookies(CefRefPtr<CefCookieVisitor> visitor)
 {
   REQUIRE_IOT();
 
-  net::CookieMonster* cookie_monster = static_cast<net::CookieMonster*>(
-      _Context->request_context()->cookie_store());
+  net::CookieMonster* cookie_monster =
+      _Context->request_context()->cookie_store()->GetCookieMonster();
+  if (!cookie_monster)
+    return;
+
+  // Cookies loaded on demand are read from the database a few keys at a time.
+  CookieVisitorAdapter adapter(cookie_monster, visitor);
+  _Context->request_context()->VisitAllCookies(&adapter);
+}
+
+// Passes the cookies read by BrowserRequestContext::VisitAllCookies() to a
+// CefCookieBatchVisitor in batches of a fixed size.
+class CookieBatchVisitorAdapter : public BrowserLazyCookieStore::Visitor {
+ public:
+  CookieBatchVisitorAdapter(int batch_size,
+                            CefRefPtr<CefCookieBatchVisitor> visitor)
+      : batch_size_(batch_size), visitor_(visitor), offset_(0), total_(0),
+        stopped_(false) {
+    batch_.reserve(batch_size);
+  }
+
+  virtual bool Visit(const net::CookieList& cookies, int total) OVERRIDE {
+    total_ = total;
+    for (size_t i = 0; i < cookies.size(); ++i) {
+      batch_.push_back(CefCookie());
+      SetCefCookie(cookies[i], batch_.back());
+      if (static_cast<int>(batch_.size()) == batch_size_ && !Flush())
+        return false;
+    }
+    return true;
+  }
+
+  // Visit the cookies collected so far. Returns false if the visitor stopped
+  // the loop.
+  bool Flush() {
+    if (stopped_)
+      return false;
+    if (batch_.empty())
+      return true;
+
+    stopped_ = !visitor_->Visit(batch_, offset_, total_);
+    offset_ += batch_.size();
+    batch_.clear();
+    return !stopped_;
+  }
+
+ private:
+  int batch_size_;
+  CefRefPtr<CefCookieBatchVisitor> visitor_;
+  std::vector<CefCookie> batch_;
+  int offset_;
+  int total_;
+  bool stopped_;
+};
+
+void IOT_VisitAllCookiesInBatches(int batchSize,
+                                  CefRefPtr<CefCookieBatchVisitor> visitor)
+{
+  REQUIRE_IOT();
+
+  net::CookieMonster* cookie_monster =
+      _Context->request_context()->cookie_store()->GetCookieMonster();
   if (!cookie_monster)
     return;
 
-  net::CookieList list = cookie_monster->GetAllCookies();
-  if (!list.empty())
-    IOT_VisitCookies(cookie_monster, list, visitor);
+  // Cookies loaded on demand are read from the database while the batches are
+  // visited.
+  CookieBatchVisitorAdapter adapter(batchSize, visitor);
+  _Context->request_context()->VisitAllCookies(&adapter);
+  adapter.Flush();
+}
+
+void IOT_SetCookies(const net::CookieList& list)
+{
+  REQUIRE_IOT();
+  _Context->request_context()->ImportCookies(list);
 }
 
 void IOT_VisitUrlCookies(const GURL& url, bool includeHttpOnly,
@@ -115,18 +259,88 @@ void IOT_VisitUrlCookies(const GURL& url, bool includeHttpOnly,
 {
   REQUIRE_IOT();
 
-  net::CookieMonster* cookie_monster = static_cast<net::CookieMonster*>(
-      _Context->request_context()->cookie_store());
+  net::CookieMonster* cookie_monster =
+      _Context->request_context()->cookie_store()->GetCookieMonster();
   if (!cookie_monster)
     return;
 
+  _Context->request_context()->LoadCookiesForURL(url);
+
   net::CookieOptions options;
   if (includeHttpOnly)
     options.set_include_httponly();
   net::CookieList list =
       cookie_monster->GetAllCookiesForURLWithOptions(url, options);
-  if (!list.empty())
-    IOT_VisitCookies(cookie_monster, list, visitor);
+  int count = 0;
+  IOT_VisitCookies(cookie_monster, list, &count, list.size(), visitor);
+}
+
+// Returns the localStorage origin identifier for |origin|, which is the
+// origin URL without the trailing slash, or an empty string if |origin| is
+// invalid.
+string16 GetLocalStorageOrigin(const CefString& origin)
+{
+  GURL gurl = GURL(origin.ToString()).GetOrigin();
+  if (!gurl.is_valid())
+    return string16();
+
+  std::string spec = gurl.spec();
+  if (!spec.empty() && spec[spec.size() - 1] == '/')
+    spec.erase(spec.size() - 1);
+  return UTF8ToUTF16(spec);
+}
+
+void UIT_VisitLocalStorage(const string16& origin,
+                           CefRefPtr<CefLocalStorageVisitor> visitor)
+{
+  REQUIRE_UIT();
+
+  DOMStorageContext* storage_context = _Context->storage_context();
+  if (!storage_context)
+    return;
+
+  DOMStorageContext::ItemMap items;
+  storage_context->GetLocalStorageItems(origin, &items);
+
+  CefLocalStorageItemMap map;
+  DOMStorageContext::ItemMap::const_iterator it = items.begin();
+  for (; it != items.end(); ++it)
+    map.insert(std::make_pair(CefString(it->first), CefString(it->second)));
+
+  visitor->Visit(origin, map);
+}
+
+void UIT_SetLocalStorage(const string16& origin,
+                         const DOMStorageContext::ItemMap& items, bool clear)
+{
+  REQUIRE_UIT();
+
+  DOMStorageContext* storage_context = _Context->storage_context();
+  if (!storage_context)
+    return;
+
+  if (!storage_context->SetLocalStorageItems(origin, items, clear)) {
+    LOG(WARNING) << "Some localStorage items for " << UTF16ToUTF8(origin) <<
+        " exceeded the quota";
+  }
+}
+
+void IOT_PurgeHttpCache(const std::string& url_prefix,
+                        const base::Time& cutoff, Task* completion_task)
+{
+  REQUIRE_IOT();
+  _Context->request_context()->PurgeHttpCache(url_prefix, cutoff,
+                                              completion_task);
+}
+
+void IOT_ImportHttpCacheEntry(const GURL& url,
+                              scoped_refptr<net::HttpResponseHeaders> headers,
+                              const std::string& data,
+                              Task* completion_task)
+{
+  REQUIRE_IOT();
+  _Context->request_context()->ImportHttpCacheEntry(url, headers, data,
+                                                    completion_task);
 }
 
 // Used in multi-threaded message loop mode to observe shutdown of the UI
@@ -144,6 +358,105 @@ private:
   base::WaitableEvent *event_;
 };
 
+// Tracks a subsystem that is written to disk by CefContext::FastShutdown().
+// The object is reference counted because the write may finish after
+// FastShutdown() has given up waiting for it.
+class ShutdownFlush : public base::RefCountedThreadSafe<ShutdownFlush>
+{
+public:
+  explicit ShutdownFlush(base::TimeTicks start_time)
+    : start_time_(start_time), pending_count_(1), context_count_(0),
+      event_(true, false) {}
+
+  // Called before starting each additional write that Done() will be called
+  // for.
+  void AddPending() {
+    base::AtomicRefCountInc(&pending_count_);
+  }
+
+  // Called on the thread that performed the write. The subsystem is finished
+  // when Done() has been called once for each write.
+  void Done() {
+    if (base::AtomicRefCountDec(&pending_count_))
+      return;
+    elapsed_ = base::TimeTicks::Now() - start_time_;
+    event_.Signal();
+  }
+
+  // The number of CefRequestContext objects that were flushed in addition to
+  // the global request context. Only valid after Wait() has succeeded.
+  void set_context_count(int count) { context_count_ = count; }
+  int context_count() const { return context_count_; }
+
+  // Wait until |deadline| for the write to finish. Returns the time taken in
+  // milliseconds or -1 if the deadline expired first. A write that blocked the
+  // waiting thread and finished after the deadline also returns -1.
+  double Wait(base::TimeTicks deadline) {
+    base::TimeDelta remaining = deadline - base::TimeTicks::Now();
+    if (!event_.TimedWait(std::max(remaining, base::TimeDelta())))
+      return -1;
+    if (start_time_ + elapsed_ > deadline)
+      return -1;
+    return elapsed_.InMillisecondsF();
+  }
+
+private:
+  base::TimeTicks start_time_;
+  base::TimeDelta elapsed_;
+  base::AtomicRefCount pending_count_;
+  int context_count_;
+  base::WaitableEvent event_;
+};
+
+typedef std::vector<scoped_refptr<BrowserRequestContext> > RequestContextList;
+
+void IOT_FlushCookies(scoped_refptr<ShutdownFlush> flush)
+{
+  // Flush the global request context and each CefRequestContext.
+  RequestContextList request_contexts;
+  scoped_refptr<BrowserRequestContext> request_context =
+      _Context->request_context();
+  if (request_context.get())
+    request_contexts.push_back(request_context);
+  CefRequestContextImpl::GetBrowserRequestContexts(&request_contexts);
+
+  RequestContextList::const_iterator it = request_contexts.begin();
+  for (; it != request_contexts.end(); ++it) {
+    // The commit runs on the FILE thread.
+    flush->AddPending();
+    (*it)->FlushCookieStore(
+        NewRunnableMethod(flush.get(), &ShutdownFlush::Done));
+  }
+  flush->Done();
+}
+
+void IOT_CloseCache(scoped_refptr<ShutdownFlush> flush)
+{
+  scoped_refptr<BrowserRequestContext> request_context =
+      _Context->request_context();
+  if (request_context.get())
+    request_context->CloseDiskCache();
+
+  RequestContextList request_contexts;
+  CefRequestContextImpl::GetBrowserRequestContexts(&request_contexts);
+  RequestContextList::const_iterator it = request_contexts.begin();
+  for (; it != request_contexts.end(); ++it)
+    (*it)->CloseDiskCache();
+
+  flush->set_context_count(static_cast<int>(request_contexts.size()));
+  flush->Done();
+}
+
+void UIT_FlushDOMStorage(scoped_refptr<ShutdownFlush> flush)
+{
+  // WebKit writes localStorage on its own local storage thread. Closing the
+  // namespace blocks until that thread has written the final changes.
+  DOMStorageContext* storage_context = _Context->storage_context();
+  if (storage_context)
+    storage_context->FlushLocalStorage();
+  flush->Done();
+}
+
 } // anonymous
 
 bool CefInitialize(const CefSettings& settings)
@@ -185,6 +498,29 @@ void CefShutdown()
   _Context = NULL;
 }
 
+bool CefFastShutdown(int timeout_ms, CefShutdownReport& report)
+{
+  // Verify that the context is in a valid state.
+  if (!CONTEXT_STATE_VALID()) {
+    NOTREACHED();
+    return false;
+  }
+
+  // Must always be called on the same thread as Initialize.
+  if(!_Context->process()->CalledOnValidThread()) {
+    NOTREACHED();
+    return false;
+  }
+
+  bool result = _Context->FastShutdown(timeout_ms, &report);
+
+  // Leak a reference so that the browsers, threads and the context itself are
+  // not destroyed by static destructors when the process exits.
+  _Context->AddRef();
+
+  return result;
+}
+
 void CefDoMessageLoopWork()
 {
   // Verify that the context is in a valid state.
@@ -202,6 +538,42 @@ void CefDoMessageLoopWork()
   _Context->process()->DoMessageLoopIteration();
 }
 
+int CefGetMessageLoopWakeupFd()
+{
+  // Verify that the context is in a valid state.
+  if (!CONTEXT_STATE_VALID()) {
+    NOTREACHED();
+    return -1;
+  }
+
+  // Must always be called on the same thread as Initialize.
+  if(!_Context->process()->CalledOnValidThread() ||
+     _Context->settings().multi_threaded_message_loop) {
+    NOTREACHED();
+    return -1;
+  }
+
+  return _Context->process()->GetMessageLoopWakeupFd();
+}
+
+long CefGetMessageLoopWorkDelay()
+{
+  // Verify that the context is in a valid state.
+  if (!CONTEXT_STATE_VALID()) {
+    NOTREACHED();
+    return -1;
+  }
+
+  // Must always be called on the same thread as Initialize.
+  if(!_Context->process()->CalledOnValidThread() ||
+     _Context->settings().multi_threaded_message_loop) {
+    NOTREACHED();
+    return -1;
+  }
+
+  return static_cast<long>(_Context->process()->GetMessageLoopWorkDelay());
+}
+
 void CefRunMessageLoop()
 {
   // Verify that the context is in a valid state.
@@ -235,6 +607,9 @@ bool CefRegisterPlugin(const CefPluginInfo& plugin_info)
 
 bool CefCurrentlyOn(CefThreadId threadId)
 {
+  if (threadId == TID_WORKER)
+    return CefWorkerPool::CurrentlyOn();
+
   int id = GetThreadId(threadId);
   if(id < 0)
     return false;
@@ -256,6 +631,11 @@ private:
 
 bool CefPostTask(CefThreadId threadId, CefRefPtr<CefTask> task)
 {
+  if (threadId == TID_WORKER) {
+    return CefWorkerPool::PostTask(FROM_HERE,
+        new CefTaskHelper(task, threadId));
+  }
+
   int id = GetThreadId(threadId);
   if(id < 0)
     return false;
@@ -267,6 +647,11 @@ bool CefPostTask(CefThreadId threadId, CefRefPtr<CefTask> task)
 bool CefPostDelayedTask(CefThreadId threadId, CefRefPtr<CefTask> task,
                         long delay_ms)
 {
+  if (threadId == TID_WORKER) {
+    return CefWorkerPool::PostDelayedTask(FROM_HERE,
+        new CefTaskHelper(task, threadId), delay_ms);
+  }
+
   int id = GetThreadId(threadId);
   if(id < 0)
     return false;
@@ -275,6 +660,133 @@ bool CefPostDelayedTask(CefThreadId threadId, CefRefPtr<CefTask> task,
       new CefTaskHelper(task, threadId), delay_ms);
 }
 
+// Runs a list of tasks from a single message loop task.
+class CefTaskBatchHelper : public Task
+{
+public:
+  CefTaskBatchHelper(const std::vector<CefRefPtr<CefTask> >& tasks,
+                     CefThreadId threadId)
+    : tasks_(tasks), thread_id_(threadId) {}
+  virtual void Run()
+  {
+    std::vector<CefRefPtr<CefTask> >::const_iterator it = tasks_.begin();
+    for (; it != tasks_.end(); ++it)
+      (*it)->Execute(thread_id_);
+  }
+private:
+  std::vector<CefRefPtr<CefTask> > tasks_;
+  CefThreadId thread_id_;
+  DISALLOW_COPY_AND_ASSIGN(CefTaskBatchHelper);
+};
+
+bool CefPostTasks(CefThreadId threadId,
+                  const std::vector<CefRefPtr<CefTask> >& tasks)
+{
+  int id = -1;
+  if (threadId != TID_WORKER) {
+    id = GetThreadId(threadId);
+    if(id < 0)
+      return false;
+  }
+
+  // There is nothing to run but the batch is still accepted, like an empty
+  // CefSetCookies() batch.
+  if (tasks.empty())
+    return true;
+
+  // A single task avoids locking and waking the target thread for each entry.
+  Task* task = new CefTaskBatchHelper(tasks, threadId);
+  if (threadId == TID_WORKER)
+    return CefWorkerPool::PostTask(FROM_HERE, task);
+  return CefThread::PostTask(static_cast<CefThread::ID>(id), FROM_HERE, task);
+}
+
+bool CefGetThreadStats(CefThreadId threadId, CefThreadStats& stats)
+{
+  // The worker pool is not instrumented.
+  if (threadId == TID_WORKER)
+    return false;
+
+  int id = GetThreadId(threadId);
+  if(id < 0)
+    return false;
+
+  return CefThreadStatsCollector::GetStats(static_cast<CefThread::ID>(id),
+                                          &stats);
+}
+
+void CefSetThreadStatsEnabled(bool enabled)
+{
+  // Verify that the context is in a valid state.
+  if (!CONTEXT_STATE_VALID()) {
+    NOTREACHED();
+    return;
+  }
+
+  if (enabled)
+    CefThreadStatsCollector::Enable(_Context->settings().slow_task_threshold);
+  else
+    CefThreadStatsCollector::Disable();
+}
+
+bool CefBeginTracing()
+{
+  return CefTraceLog::Start();
+}
+
+bool CefEndTracing(const CefString& tracing_file)
+{
+  if (tracing_file.empty())
+    return false;
+
+  return CefTraceLog::Stop(FilePath(tracing_file));
+}
+
+bool CefGetStartupTimings(CefStartupTimings& timings)
+{
+  // Verify that the context is in a valid state.
+  if (!CONTEXT_STATE_VALID())
+    return false;
+
+  CefStartupTimer::GetTimings(&timings);
+  return true;
+}
+
+// Implementation of CefSequencedTaskRunner that wraps a CefWorkerSequence.
+class CefSequencedTaskRunnerImpl : public CefSequencedTaskRunner
+{
+public:
+  CefSequencedTaskRunnerImpl() : sequence_(new CefWorkerSequence()) {}
+
+  virtual bool PostTask(CefRefPtr<CefTask> task)
+  {
+    return sequence_->PostTask(FROM_HERE,
+        new CefTaskHelper(task, TID_WORKER));
+  }
+
+  virtual bool PostDelayedTask(CefRefPtr<CefTask> task, long delay_ms)
+  {
+    return sequence_->PostDelayedTask(FROM_HERE,
+        new CefTaskHelper(task, TID_WORKER), delay_ms);
+  }
+
+  virtual bool RunsTasksOnCurrentThread()
+  {
+    return sequence_->RunsTasksOnCurrentThread();
+  }
+
+private:
+  scoped_refptr<CefWorkerSequence> sequence_;
+
+  IMPLEMENT_REFCOUNTING(CefSequencedTaskRunnerImpl);
+};
+
+// static
+CefRefPtr<CefSequencedTaskRunner> CefSequencedTaskRunner::Create()
+{
+  return new CefSequencedTaskRunnerImpl();
+}
+
 bool CefParseURL(const CefString& url,
                  CefURLParts& parts)
 {
@@ -350,6 +862,24 @@ bool CefVisitAllCookies(CefRefPtr<CefCookieVisitor> visitor)
       NewRunnableFunction(IOT_VisitAllCookies, visitor));
 }
 
+bool CefVisitAllCookiesInBatches(int batchSize,
+                                 CefRefPtr<CefCookieBatchVisitor> visitor)
+{
+  // Verify that the context is in a valid state.
+  if (!CONTEXT_STATE_VALID()) {
+    NOTREACHED();
+    return false;
+  }
+
+  if (batchSize <= 0) {
+    NOTREACHED() << "invalid batch size";
+    return false;
+  }
+
+  return CefThread::PostTask(CefThread::IO, FROM_HERE,
+      NewRunnableFunction(IOT_VisitAllCookiesInBatches, batchSize, visitor));
+}
+
 bool CefVisitUrlCookies(const CefString& url, bool includeHttpOnly,
                         CefRefPtr<CefCookieVisitor> visitor)
 {
@@ -382,8 +912,8 @@ bool CefSetCookie(const CefString& url, const CefCookie& cookie)
     return false;
   }
 
-  net::CookieMonster* cookie_monster = static_cast<net::CookieMonster*>(
-      _Context->request_context()->cookie_store());
+  net::CookieMonster* cookie_monster =
+      _Context->request_context()->cookie_store()->GetCookieMonster();
   if (!cookie_monster)
     return false;
 
@@ -401,11 +931,83 @@ bool CefSetCookie(const CefString& url, const CefCookie& cookie)
   if (cookie.has_expires)
     cef_time_to_basetime(cookie.expires, expiration_time);
 
+  _Context->request_context()->LoadCookiesForURL(gurl);
   return cookie_monster->SetCookieWithDetails(gurl, name, value, domain, path,
                                               expiration_time, cookie.secure,
                                               cookie.httponly);
 }
 
+bool CefSetCookies(const std::vector<CefCookie>& cookies)
+{
+  // Verify that the context is in a valid state.
+  if (!CONTEXT_STATE_VALID()) {
+    NOTREACHED();
+    return false;
+  }
+
+  // Cookies without a creation time receive unique times starting now.
+  int64 next_creation_time = base::Time::Now().ToInternalValue();
+
+  net::CookieList list;
+  list.reserve(cookies.size());
+  std::vector<CefCookie>::const_iterator it = cookies.begin();
+  for (; it != cookies.end(); ++it) {
+    const CefCookie& cookie = *it;
+    std::string domain;
+    if (!CanonicalizeCookieDomain(CefString(&cookie.domain).ToString(),
+                                  &domain)) {
+      LOG(WARNING) << "Ignoring imported cookie with an invalid domain";
+      continue;
+    }
+
+    std::string name = CefString(&cookie.name).ToString();
+    std::string value = CefString(&cookie.value).ToString();
+    std::string path = CefString(&cookie.path).ToString();
+    if (path.empty())
+      path = "/";
+
+    // Reject the same disallowed characters as SetCookieWithDetails().
+    if (net::CookieMonster::ParsedCookie::ParseTokenString(name) != name ||
+        net::CookieMonster::ParsedCookie::ParseValueString(value) != value ||
+        net::CookieMonster::ParsedCookie::ParseValueString(path) != path ||
+        path[0] != '/') {
+      LOG(WARNING) << "Ignoring imported cookie with invalid attributes";
+      continue;
+    }
+
+    // Times that are not specified have a year of 0.
+    base::Time creation_time, last_access_time, expiration_time;
+    if (cookie.creation.year != 0)
+      cef_time_to_basetime(cookie.creation, creation_time);
+    else
+      creation_time = base::Time::FromInternalValue(next_creation_time++);
+    if (cookie.last_access.year != 0)
+      cef_time_to_basetime(cookie.last_access, last_access_time);
+    else
+      last_access_time = creation_time;
+    if (cookie.has_expires)
+      cef_time_to_basetime(cookie.expires, expiration_time);
+
+    list.push_back(net::CookieMonster::CanonicalCookie(GURL(), name, value,
+        domain, path, std::string(), std::string(), creation_time,
+        expiration_time, last_access_time, cookie.secure ? true : false,
+        cookie.httponly ? true : false, cookie.has_expires ? true : false));
+  }
+
+  // Importing zero cookies succeeds but a batch that is entirely rejected
+  // does not.
+  if (list.empty())
+    return cookies.empty();
+
+  if (CefThread::CurrentlyOn(CefThread::IO)) {
+    IOT_SetCookies(list);
+    return true;
+  }
+
+  return CefThread::PostTask(CefThread::IO, FROM_HERE,
+      NewRunnableFunction(IOT_SetCookies, list));
+}
+
 bool CefDeleteCookies(const CefString& url, const CefString& cookie_name)
 {
   // Verify that the context is in a valid state.
@@ -420,14 +1022,14 @@ bool CefDeleteCookies(const CefString& url, const CefString& cookie_name)
     return false;
   }
 
-  net::CookieMonster* cookie_monster = static_cast<net::CookieMonster*>(
-      _Context->request_context()->cookie_store());
+  net::CookieMonster* cookie_monster =
+      _Context->request_context()->cookie_store()->GetCookieMonster();
   if (!cookie_monster)
     return false;
 
   if (url.empty()) {
-    // Delete all cookies.
-    cookie_monster->DeleteAll(true);
+    // Delete all cookies, including those that haven't been loaded yet.
+    _Context->request_context()->DeleteAllCookies();
     return true;
   }
 
@@ -436,6 +1038,8 @@ bool CefDeleteCookies(const CefString& url, const CefString& cookie_name)
   if (!gurl.is_valid())
     return false;
 
+  _Context->request_context()->LoadCookiesForURL(gurl);
+
   if (cookie_name.empty()) {
     // Delete all matching host cookies.
     cookie_monster->DeleteAllForHost(gurl);
@@ -446,6 +1050,254 @@ bool CefDeleteCookies(const CefString& url, const CefString& cookie_name)
   return true;
 }
 
+bool CefGetCookieStoreStats(CefCookieStoreStats& stats)
+{
+  // Verify that the context is in a valid state.
+  if (!CONTEXT_STATE_VALID()) {
+    NOTREACHED();
+    return false;
+  }
+
+  scoped_refptr<BrowserRequestContext> request_context =
+      _Context->request_context();
+  if (!request_context.get())
+    return false;
+
+  return request_context->GetCookieStoreStats(&stats);
+}
+
+bool CefFlushCookieStore(CefRefPtr<CefTask> completionTask)
+{
+  // Verify that the context is in a valid state.
+  if (!CONTEXT_STATE_VALID()) {
+    NOTREACHED();
+    return false;
+  }
+
+  scoped_refptr<BrowserRequestContext> request_context =
+      _Context->request_context();
+  if (!request_context.get() || _Context->cache_path().empty())
+    return false;
+
+  Task* task = NULL;
+  if (completionTask.get())
+    task = new CefTaskHelper(completionTask, TID_FILE);
+  return CefThread::PostTask(CefThread::IO, FROM_HERE,
+      NewRunnableMethod(request_context.get(),
+                        &BrowserRequestContext::FlushCookieStore, task));
+}
+
+bool CefSaveCookies(const CefString& domain, CefRefPtr<CefStreamWriter> writer)
+{
+  // Verify that the context is in a valid state.
+  if (!CONTEXT_STATE_VALID()) {
+    NOTREACHED();
+    return false;
+  }
+
+  // Verify that this function is being called on the IO thread.
+  if (!CefThread::CurrentlyOn(CefThread::IO)) {
+    NOTREACHED();
+    return false;
+  }
+
+  CEF_TRACE_EVENT0("cef", "CefSaveCookies");
+
+  net::CookieMonster* cookie_monster =
+      _Context->request_context()->cookie_store()->GetCookieMonster();
+  if (!cookie_monster)
+    return false;
+
+  std::string domainStr = StringToLowerASCII(domain.ToString());
+  if (!domainStr.empty() && domainStr[0] == '.')
+    domainStr.erase(0, 1);
+
+  net::CookieList cookies;
+  if (domainStr.empty()) {
+    _Context->request_context()->GetAllCookies(&cookies);
+  } else {
+    // Subdomain cookies share the database key of their registered domain.
+    _Context->request_context()->LoadCookiesForURL(
+        GURL("http://" + domainStr + "/"));
+    cookies = cookie_monster->GetAllCookies();
+  }
+
+  std::string data;
+  CookieSnapshot::Write(domainStr, cookies, &data);
+  return writer->Write(data.data(), 1, data.size()) == data.size();
+}
+
+bool CefRestoreCookies(CefRefPtr<CefStreamReader> reader)
+{
+  // Verify that the context is in a valid state.
+  if (!CONTEXT_STATE_VALID()) {
+    NOTREACHED();
+    return false;
+  }
+
+  // Verify that this function is being called on the IO thread.
+  if (!CefThread::CurrentlyOn(CefThread::IO)) {
+    NOTREACHED();
+    return false;
+  }
+
+  CEF_TRACE_EVENT0("cef", "CefRestoreCookies");
+
+  std::string data;
+  char buffer[8192];
+  size_t read;
+  while ((read = reader->Read(buffer, 1, sizeof(buffer))) > 0)
+    data.append(buffer, read);
+
+  // Parse the whole snapshot before changing any cookies.
+  std::string domain;
+  net::CookieList list;
+  if (!CookieSnapshot::Read(data, &domain, &list)) {
+    LOG(WARNING) << "Ignoring invalid cookie snapshot";
+    return false;
+  }
+
+  _Context->request_context()->ReplaceCookies(domain, list);
+  return true;
+}
+
+bool CefVisitLocalStorage(const CefString& origin,
+                          CefRefPtr<CefLocalStorageVisitor> visitor)
+{
+  // Verify that the context is in a valid state.
+  if (!CONTEXT_STATE_VALID()) {
+    NOTREACHED();
+    return false;
+  }
+
+  string16 originStr = GetLocalStorageOrigin(origin);
+  if (originStr.empty())
+    return false;
+
+  if (CefThread::CurrentlyOn(CefThread::UI)) {
+    UIT_VisitLocalStorage(originStr, visitor);
+    return true;
+  }
+
+  return CefThread::PostTask(CefThread::UI, FROM_HERE,
+      NewRunnableFunction(UIT_VisitLocalStorage, originStr, visitor));
+}
+
+bool CefSetLocalStorage(const CefString& origin,
+                        const CefLocalStorageItemMap& items, bool clear)
+{
+  // Verify that the context is in a valid state.
+  if (!CONTEXT_STATE_VALID()) {
+    NOTREACHED();
+    return false;
+  }
+
+  string16 originStr = GetLocalStorageOrigin(origin);
+  if (originStr.empty())
+    return false;
+
+  // Copy the items so that the CefString values are not shared between
+  // threads.
+  DOMStorageContext::ItemMap itemMap;
+  CefLocalStorageItemMap::const_iterator it = items.begin();
+  for (; it != items.end(); ++it)
+    itemMap.insert(std::make_pair(it->first.ToString16(),
+                                  it->second.ToString16()));
+
+  if (CefThread::CurrentlyOn(CefThread::UI)) {
+    UIT_SetLocalStorage(originStr, itemMap, clear);
+    return true;
+  }
+
+  return CefThread::PostTask(CefThread::UI, FROM_HERE,
+      NewRunnableFunction(UIT_SetLocalStorage, originStr, itemMap, clear));
+}
+
+bool CefGetHttpCacheStats(CefHttpCacheStats& stats)
+{
+  // Verify that the context is in a valid state.
+  if (!CONTEXT_STATE_VALID()) {
+    NOTREACHED();
+    return false;
+  }
+
+  // Verify that this function is being called on the IO thread.
+  if (!CefThread::CurrentlyOn(CefThread::IO)) {
+    NOTREACHED();
+    return false;
+  }
+
+  return _Context->request_context()->GetHttpCacheStats(&stats);
+}
+
+bool CefPurgeHttpCache(const CefString& url_prefix, int max_age,
+                       CefRefPtr<CefTask> completionTask)
+{
+  // Verify that the context is in a valid state.
+  if (!CONTEXT_STATE_VALID()) {
+    NOTREACHED();
+    return false;
+  }
+
+  std::string prefix = url_prefix;
+  base::Time cutoff;
+  if (max_age > 0)
+    cutoff = base::Time::Now() - base::TimeDelta::FromSeconds(max_age);
+
+  Task* task = NULL;
+  if (completionTask.get())
+    task = new CefTaskHelper(completionTask, TID_IO);
+
+  if (CefThread::CurrentlyOn(CefThread::IO)) {
+    IOT_PurgeHttpCache(prefix, cutoff, task);
+    return true;
+  }
+
+  return CefThread::PostTask(CefThread::IO, FROM_HERE,
+      NewRunnableFunction(IOT_PurgeHttpCache, prefix, cutoff, task));
+}
+
+bool CefImportHttpCacheEntry(const CefString& url, const CefString& headers,
+                             CefRefPtr<CefStreamReader> data,
+                             CefRefPtr<CefTask> completionTask)
+{
+  // Verify that the context is in a valid state.
+  if (!CONTEXT_STATE_VALID()) {
+    NOTREACHED();
+    return false;
+  }
+
+  GURL gurl = GURL(url.ToString());
+  if (!gurl.is_valid() || !(gurl.SchemeIs("http") || gurl.SchemeIs("https")))
+    return false;
+
+  std::string headersStr = headers;
+  scoped_refptr<net::HttpResponseHeaders> responseHeaders(
+      new net::HttpResponseHeaders(net::HttpUtil::AssembleRawHeaders(
+          headersStr.c_str(), static_cast<int>(headersStr.size()))));
+  if (responseHeaders->response_code() != 200)
+    return false;
+
+  std::string dataStr;
+  char buffer[8192];
+  size_t read;
+  while ((read = data->Read(buffer, 1, sizeof(buffer))) > 0)
+    dataStr.append(buffer, read);
+
+  Task* task = NULL;
+  if (completionTask.get())
+    task = new CefTaskHelper(completionTask, TID_IO);
+
+  if (CefThread::CurrentlyOn(CefThread::IO)) {
+    IOT_ImportHttpCacheEntry(gurl, responseHeaders, dataStr, task);
+    return true;
+  }
+
+  return CefThread::PostTask(CefThread::IO, FROM_HERE,
+      NewRunnableFunction(IOT_ImportHttpCacheEntry, gurl, responseHeaders,
+                          dataStr, task));
+}
+
 
 // CefContext
 
@@ -465,6 +1317,9 @@ CefContext::~CefContext()
 
 bool CefContext::Initialize(const CefSettings& settings)
 {
+  CefStartupTimer::Reset();
+  CefStartupTimer timer(CefStartupTimer::INITIALIZE);
+
   settings_ = settings;
 
   cache_path_ = FilePath(CefString(&settings.cache_path));
@@ -474,9 +1329,18 @@ bool CefContext::Initialize(const CefSettings& settings)
   crypto::EnsureNSPRInit();
 #endif
 
+  if (settings_.thread_stats_enabled)
+    CefThreadStatsCollector::Enable(settings_.slow_task_threshold);
+
   process_ = new CefProcess(settings_.multi_threaded_message_loop);
   process_->CreateChildThreads();
 
+  if (settings_.thread_stats_enabled &&
+      settings_.thread_stats_dump_interval > 0) {
+    CefThreadStatsCollector::StartPeriodicLog(
+        settings_.thread_stats_dump_interval);
+  }
+
   initialized_ = true;
 
   return true;
@@ -515,6 +1379,73 @@ void CefContext::Shutdown()
     // Delete the process to destroy the child threads.
     process_ = NULL;
   }
+
+  CefThreadStatsCollector::Disable();
+}
+
+bool CefContext::FastShutdown(int timeout_ms, cef_shutdown_report_t* report)
+{
+  // Must always be called on the same thread as Initialize.
+  DCHECK(process_->CalledOnValidThread());
+
+  base::TimeTicks start_time = base::TimeTicks::Now();
+  base::TimeTicks deadline = start_time +
+      base::TimeDelta::FromMilliseconds(std::max(timeout_ms, 0));
+
+  // Reject further API calls. Nothing is destroyed so the threads continue to
+  // run until the process exits.
+  shutting_down_ = true;
+
+  scoped_refptr<ShutdownFlush> cookies(new ShutdownFlush(start_time));
+  scoped_refptr<ShutdownFlush> dom_storage(new ShutdownFlush(start_time));
+  scoped_refptr<ShutdownFlush> cache(new ShutdownFlush(start_time));
+
+  // Flushing the cookie store only posts a task to the FILE thread so it is
+  // started before the IO thread blocks while the cache is closed.
+  if (!CefThread::PostTask(CefThread::IO, FROM_HERE,
+          NewRunnableFunction(IOT_FlushCookies, cookies))) {
+    cookies->Done();
+  }
+  if (!CefThread::PostTask(CefThread::IO, FROM_HERE,
+          NewRunnableFunction(IOT_CloseCache, cache))) {
+    cache->Done();
+  }
+
+  if (settings_.multi_threaded_message_loop) {
+    if (!CefThread::PostTask(CefThread::UI, FROM_HERE,
+            NewRunnableFunction(UIT_FlushDOMStorage, dom_storage))) {
+      dom_storage->Done();
+    }
+  } else {
+    // The current thread is the UI thread. The cookie and cache writes that
+    // were started above continue on the FILE and IO threads while this blocks
+    // and the deadline is checked after it returns.
+    UIT_FlushDOMStorage(dom_storage);
+  }
+
+  memset(report, 0, sizeof(cef_shutdown_report_t));
+  report->cookies = cookies->Wait(deadline);
+  report->dom_storage = dom_storage->Wait(deadline);
+  report->cache = cache->Wait(deadline);
+  report->request_contexts = (report->cache < 0) ? -1 : cache->context_count();
+  report->total = (base::TimeTicks::Now() - start_time).InMillisecondsF();
+
+  if (report->cookies < 0)
+    report->timed_out |= SHUTDOWN_COOKIES;
+  if (report->dom_storage < 0)
+    report->timed_out |= SHUTDOWN_DOM_STORAGE;
+  if (report->cache < 0)
+    report->timed_out |= SHUTDOWN_CACHE;
+
+  if (report->timed_out) {
+    LOG(WARNING) << "Fast shutdown exceeded the " << timeout_ms <<
+        "ms deadline for:" <<
+        ((report->timed_out & SHUTDOWN_COOKIES) ? " cookies" : "") <<
+        ((report->timed_out & SHUTDOWN_DOM_STORAGE) ? " dom_storage" : "") <<
+        ((report->timed_out & SHUTDOWN_CACHE) ? " cache" : "");
+  }
+
+  return (report->timed_out == 0);
 }
 
 bool CefContext::AddBrowser(CefRefPtr<CefBrowserImpl> browser)
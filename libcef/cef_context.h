@@ -33,6 +33,10 @@ public:
   bool Initialize(const CefSettings& settings);
   void Shutdown();
 
+  // Write persistent state to disk without destroying anything. Waits at most
+  // |timeout_ms| for the writes to finish.
+  bool FastShutdown(int timeout_ms, cef_shutdown_report_t* report);
+
   // Returns true if the context is initialized.
   bool initialized() { return initialized_; }
 
@@ -0,0 +1,132 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors.
+// Portions copyright (c) 2010 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#include "cef_message_loop.h"
+
+#include <algorithm>
+
+#if defined(OS_LINUX)
+#include <errno.h>
+#include <sys/eventfd.h>
+#include <unistd.h>
+
+#include "base/eintr_wrapper.h"
+#include "base/message_pump_gtk.h"
+#endif
+
+namespace {
+
+#if defined(OS_LINUX)
+// Message pump that signals an eventfd whenever work is scheduled so that
+// applications can wait for CEF work in their own event loop.
+class CefMessagePumpGtk : public base::MessagePumpGtk
+{
+public:
+  CefMessagePumpGtk()
+    : wakeup_fd_(eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC))
+  {
+    DCHECK_GE(wakeup_fd_, 0);
+  }
+
+  virtual ~CefMessagePumpGtk() {
+    if (wakeup_fd_ >= 0)
+      HANDLE_EINTR(close(wakeup_fd_));
+  }
+
+  // Used with MessageLoop::InitMessagePumpForUIFactory.
+  static base::MessagePump* Create() {
+    return new CefMessagePumpGtk();
+  }
+
+  // May be called on any thread.
+  virtual void ScheduleWork() {
+    base::MessagePumpGtk::ScheduleWork();
+
+    uint64 value = 1;
+    ssize_t result = HANDLE_EINTR(write(wakeup_fd_, &value, sizeof(value)));
+    DCHECK(result == sizeof(value) || errno == EAGAIN);
+  }
+
+  // Clear the signaled state before work is performed. Work that is scheduled
+  // after this call signals the descriptor again.
+  void ResetWakeup() {
+    uint64 value;
+    HANDLE_EINTR(read(wakeup_fd_, &value, sizeof(value)));
+  }
+
+  int wakeup_fd() const { return wakeup_fd_; }
+
+private:
+  int wakeup_fd_;
+
+  DISALLOW_COPY_AND_ASSIGN(CefMessagePumpGtk);
+};
+#endif  // defined(OS_LINUX)
+
+}  // namespace
+
+CefMessageLoopForUI::CefMessageLoopForUI()
+  : is_iterating_(true)
+{
+}
+
+// static
+CefMessageLoopForUI* CefMessageLoopForUI::Create() {
+#if defined(OS_LINUX)
+  // The pump is created by the MessageLoop constructor, so the factory is only
+  // installed while this loop is created.
+  MessageLoop::InitMessagePumpForUIFactory(&CefMessagePumpGtk::Create);
+  CefMessageLoopForUI* loop = new CefMessageLoopForUI();
+  MessageLoop::InitMessagePumpForUIFactory(NULL);
+  return loop;
+#else
+  return new CefMessageLoopForUI();
+#endif
+}
+
+bool CefMessageLoopForUI::DoIdleWork() {
+  bool valueToRet = inherited::DoIdleWork();
+  if (is_iterating_)
+    pump_->Quit();
+  return valueToRet;
+}
+
+void CefMessageLoopForUI::DoMessageLoopIteration() {
+#if defined(OS_LINUX)
+  static_cast<CefMessagePumpGtk*>(pump_.get())->ResetWakeup();
+#endif
+#if defined(OS_MACOSX)
+  Run();
+#else
+  Run(NULL);
+#endif
+}
+
+int CefMessageLoopForUI::GetWakeupFd() {
+#if defined(OS_LINUX)
+  return static_cast<CefMessagePumpGtk*>(pump_.get())->wakeup_fd();
+#else
+  return -1;
+#endif
+}
+
+int64 CefMessageLoopForUI::GetWorkDelay() {
+  // Tasks posted from any thread wait in the incoming queue until the next
+  // iteration moves them to the work queues. Delayed tasks are only ordered
+  // once they get there, so report any incoming task as ready now.
+  if (!work_queue_.empty() || !IsIdle())
+    return 0;
+  if (delayed_work_queue_.empty())
+    return -1;
+
+  base::TimeDelta delay =
+      delayed_work_queue_.top().delayed_run_time - base::TimeTicks::Now();
+  return std::max(delay.InMillisecondsRoundedUp(), static_cast<int64>(0));
+}
+
+void CefMessageLoopForUI::RunMessageLoop() {
+  is_iterating_ = false;
+  DoMessageLoopIteration();
+}
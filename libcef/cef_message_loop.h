@@ -0,0 +1,58 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors.
+// Portions copyright (c) 2010 The Chromium Authors. All rights reserved.
+// Use of this source code is governed by a BSD-style license that can be
+// found in the LICENSE file.
+
+#ifndef _CEF_MESSAGE_LOOP_H
+#define _CEF_MESSAGE_LOOP_H
+
+#include "base/basictypes.h"
+#include "base/message_loop.h"
+
+// Class used to process events on the current message loop when the
+// application drives the UI message loop itself.
+class CefMessageLoopForUI : public MessageLoopForUI
+{
+  typedef MessageLoopForUI inherited;
+
+public:
+  // Create a new message loop for the current thread. On Linux the message
+  // pump signals a file descriptor whenever work is scheduled.
+  static CefMessageLoopForUI* Create();
+
+  // Returns the MessageLoopForUI of the current thread.
+  static CefMessageLoopForUI* current() {
+    MessageLoop* loop = MessageLoop::current();
+    DCHECK_EQ(MessageLoop::TYPE_UI, loop->type());
+    return static_cast<CefMessageLoopForUI*>(loop);
+  }
+
+  virtual bool DoIdleWork();
+
+  // Do a single interation of the UI message loop.
+  void DoMessageLoopIteration();
+
+  // Returns a file descriptor that is signaled when work is scheduled, or -1 if
+  // not supported on the current platform.
+  int GetWakeupFd();
+
+  // Returns the delay in milliseconds until delayed work is due, 0 if work is
+  // ready now or -1 if there is no delayed work. Tasks that have been posted
+  // but not yet moved to the work queue are treated as ready.
+  int64 GetWorkDelay();
+
+  // Run the UI message loop.
+  void RunMessageLoop();
+
+  bool is_iterating() { return is_iterating_; }
+
+ private:
+  CefMessageLoopForUI();
+
+  // True if the message loop is doing one iteration at a time.
+  bool is_iterating_;
+
+  DISALLOW_COPY_AND_ASSIGN(CefMessageLoopForUI);
+};
+
+#endif  // _CEF_MESSAGE_LOOP_H
@@ -4,73 +4,35 @@
 // found in the LICENSE file.
 
 #include "cef_process.h"
+#include "cef_message_loop.h"
 #include "cef_process_io_thread.h"
 #include "cef_process_sub_thread.h"
 #include "cef_process_ui_thread.h"
+#include "cef_worker_pool.h"
 
 #include "base/synchronization/waitable_event.h"
 #include "base/threading/thread.h"
 
-CefProcess* g_cef_process = NULL;
-
-// Class used to process events on the current message loop.
-class CefMessageLoopForUI : public MessageLoopForUI
-{
-  typedef MessageLoopForUI inherited;
-
-public:
-  CefMessageLoopForUI()
-    : is_iterating_(true)
-  {
-  }
-
-  // Returns the MessageLoopForUI of the current thread.
-  static CefMessageLoopForUI* current() {
-    MessageLoop* loop = MessageLoop::current();
-    DCHECK_EQ(MessageLoop::TYPE_UI, loop->type());
-    return static_cast<CefMessageLoopForUI*>(loop);
-  }
-
-  virtual bool DoIdleWork() {
-    bool valueToRet = inherited::DoIdleWork();
-    if (is_iterating_)
-      pump_->Quit();
-    return valueToRet;
-  }
-
-  // Do a single interation of the UI message loop.
-  void DoMessageLoopIteration() {
-#if defined(OS_MACOSX)
-    Run();
-#else
-    Run(NULL);
+#if defined(OS_LINUX)
+#include <glib.h>
 #endif
-  }
-
-  // Run the UI message loop.
-  void RunMessageLoop() {
-    is_iterating_ = false;
-    DoMessageLoopIteration();
-  }
-
-  bool is_iterating() { return is_iterating_; }
-
- private:
-  // True if the message loop is doing one iteration at a time.
-  bool is_iterating_;
 
-  DISALLOW_COPY_AND_ASSIGN(CefMessageLoopForUI);
-};
+CefProcess* g_cef_process = NULL;
 
 CefProcess::CefProcess(bool multi_threaded_message_loop)
     : multi_threaded_message_loop_(multi_threaded_message_loop),
       created_ui_thread_(false),
       created_io_thread_(false),
-      created_file_thread_(false) {
+      created_file_thread_(false),
+      created_worker_pool_(false) {
   g_cef_process = this;
 }
 
 CefProcess::~CefProcess() {
+  // Terminate the worker pool first because workers may post tasks to the
+  // other threads.
+  worker_pool_.reset();
+
   // Terminate the IO thread.
   io_thread_.reset();
 
@@ -102,12 +64,28 @@ void CefProcess::RunMessageLoop() {
   ui_message_loop_->RunMessageLoop();
 }
 
+int CefProcess::GetMessageLoopWakeupFd() {
+  DCHECK(CalledOnValidThread() && ui_message_loop_.get() != NULL);
+  return ui_message_loop_->GetWakeupFd();
+}
+
+int64 CefProcess::GetMessageLoopWorkDelay() {
+  DCHECK(CalledOnValidThread() && ui_message_loop_.get() != NULL);
+  return ui_message_loop_->GetWorkDelay();
+}
+
 void CefProcess::CreateUIThread() {
   DCHECK(!created_ui_thread_ && ui_thread_.get() == NULL);
   created_ui_thread_ = true;
 
   scoped_ptr<CefProcessUIThread> thread;
   if(multi_threaded_message_loop_) {
+#if defined(OS_LINUX)
+    // GLib must be made thread safe before the UI thread starts using it.
+    if (!g_thread_supported())
+      g_thread_init(NULL);
+#endif
+
     // Create the message loop on a new thread.
     thread.reset(new CefProcessUIThread());
     base::Thread::Options options;
@@ -116,7 +94,7 @@ void CefProcess::CreateUIThread() {
       return;
   } else {
     // Create the message loop on the current (main application) thread.
-    ui_message_loop_.reset(new CefMessageLoopForUI());
+    ui_message_loop_.reset(CefMessageLoopForUI::Create());
     thread.reset(
         new CefProcessUIThread(ui_message_loop_.get()));
 
@@ -150,3 +128,11 @@ void CefProcess::CreateFileThread() {
     return;
   file_thread_.swap(thread);
 }
+
+void CefProcess::CreateWorkerPool() {
+  DCHECK(!created_worker_pool_ && worker_pool_.get() == NULL);
+  created_worker_pool_ = true;
+
+  worker_pool_.reset(
+      new CefWorkerPool(CefWorkerPool::GetDefaultThreadCount()));
+}
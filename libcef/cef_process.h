@@ -27,6 +27,7 @@ class WaitableEvent;
 }
 
 class CefProcessIOThread;
+class CefWorkerPool;
 class CefProcessUIThread;
 class CefMessageLoopForUI;
 
@@ -48,6 +49,7 @@ class CefProcess : public base::RefCounted<CefProcess>,
     // support, etc).
     file_thread();
     io_thread();
+    worker_pool();
   }
 
   CefProcessUIThread* ui_thread() {
@@ -64,6 +66,16 @@ class CefProcess : public base::RefCounted<CefProcess>,
   // Run the UI message loop for the on the current thread.
   void RunMessageLoop();
 
+  // Returns a file descriptor that is signaled when work is scheduled on the UI
+  // message loop, or -1 if not supported. Only valid if the UI message loop
+  // runs on the current thread.
+  int GetMessageLoopWakeupFd();
+
+  // Returns the delay in milliseconds until delayed work is due on the UI
+  // message loop, 0 if work is ready now or -1 if there is no delayed work.
+  // Only valid if the UI message loop runs on the current thread.
+  int64 GetMessageLoopWorkDelay();
+
   // Returns the thread that we perform I/O coordination on (network requests,
   // communication with renderers, etc.
   // NOTE: You should ONLY use this to pass to IPC or other objects which must
@@ -89,6 +101,15 @@ class CefProcess : public base::RefCounted<CefProcess>,
     return file_thread_.get();
   }
 
+  // Returns the pool of threads used for CPU-bound work. Use
+  // CefWorkerPool::PostTask to post tasks to the pool.
+  CefWorkerPool* worker_pool() {
+    DCHECK(CalledOnValidThread());
+    if (!created_worker_pool_)
+      CreateWorkerPool();
+    return worker_pool_.get();
+  }
+
 #if defined(IPC_MESSAGE_LOG_ENABLED)
   // Enable or disable IPC logging for the browser, all processes
   // derived from ChildProcess (plugin etc), and all
@@ -100,6 +121,7 @@ class CefProcess : public base::RefCounted<CefProcess>,
   void CreateUIThread();
   void CreateIOThread();
   void CreateFileThread();
+  void CreateWorkerPool();
 
   bool multi_threaded_message_loop_;
 
@@ -113,6 +135,9 @@ class CefProcess : public base::RefCounted<CefProcess>,
   bool created_file_thread_;
   scoped_ptr<base::Thread> file_thread_;
 
+  bool created_worker_pool_;
+  scoped_ptr<CefWorkerPool> worker_pool_;
+
   DISALLOW_COPY_AND_ASSIGN(CefProcess);
 };
 
@@ -5,11 +5,13 @@
 
 #include "cef_process_io_thread.h"
 #include "cef_context.h"
+#include "cef_startup_timer.h"
 #include "browser_appcache_system.h"
 #include "browser_file_writer.h"
 #include "browser_resource_loader_bridge.h"
 #include "browser_socket_stream_bridge.h"
 #include "browser_webblobregistry_impl.h"
+#include "request_context_impl.h"
 
 #include "build/build_config.h"
 #include "net/socket/client_socket_pool_manager.h"
@@ -31,6 +33,8 @@ CefProcessIOThread::~CefProcessIOThread() {
 }
 
 void CefProcessIOThread::Init() {
+  CefStartupTimer timer(CefStartupTimer::IO_THREAD_INIT);
+
 #if defined(OS_WIN)
   // Initializes the COM library on the current thread.
   CoInitialize(NULL);
@@ -41,7 +45,8 @@ void CefProcessIOThread::Init() {
       net::HttpCache::NORMAL, false);
   _Context->set_request_context(request_context_);
 
-  BrowserAppCacheSystem::InitializeOnIOThread(request_context_);
+  // The appcache system is initialized when the first document is loaded. See
+  // BrowserAppCacheSystem::CreateApplicationCacheHost().
   BrowserFileWriter::InitializeOnIOThread(request_context_);
   BrowserSocketStreamBridge::InitializeOnIOThread(request_context_);
   BrowserWebBlobRegistryImpl::InitializeOnIOThread(
@@ -49,6 +54,12 @@ void CefProcessIOThread::Init() {
 }
 
 void CefProcessIOThread::CleanUp() {
+  // Request contexts that are still referenced by the client would otherwise
+  // keep their network objects, and the global request context, alive after
+  // the IO thread is gone. Released first so that contexts destroyed while
+  // this runs post their releases before the pending messages are flushed.
+  CefRequestContextImpl::ShutdownOnIOThread();
+
   // Flush any remaining messages.  This ensures that any accumulated
   // Task objects get destroyed before we exit, which avoids noise in
   // purify leak-test results.
@@ -7,6 +7,7 @@
 #include "browser_webkit_glue.h"
 #include "browser_webkit_init.h"
 #include "cef_context.h"
+#include "cef_startup_timer.h"
 
 #include "base/command_line.h"
 #include "base/i18n/icu_util.h"
@@ -20,7 +21,6 @@
 #include "ui/gfx/gl/gl_implementation.h"
 #include "webkit/extensions/v8/gc_extension.h"
 #include "webkit/glue/webkit_glue.h"
-#include "webkit/plugins/npapi/plugin_list.h"
 
 #if defined(OS_WIN)
 #include <commctrl.h>
@@ -45,6 +45,8 @@ CefProcessUIThread::~CefProcessUIThread() {
 }
 
 void CefProcessUIThread::Init() {
+  CefStartupTimer timer(CefStartupTimer::UI_THREAD_INIT);
+
   PlatformInit();
 
   // Initialize the global CommandLine object.
@@ -71,7 +73,10 @@ void CefProcessUIThread::Init() {
       logging::DISABLE_DCHECK_FOR_NON_OFFICIAL_RELEASE_BUILDS);
 
   // Initialize WebKit.
-  webkit_init_ = new BrowserWebKitInit();
+  {
+    CefStartupTimer webkit_timer(CefStartupTimer::WEBKIT_INIT);
+    webkit_init_ = new BrowserWebKitInit();
+  }
 
   // Initialize WebKit encodings
   webkit_glue::InitializeTextEncoding();
@@ -121,20 +126,9 @@ void CefProcessUIThread::Init() {
 
   if (settings.user_agent.length > 0)
     webkit_glue::SetUserAgent(CefString(&settings.user_agent));
-  
-  if (settings.extra_plugin_paths) {
-    cef_string_t str;
-    memset(&str, 0, sizeof(str));
-
-    FilePath path;
-    int size = cef_string_list_size(settings.extra_plugin_paths);
-    for(int i = 0; i < size; ++i) {
-      if (!cef_string_list_value(settings.extra_plugin_paths, i, &str))
-        continue;
-      path = FilePath(CefString(&str));
-      webkit::npapi::PluginList::Singleton()->AddExtraPluginPath(path);
-    }
-  }
+
+  // The plugin list, including |settings.extra_plugin_paths|, is loaded by
+  // webkit_glue::GetLoadedPluginList() when first queried.
 
   // Create a network change notifier before starting the IO & File threads.
   network_change_notifier_.reset(net::NetworkChangeNotifier::Create());
@@ -5,8 +5,19 @@
 #include "cef_process_ui_thread.h"
 #include "browser_impl.h"
 #include "browser_webkit_glue.h"
+#include "cef_context.h"
+
+#include <gtk/gtk.h>
 
 void CefProcessUIThread::PlatformInit() {
+  if (_Context->settings().multi_threaded_message_loop &&
+      !gdk_display_get_default()) {
+    // The UI thread owns GTK when the message loop runs in a separate thread.
+    // Initialization fails without a display in which case only windowless
+    // browsers can be created.
+    gtk_init_check(NULL, NULL);
+  }
+
 	webkit_glue::InitializeDataPak();
 }
 
@@ -0,0 +1,75 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "cef_startup_timer.h"
+
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "base/synchronization/lock.h"
+
+namespace {
+
+// Trace event names for each phase.
+const char* kPhaseNames[CefStartupTimer::PHASE_COUNT] = {
+  "CefStartup::Initialize",
+  "CefStartup::UIThreadInit",
+  "CefStartup::WebKitInit",
+  "CefStartup::IOThreadInit",
+  "CefStartup::AppCacheInit",
+  "CefStartup::DatabaseInit",
+  "CefStartup::FileSystemInit",
+  "CefStartup::PluginInit",
+};
+
+struct TimingData {
+  TimingData() {
+    for (int i = 0; i < CefStartupTimer::PHASE_COUNT; ++i)
+      timings[i] = 0;
+  }
+
+  base::Lock lock;
+  double timings[CefStartupTimer::PHASE_COUNT];
+};
+
+base::LazyInstance<TimingData> g_timing_data(base::LINKER_INITIALIZED);
+
+} // namespace
+
+
+CefStartupTimer::CefStartupTimer(Phase phase)
+    : phase_(phase),
+      start_time_(base::TimeTicks::Now()),
+      trace_scope_("startup", kPhaseNames[phase], NULL, 0) {
+  DCHECK(phase >= 0 && phase < PHASE_COUNT);
+}
+
+CefStartupTimer::~CefStartupTimer() {
+  double elapsed = (base::TimeTicks::Now() - start_time_).InMillisecondsF();
+
+  TimingData& data = g_timing_data.Get();
+  base::AutoLock lock_scope(data.lock);
+  data.timings[phase_] = elapsed;
+}
+
+// static
+void CefStartupTimer::Reset() {
+  TimingData& data = g_timing_data.Get();
+  base::AutoLock lock_scope(data.lock);
+  for (int i = 0; i < PHASE_COUNT; ++i)
+    data.timings[i] = 0;
+}
+
+// static
+void CefStartupTimer::GetTimings(cef_startup_timings_t* timings) {
+  TimingData& data = g_timing_data.Get();
+  base::AutoLock lock_scope(data.lock);
+  timings->initialize = data.timings[INITIALIZE];
+  timings->ui_thread_init = data.timings[UI_THREAD_INIT];
+  timings->webkit_init = data.timings[WEBKIT_INIT];
+  timings->io_thread_init = data.timings[IO_THREAD_INIT];
+  timings->appcache_init = data.timings[APPCACHE_INIT];
+  timings->database_init = data.timings[DATABASE_INIT];
+  timings->file_system_init = data.timings[FILE_SYSTEM_INIT];
+  timings->plugin_init = data.timings[PLUGIN_INIT];
+}
@@ -0,0 +1,57 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#ifndef _CEF_STARTUP_TIMER_H
+#define _CEF_STARTUP_TIMER_H
+
+#include "cef_trace.h"
+#include "include/internal/cef_types.h"
+
+#include "base/basictypes.h"
+#include "base/time.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// CefStartupTimer
+//
+// Records the duration of the current scope as the time spent in a startup
+// phase. Each phase is also recorded as a trace event. For example:
+//
+//   void CefProcessIOThread::Init() {
+//     CefStartupTimer timer(CefStartupTimer::IO_THREAD_INIT);
+//     ...
+//   }
+//
+// Timings may be recorded on any thread.
+class CefStartupTimer {
+ public:
+  enum Phase {
+    INITIALIZE,
+    UI_THREAD_INIT,
+    WEBKIT_INIT,
+    IO_THREAD_INIT,
+    APPCACHE_INIT,
+    DATABASE_INIT,
+    FILE_SYSTEM_INIT,
+    PLUGIN_INIT,
+    PHASE_COUNT,
+  };
+
+  explicit CefStartupTimer(Phase phase);
+  ~CefStartupTimer();
+
+  // Discard all recorded timings. Called when CEF is initialized.
+  static void Reset();
+
+  // Copy the recorded timings into |timings|.
+  static void GetTimings(cef_startup_timings_t* timings);
+
+ private:
+  Phase phase_;
+  base::TimeTicks start_time_;
+  CefTraceScope trace_scope_;
+
+  DISALLOW_COPY_AND_ASSIGN(CefStartupTimer);
+};
+
+#endif  // _CEF_STARTUP_TIMER_H
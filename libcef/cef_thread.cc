@@ -4,13 +4,22 @@
 // found in the LICENSE file.
 
 #include "cef_thread.h"
+#include "cef_thread_stats.h"
 
 #include "base/compiler_specific.h"
+#include "base/lazy_instance.h"
 #include "base/message_loop.h"
 #include "base/message_loop_proxy.h"
+#include "base/threading/thread_local.h"
 
 using base::MessageLoopProxy;
 
+// The CefThread that is running on the current thread, if any. Set the first
+// time the current thread is identified so that later lookups don't need to
+// search |cef_threads_|.
+static base::LazyInstance<base::ThreadLocalPointer<CefThread> >
+    g_current_cef_thread(base::LINKER_INITIALIZED);
+
 // Friendly names for the well-known threads.
 static const char* cef_thread_names[CefThread::ID_COUNT] = {
   "Cef_UIThread",  // UI
@@ -115,6 +124,10 @@ CefThread::~CefThread() {
   // correct CefThread succeeds.
   Stop();
 
+  // The UI thread object may be destroyed on the thread that it represents.
+  if (g_current_cef_thread.Pointer()->Get() == this)
+    g_current_cef_thread.Pointer()->Set(NULL);
+
   base::AutoLock lock(lock_);
   cef_threads_[identifier_] = NULL;
 #ifndef NDEBUG
@@ -135,10 +148,12 @@ bool CefThread::IsWellKnownThread(ID identifier) {
 
 // static
 bool CefThread::CurrentlyOn(ID identifier) {
-  base::AutoLock lock(lock_);
   DCHECK(identifier >= 0 && identifier < ID_COUNT);
-  return cef_threads_[identifier] &&
-         cef_threads_[identifier]->message_loop() == MessageLoop::current();
+  // No lock is required. If the current thread is a CefThread it can't be
+  // destroyed while this method is running.
+  ID current_thread;
+  return GetCurrentThreadIdentifier(&current_thread) &&
+         current_thread == identifier;
 }
 
 // static
@@ -207,11 +222,23 @@ bool CefThread::PostNonNestableDelayedTask(
 
 // static
 bool CefThread::GetCurrentThreadIdentifier(ID* identifier) {
+  CefThread* current = g_current_cef_thread.Pointer()->Get();
+  if (current) {
+    *identifier = current->identifier_;
+    return true;
+  }
+
+  // Threads without a MessageLoop, such as worker pool threads, are never
+  // well-known threads.
   MessageLoop* cur_message_loop = MessageLoop::current();
+  if (!cur_message_loop)
+    return false;
+
   for (int i = 0; i < ID_COUNT; ++i) {
-    if (cef_threads_[i] &&
-        cef_threads_[i]->message_loop() == cur_message_loop) {
-      *identifier = cef_threads_[i]->identifier_;
+    CefThread* thread = cef_threads_[i];
+    if (thread && thread->message_loop() == cur_message_loop) {
+      g_current_cef_thread.Pointer()->Set(thread);
+      *identifier = thread->identifier_;
       return true;
     }
   }
@@ -252,6 +279,10 @@ bool CefThread::PostTaskHelper(
   MessageLoop* message_loop = cef_threads_[identifier] ?
       cef_threads_[identifier]->message_loop() : NULL;
   if (message_loop) {
+    if (CefThreadStatsCollector::IsEnabled())
+      task = CefThreadStatsCollector::WrapTask(identifier, from_here, task,
+                                               delay_ms);
+
     if (nestable) {
       message_loop->PostDelayedTask(from_here, task, delay_ms);
     } else {
@@ -293,7 +324,16 @@ bool CefThread::PostTaskHelper(
   MessageLoop* message_loop = cef_threads_[identifier] ?
       cef_threads_[identifier]->message_loop() : NULL;
   if (message_loop) {
-    if (nestable) {
+    if (CefThreadStatsCollector::IsEnabled()) {
+      Task* tracked_task =
+          CefThreadStatsCollector::WrapClosure(identifier, from_here, task, delay_ms);
+      if (nestable) {
+        message_loop->PostDelayedTask(from_here, tracked_task, delay_ms);
+      } else {
+        message_loop->PostNonNestableDelayedTask(from_here, tracked_task,
+                                                 delay_ms);
+      }
+    } else if (nestable) {
       message_loop->PostDelayedTask(from_here, task, delay_ms);
     } else {
       message_loop->PostNonNestableDelayedTask(from_here, task, delay_ms);
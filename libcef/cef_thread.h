@@ -32,8 +32,8 @@ class MessageLoopProxy;
 // It's always safe to call PostTask on any thread.  If it's not yet created,
 // the task is deleted.  There are no race conditions.  If the thread that the
 // task is posted to is guaranteed to outlive the current thread, then no locks
-// are used.  You should never need to cache pointers to MessageLoops, since
-// they're not thread safe.
+// are used.  CurrentlyOn() never locks.  You should never need to cache
+// pointers to MessageLoops, since they're not thread safe.
 class CefThread : public base::Thread {
  public:
   // An enumeration of the well-known threads.
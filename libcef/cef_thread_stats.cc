@@ -0,0 +1,346 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "cef_thread_stats.h"
+
+#include <string.h>
+
+#include <algorithm>
+#include <map>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/atomicops.h"
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/stringprintf.h"
+#include "base/synchronization/lock.h"
+#include "base/time.h"
+
+using base::subtle::Acquire_Load;
+using base::subtle::Atomic32;
+using base::subtle::Barrier_AtomicIncrement;
+using base::subtle::NoBarrier_CompareAndSwap;
+using base::subtle::NoBarrier_Load;
+using base::subtle::NoBarrier_Store;
+using base::subtle::Release_Store;
+
+namespace {
+
+// Used when CefSettings.slow_task_threshold is 0.
+const int kDefaultSlowTaskThresholdMs = 100;
+
+const char* kThreadNames[CefThread::ID_COUNT] = {
+  "UI",
+  "FILE",
+  "IO",
+};
+
+// Statistics for the tasks posted from a single location.
+struct LocationStats {
+  LocationStats() : function_name(NULL) {
+    memset(&stats, 0, sizeof(stats));
+  }
+
+  const char* function_name;
+  cef_thread_stats_t stats;
+};
+
+// Locations are identified by file name and line number. The file name is a
+// string literal so the pointer can be compared.
+typedef std::pair<const char*, int> LocationKey;
+typedef std::map<LocationKey, LocationStats> LocationMap;
+
+struct ThreadData {
+  ThreadData() : queue_depth(0), max_queue_depth(0) {
+    memset(&totals, 0, sizeof(totals));
+  }
+
+  // Accessed without holding |lock|.
+  Atomic32 queue_depth;
+  Atomic32 max_queue_depth;
+
+  // Protects the members below. Only contended while statistics are read.
+  base::Lock lock;
+  cef_thread_stats_t totals;
+  LocationMap locations;
+};
+
+struct StatsData {
+  ThreadData threads[CefThread::ID_COUNT];
+};
+
+base::LazyInstance<StatsData> g_stats(base::LINKER_INITIALIZED);
+
+// Collection may be started and stopped while tasks are being posted.
+Atomic32 g_enabled = 0;
+Atomic32 g_slow_task_threshold_ms = kDefaultSlowTaskThresholdMs;
+
+// Returns the histogram bucket for |delta|.
+int GetBucket(const base::TimeDelta& delta) {
+  int64 ms = delta.InMilliseconds();
+  int bucket = 0;
+  while (ms > 0 && bucket < CEF_THREAD_STATS_BUCKET_COUNT - 1) {
+    ms >>= 1;
+    ++bucket;
+  }
+  return bucket;
+}
+
+void RecordTask(cef_thread_stats_t* stats, const base::TimeDelta& latency,
+                const base::TimeDelta& run_time, bool slow) {
+  double latency_ms = latency.InMillisecondsF();
+  double run_time_ms = run_time.InMillisecondsF();
+
+  stats->task_count++;
+  if (slow)
+    stats->slow_task_count++;
+  stats->total_queue_latency += latency_ms;
+  stats->max_queue_latency = std::max(stats->max_queue_latency, latency_ms);
+  stats->total_run_time += run_time_ms;
+  stats->max_run_time = std::max(stats->max_run_time, run_time_ms);
+  stats->queue_latency_histogram[GetBucket(latency)]++;
+  stats->run_time_histogram[GetBucket(run_time)]++;
+}
+
+void IncrementQueueDepth(ThreadData* data) {
+  Atomic32 depth = Barrier_AtomicIncrement(&data->queue_depth, 1);
+  Atomic32 max_depth = NoBarrier_Load(&data->max_queue_depth);
+  while (depth > max_depth) {
+    Atomic32 prev =
+        NoBarrier_CompareAndSwap(&data->max_queue_depth, max_depth, depth);
+    if (prev == max_depth)
+      break;
+    max_depth = prev;
+  }
+}
+
+std::string FormatHistogram(const int64* histogram) {
+  std::string result;
+  for (int i = 0; i < CEF_THREAD_STATS_BUCKET_COUNT; ++i) {
+    if (histogram[i] == 0)
+      continue;
+    if (i < CEF_THREAD_STATS_BUCKET_COUNT - 1) {
+      base::StringAppendF(&result, " <%dms:%lld", 1 << i,
+                          static_cast<long long>(histogram[i]));
+    } else {
+      base::StringAppendF(&result, " >=%dms:%lld", 1 << (i - 1),
+                          static_cast<long long>(histogram[i]));
+    }
+  }
+  return result;
+}
+
+std::string FormatStats(const cef_thread_stats_t& stats) {
+  double count = stats.task_count > 0 ?
+      static_cast<double>(stats.task_count) : 1.0;
+  return base::StringPrintf(
+      "tasks=%lld slow=%lld latency avg=%.2fms max=%.2fms "
+      "run avg=%.2fms max=%.2fms\n    latency:%s\n    run:%s",
+      static_cast<long long>(stats.task_count),
+      static_cast<long long>(stats.slow_task_count),
+      stats.total_queue_latency / count, stats.max_queue_latency,
+      stats.total_run_time / count, stats.max_run_time,
+      FormatHistogram(stats.queue_latency_histogram).c_str(),
+      FormatHistogram(stats.run_time_histogram).c_str());
+}
+
+bool CompareTotalRunTime(const std::pair<LocationKey, LocationStats>& a,
+                         const std::pair<LocationKey, LocationStats>& b) {
+  return a.second.stats.total_run_time > b.second.stats.total_run_time;
+}
+
+void FILE_LogStats(int interval_sec) {
+  CefThreadStatsCollector::LogStats();
+  CefThread::PostDelayedTask(CefThread::FILE, FROM_HERE,
+      NewRunnableFunction(FILE_LogStats, interval_sec),
+      static_cast<int64>(interval_sec) * 1000);
+}
+
+} // namespace
+
+
+class CefThreadStatsCollector::TrackedTask : public Task {
+ public:
+  TrackedTask(CefThread::ID identifier,
+              const tracked_objects::Location& from_here,
+              Task* task,
+              const base::Closure& closure,
+              int64 delay_ms)
+      : identifier_(identifier),
+        from_here_(from_here),
+        task_(task),
+        closure_(closure),
+        due_time_(base::TimeTicks::Now() +
+                  base::TimeDelta::FromMilliseconds(delay_ms)),
+        queued_(true) {
+    IncrementQueueDepth(&g_stats.Get().threads[identifier_]);
+  }
+
+  virtual ~TrackedTask() {
+    // The task may be deleted without running if the thread is shutting down.
+    Dequeue();
+  }
+
+  virtual void Run() {
+    Dequeue();
+
+    base::TimeTicks start_time = base::TimeTicks::Now();
+    if (task_.get())
+      task_->Run();
+    else
+      closure_.Run();
+    base::TimeTicks end_time = base::TimeTicks::Now();
+
+    // A delayed task may run slightly before its due time.
+    base::TimeDelta latency = std::max(start_time - due_time_,
+                                       base::TimeDelta());
+    base::TimeDelta run_time = end_time - start_time;
+    bool slow = run_time.InMilliseconds() >=
+        NoBarrier_Load(&g_slow_task_threshold_ms);
+
+    ThreadData& data = g_stats.Get().threads[identifier_];
+    {
+      base::AutoLock lock_scope(data.lock);
+      RecordTask(&data.totals, latency, run_time, slow);
+      LocationStats& location = data.locations[
+          LocationKey(from_here_.file_name(), from_here_.line_number())];
+      location.function_name = from_here_.function_name();
+      RecordTask(&location.stats, latency, run_time, slow);
+    }
+
+    if (slow) {
+      LOG(WARNING) << "Slow task on the " << kThreadNames[identifier_] <<
+          " thread: " << from_here_.function_name() << " (" <<
+          from_here_.file_name() << ":" << from_here_.line_number() <<
+          ") ran for " << run_time.InMilliseconds() << "ms after waiting " <<
+          latency.InMilliseconds() << "ms";
+    }
+  }
+
+ private:
+  void Dequeue() {
+    if (queued_) {
+      queued_ = false;
+      Barrier_AtomicIncrement(&g_stats.Get().threads[identifier_].queue_depth,
+                              -1);
+    }
+  }
+
+  CefThread::ID identifier_;
+  tracked_objects::Location from_here_;
+  scoped_ptr<Task> task_;
+  base::Closure closure_;
+  base::TimeTicks due_time_;
+  bool queued_;
+
+  DISALLOW_COPY_AND_ASSIGN(TrackedTask);
+};
+
+
+// static
+void CefThreadStatsCollector::Enable(int slow_task_threshold_ms) {
+  StatsData& stats = g_stats.Get();
+  for (int i = 0; i < CefThread::ID_COUNT; ++i) {
+    ThreadData& data = stats.threads[i];
+    base::AutoLock lock_scope(data.lock);
+    memset(&data.totals, 0, sizeof(data.totals));
+    data.locations.clear();
+    // Tasks that were tracked before a previous Disable() may still be queued
+    // and will decrement |queue_depth| when they run, so it is not reset.
+    NoBarrier_Store(&data.max_queue_depth, NoBarrier_Load(&data.queue_depth));
+  }
+
+  NoBarrier_Store(&g_slow_task_threshold_ms, slow_task_threshold_ms > 0 ?
+      slow_task_threshold_ms : kDefaultSlowTaskThresholdMs);
+  Release_Store(&g_enabled, 1);
+}
+
+// static
+void CefThreadStatsCollector::Disable() {
+  Release_Store(&g_enabled, 0);
+}
+
+// static
+bool CefThreadStatsCollector::IsEnabled() {
+  return Acquire_Load(&g_enabled) != 0;
+}
+
+// static
+Task* CefThreadStatsCollector::WrapTask(CefThread::ID identifier,
+                               const tracked_objects::Location& from_here,
+                               Task* task,
+                               int64 delay_ms) {
+  return new TrackedTask(identifier, from_here, task, base::Closure(),
+                         delay_ms);
+}
+
+// static
+Task* CefThreadStatsCollector::WrapClosure(CefThread::ID identifier,
+                                  const tracked_objects::Location& from_here,
+                                  const base::Closure& task,
+                                  int64 delay_ms) {
+  return new TrackedTask(identifier, from_here, NULL, task, delay_ms);
+}
+
+// static
+bool CefThreadStatsCollector::GetStats(CefThread::ID identifier,
+                              cef_thread_stats_t* stats) {
+  DCHECK(identifier >= 0 && identifier < CefThread::ID_COUNT);
+  if (!IsEnabled())
+    return false;
+
+  ThreadData& data = g_stats.Get().threads[identifier];
+  {
+    base::AutoLock lock_scope(data.lock);
+    *stats = data.totals;
+  }
+  stats->queue_depth = NoBarrier_Load(&data.queue_depth);
+  stats->max_queue_depth = NoBarrier_Load(&data.max_queue_depth);
+  return true;
+}
+
+// static
+void CefThreadStatsCollector::LogStats() {
+  if (!IsEnabled())
+    return;
+
+  for (int i = 0; i < CefThread::ID_COUNT; ++i) {
+    cef_thread_stats_t totals;
+    std::vector<std::pair<LocationKey, LocationStats> > locations;
+
+    ThreadData& data = g_stats.Get().threads[i];
+    {
+      base::AutoLock lock_scope(data.lock);
+      totals = data.totals;
+      locations.assign(data.locations.begin(), data.locations.end());
+    }
+
+    // List the locations that spent the most time running first.
+    std::sort(locations.begin(), locations.end(), CompareTotalRunTime);
+
+    std::string result = base::StringPrintf(
+        "Thread stats for the %s thread: depth=%d max_depth=%d %s",
+        kThreadNames[i], static_cast<int>(NoBarrier_Load(&data.queue_depth)),
+        static_cast<int>(NoBarrier_Load(&data.max_queue_depth)),
+        FormatStats(totals).c_str());
+    for (size_t j = 0; j < locations.size(); ++j) {
+      base::StringAppendF(&result, "\n  %s (%s:%d): %s",
+          locations[j].second.function_name, locations[j].first.first,
+          locations[j].first.second,
+          FormatStats(locations[j].second.stats).c_str());
+    }
+    LOG(INFO) << result;
+  }
+}
+
+// static
+void CefThreadStatsCollector::StartPeriodicLog(int interval_sec) {
+  DCHECK_GT(interval_sec, 0);
+  CefThread::PostDelayedTask(CefThread::FILE, FROM_HERE,
+      NewRunnableFunction(FILE_LogStats, interval_sec),
+      static_cast<int64>(interval_sec) * 1000);
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#ifndef _CEF_THREAD_STATS_H
+#define _CEF_THREAD_STATS_H
+
+#include "cef_thread.h"
+#include "include/internal/cef_types.h"
+
+#include "base/basictypes.h"
+#include "base/callback.h"
+#include "base/task.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// CefThreadStatsCollector
+//
+// Records task queue statistics for the CefThread message loops. When enabled
+// CefThread wraps each posted task so that the number of queued tasks, the
+// time each task waits after it becomes due and the time it spends running
+// are recorded for the target thread and for the FROM_HERE location that
+// posted it. Tasks that run for longer than the slow task threshold are logged
+// with their location.
+//
+// Statistics are recorded by the thread that runs the task and may be read
+// from any thread.
+class CefThreadStatsCollector {
+ public:
+  // Start collecting statistics and clear any statistics collected so far.
+  // Tasks that run for longer than |slow_task_threshold_ms| will be logged.
+  // Only tasks posted after this call are counted. May be called on any
+  // thread.
+  static void Enable(int slow_task_threshold_ms);
+
+  // Stop collecting statistics. Tasks that were already posted are still
+  // recorded when they run. May be called on any thread.
+  static void Disable();
+
+  // Returns true if statistics are being collected.
+  static bool IsEnabled();
+
+  // Returns a task that records statistics for |identifier| and then runs
+  // |task|. The returned task takes ownership of |task|.
+  static Task* WrapTask(CefThread::ID identifier,
+                        const tracked_objects::Location& from_here,
+                        Task* task,
+                        int64 delay_ms);
+  static Task* WrapClosure(CefThread::ID identifier,
+                           const tracked_objects::Location& from_here,
+                           const base::Closure& task,
+                           int64 delay_ms);
+
+  // Copy the statistics for |identifier| into |stats|. Returns false if
+  // statistics are not being collected.
+  static bool GetStats(CefThread::ID identifier, cef_thread_stats_t* stats);
+
+  // Write the statistics for all threads, broken down by location, to the log.
+  static void LogStats();
+
+  // Write the statistics to the log every |interval_sec| seconds from the FILE
+  // thread until the FILE thread is destroyed.
+  static void StartPeriodicLog(int interval_sec);
+
+ private:
+  class TrackedTask;
+
+  DISALLOW_IMPLICIT_CONSTRUCTORS(CefThreadStatsCollector);
+};
+
+#endif  // _CEF_THREAD_STATS_H
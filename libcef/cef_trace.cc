@@ -0,0 +1,235 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "cef_trace.h"
+#include "cef_worker_pool.h"
+
+#include <string>
+#include <vector>
+
+#include "base/file_path.h"
+#include "base/file_util.h"
+#include "base/json/string_escape.h"
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "base/message_loop.h"
+#include "base/process_util.h"
+#include "base/stringprintf.h"
+#include "base/synchronization/lock.h"
+#include "base/threading/platform_thread.h"
+#include "base/threading/thread_local.h"
+#include "base/time.h"
+
+namespace {
+
+// Number of events retained for each thread.
+const size_t kThreadBufferSize = 32 * 1024;
+
+struct TraceEvent {
+  int64 timestamp;
+  int64 id;
+  int64 arg_value;
+  const char* category;
+  const char* name;
+  const char* arg_name;
+  char phase;
+};
+
+// Events recorded by a single thread. The buffer is only written by its
+// thread so |lock| is only contended while the events are collected.
+struct ThreadBuffer {
+  ThreadBuffer() : thread_id(0), next(0), wrapped(false) {}
+
+  base::PlatformThreadId thread_id;
+  std::string thread_name;
+
+  base::Lock lock;
+  std::vector<TraceEvent> events;
+  size_t next;
+  bool wrapped;
+};
+
+struct TraceData {
+  TraceData() : started(false) {}
+
+  // Protects |buffers|. Only acquired when a thread records its first event
+  // and when tracing starts or stops.
+  base::Lock lock;
+  std::vector<ThreadBuffer*> buffers;
+  bool started;
+};
+
+base::LazyInstance<TraceData> g_trace_data(base::LINKER_INITIALIZED);
+
+// The buffer for the current thread. Buffers are never deleted so they may
+// outlive their thread.
+base::LazyInstance<base::ThreadLocalPointer<ThreadBuffer> >
+    g_thread_buffer(base::LINKER_INITIALIZED);
+
+ThreadBuffer* GetThreadBuffer() {
+  ThreadBuffer* buffer = g_thread_buffer.Pointer()->Get();
+  if (buffer)
+    return buffer;
+
+  buffer = new ThreadBuffer();
+  buffer->thread_id = base::PlatformThread::CurrentId();
+  if (MessageLoop::current() && !MessageLoop::current()->thread_name().empty())
+    buffer->thread_name = MessageLoop::current()->thread_name();
+  else if (CefWorkerPool::CurrentlyOn())
+    buffer->thread_name = "Cef_WorkerThread";
+
+  g_thread_buffer.Pointer()->Set(buffer);
+
+  TraceData& data = g_trace_data.Get();
+  base::AutoLock lock_scope(data.lock);
+  data.buffers.push_back(buffer);
+  return buffer;
+}
+
+void AppendQuoted(const char* str, std::string* out) {
+  base::JsonDoubleQuote(std::string(str), true, out);
+}
+
+void AppendEvent(const TraceEvent& event, int pid, const ThreadBuffer& buffer,
+                 std::string* out) {
+  base::StringAppendF(out, "{\"cat\":");
+  AppendQuoted(event.category, out);
+  base::StringAppendF(out, ",\"pid\":%d,\"tid\":%d,\"ts\":%lld,\"ph\":\"%c\","
+                      "\"name\":", pid, static_cast<int>(buffer.thread_id),
+                      static_cast<long long>(event.timestamp), event.phase);
+  AppendQuoted(event.name, out);
+
+  if (event.phase == CefTraceLog::PHASE_ASYNC_BEGIN ||
+      event.phase == CefTraceLog::PHASE_ASYNC_END) {
+    base::StringAppendF(out, ",\"id\":\"0x%llx\"",
+                        static_cast<unsigned long long>(event.id));
+  }
+
+  out->append(",\"args\":{");
+  if (event.phase == CefTraceLog::PHASE_COUNTER) {
+    // Counters are displayed using the argument names.
+    AppendQuoted(event.arg_name ? event.arg_name : "value", out);
+    base::StringAppendF(out, ":%lld", static_cast<long long>(event.arg_value));
+  } else if (event.arg_name) {
+    AppendQuoted(event.arg_name, out);
+    base::StringAppendF(out, ":%lld", static_cast<long long>(event.arg_value));
+  }
+  out->append("}}");
+}
+
+} // namespace
+
+
+base::subtle::Atomic32 CefTraceLog::enabled_ = 0;
+base::subtle::Atomic32 CefTraceLog::trace_id_ = 0;
+
+// static
+bool CefTraceLog::Start() {
+  TraceData& data = g_trace_data.Get();
+  base::AutoLock lock_scope(data.lock);
+  if (data.started)
+    return false;
+
+  // Discard events from the previous trace.
+  for (size_t i = 0; i < data.buffers.size(); ++i) {
+    ThreadBuffer* buffer = data.buffers[i];
+    base::AutoLock buffer_lock(buffer->lock);
+    buffer->next = 0;
+    buffer->wrapped = false;
+  }
+
+  data.started = true;
+  // Skip 0, which means that no trace is running.
+  int trace_id = base::subtle::NoBarrier_Load(&trace_id_) + 1;
+  base::subtle::NoBarrier_Store(&trace_id_, trace_id > 0 ? trace_id : 1);
+  base::subtle::Release_Store(&enabled_, 1);
+  return true;
+}
+
+// static
+bool CefTraceLog::Stop(const FilePath& path) {
+  TraceData& data = g_trace_data.Get();
+  std::vector<ThreadBuffer*> buffers;
+  {
+    base::AutoLock lock_scope(data.lock);
+    if (!data.started)
+      return false;
+    data.started = false;
+    base::subtle::Release_Store(&enabled_, 0);
+    buffers = data.buffers;
+  }
+
+  int pid = static_cast<int>(base::GetCurrentProcId());
+  std::string json("{\"traceEvents\":[");
+  bool first = true;
+
+  for (size_t i = 0; i < buffers.size(); ++i) {
+    ThreadBuffer* buffer = buffers[i];
+    base::AutoLock buffer_lock(buffer->lock);
+    if (buffer->next == 0 && !buffer->wrapped)
+      continue;
+
+    if (!buffer->thread_name.empty()) {
+      base::StringAppendF(&json, "%s{\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+                          "\"name\":\"thread_name\",\"args\":{\"name\":",
+                          first ? "" : ",", pid,
+                          static_cast<int>(buffer->thread_id));
+      AppendQuoted(buffer->thread_name.c_str(), &json);
+      json.append("}}");
+      first = false;
+    }
+
+    // Write the events from oldest to newest.
+    size_t count = buffer->wrapped ? buffer->events.size() : buffer->next;
+    size_t start = buffer->wrapped ? buffer->next : 0;
+    for (size_t j = 0; j < count; ++j) {
+      const TraceEvent& event =
+          buffer->events[(start + j) % buffer->events.size()];
+      if (!first)
+        json.append(",");
+      AppendEvent(event, pid, *buffer, &json);
+      first = false;
+    }
+
+    // Release the memory until the next trace.
+    std::vector<TraceEvent>().swap(buffer->events);
+    buffer->next = 0;
+    buffer->wrapped = false;
+  }
+
+  json.append("]}");
+
+  int size = static_cast<int>(json.size());
+  if (file_util::WriteFile(path, json.data(), size) != size) {
+    LOG(ERROR) << "Failed to write trace file " << path.value();
+    return false;
+  }
+  return true;
+}
+
+// static
+void CefTraceLog::AddEvent(Phase phase, const char* category, const char* name,
+                           int64 id, const char* arg_name, int64 arg_value) {
+  if (!IsEnabled())
+    return;
+
+  TraceEvent event;
+  event.timestamp = base::TimeTicks::HighResNow().ToInternalValue();
+  event.id = id;
+  event.arg_value = arg_value;
+  event.category = category;
+  event.name = name;
+  event.arg_name = arg_name;
+  event.phase = static_cast<char>(phase);
+
+  ThreadBuffer* buffer = GetThreadBuffer();
+  base::AutoLock buffer_lock(buffer->lock);
+  if (buffer->events.empty())
+    buffer->events.resize(kThreadBufferSize);
+  buffer->events[buffer->next] = event;
+  if (++buffer->next == buffer->events.size()) {
+    buffer->next = 0;
+    buffer->wrapped = true;
+  }
+}
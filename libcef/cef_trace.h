@@ -0,0 +1,145 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#ifndef _CEF_TRACE_H
+#define _CEF_TRACE_H
+
+#include "base/atomicops.h"
+#include "base/basictypes.h"
+
+class FilePath;
+
+///////////////////////////////////////////////////////////////////////////////
+// CefTraceLog
+//
+// Records trace events in the Chrome trace event format so that they can be
+// viewed with about:tracing. Use the CEF_TRACE_* macros below to add events:
+//
+//   void WebWidgetHost::Paint() {
+//     CEF_TRACE_EVENT0("cef", "WebWidgetHost::Paint");
+//     ...
+//   }
+//
+// Each thread records events into its own fixed size ring buffer so recording
+// an event never blocks on another thread. When the buffer is full the oldest
+// events are overwritten. When tracing is not started each macro costs a
+// single load of the enabled flag.
+//
+// Category, name and argument name strings are not copied and must be string
+// literals.
+class CefTraceLog {
+ public:
+  enum Phase {
+    PHASE_BEGIN = 'B',
+    PHASE_END = 'E',
+    PHASE_INSTANT = 'I',
+    PHASE_ASYNC_BEGIN = 'S',
+    PHASE_ASYNC_END = 'F',
+    PHASE_COUNTER = 'C',
+  };
+
+  // Start recording events. Any events from a previous trace are discarded.
+  // Returns false if tracing is already started.
+  static bool Start();
+
+  // Stop recording events and write them to |path|. Returns false if tracing
+  // was not started or the file could not be written.
+  static bool Stop(const FilePath& path);
+
+  // Returns true if events are being recorded.
+  static bool IsEnabled() {
+    return base::subtle::NoBarrier_Load(&enabled_) != 0;
+  }
+
+  // Returns a non-zero value that identifies the current trace, or 0 if
+  // events are not being recorded. Each call to Start() begins a new trace.
+  static int CurrentTrace() {
+    return IsEnabled() ? base::subtle::NoBarrier_Load(&trace_id_) : 0;
+  }
+
+  // Record an event for the current thread. |arg_name| may be NULL. |id| is
+  // only used by async events. Use the macros instead of calling this method
+  // directly.
+  static void AddEvent(Phase phase, const char* category, const char* name,
+                       int64 id, const char* arg_name, int64 arg_value);
+
+ private:
+  static base::subtle::Atomic32 enabled_;
+  static base::subtle::Atomic32 trace_id_;
+
+  DISALLOW_IMPLICIT_CONSTRUCTORS(CefTraceLog);
+};
+
+// Records a begin event on construction and the matching end event on
+// destruction. The end event is only recorded if the begin event was recorded
+// in the same trace.
+class CefTraceScope {
+ public:
+  CefTraceScope(const char* category, const char* name, const char* arg_name,
+                int64 arg_value)
+      : category_(category), name_(name),
+        trace_id_(CefTraceLog::CurrentTrace()) {
+    if (trace_id_) {
+      CefTraceLog::AddEvent(CefTraceLog::PHASE_BEGIN, category, name, 0,
+                            arg_name, arg_value);
+    }
+  }
+
+  ~CefTraceScope() {
+    if (trace_id_ && CefTraceLog::CurrentTrace() == trace_id_) {
+      CefTraceLog::AddEvent(CefTraceLog::PHASE_END, category_, name_, 0, NULL,
+                            0);
+    }
+  }
+
+ private:
+  const char* category_;
+  const char* name_;
+  int trace_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(CefTraceScope);
+};
+
+#define CEF_TRACE_CONCAT_INTERNAL(a, b) a##b
+#define CEF_TRACE_CONCAT(a, b) CEF_TRACE_CONCAT_INTERNAL(a, b)
+
+#define CEF_TRACE_ADD_EVENT(phase, category, name, id, arg_name, arg_value) \
+    do { \
+      if (CefTraceLog::IsEnabled()) { \
+        CefTraceLog::AddEvent(phase, category, name, \
+                              static_cast<int64>(id), arg_name, \
+                              static_cast<int64>(arg_value)); \
+      } \
+    } while (0)
+
+// Record the duration of the current scope.
+#define CEF_TRACE_EVENT0(category, name) \
+    CefTraceScope CEF_TRACE_CONCAT(cef_trace_scope_, __LINE__)( \
+        category, name, NULL, 0)
+#define CEF_TRACE_EVENT1(category, name, arg_name, arg_value) \
+    CefTraceScope CEF_TRACE_CONCAT(cef_trace_scope_, __LINE__)( \
+        category, name, arg_name, static_cast<int64>(arg_value))
+
+// Record a single point in time.
+#define CEF_TRACE_INSTANT0(category, name) \
+    CEF_TRACE_ADD_EVENT(CefTraceLog::PHASE_INSTANT, category, name, 0, NULL, 0)
+#define CEF_TRACE_INSTANT1(category, name, arg_name, arg_value) \
+    CEF_TRACE_ADD_EVENT(CefTraceLog::PHASE_INSTANT, category, name, 0, \
+                        arg_name, arg_value)
+
+// Record an operation that starts and finishes on different threads or in
+// different scopes. The begin and end events are matched by |name| and |id|.
+#define CEF_TRACE_ASYNC_BEGIN0(category, name, id) \
+    CEF_TRACE_ADD_EVENT(CefTraceLog::PHASE_ASYNC_BEGIN, category, name, id, \
+                        NULL, 0)
+#define CEF_TRACE_ASYNC_END0(category, name, id) \
+    CEF_TRACE_ADD_EVENT(CefTraceLog::PHASE_ASYNC_END, category, name, id, \
+                        NULL, 0)
+
+// Record the value of a counter.
+#define CEF_TRACE_COUNTER1(category, name, value) \
+    CEF_TRACE_ADD_EVENT(CefTraceLog::PHASE_COUNTER, category, name, 0, NULL, \
+                        value)
+
+#endif  // _CEF_TRACE_H
@@ -0,0 +1,415 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "cef_worker_pool.h"
+
+#include <algorithm>
+#include <deque>
+
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "base/stl_util-inl.h"
+#include "base/stringprintf.h"
+#include "base/sys_info.h"
+#include "base/threading/thread_local.h"
+
+using base::subtle::Acquire_Load;
+using base::subtle::Barrier_AtomicIncrement;
+using base::subtle::Release_Store;
+
+namespace {
+
+// The worker that is running on the current thread, if any.
+base::LazyInstance<base::ThreadLocalPointer<void> >
+    g_current_worker(base::LINKER_INITIALIZED);
+
+// Adds a delayed task to its sequence once the delay expires.
+class SequenceDelayedTask : public Task {
+ public:
+  SequenceDelayedTask(CefWorkerSequence* sequence, Task* task)
+      : sequence_(sequence), task_(task) {
+  }
+
+  virtual void Run() {
+    sequence_->PostTask(FROM_HERE, task_.release());
+  }
+
+ private:
+  scoped_refptr<CefWorkerSequence> sequence_;
+  scoped_ptr<Task> task_;
+};
+
+} // namespace
+
+
+class CefWorkerPool::Worker : public base::PlatformThread::Delegate {
+ public:
+  Worker(CefWorkerPool* pool, int index)
+      : pool_(pool),
+        name_(base::StringPrintf("Cef_WorkerThread/%d", index)),
+        thread_(base::kNullThreadHandle) {
+  }
+
+  ~Worker() {
+    STLDeleteElements(&tasks_);
+  }
+
+  bool Start() {
+    return base::PlatformThread::Create(0, this, &thread_);
+  }
+
+  void Join() {
+    if (thread_ != base::kNullThreadHandle) {
+      base::PlatformThread::Join(thread_);
+      thread_ = base::kNullThreadHandle;
+    }
+  }
+
+  CefWorkerPool* pool() const { return pool_; }
+
+  void Push(Task* task) {
+    base::AutoLock lock_scope(lock_);
+    tasks_.push_back(task);
+  }
+
+  // The owning worker takes tasks from the front of its queue.
+  Task* Pop() {
+    base::AutoLock lock_scope(lock_);
+    if (tasks_.empty())
+      return NULL;
+    Task* task = tasks_.front();
+    tasks_.pop_front();
+    return task;
+  }
+
+  // Other workers steal from the back so that they rarely compete with the
+  // owner for the same task.
+  Task* Steal() {
+    base::AutoLock lock_scope(lock_);
+    if (tasks_.empty())
+      return NULL;
+    Task* task = tasks_.back();
+    tasks_.pop_back();
+    return task;
+  }
+
+  // PlatformThread::Delegate methods.
+  virtual void ThreadMain() {
+    base::PlatformThread::SetName(name_.c_str());
+    g_current_worker.Pointer()->Set(this);
+
+    while (Task* task = pool_->GetNextTask(this)) {
+      task->Run();
+      delete task;
+    }
+
+    g_current_worker.Pointer()->Set(NULL);
+  }
+
+ private:
+  CefWorkerPool* pool_;
+  std::string name_;
+  base::PlatformThreadHandle thread_;
+
+  base::Lock lock_;
+  std::deque<Task*> tasks_;
+
+  DISALLOW_COPY_AND_ASSIGN(Worker);
+};
+
+
+// CefWorkerPool
+
+// static
+base::Lock CefWorkerPool::instance_lock_;
+
+// static
+CefWorkerPool* CefWorkerPool::instance_ = NULL;
+
+CefWorkerPool::DelayedTask::DelayedTask(Task* task, base::TimeTicks run_time,
+                                        int sequence_num)
+    : task(task),
+      run_time(run_time),
+      sequence_num(sequence_num) {
+}
+
+bool CefWorkerPool::DelayedTask::operator<(const DelayedTask& other) const {
+  // std::priority_queue keeps the largest element on top so the comparison is
+  // reversed. Tasks with the same run time run in the order they were posted.
+  if (run_time == other.run_time)
+    return sequence_num > other.sequence_num;
+  return run_time > other.run_time;
+}
+
+CefWorkerPool::CefWorkerPool(int thread_count)
+    : work_available_(&lock_),
+      next_sequence_num_(0),
+      shutdown_(false),
+      pending_count_(0),
+      delayed_count_(0),
+      idle_count_(0),
+      next_worker_(0),
+      shutdown_flag_(0) {
+  DCHECK_GT(thread_count, 0);
+
+  // All workers must exist before any of them start stealing.
+  for (int i = 0; i < thread_count; ++i)
+    workers_.push_back(new Worker(this, i));
+  for (size_t i = 0; i < workers_.size(); ++i) {
+    bool started = workers_[i]->Start();
+    DCHECK(started);
+  }
+
+  base::AutoLock lock_scope(instance_lock_);
+  DCHECK(!instance_);
+  instance_ = this;
+}
+
+CefWorkerPool::~CefWorkerPool() {
+  {
+    base::AutoLock lock_scope(instance_lock_);
+    DCHECK_EQ(this, instance_);
+    instance_ = NULL;
+  }
+
+  {
+    base::AutoLock lock_scope(lock_);
+    shutdown_ = true;
+    Release_Store(&shutdown_flag_, 1);
+    work_available_.Broadcast();
+  }
+
+  for (size_t i = 0; i < workers_.size(); ++i)
+    workers_[i]->Join();
+
+  // Delete the tasks that did not run.
+  STLDeleteElements(&workers_);
+  while (!delayed_tasks_.empty()) {
+    delete delayed_tasks_.top().task;
+    delayed_tasks_.pop();
+  }
+}
+
+// static
+bool CefWorkerPool::PostTask(const tracked_objects::Location& from_here,
+                             Task* task) {
+  return PostTaskHelper(task, 0);
+}
+
+// static
+bool CefWorkerPool::PostDelayedTask(const tracked_objects::Location& from_here,
+                                    Task* task,
+                                    int64 delay_ms) {
+  return PostTaskHelper(task, delay_ms);
+}
+
+// static
+bool CefWorkerPool::CurrentlyOn() {
+  return (g_current_worker.Pointer()->Get() != NULL);
+}
+
+// static
+int CefWorkerPool::GetDefaultThreadCount() {
+  return std::max(base::SysInfo::NumberOfProcessors(), 1);
+}
+
+// static
+bool CefWorkerPool::PostTaskHelper(Task* task, int64 delay_ms) {
+  // The pool joins its workers before it is destroyed so no lock is required
+  // when posting from a worker thread.
+  Worker* current = static_cast<Worker*>(g_current_worker.Pointer()->Get());
+  if (current) {
+    current->pool()->Enqueue(task, delay_ms, current);
+    return true;
+  }
+
+  base::AutoLock lock_scope(instance_lock_);
+  if (!instance_) {
+    delete task;
+    return false;
+  }
+
+  instance_->Enqueue(task, delay_ms, NULL);
+  return true;
+}
+
+void CefWorkerPool::Enqueue(Task* task, int64 delay_ms, Worker* worker) {
+  if (delay_ms > 0) {
+    base::AutoLock lock_scope(lock_);
+    delayed_tasks_.push(DelayedTask(task,
+        base::TimeTicks::Now() + base::TimeDelta::FromMilliseconds(delay_ms),
+        next_sequence_num_++));
+    Barrier_AtomicIncrement(&delayed_count_, 1);
+
+    // Wake a worker so that it waits for the new deadline.
+    work_available_.Signal();
+    return;
+  }
+
+  if (!worker) {
+    uint32 index =
+        static_cast<uint32>(Barrier_AtomicIncrement(&next_worker_, 1));
+    worker = workers_[index % workers_.size()];
+  }
+  worker->Push(task);
+
+  // An idle worker checks |pending_count_| after incrementing |idle_count_|
+  // and before waiting, so at least one side sees the other's update.
+  Barrier_AtomicIncrement(&pending_count_, 1);
+  if (Acquire_Load(&idle_count_) > 0) {
+    base::AutoLock lock_scope(lock_);
+    work_available_.Signal();
+  }
+}
+
+Task* CefWorkerPool::GetNextTask(Worker* worker) {
+  while (true) {
+    if (Acquire_Load(&shutdown_flag_))
+      return NULL;
+
+    if (Acquire_Load(&delayed_count_) > 0) {
+      base::AutoLock lock_scope(lock_);
+      ScheduleDueTasks(worker);
+    }
+
+    Task* task = worker->Pop();
+    for (size_t i = 0; !task && i < workers_.size(); ++i) {
+      if (workers_[i] != worker)
+        task = workers_[i]->Steal();
+    }
+    if (task) {
+      Barrier_AtomicIncrement(&pending_count_, -1);
+      return task;
+    }
+
+    base::AutoLock lock_scope(lock_);
+    if (shutdown_)
+      return NULL;
+
+    Barrier_AtomicIncrement(&idle_count_, 1);
+    if (Acquire_Load(&pending_count_) <= 0) {
+      if (delayed_tasks_.empty()) {
+        work_available_.Wait();
+      } else {
+        base::TimeDelta delay =
+            delayed_tasks_.top().run_time - base::TimeTicks::Now();
+        if (delay > base::TimeDelta())
+          work_available_.TimedWait(delay);
+      }
+    }
+    Barrier_AtomicIncrement(&idle_count_, -1);
+  }
+}
+
+void CefWorkerPool::ScheduleDueTasks(Worker* worker) {
+  lock_.AssertAcquired();
+
+  if (delayed_tasks_.empty())
+    return;
+
+  base::TimeTicks now = base::TimeTicks::Now();
+  int count = 0;
+  while (!delayed_tasks_.empty() && delayed_tasks_.top().run_time <= now) {
+    worker->Push(delayed_tasks_.top().task);
+    delayed_tasks_.pop();
+    ++count;
+  }
+
+  if (count > 0) {
+    Barrier_AtomicIncrement(&delayed_count_, -count);
+    Barrier_AtomicIncrement(&pending_count_, count);
+    // Let idle workers steal the remaining tasks.
+    if (count > 1)
+      work_available_.Broadcast();
+  }
+}
+
+
+// CefWorkerSequence
+
+CefWorkerSequence::CefWorkerSequence()
+    : scheduled_(false),
+      running_(false),
+      running_thread_id_(0) {
+}
+
+CefWorkerSequence::~CefWorkerSequence() {
+  while (!tasks_.empty()) {
+    delete tasks_.front();
+    tasks_.pop();
+  }
+}
+
+bool CefWorkerSequence::PostTask(const tracked_objects::Location& from_here,
+                                 Task* task) {
+  bool schedule;
+  {
+    base::AutoLock lock_scope(lock_);
+    tasks_.push(task);
+    schedule = !scheduled_;
+    scheduled_ = true;
+  }
+
+  if (schedule && !CefWorkerPool::PostTask(from_here,
+          NewRunnableMethod(this, &CefWorkerSequence::RunNextTask))) {
+    // The pool doesn't exist so the task will never run.
+    base::AutoLock lock_scope(lock_);
+    while (!tasks_.empty()) {
+      delete tasks_.front();
+      tasks_.pop();
+    }
+    scheduled_ = false;
+    return false;
+  }
+
+  return true;
+}
+
+bool CefWorkerSequence::PostDelayedTask(
+    const tracked_objects::Location& from_here,
+    Task* task,
+    int64 delay_ms) {
+  if (delay_ms <= 0)
+    return PostTask(from_here, task);
+
+  return CefWorkerPool::PostDelayedTask(from_here,
+      new SequenceDelayedTask(this, task), delay_ms);
+}
+
+bool CefWorkerSequence::RunsTasksOnCurrentThread() {
+  base::AutoLock lock_scope(lock_);
+  return (running_ &&
+          running_thread_id_ == base::PlatformThread::CurrentId());
+}
+
+void CefWorkerSequence::RunNextTask() {
+  Task* task;
+  {
+    base::AutoLock lock_scope(lock_);
+    DCHECK(!tasks_.empty());
+    task = tasks_.front();
+    tasks_.pop();
+    running_ = true;
+    running_thread_id_ = base::PlatformThread::CurrentId();
+  }
+
+  task->Run();
+  delete task;
+
+  bool reschedule;
+  {
+    base::AutoLock lock_scope(lock_);
+    running_ = false;
+    reschedule = !tasks_.empty();
+    if (!reschedule)
+      scheduled_ = false;
+  }
+
+  // Run one task at a time so that a long sequence does not monopolize a
+  // worker thread.
+  if (reschedule) {
+    CefWorkerPool::PostTask(FROM_HERE,
+        NewRunnableMethod(this, &CefWorkerSequence::RunNextTask));
+  }
+}
@@ -0,0 +1,158 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#ifndef _CEF_WORKER_POOL_H
+#define _CEF_WORKER_POOL_H
+
+#include <queue>
+#include <vector>
+
+#include "base/atomicops.h"
+#include "base/basictypes.h"
+#include "base/memory/ref_counted.h"
+#include "base/synchronization/condition_variable.h"
+#include "base/synchronization/lock.h"
+#include "base/task.h"
+#include "base/threading/platform_thread.h"
+#include "base/time.h"
+
+///////////////////////////////////////////////////////////////////////////////
+// CefWorkerPool
+//
+// A pool of threads for CPU-bound tasks that should not delay the UI, IO or
+// FILE threads. The pool is created by CefProcess with one thread per
+// processor core. Invoke a task on the pool:
+//
+//   CefWorkerPool::PostTask(FROM_HERE, task);
+//
+// Each worker thread owns a task queue. Tasks posted from a worker thread are
+// added to that worker's queue and tasks posted from other threads are
+// distributed between the workers. A worker that runs out of tasks steals from
+// the queues of the other workers before going to sleep.
+//
+// Tasks posted to the pool may run concurrently and in any order. Delayed
+// tasks will not run before their delay expires. Use CefWorkerSequence when
+// tasks must run one at a time in the order they were posted.
+//
+// Worker threads do not have a MessageLoop so tasks must not use
+// MessageLoop::current().
+//
+// As with CefThread it is always safe to post a task. If the pool doesn't
+// exist the task is deleted and false is returned. Tasks that have not started
+// when the pool is destroyed are deleted without running.
+class CefWorkerPool {
+ public:
+  // Start |thread_count| worker threads. Only one pool may exist at a time.
+  explicit CefWorkerPool(int thread_count);
+
+  // Stop the worker threads. Blocks until running tasks complete.
+  ~CefWorkerPool();
+
+  static bool PostTask(const tracked_objects::Location& from_here,
+                       Task* task);
+  static bool PostDelayedTask(const tracked_objects::Location& from_here,
+                              Task* task,
+                              int64 delay_ms);
+
+  // Callable on any thread. Returns true if called on a worker pool thread.
+  static bool CurrentlyOn();
+
+  // Returns the number of worker threads to create for this machine.
+  static int GetDefaultThreadCount();
+
+ private:
+  class Worker;
+
+  struct DelayedTask {
+    DelayedTask(Task* task, base::TimeTicks run_time, int sequence_num);
+
+    // Used to order the priority queue so that the earliest task is on top.
+    bool operator<(const DelayedTask& other) const;
+
+    Task* task;
+    base::TimeTicks run_time;
+    int sequence_num;
+  };
+
+  static bool PostTaskHelper(Task* task, int64 delay_ms);
+
+  // Add |task| to the queue of |worker| or, if |worker| is NULL, the next
+  // worker in turn.
+  void Enqueue(Task* task, int64 delay_ms, Worker* worker);
+
+  // Returns the next task for |worker|, waiting until one is available.
+  // Returns NULL when the pool is shutting down.
+  Task* GetNextTask(Worker* worker);
+
+  // Move delayed tasks that are due to the queue of |worker|. Must be called
+  // with |lock_| held.
+  void ScheduleDueTasks(Worker* worker);
+
+  std::vector<Worker*> workers_;
+
+  // Protects the members below. |work_available_| is signaled when a task is
+  // added while workers are idle.
+  base::Lock lock_;
+  base::ConditionVariable work_available_;
+  std::priority_queue<DelayedTask> delayed_tasks_;
+  int next_sequence_num_;
+  bool shutdown_;
+
+  // These counters are accessed without holding |lock_|.
+  base::subtle::Atomic32 pending_count_;
+  base::subtle::Atomic32 delayed_count_;
+  base::subtle::Atomic32 idle_count_;
+  base::subtle::Atomic32 next_worker_;
+  base::subtle::Atomic32 shutdown_flag_;
+
+  // Protects access to |instance_| from threads that are not workers.
+  static base::Lock instance_lock_;
+  static CefWorkerPool* instance_;
+
+  DISALLOW_COPY_AND_ASSIGN(CefWorkerPool);
+};
+
+///////////////////////////////////////////////////////////////////////////////
+// CefWorkerSequence
+//
+// Runs tasks on the worker pool one at a time in the order they were posted.
+// Tasks posted to the same sequence never run concurrently and each task sees
+// the effects of the tasks before it, although consecutive tasks may run on
+// different worker threads. A delayed task joins the end of the sequence when
+// its delay expires. Tasks that have not run when the sequence is destroyed
+// are deleted.
+class CefWorkerSequence
+    : public base::RefCountedThreadSafe<CefWorkerSequence> {
+ public:
+  CefWorkerSequence();
+
+  bool PostTask(const tracked_objects::Location& from_here, Task* task);
+  bool PostDelayedTask(const tracked_objects::Location& from_here,
+                       Task* task,
+                       int64 delay_ms);
+
+  // Returns true if a task from this sequence is running on the current
+  // thread.
+  bool RunsTasksOnCurrentThread();
+
+ private:
+  friend class base::RefCountedThreadSafe<CefWorkerSequence>;
+
+  ~CefWorkerSequence();
+
+  // Run the task at the front of the sequence.
+  void RunNextTask();
+
+  base::Lock lock_;
+  std::queue<Task*> tasks_;
+  // True if a RunNextTask() call is pending or running.
+  bool scheduled_;
+  // True while a task is running on |running_thread_id_|.
+  bool running_;
+  base::PlatformThreadId running_thread_id_;
+
+  DISALLOW_COPY_AND_ASSIGN(CefWorkerSequence);
+};
+
+#endif  // _CEF_WORKER_POOL_H
@@ -18,6 +18,15 @@ using WebKit::WebStorageArea;
 using WebKit::WebString;
 using WebKit::WebURL;
 
+namespace {
+
+// Estimated size of an item. Keys and values are stored as UTF-16.
+int64 ItemSize(const WebString& key, const WebString& value) {
+  return static_cast<int64>(key.length() + value.length()) * sizeof(char16);
+}
+
+}  // namespace
+
 DOMStorageArea::DOMStorageArea(
     const string16& origin,
     int64 id,
@@ -25,11 +34,14 @@ DOMStorageArea::DOMStorageArea(
     : origin_(origin),
       origin_url_(origin),
       id_(id),
+      memory_usage_(0),
       owner_(owner) {
   DCHECK(owner_);
 }
 
 DOMStorageArea::~DOMStorageArea() {
+  StopSharingItems();
+  AdjustMemoryUsage(-memory_usage_);
 }
 
 unsigned DOMStorageArea::Length() {
@@ -51,30 +63,81 @@ NullableString16 DOMStorageArea::SetItem(
     const string16& key, const string16& value,
     WebStorageArea::Result* result) {
   CreateWebStorageAreaIfNecessary();
+  StopSharingItems();
   WebString old_value;
   storage_area_->setItem(key, value, WebURL(), *result, old_value);
+  if (*result == WebStorageArea::ResultOK) {
+    int64 delta = ItemSize(key, value);
+    if (!old_value.isNull())
+      delta -= ItemSize(key, old_value);
+    AdjustMemoryUsage(delta);
+  }
   return old_value;
 }
 
 NullableString16 DOMStorageArea::RemoveItem(const string16& key) {
   CreateWebStorageAreaIfNecessary();
+  StopSharingItems();
   WebString old_value;
   storage_area_->removeItem(key, WebURL(), old_value);
+  if (!old_value.isNull())
+    AdjustMemoryUsage(-ItemSize(key, old_value));
   return old_value;
 }
 
 bool DOMStorageArea::Clear() {
   CreateWebStorageAreaIfNecessary();
+  StopSharingItems();
   bool somethingCleared;
   storage_area_->clear(WebURL(), somethingCleared);
+  AdjustMemoryUsage(-memory_usage_);
   return somethingCleared;
 }
 
+void DOMStorageArea::AddSharedItems(DOMStorageSharedItems* shared_items) {
+  DCHECK(owner_->dom_storage_type() == DOM_STORAGE_SESSION);
+  shared_items_.push_back(shared_items);
+}
+
 void DOMStorageArea::PurgeMemory() {
   storage_area_.reset();
+  AdjustMemoryUsage(-memory_usage_);
 }
 
 void DOMStorageArea::CreateWebStorageAreaIfNecessary() {
-  if (!storage_area_.get())
-    storage_area_.reset(owner_->CreateWebStorageArea(origin_));
+  if (storage_area_.get())
+    return;
+
+  storage_area_.reset(owner_->CreateWebStorageArea(origin_));
+
+  if (owner_->dom_storage_type() == DOM_STORAGE_LOCAL) {
+    // WebKit reads all of the items when the area is first accessed so
+    // measuring them here does not touch the disk again.
+    int64 size = 0;
+    unsigned length = storage_area_->length();
+    for (unsigned i = 0; i < length; ++i) {
+      WebString key = storage_area_->key(i);
+      size += ItemSize(key, storage_area_->getItem(key));
+    }
+    AdjustMemoryUsage(size);
+  } else {
+    // A cloned sessionStorage area starts with the items of the original.
+    AdjustMemoryUsage(owner_->TakeClonedItems(origin_, &shared_items_));
+  }
+}
+
+void DOMStorageArea::StopSharingItems() {
+  for (DOMStorageSharedItemsList::const_iterator iter(shared_items_.begin());
+       iter != shared_items_.end(); ++iter)
+    owner_->dom_storage_context()->StopSharingSessionStorage(*iter);
+  shared_items_.clear();
+}
+
+void DOMStorageArea::AdjustMemoryUsage(int64 delta) {
+  if (delta == 0)
+    return;
+  memory_usage_ += delta;
+  DCHECK_GE(memory_usage_, 0);
+  if (owner_->dom_storage_type() == DOM_STORAGE_LOCAL)
+    owner_->dom_storage_context()->AdjustLocalStorageMemoryUsage(delta);
 }
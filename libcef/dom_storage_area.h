@@ -6,6 +6,8 @@
 #define _DOM_STORAGE_AREA_H
 #pragma once
 
+#include <vector>
+
 #include "base/hash_tables.h"
 #include "base/memory/ref_counted.h"
 #include "base/memory/scoped_ptr.h"
@@ -15,6 +17,35 @@
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebStorageArea.h"
 
 class DOMStorageNamespace;
+
+// The estimated size of the items of a sessionStorage area that WebKit shares
+// between two copies of a namespace. Held by both copies until either side
+// writes to the area or is deleted, which ends the sharing.
+class DOMStorageSharedItems
+    : public base::RefCounted<DOMStorageSharedItems> {
+ public:
+  explicit DOMStorageSharedItems(int64 size) : size_(size) {}
+
+  // Returns the size if the items are still shared and marks them as no
+  // longer shared.
+  int64 TakeSize() {
+    int64 size = size_;
+    size_ = 0;
+    return size;
+  }
+
+ private:
+  friend class base::RefCounted<DOMStorageSharedItems>;
+  ~DOMStorageSharedItems() {}
+
+  int64 size_;
+
+  DISALLOW_COPY_AND_ASSIGN(DOMStorageSharedItems);
+};
+
+typedef std::vector<scoped_refptr<DOMStorageSharedItems> >
+    DOMStorageSharedItemsList;
+
 // Only use on the WebKit thread.  DOMStorageNamespace manages our registration
 // with DOMStorageContext.
 class DOMStorageArea {
@@ -36,12 +67,27 @@ class DOMStorageArea {
 
   int64 id() const { return id_; }
 
+  // Estimated size in bytes of the items held in memory.
+  int64 memory_usage() const { return memory_usage_; }
+
   DOMStorageNamespace* owner() const { return owner_; }
 
+  // Called when the items of this sessionStorage area are shared with a copy
+  // of the namespace.
+  void AddSharedItems(DOMStorageSharedItems* shared_items);
+
  private:
+  // Ends the sharing of the items with copies of the namespace. Called before
+  // the items are changed because WebKit copies them on the first write.
+  void StopSharingItems();
+
   // Creates the underlying WebStorageArea on demand.
   void CreateWebStorageAreaIfNecessary();
 
+  // Adjust the estimated size of the items held in memory and report the
+  // change to the DOMStorageContext for localStorage areas.
+  void AdjustMemoryUsage(int64 delta);
+
   // The origin this storage area represents.
   string16 origin_;
   GURL origin_url_;
@@ -52,6 +98,13 @@ class DOMStorageArea {
   // Our storage area id.  Unique to our parent context.
   int64 id_;
 
+  // Estimated size of the items. Only reported to the DOMStorageContext for
+  // localStorage areas because sessionStorage areas cannot be purged.
+  int64 memory_usage_;
+
+  // The items that are shared with copies of the namespace.
+  DOMStorageSharedItemsList shared_items_;
+
   // The DOMStorageNamespace that owns us.
   DOMStorageNamespace* owner_;
 
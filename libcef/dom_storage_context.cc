@@ -5,6 +5,7 @@
 #include "dom_storage_context.h"
 #include "cef_context.h"
 #include "cef_thread.h"
+#include "cef_trace.h"
 #include "dom_storage_namespace.h"
 
 #include <algorithm>
@@ -26,7 +27,12 @@ const FilePath::CharType DOMStorageContext::kLocalStorageExtension[] =
 DOMStorageContext::DOMStorageContext()
     : last_storage_area_id_(0),
       last_session_storage_namespace_id_on_ui_thread_(kLocalStorageNamespaceId),
-      last_session_storage_namespace_id_on_io_thread_(kLocalStorageNamespaceId){
+      last_session_storage_namespace_id_on_io_thread_(kLocalStorageNamespaceId),
+      local_storage_memory_usage_(0),
+      local_storage_memory_limit_(
+          _Context->settings().local_storage_memory_limit),
+      enforce_memory_limit_pending_(false),
+      session_storage_bytes_shared_(0) {
 }
 
 DOMStorageContext::~DOMStorageContext() {
@@ -57,6 +63,13 @@ int64 DOMStorageContext::CloneSessionStorage(int64 original_id) {
   return clone_id;
 }
 
+int64 DOMStorageContext::CopySessionStorage(int64 original_id) {
+  DCHECK(CefThread::CurrentlyOn(CefThread::UI));
+  int64 clone_id = AllocateSessionStorageNamespaceId();
+  CompleteCloningSessionStorage(this, original_id, clone_id);
+  return clone_id;
+}
+
 void DOMStorageContext::RegisterStorageArea(DOMStorageArea* storage_area) {
   DCHECK(CefThread::CurrentlyOn(CefThread::UI));
   int64 id = storage_area->id();
@@ -114,6 +127,70 @@ void DOMStorageContext::PurgeMemory() {
     local_storage->PurgeMemory();
 }
 
+void DOMStorageContext::FlushLocalStorage() {
+  DCHECK(CefThread::CurrentlyOn(CefThread::UI));
+  DOMStorageNamespace* local_storage =
+      GetStorageNamespace(kLocalStorageNamespaceId, false);
+  if (local_storage)
+    local_storage->Close();
+}
+
+void DOMStorageContext::AdjustLocalStorageMemoryUsage(int64 delta) {
+  DCHECK(CefThread::CurrentlyOn(CefThread::UI));
+  local_storage_memory_usage_ += delta;
+  DCHECK_GE(local_storage_memory_usage_, 0);
+
+  if (local_storage_memory_limit_ <= 0 ||
+      local_storage_memory_usage_ <= local_storage_memory_limit_ ||
+      enforce_memory_limit_pending_) {
+    return;
+  }
+
+  // Purging from inside a storage area method would release the area that is
+  // being used.
+  enforce_memory_limit_pending_ = true;
+  CefThread::PostTask(
+      CefThread::UI, FROM_HERE, NewRunnableFunction(
+          &DOMStorageContext::EnforceLocalStorageMemoryLimit, this));
+}
+
+void DOMStorageContext::GetLocalStorageItems(const string16& origin,
+                                             ItemMap* items) {
+  DCHECK(CefThread::CurrentlyOn(CefThread::UI));
+  DOMStorageArea* area =
+      GetStorageNamespace(kLocalStorageNamespaceId, true)->
+          GetStorageArea(origin);
+  unsigned length = area->Length();
+  for (unsigned i = 0; i < length; ++i) {
+    NullableString16 key = area->Key(i);
+    if (key.is_null())
+      continue;
+    NullableString16 value = area->GetItem(key.string());
+    if (!value.is_null())
+      (*items)[key.string()] = value.string();
+  }
+}
+
+bool DOMStorageContext::SetLocalStorageItems(const string16& origin,
+                                             const ItemMap& items,
+                                             bool clear) {
+  DCHECK(CefThread::CurrentlyOn(CefThread::UI));
+  DOMStorageArea* area =
+      GetStorageNamespace(kLocalStorageNamespaceId, true)->
+          GetStorageArea(origin);
+  if (clear)
+    area->Clear();
+
+  bool success = true;
+  for (ItemMap::const_iterator it = items.begin(); it != items.end(); ++it) {
+    WebKit::WebStorageArea::Result result = WebKit::WebStorageArea::ResultOK;
+    area->SetItem(it->first, it->second, &result);
+    if (result != WebKit::WebStorageArea::ResultOK)
+      success = false;
+  }
+  return success;
+}
+
 void DOMStorageContext::DeleteDataModifiedSince(
     const base::Time& cutoff,
     const char* url_scheme_to_be_skipped,
@@ -217,8 +294,56 @@ void DOMStorageContext::CompleteCloningSessionStorage(
   DOMStorageNamespace* existing_namespace =
       context->GetStorageNamespace(existing_id, false);
   // If nothing exists, then there's nothing to clone.
-  if (existing_namespace)
-    context->RegisterStorageNamespace(existing_namespace->Copy(clone_id));
+  if (!existing_namespace)
+    return;
+
+  context->RegisterStorageNamespace(existing_namespace->Copy(clone_id));
+
+  context->session_storage_bytes_shared_ +=
+      existing_namespace->GetMemoryUsage();
+  CEF_TRACE_COUNTER1("cef", "SessionStorageBytesShared",
+                     context->session_storage_bytes_shared_);
+}
+
+void DOMStorageContext::StopSharingSessionStorage(
+    DOMStorageSharedItems* shared_items) {
+  DCHECK(CefThread::CurrentlyOn(CefThread::UI));
+  int64 size = shared_items->TakeSize();
+  if (size == 0)
+    return;
+  session_storage_bytes_shared_ -= size;
+  DCHECK_GE(session_storage_bytes_shared_, 0);
+  CEF_TRACE_COUNTER1("cef", "SessionStorageBytesShared",
+                     session_storage_bytes_shared_);
+}
+
+/* static */
+void DOMStorageContext::EnforceLocalStorageMemoryLimit(
+    DOMStorageContext* context) {
+  DCHECK(CefThread::CurrentlyOn(CefThread::UI));
+  context->enforce_memory_limit_pending_ = false;
+  if (context->local_storage_memory_usage_ <=
+      context->local_storage_memory_limit_) {
+    return;
+  }
+
+  // Purging a single localStorage area that exceeds the limit by itself would
+  // only cause it to be read from disk again on the next access.
+  int loaded_count = 0;
+  for (StorageAreaMap::const_iterator it = context->storage_area_map_.begin();
+       it != context->storage_area_map_.end(); ++it) {
+    if (it->second->owner()->dom_storage_type() == DOM_STORAGE_LOCAL &&
+        it->second->memory_usage() > 0)
+      ++loaded_count;
+  }
+  if (loaded_count <= 1)
+    return;
+
+  // WebKit keeps the items of every localStorage area until the namespace is
+  // released so the areas cannot be released individually.
+  CEF_TRACE_INSTANT1("cef", "LocalStorageMemoryLimitPurge", "memory_usage",
+                     context->local_storage_memory_usage_);
+  context->PurgeMemory();
 }
 
 // static
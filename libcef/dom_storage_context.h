@@ -7,6 +7,7 @@
 
 #include <map>
 #include <set>
+#include <vector>
 
 #include "base/file_path.h"
 #include "base/string16.h"
@@ -14,6 +15,7 @@
 
 class DOMStorageArea;
 class DOMStorageNamespace;
+class DOMStorageSharedItems;
 
 // This is owned by CefContext and is all the dom storage information that's
 // shared by all of the browser windows.  The specifics of responsibilities are
@@ -37,6 +39,20 @@ class DOMStorageContext {
   // Only call on the IO thread.
   int64 CloneSessionStorage(int64 original_id);
 
+  // Same as CloneSessionStorage but the clone is created immediately.  Only
+  // call on the WebKit thread.
+  int64 CopySessionStorage(int64 original_id);
+
+  // Total estimated size of the sessionStorage items that were shared with a
+  // clone instead of being copied.
+  int64 session_storage_bytes_shared() const {
+    return session_storage_bytes_shared_;
+  }
+
+  // Called when the sessionStorage items in |shared_items| stop being shared,
+  // either because one of the copies wrote to them or was deleted.
+  void StopSharingSessionStorage(DOMStorageSharedItems* shared_items);
+
   // Various storage area methods.  The storage area is owned by one of the
   // namespaces that's owned by this class.
   void RegisterStorageArea(DOMStorageArea* storage_area);
@@ -54,6 +70,27 @@ class DOMStorageContext {
   // Tells storage namespaces to purge any memory they do not need.
   virtual void PurgeMemory();
 
+  // Writes the pending localStorage changes to disk and blocks until they have
+  // been written. Only call on the WebKit thread.
+  void FlushLocalStorage();
+
+  // Called by localStorage areas when the estimated size of the items they
+  // hold in memory changes. If the total exceeds the limit from CefSettings
+  // the localStorage namespace is purged after the current task.
+  void AdjustLocalStorageMemoryUsage(int64 delta);
+  int64 local_storage_memory_usage() const {
+    return local_storage_memory_usage_;
+  }
+
+  // Read all of the localStorage items for |origin|, or replace them with
+  // |items|. If |clear| is false the existing items that are not in |items|
+  // are kept. Returns false if an item could not be written because the quota
+  // was exceeded. Only call on the WebKit thread.
+  typedef std::map<string16, string16> ItemMap;
+  void GetLocalStorageItems(const string16& origin, ItemMap* items);
+  bool SetLocalStorageItems(const string16& origin, const ItemMap& items,
+                            bool clear);
+
   // Delete any local storage files that have been touched since the cutoff
   // date that's supplied.
   void DeleteDataModifiedSince(const base::Time& cutoff,
@@ -99,6 +136,10 @@ class DOMStorageContext {
   static void CompleteCloningSessionStorage(DOMStorageContext* context,
                                             int64 existing_id, int64 clone_id);
 
+  // Purge the localStorage namespace if it still exceeds the memory limit.
+  // Static for the same reason as CompleteCloningSessionStorage.
+  static void EnforceLocalStorageMemoryLimit(DOMStorageContext* context);
+
   // The last used storage_area_id and storage_namespace_id's.  For the storage
   // namespaces, IDs allocated on the UI thread are positive and count up while
   // IDs allocated on the IO thread are negative and count down.  This allows us
@@ -116,6 +157,14 @@ class DOMStorageContext {
   // Maps ids to StorageNamespaces.  We own these objects.
   typedef std::map<int64, DOMStorageNamespace*> StorageNamespaceMap;
   StorageNamespaceMap storage_namespace_map_;
+
+  // Estimated size of the localStorage items held in memory and the limit
+  // that causes them to be purged. The limit is 0 if there is no limit.
+  int64 local_storage_memory_usage_;
+  int64 local_storage_memory_limit_;
+  bool enforce_memory_limit_pending_;
+
+  int64 session_storage_bytes_shared_;
 };
 
 #endif  // _DOM_STORAGE_CONTEXT_H
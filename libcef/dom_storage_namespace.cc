@@ -3,7 +3,6 @@
 // LICENSE file.
 
 #include "dom_storage_namespace.h"
-#include "dom_storage_area.h"
 #include "dom_storage_context.h"
 
 #include "base/file_path.h"
@@ -52,6 +51,13 @@ DOMStorageNamespace::~DOMStorageNamespace() {
     dom_storage_context_->UnregisterStorageArea(iter->second);
     delete iter->second;
   }
+  for (OriginToSharedItemsMap::const_iterator iter(
+           cloned_shared_items_.begin());
+       iter != cloned_shared_items_.end(); ++iter) {
+    for (DOMStorageSharedItemsList::const_iterator item(iter->second.begin());
+         item != iter->second.end(); ++item)
+      dom_storage_context_->StopSharingSessionStorage(*item);
+  }
 }
 
 DOMStorageArea* DOMStorageNamespace::GetStorageArea(
@@ -76,11 +82,72 @@ DOMStorageNamespace* DOMStorageNamespace::Copy(int64 id) {
   DOMStorageNamespace* new_storage_namespace = new DOMStorageNamespace(
       dom_storage_context_, id, data_dir_path_, dom_storage_type_);
   // If we haven't used the namespace yet, there's nothing to copy.
-  if (storage_namespace_.get())
-    new_storage_namespace->storage_namespace_.reset(storage_namespace_->copy());
+  if (!storage_namespace_.get())
+    return new_storage_namespace;
+
+  // WebKit shares the items of each area between the copies and only copies
+  // them when one of the copies is changed.
+  new_storage_namespace->storage_namespace_.reset(storage_namespace_->copy());
+
+  // Both copies hold the shared items of each area so that the sharing ends
+  // when either side writes to the area first.
+  OriginToSizeMap& sizes = new_storage_namespace->cloned_sizes_;
+  OriginToSharedItemsMap& shared_items =
+      new_storage_namespace->cloned_shared_items_;
+  for (OriginToSizeMap::const_iterator iter(cloned_sizes_.begin());
+       iter != cloned_sizes_.end(); ++iter) {
+    if (iter->second <= 0)
+      continue;
+    scoped_refptr<DOMStorageSharedItems> items(
+        new DOMStorageSharedItems(iter->second));
+    cloned_shared_items_[iter->first].push_back(items);
+    shared_items[iter->first].push_back(items);
+    sizes[iter->first] += iter->second;
+  }
+  for (OriginToStorageAreaMap::const_iterator iter(
+           origin_to_storage_area_.begin());
+       iter != origin_to_storage_area_.end(); ++iter) {
+    int64 size = iter->second->memory_usage();
+    if (size <= 0)
+      continue;
+    scoped_refptr<DOMStorageSharedItems> items(
+        new DOMStorageSharedItems(size));
+    iter->second->AddSharedItems(items);
+    shared_items[iter->first].push_back(items);
+    sizes[iter->first] += size;
+  }
   return new_storage_namespace;
 }
 
+int64 DOMStorageNamespace::GetMemoryUsage() const {
+  int64 size = 0;
+  for (OriginToStorageAreaMap::const_iterator iter(
+           origin_to_storage_area_.begin());
+       iter != origin_to_storage_area_.end(); ++iter)
+    size += iter->second->memory_usage();
+  for (OriginToSizeMap::const_iterator iter(cloned_sizes_.begin());
+       iter != cloned_sizes_.end(); ++iter)
+    size += iter->second;
+  return size;
+}
+
+int64 DOMStorageNamespace::TakeClonedItems(
+    const string16& origin, DOMStorageSharedItemsList* shared_items) {
+  OriginToSharedItemsMap::iterator items = cloned_shared_items_.find(origin);
+  if (items != cloned_shared_items_.end()) {
+    shared_items->insert(shared_items->end(), items->second.begin(),
+                         items->second.end());
+    cloned_shared_items_.erase(items);
+  }
+
+  OriginToSizeMap::iterator iter = cloned_sizes_.find(origin);
+  if (iter == cloned_sizes_.end())
+    return 0;
+  int64 size = iter->second;
+  cloned_sizes_.erase(iter);
+  return size;
+}
+
 void DOMStorageNamespace::PurgeMemory() {
   DCHECK(dom_storage_type_ == DOM_STORAGE_LOCAL);
   for (OriginToStorageAreaMap::iterator iter(origin_to_storage_area_.begin());
@@ -89,6 +156,19 @@ void DOMStorageNamespace::PurgeMemory() {
   storage_namespace_.reset();
 }
 
+void DOMStorageNamespace::Close() {
+  DCHECK(dom_storage_type_ == DOM_STORAGE_LOCAL);
+  for (OriginToStorageAreaMap::iterator iter(origin_to_storage_area_.begin());
+       iter != origin_to_storage_area_.end(); ++iter)
+    iter->second->PurgeMemory();
+  if (storage_namespace_.get()) {
+    // Schedules the final sync of each area behind any pending syncs and waits
+    // for the local storage thread to process them and exit.
+    storage_namespace_->close();
+    storage_namespace_.reset();
+  }
+}
+
 WebStorageArea* DOMStorageNamespace::CreateWebStorageArea(
     const string16& origin) {
   CreateWebStorageNamespaceIfNecessary();
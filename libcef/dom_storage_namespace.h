@@ -5,6 +5,7 @@
 #ifndef _DOM_STORAGE_NAMESPACE_H
 #define _DOM_STORAGE_NAMESPACE_H
 
+#include "dom_storage_area.h"
 #include "dom_storage_common.h"
 
 #include "base/hash_tables.h"
@@ -12,7 +13,6 @@
 #include "base/string16.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebString.h"
 
-class DOMStorageArea;
 class DOMStorageContext;
 class FilePath;
 
@@ -32,11 +32,29 @@ class DOMStorageNamespace {
   ~DOMStorageNamespace();
 
   DOMStorageArea* GetStorageArea(const string16& origin);
+
+  // Copy a sessionStorage namespace. The copy shares the items of each area
+  // with this namespace until either side writes to the area.
   DOMStorageNamespace* Copy(int64 clone_namespace_id);
 
+  // Returns the estimated size of the items in all areas, including the areas
+  // that were copied but have not been accessed yet.
+  int64 GetMemoryUsage() const;
+
+  // Returns the estimated size of the items that the area for |origin| was
+  // copied with and forgets it. The items that are still shared with other
+  // copies are appended to |shared_items|. Called when the copied area is
+  // first used.
+  int64 TakeClonedItems(const string16& origin,
+                        DOMStorageSharedItemsList* shared_items);
+
   void PurgeMemory();
 
-  const DOMStorageContext* dom_storage_context() const {
+  // Like PurgeMemory() but also closes the WebKit namespace, which blocks until
+  // the final sync of each area has been written by the local storage thread.
+  void Close();
+
+  DOMStorageContext* dom_storage_context() const {
     return dom_storage_context_;
   }
   int64 id() const { return id_; }
@@ -61,6 +79,16 @@ class DOMStorageNamespace {
   typedef base::hash_map<string16, DOMStorageArea*> OriginToStorageAreaMap;
   OriginToStorageAreaMap origin_to_storage_area_;
 
+  // Estimated sizes of the copied areas that have not been accessed yet.
+  typedef base::hash_map<string16, int64> OriginToSizeMap;
+  OriginToSizeMap cloned_sizes_;
+
+  // Items shared with other copies by the areas that have not been accessed
+  // yet.
+  typedef base::hash_map<string16, DOMStorageSharedItemsList>
+      OriginToSharedItemsMap;
+  OriginToSharedItemsMap cloned_shared_items_;
+
   // The DOMStorageContext that owns us.
   DOMStorageContext* dom_storage_context_;
 
@@ -0,0 +1,72 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "http_cache_size.h"
+
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "base/logging.h"
+#include "base/string_number_conversions.h"
+#include "net/base/net_errors.h"
+#include "net/disk_cache/disk_cache.h"
+
+namespace {
+
+// Name of the GetStats() item in which the blockfile backend reports the
+// bytes that it uses. See disk_cache::BackendImpl::GetStats().
+const char kCurrentSizeStat[] = "Current size";
+
+// net::HttpCache stores the response headers, the response data and the
+// metadata of an entry in separate streams.
+const int kHttpCacheStreamCount = 3;
+
+int64 GetDiskCacheBytesUsed(disk_cache::Backend* backend) {
+  std::vector<std::pair<std::string, std::string> > items;
+  backend->GetStats(&items);
+  for (size_t i = 0; i < items.size(); ++i) {
+    if (items[i].first != kCurrentSizeStat)
+      continue;
+    int64 bytes = 0;
+    if (base::StringToInt64(items[i].second, &bytes))
+      return bytes;
+    break;
+  }
+
+  // The blockfile backend always reports its size, so the statistics have
+  // changed.
+  NOTREACHED() << "The disk cache did not report its size";
+  return -1;
+}
+
+int64 GetMemoryCacheBytesUsed(disk_cache::Backend* backend) {
+  // The in-memory backend opens entries synchronously, so the enumeration
+  // completes without a callback.
+  int64 bytes = 0;
+  void* iter = NULL;
+  disk_cache::Entry* entry = NULL;
+  int rv;
+  while ((rv = backend->OpenNextEntry(&iter, &entry, NULL)) == net::OK) {
+    for (int i = 0; i < kHttpCacheStreamCount; ++i)
+      bytes += entry->GetDataSize(i);
+    entry->Close();
+  }
+  DCHECK_NE(rv, net::ERR_IO_PENDING);
+  if (iter)
+    backend->EndEnumeration(&iter);
+  return bytes;
+}
+
+}  // namespace
+
+namespace HttpCacheSize {
+
+int64 GetBytesUsed(disk_cache::Backend* backend, net::CacheType type) {
+  if (type == net::MEMORY_CACHE)
+    return GetMemoryCacheBytesUsed(backend);
+  return GetDiskCacheBytesUsed(backend);
+}
+
+}  // namespace HttpCacheSize
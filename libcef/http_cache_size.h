@@ -0,0 +1,30 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#ifndef _HTTP_CACHE_SIZE_H
+#define _HTTP_CACHE_SIZE_H
+
+#include "base/basictypes.h"
+#include "net/base/cache_type.h"
+
+namespace disk_cache {
+class Backend;
+}
+
+// Size accounting for HTTP cache backends. disk_cache::Backend has no
+// accessor for the number of bytes that a cache uses, so the size is found in
+// a way that depends on the type of the backend.
+namespace HttpCacheSize {
+
+// Returns the number of bytes used by |backend|, which was created for |type|.
+// The disk cache size is read from the "Current size" item that the blockfile
+// backend reports from GetStats(). The in-memory backend reports no
+// statistics, so the data sizes of its entries are added up instead. Returns
+// -1 if the disk cache does not report its size. Only use on the thread that
+// the cache is used on.
+int64 GetBytesUsed(disk_cache::Backend* backend, net::CacheType type);
+
+}  // namespace HttpCacheSize
+
+#endif  // _HTTP_CACHE_SIZE_H
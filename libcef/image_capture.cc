@@ -0,0 +1,203 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "image_capture.h"
+#include "cef_worker_pool.h"
+#include "image_encoder.h"
+#include "pixel_convert.h"
+#include "webview_host.h"
+
+#include <algorithm>
+#include <vector>
+
+#include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/stl_util-inl.h"
+#include "base/task.h"
+#include "skia/ext/image_operations.h"
+#include "skia/ext/platform_canvas.h"
+#include "third_party/WebKit/Source/WebKit/chromium/public/WebFrame.h"
+#include "third_party/WebKit/Source/WebKit/chromium/public/WebRect.h"
+#include "third_party/WebKit/Source/WebKit/chromium/public/WebSize.h"
+#include "third_party/WebKit/Source/WebKit/chromium/public/WebView.h"
+#include "ui/gfx/rect.h"
+
+using WebKit::WebFrame;
+using WebKit::WebRect;
+using WebKit::WebSize;
+using WebKit::WebView;
+
+namespace ImageCapture {
+
+namespace {
+
+// Writes the rows of each tile to a stream. Tiles span the full page width so
+// the stream receives the page's pixel rows in order.
+class StreamCaptureHandler : public CefPageCaptureHandler
+{
+public:
+  explicit StreamCaptureHandler(CefRefPtr<CefStreamWriter> stream)
+    : stream_(stream)
+  {
+  }
+
+  virtual bool OnCaptureTile(CefRefPtr<CefBrowser> browser,
+                             const CefRect& tileRect,
+                             const void* buffer) OVERRIDE
+  {
+    size_t size = static_cast<size_t>(tileRect.width) * tileRect.height * 4;
+    return (stream_->Write(buffer, 1, size) == size);
+  }
+
+private:
+  CefRefPtr<CefStreamWriter> stream_;
+
+  IMPLEMENT_REFCOUNTING(StreamCaptureHandler);
+};
+
+void WORKER_EncodeAndDeliver(CefRefPtr<CefBrowser> browser, SkBitmap bitmap,
+                             int width, int height,
+                             cef_image_encoding_t encoding, int quality,
+                             CefRefPtr<CefImageCaptureCallback> callback)
+{
+  DCHECK(CefWorkerPool::CurrentlyOn());
+
+  std::vector<unsigned char> output;
+  bool success = false;
+
+  if (!bitmap.isNull()) {
+    if (width > 0 && height > 0 &&
+        (width != bitmap.width() || height != bitmap.height())) {
+      bitmap = skia::ImageOperations::Resize(bitmap,
+          skia::ImageOperations::RESIZE_GOOD, width, height);
+    }
+    success = ImageEncoder::Encode(bitmap, encoding, quality, &output);
+  }
+
+  if (success && !output.empty()) {
+    callback->OnImageCaptured(browser, true, vector_as_array(&output),
+                              output.size());
+  } else {
+    callback->OnImageCaptured(browser, false, NULL, 0);
+  }
+}
+
+}  // namespace
+
+SkBitmap CopyCanvas(skia::PlatformCanvas* canvas, const gfx::Rect& src_rect)
+{
+  REQUIRE_UIT();
+
+  SkBitmap copy;
+  if (!canvas)
+    return copy;
+
+  const SkBitmap& bitmap = canvas->getDevice()->accessBitmap(false);
+  gfx::Rect bounds(bitmap.width(), bitmap.height());
+  gfx::Rect rect = src_rect.IsEmpty() ? bounds : bounds.Intersect(src_rect);
+  if (rect.IsEmpty())
+    return copy;
+
+  SkIRect subset_rect = SkIRect::MakeXYWH(rect.x(), rect.y(), rect.width(),
+                                          rect.height());
+  SkBitmap subset;
+  if (bitmap.extractSubset(&subset, subset_rect))
+    subset.copyTo(&copy, SkBitmap::kARGB_8888_Config);
+  return copy;
+}
+
+bool CapturePage(CefRefPtr<CefBrowser> browser, WebViewHost* host,
+                 int tile_height, int pixel_format,
+                 CefRefPtr<CefPageCaptureHandler> handler)
+{
+  REQUIRE_UIT();
+
+  WebView* webview = host->webview();
+  if (!webview)
+    return false;
+  WebFrame* frame = webview->mainFrame();
+
+  const WebSize view_size = webview->size();
+  if (view_size.isEmpty())
+    return false;
+  if (tile_height <= 0)
+    tile_height = view_size.height;
+  const WebSize scroll_offset = frame->scrollOffset();
+
+  // Keep the layout width but use a tile-sized viewport. Scrollbars would
+  // otherwise be painted into every tile.
+  frame->setCanHaveScrollbars(false);
+  webview->resize(WebSize(view_size.width, tile_height));
+  webview->layout();
+
+  const int page_width = view_size.width;
+  const int page_height = frame->contentsSize().height;
+  const int format = pixel_format & ~PF_BOTTOM_UP;
+
+  bool success = (page_height > 0);
+  if (success)
+    success = handler->OnCaptureStart(browser, page_width, page_height);
+
+  scoped_ptr<skia::PlatformCanvas> canvas;
+  scoped_array<uint8> tile_buffer;
+  if (success)
+    canvas.reset(new skia::PlatformCanvas(page_width, tile_height, true));
+
+  for (int y = 0; success && y < page_height; y += tile_height) {
+    frame->setScrollOffset(WebSize(0, y));
+    webview->layout();
+    webview->paint(canvas.get(), WebRect(0, 0, page_width, tile_height));
+
+    // The scroll position is clamped at the end of the page so the last tile
+    // may start above |y|.
+    int offset = y - frame->scrollOffset().height;
+    if (offset < 0)
+      offset = 0;
+    const int rows = std::min(tile_height - offset, page_height - y);
+
+    const SkBitmap& bitmap = canvas->getDevice()->accessBitmap(false);
+    const uint8* pixels = static_cast<const uint8*>(bitmap.getPixels()) +
+        offset * bitmap.rowBytes();
+    const void* buffer = pixels;
+    if (format != PF_DEFAULT ||
+        bitmap.rowBytes() != static_cast<size_t>(page_width) * 4) {
+      if (!tile_buffer.get())
+        tile_buffer.reset(new uint8[page_width * tile_height * 4]);
+      PixelConvert::ConvertRect(pixels, static_cast<int>(bitmap.rowBytes()),
+                                tile_buffer.get(), page_width * 4, rows,
+                                0, 0, page_width, rows, format);
+      buffer = tile_buffer.get();
+    }
+
+    success = handler->OnCaptureTile(browser,
+        CefRect(0, y, page_width, rows), buffer);
+  }
+
+  // Restore the original view and repaint it.
+  frame->setCanHaveScrollbars(true);
+  webview->resize(view_size);
+  frame->setScrollOffset(scroll_offset);
+  webview->layout();
+  host->DiscardBackingStore();
+  host->ScheduleComposite();
+
+  return success;
+}
+
+CefRefPtr<CefPageCaptureHandler> CreateStreamCaptureHandler(
+    CefRefPtr<CefStreamWriter> stream)
+{
+  return new StreamCaptureHandler(stream);
+}
+
+void PostEncodeTask(CefRefPtr<CefBrowser> browser, const SkBitmap& bitmap,
+                    int width, int height, cef_image_encoding_t encoding,
+                    int quality, CefRefPtr<CefImageCaptureCallback> callback)
+{
+  CefWorkerPool::PostTask(FROM_HERE,
+      NewRunnableFunction(&WORKER_EncodeAndDeliver, browser, bitmap, width,
+                          height, encoding, quality, callback));
+}
+
+}  // namespace ImageCapture
@@ -0,0 +1,51 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#ifndef _IMAGE_CAPTURE_H
+#define _IMAGE_CAPTURE_H
+
+#include "../include/cef.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+
+namespace gfx {
+class Rect;
+}
+
+namespace skia {
+class PlatformCanvas;
+}
+
+class WebViewHost;
+
+namespace ImageCapture {
+
+// Copy the |src_rect| region of |canvas| into a new bitmap. If |src_rect| is
+// empty the whole canvas is copied. Returns an empty bitmap if |canvas| is NULL
+// or the region does not intersect the canvas. Must be called on the UI thread.
+SkBitmap CopyCanvas(skia::PlatformCanvas* canvas, const gfx::Rect& src_rect);
+
+// Post a task to the worker pool that scales |bitmap| to |width| x |height|,
+// if non-zero, encodes it and delivers the result to |callback|. An empty
+// |bitmap| is reported to |callback| as a failure.
+void PostEncodeTask(CefRefPtr<CefBrowser> browser, const SkBitmap& bitmap,
+                    int width, int height, cef_image_encoding_t encoding,
+                    int quality, CefRefPtr<CefImageCaptureCallback> callback);
+
+// Paint the whole page of |host| at the current view width in tiles of
+// |tile_height| pixels, delivering each tile to |handler| before painting the
+// next. Only one tile-sized canvas is allocated. |pixel_format| is applied to
+// each tile except for PF_BOTTOM_UP. The view is restored and repainted
+// afterwards. Returns true if every tile was delivered. Must be called on the
+// UI thread.
+bool CapturePage(CefRefPtr<CefBrowser> browser, WebViewHost* host,
+                 int tile_height, int pixel_format,
+                 CefRefPtr<CefPageCaptureHandler> handler);
+
+// Returns a handler that writes each tile's pixel rows to |stream|.
+CefRefPtr<CefPageCaptureHandler> CreateStreamCaptureHandler(
+    CefRefPtr<CefStreamWriter> stream);
+
+}  // namespace ImageCapture
+
+#endif // _IMAGE_CAPTURE_H
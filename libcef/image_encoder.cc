@@ -0,0 +1,53 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "image_encoder.h"
+
+#include "base/logging.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/zlib/zlib.h"
+#include "ui/gfx/codec/jpeg_codec.h"
+#include "ui/gfx/codec/png_codec.h"
+#include "ui/gfx/size.h"
+
+namespace ImageEncoder {
+
+bool Encode(const SkBitmap& bitmap, cef_image_encoding_t encoding,
+            int quality, std::vector<unsigned char>* output)
+{
+  SkAutoLockPixels lock(bitmap);
+  const unsigned char* pixels =
+      static_cast<const unsigned char*>(bitmap.getPixels());
+  if (!pixels)
+    return false;
+
+  switch (encoding) {
+    case IMAGE_ENCODING_PNG:
+      // FORMAT_SkBitmap unpremultiplies the pixels. FORMAT_BGRA would write
+      // translucent pixels with darkened colors.
+      return gfx::PNGCodec::EncodeWithCompressionLevel(
+          pixels,
+          gfx::PNGCodec::FORMAT_SkBitmap,
+          gfx::Size(bitmap.width(), bitmap.height()),
+          static_cast<int>(bitmap.rowBytes()),
+          false,
+          std::vector<gfx::PNGCodec::Comment>(),
+          Z_BEST_SPEED,
+          output);
+    case IMAGE_ENCODING_JPEG:
+      if (quality < 0)
+        quality = 0;
+      else if (quality > 100)
+        quality = 100;
+      return gfx::JPEGCodec::Encode(pixels, gfx::JPEGCodec::FORMAT_BGRA,
+                                    bitmap.width(), bitmap.height(),
+                                    static_cast<int>(bitmap.rowBytes()),
+                                    quality, output);
+  }
+
+  NOTREACHED();
+  return false;
+}
+
+}  // namespace ImageEncoder
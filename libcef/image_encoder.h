@@ -0,0 +1,24 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#ifndef _IMAGE_ENCODER_H
+#define _IMAGE_ENCODER_H
+
+#include "include/internal/cef_types.h"
+#include <vector>
+
+class SkBitmap;
+
+namespace ImageEncoder {
+
+// Encode |bitmap|, which contains Skia's premultiplied pixels, using
+// |encoding|. PNG images keep the alpha channel and are written with
+// unpremultiplied colors. |quality| is only used for JPEG images. Returns false
+// if encoding fails.
+bool Encode(const SkBitmap& bitmap, cef_image_encoding_t encoding,
+            int quality, std::vector<unsigned char>* output);
+
+}  // namespace ImageEncoder
+
+#endif // _IMAGE_ENCODER_H
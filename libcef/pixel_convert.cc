@@ -0,0 +1,371 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "pixel_convert.h"
+
+#include <string.h>
+
+#include "base/basictypes.h"
+#include "base/logging.h"
+#include "build/build_config.h"
+
+#if defined(ARCH_CPU_X86_FAMILY)
+#if defined(COMPILER_MSVC)
+#include <intrin.h>
+#define PIXEL_CONVERT_HAS_SSE2 1
+#if _MSC_VER >= 1700
+#define PIXEL_CONVERT_HAS_AVX2 1
+#endif
+#elif defined(__GNUC__)
+#include <cpuid.h>
+#if defined(__SSE2__)
+#define PIXEL_CONVERT_HAS_SSE2 1
+#endif
+#if defined(__clang__) || \
+    (__GNUC__ > 4 || (__GNUC__ == 4 && __GNUC_MINOR__ >= 9))
+#define PIXEL_CONVERT_HAS_AVX2 1
+#endif
+#endif
+#endif  // defined(ARCH_CPU_X86_FAMILY)
+
+#if defined(PIXEL_CONVERT_HAS_SSE2)
+#include <emmintrin.h>
+#endif
+#if defined(PIXEL_CONVERT_HAS_AVX2)
+#include <immintrin.h>
+// GCC and Clang only allow AVX2 intrinsics in functions that are explicitly
+// compiled for that target. The kernels are only called after a CPUID check.
+#if defined(COMPILER_MSVC)
+#define AVX2_TARGET
+#else
+#define AVX2_TARGET __attribute__((target("avx2")))
+#endif
+#endif
+
+namespace PixelConvert {
+
+namespace {
+
+// Pixels are handled as little-endian 32-bit values so that BGRA byte order
+// maps to 0xAARRGGBB.
+typedef void (*RowFunc)(const uint32* src, uint32* dst, int count);
+
+// Matches SkUnPreMultiply rounding: (c * 255 + a / 2) / a.
+inline uint32 UnpremultiplyChannel(uint32 c, uint32 a) {
+  uint32 value = (c * 255 + (a >> 1)) / a;
+  return value > 255 ? 255 : value;
+}
+
+template<bool kSwizzle, bool kUnpremultiply>
+void ConvertRowScalar(const uint32* src, uint32* dst, int count) {
+  for (int i = 0; i < count; ++i) {
+    uint32 p = src[i];
+    uint32 a = p >> 24;
+    uint32 c0 = p & 0xFF;
+    uint32 c1 = (p >> 8) & 0xFF;
+    uint32 c2 = (p >> 16) & 0xFF;
+    if (kUnpremultiply && a != 255) {
+      if (a == 0) {
+        c0 = c1 = c2 = 0;
+      } else {
+        c0 = UnpremultiplyChannel(c0, a);
+        c1 = UnpremultiplyChannel(c1, a);
+        c2 = UnpremultiplyChannel(c2, a);
+      }
+    }
+    if (kSwizzle) {
+      uint32 tmp = c0;
+      c0 = c2;
+      c2 = tmp;
+    }
+    dst[i] = (a << 24) | (c2 << 16) | (c1 << 8) | c0;
+  }
+}
+
+#if defined(PIXEL_CONVERT_HAS_SSE2)
+
+// Swap bytes 0 and 2 of each 32-bit lane. SSE2 has no byte shuffle so this is
+// done with masks and shifts.
+inline __m128i SwizzleSSE2(__m128i v) {
+  const __m128i ag_mask = _mm_set1_epi32(0xFF00FF00);
+  const __m128i c_mask = _mm_set1_epi32(0xFF);
+  __m128i ag = _mm_and_si128(v, ag_mask);
+  __m128i lo = _mm_and_si128(_mm_srli_epi32(v, 16), c_mask);
+  __m128i hi = _mm_slli_epi32(_mm_and_si128(v, c_mask), 16);
+  return _mm_or_si128(ag, _mm_or_si128(lo, hi));
+}
+
+// Divide one channel by alpha. The numerator is an exact integer in single
+// precision and the quotient is correctly rounded, so truncation produces the
+// same result as the integer division in UnpremultiplyChannel().
+inline __m128i UnpremultiplyChannelSSE2(__m128i c, __m128 alpha,
+                                        __m128 half_alpha) {
+  const __m128 k255 = _mm_set1_ps(255.0f);
+  __m128 value = _mm_add_ps(_mm_mul_ps(_mm_cvtepi32_ps(c), k255), half_alpha);
+  value = _mm_min_ps(_mm_div_ps(value, alpha), k255);
+  return _mm_cvttps_epi32(value);
+}
+
+template<bool kSwizzle>
+inline __m128i UnpremultiplySSE2(__m128i v) {
+  const __m128i c_mask = _mm_set1_epi32(0xFF);
+  __m128i a = _mm_srli_epi32(v, 24);
+
+  // Fully opaque pixels, the common case for web content, are unchanged.
+  if (_mm_movemask_epi8(_mm_cmpeq_epi32(a, c_mask)) == 0xFFFF)
+    return kSwizzle ? SwizzleSSE2(v) : v;
+
+  __m128 alpha = _mm_cvtepi32_ps(a);
+  __m128 half_alpha = _mm_cvtepi32_ps(_mm_srli_epi32(a, 1));
+  __m128i c0 = UnpremultiplyChannelSSE2(_mm_and_si128(v, c_mask), alpha,
+                                        half_alpha);
+  __m128i c1 = UnpremultiplyChannelSSE2(
+      _mm_and_si128(_mm_srli_epi32(v, 8), c_mask), alpha, half_alpha);
+  __m128i c2 = UnpremultiplyChannelSSE2(
+      _mm_and_si128(_mm_srli_epi32(v, 16), c_mask), alpha, half_alpha);
+
+  __m128i rgb;
+  if (kSwizzle) {
+    rgb = _mm_or_si128(_mm_or_si128(c2, _mm_slli_epi32(c1, 8)),
+                       _mm_slli_epi32(c0, 16));
+  } else {
+    rgb = _mm_or_si128(_mm_or_si128(c0, _mm_slli_epi32(c1, 8)),
+                       _mm_slli_epi32(c2, 16));
+  }
+
+  // Zero alpha produces NaN quotients; those pixels become transparent black.
+  __m128i transparent = _mm_cmpeq_epi32(a, _mm_setzero_si128());
+  rgb = _mm_andnot_si128(transparent, rgb);
+  return _mm_or_si128(rgb, _mm_slli_epi32(a, 24));
+}
+
+template<bool kSwizzle, bool kUnpremultiply>
+void ConvertRowSSE2(const uint32* src, uint32* dst, int count) {
+  int i = 0;
+  for (; i + 4 <= count; i += 4) {
+    __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+    if (kUnpremultiply)
+      v = UnpremultiplySSE2<kSwizzle>(v);
+    else if (kSwizzle)
+      v = SwizzleSSE2(v);
+    _mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), v);
+  }
+  ConvertRowScalar<kSwizzle, kUnpremultiply>(src + i, dst + i, count - i);
+}
+
+#endif  // defined(PIXEL_CONVERT_HAS_SSE2)
+
+#if defined(PIXEL_CONVERT_HAS_AVX2)
+
+AVX2_TARGET inline __m256i SwizzleAVX2(__m256i v) {
+  const __m256i shuffle = _mm256_setr_epi8(
+      2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15,
+      2, 1, 0, 3, 6, 5, 4, 7, 10, 9, 8, 11, 14, 13, 12, 15);
+  return _mm256_shuffle_epi8(v, shuffle);
+}
+
+AVX2_TARGET inline __m256i UnpremultiplyChannelAVX2(__m256i c, __m256 alpha,
+                                                    __m256 half_alpha) {
+  const __m256 k255 = _mm256_set1_ps(255.0f);
+  __m256 value = _mm256_add_ps(_mm256_mul_ps(_mm256_cvtepi32_ps(c), k255),
+                               half_alpha);
+  value = _mm256_min_ps(_mm256_div_ps(value, alpha), k255);
+  return _mm256_cvttps_epi32(value);
+}
+
+template<bool kSwizzle>
+AVX2_TARGET inline __m256i UnpremultiplyAVX2(__m256i v) {
+  const __m256i c_mask = _mm256_set1_epi32(0xFF);
+  __m256i a = _mm256_srli_epi32(v, 24);
+
+  if (_mm256_movemask_epi8(_mm256_cmpeq_epi32(a, c_mask)) == -1)
+    return kSwizzle ? SwizzleAVX2(v) : v;
+
+  __m256 alpha = _mm256_cvtepi32_ps(a);
+  __m256 half_alpha = _mm256_cvtepi32_ps(_mm256_srli_epi32(a, 1));
+  __m256i c0 = UnpremultiplyChannelAVX2(_mm256_and_si256(v, c_mask), alpha,
+                                        half_alpha);
+  __m256i c1 = UnpremultiplyChannelAVX2(
+      _mm256_and_si256(_mm256_srli_epi32(v, 8), c_mask), alpha, half_alpha);
+  __m256i c2 = UnpremultiplyChannelAVX2(
+      _mm256_and_si256(_mm256_srli_epi32(v, 16), c_mask), alpha, half_alpha);
+
+  __m256i rgb;
+  if (kSwizzle) {
+    rgb = _mm256_or_si256(_mm256_or_si256(c2, _mm256_slli_epi32(c1, 8)),
+                          _mm256_slli_epi32(c0, 16));
+  } else {
+    rgb = _mm256_or_si256(_mm256_or_si256(c0, _mm256_slli_epi32(c1, 8)),
+                          _mm256_slli_epi32(c2, 16));
+  }
+
+  __m256i transparent = _mm256_cmpeq_epi32(a, _mm256_setzero_si256());
+  rgb = _mm256_andnot_si256(transparent, rgb);
+  return _mm256_or_si256(rgb, _mm256_slli_epi32(a, 24));
+}
+
+template<bool kSwizzle, bool kUnpremultiply>
+AVX2_TARGET void ConvertRowAVX2(const uint32* src, uint32* dst, int count) {
+  int i = 0;
+  for (; i + 8 <= count; i += 8) {
+    __m256i v =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+    if (kUnpremultiply)
+      v = UnpremultiplyAVX2<kSwizzle>(v);
+    else if (kSwizzle)
+      v = SwizzleAVX2(v);
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst + i), v);
+  }
+  ConvertRowScalar<kSwizzle, kUnpremultiply>(src + i, dst + i, count - i);
+}
+
+#endif  // defined(PIXEL_CONVERT_HAS_AVX2)
+
+#if defined(ARCH_CPU_X86_FAMILY)
+
+void GetCpuId(int leaf, int subleaf, uint32 regs[4]) {
+#if defined(COMPILER_MSVC)
+  int info[4];
+  __cpuidex(info, leaf, subleaf);
+  for (int i = 0; i < 4; ++i)
+    regs[i] = static_cast<uint32>(info[i]);
+#else
+  __cpuid_count(leaf, subleaf, regs[0], regs[1], regs[2], regs[3]);
+#endif
+}
+
+// Returns true if the OS saves the XMM and YMM registers on context switch.
+bool IsYmmStateEnabled() {
+#if defined(COMPILER_MSVC) && _MSC_VER >= 1600
+  return (_xgetbv(0) & 6) == 6;
+#elif defined(__GNUC__)
+  uint32 eax, edx;
+  __asm__ volatile("xgetbv" : "=a"(eax), "=d"(edx) : "c"(0));
+  return (eax & 6) == 6;
+#else
+  return false;
+#endif
+}
+
+#endif  // defined(ARCH_CPU_X86_FAMILY)
+
+Kernel DetectBestKernel() {
+#if defined(ARCH_CPU_X86_FAMILY)
+  uint32 regs[4];
+  GetCpuId(0, 0, regs);
+  uint32 max_leaf = regs[0];
+
+  GetCpuId(1, 0, regs);
+  bool has_sse2 = (regs[3] & (1 << 26)) != 0;
+  bool has_osxsave = (regs[2] & (1 << 27)) != 0;
+  bool has_avx = (regs[2] & (1 << 28)) != 0;
+  bool has_avx2 = false;
+  if (max_leaf >= 7 && has_osxsave && has_avx && IsYmmStateEnabled()) {
+    GetCpuId(7, 0, regs);
+    has_avx2 = (regs[1] & (1 << 5)) != 0;
+  }
+
+#if defined(PIXEL_CONVERT_HAS_AVX2)
+  if (has_avx2)
+    return KERNEL_AVX2;
+#endif
+#if defined(PIXEL_CONVERT_HAS_SSE2)
+  if (has_sse2)
+    return KERNEL_SSE2;
+#endif
+#endif  // defined(ARCH_CPU_X86_FAMILY)
+  return KERNEL_SCALAR;
+}
+
+// Returns the row conversion function for |kernel| and the channel operations
+// in |format|. Returns NULL if the row can be copied without conversion.
+RowFunc GetRowFunc(Kernel kernel, int format) {
+  bool swizzle = (format & PF_RGBA) != 0;
+  bool unpremultiply = (format & PF_UNPREMULTIPLY) != 0;
+  if (!swizzle && !unpremultiply)
+    return NULL;
+
+  switch (kernel) {
+#if defined(PIXEL_CONVERT_HAS_AVX2)
+    case KERNEL_AVX2:
+      if (swizzle && unpremultiply)
+        return &ConvertRowAVX2<true, true>;
+      return swizzle ? &ConvertRowAVX2<true, false> :
+                       &ConvertRowAVX2<false, true>;
+#endif
+#if defined(PIXEL_CONVERT_HAS_SSE2)
+    case KERNEL_SSE2:
+      if (swizzle && unpremultiply)
+        return &ConvertRowSSE2<true, true>;
+      return swizzle ? &ConvertRowSSE2<true, false> :
+                       &ConvertRowSSE2<false, true>;
+#endif
+    default:
+      if (swizzle && unpremultiply)
+        return &ConvertRowScalar<true, true>;
+      return swizzle ? &ConvertRowScalar<true, false> :
+                       &ConvertRowScalar<false, true>;
+  }
+}
+
+}  // namespace
+
+Kernel GetBestKernel() {
+  // CPU detection is idempotent so a race on first use is harmless.
+  static Kernel best_kernel = DetectBestKernel();
+  return best_kernel;
+}
+
+bool IsKernelSupported(Kernel kernel) {
+  switch (kernel) {
+    case KERNEL_AUTO:
+    case KERNEL_SCALAR:
+      return true;
+    case KERNEL_SSE2:
+      return GetBestKernel() == KERNEL_SSE2 || GetBestKernel() == KERNEL_AVX2;
+    case KERNEL_AVX2:
+      return GetBestKernel() == KERNEL_AVX2;
+  }
+  return false;
+}
+
+void ConvertRect(const void* src, int src_stride,
+                 void* dst, int dst_stride,
+                 int image_height,
+                 int x, int y, int width, int height,
+                 int format,
+                 Kernel kernel) {
+  DCHECK(src && dst);
+  DCHECK(x >= 0 && y >= 0 && width >= 0 && height >= 0);
+  DCHECK(y + height <= image_height);
+  if (width == 0 || height == 0)
+    return;
+
+  if (kernel == KERNEL_AUTO || !IsKernelSupported(kernel))
+    kernel = GetBestKernel();
+
+  RowFunc row_func = GetRowFunc(kernel, format);
+  bool bottom_up = (format & PF_BOTTOM_UP) != 0;
+
+  const uint8* src_bytes = static_cast<const uint8*>(src);
+  uint8* dst_bytes = static_cast<uint8*>(dst);
+  const size_t row_offset = static_cast<size_t>(x) * 4;
+  const size_t row_bytes = static_cast<size_t>(width) * 4;
+
+  for (int row = y; row < y + height; ++row) {
+    int dst_row = bottom_up ? image_height - 1 - row : row;
+    const uint8* src_ptr = src_bytes +
+        static_cast<size_t>(row) * src_stride + row_offset;
+    uint8* dst_ptr = dst_bytes +
+        static_cast<size_t>(dst_row) * dst_stride + row_offset;
+    if (row_func) {
+      row_func(reinterpret_cast<const uint32*>(src_ptr),
+               reinterpret_cast<uint32*>(dst_ptr), width);
+    } else {
+      memcpy(dst_ptr, src_ptr, row_bytes);
+    }
+  }
+}
+
+}  // namespace PixelConvert
@@ -0,0 +1,44 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#ifndef _PIXEL_CONVERT_H
+#define _PIXEL_CONVERT_H
+
+#include "include/internal/cef_types.h"
+
+// Conversion of Skia's native premultiplied BGRA pixel data into the formats
+// described by cef_pixel_format_t. SIMD kernels are selected at runtime based
+// on the capabilities of the current CPU.
+namespace PixelConvert {
+
+enum Kernel {
+  // Use the fastest kernel supported by the current CPU.
+  KERNEL_AUTO = 0,
+  KERNEL_SCALAR,
+  KERNEL_SSE2,
+  KERNEL_AVX2
+};
+
+// Returns true if |kernel| is compiled in and supported by the current CPU.
+bool IsKernelSupported(Kernel kernel);
+
+// Returns the kernel that KERNEL_AUTO resolves to.
+Kernel GetBestKernel();
+
+// Convert the region of |src| starting at (|x|, |y|) with size |width| x
+// |height| into the same region of |dst|. |src| is a premultiplied BGRA image
+// with an upper-left origin and |image_height| rows. |format| is a combination
+// of cef_pixel_format_t flags. If PF_BOTTOM_UP is specified the region is
+// written to the vertically mirrored rows of |dst|. |src| and |dst| must not
+// overlap.
+void ConvertRect(const void* src, int src_stride,
+                 void* dst, int dst_stride,
+                 int image_height,
+                 int x, int y, int width, int height,
+                 int format,
+                 Kernel kernel = KERNEL_AUTO);
+
+}  // namespace PixelConvert
+
+#endif // _PIXEL_CONVERT_H
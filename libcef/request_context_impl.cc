@@ -0,0 +1,127 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "request_context_impl.h"
+#include "browser_cookie_cache.h"
+#include "browser_request_context.h"
+#include "cef_context.h"
+#include "cef_thread.h"
+
+#include <set>
+
+#include "base/lazy_instance.h"
+#include "base/logging.h"
+#include "base/synchronization/lock.h"
+
+namespace {
+
+// Request contexts that have not been destroyed yet.
+struct ContextList {
+  ContextList() : shut_down(false) {}
+
+  base::Lock lock;
+  std::set<CefRequestContextImpl*> contexts;
+  // Only written on the IO thread.
+  bool shut_down;
+};
+
+base::LazyInstance<ContextList> g_context_list(base::LINKER_INITIALIZED);
+
+}  // namespace
+
+// static
+CefRefPtr<CefRequestContext> CefRequestContext::CreateContext(
+    const CefString& cache_path)
+{
+  // Verify that the context is in a valid state.
+  if (!CONTEXT_STATE_VALID()) {
+    NOTREACHED();
+    return NULL;
+  }
+
+  FilePath path(cache_path);
+  if (!path.empty() && path == _Context->cache_path()) {
+    NOTREACHED() << "cache_path is used by the global request context";
+    return NULL;
+  }
+
+  return new CefRequestContextImpl(path);
+}
+
+CefRequestContextImpl::CefRequestContextImpl(const FilePath& cache_path)
+  : cache_path_(cache_path),
+    cookie_cache_(new BrowserCookieCache())
+{
+  ContextList* list = g_context_list.Pointer();
+  base::AutoLock lock_scope(list->lock);
+  list->contexts.insert(this);
+}
+
+CefRequestContextImpl::~CefRequestContextImpl()
+{
+  // Holding the lock keeps ShutdownOnIOThread() from releasing the network
+  // objects at the same time, and makes sure that a release posted from here
+  // runs before the IO thread is cleaned up.
+  ContextList* list = g_context_list.Pointer();
+  base::AutoLock lock_scope(list->lock);
+  list->contexts.erase(this);
+
+  // The network objects must be destroyed on the IO thread.
+  if (request_context_.get() && !CefThread::CurrentlyOn(CefThread::IO)) {
+    BrowserRequestContext* request_context = request_context_.get();
+    request_context->AddRef();
+    request_context_ = NULL;
+    CefThread::ReleaseSoon(CefThread::IO, FROM_HERE, request_context);
+  }
+}
+
+// static
+void CefRequestContextImpl::ShutdownOnIOThread()
+{
+  REQUIRE_IOT();
+
+  ContextList* list = g_context_list.Pointer();
+  base::AutoLock lock_scope(list->lock);
+  list->shut_down = true;
+  std::set<CefRequestContextImpl*>::const_iterator it = list->contexts.begin();
+  for (; it != list->contexts.end(); ++it)
+    (*it)->request_context_ = NULL;
+}
+
+// static
+void CefRequestContextImpl::GetBrowserRequestContexts(
+    std::vector<scoped_refptr<BrowserRequestContext> >* request_contexts)
+{
+  REQUIRE_IOT();
+
+  ContextList* list = g_context_list.Pointer();
+  base::AutoLock lock_scope(list->lock);
+  std::set<CefRequestContextImpl*>::const_iterator it = list->contexts.begin();
+  for (; it != list->contexts.end(); ++it) {
+    if ((*it)->request_context_.get())
+      request_contexts->push_back((*it)->request_context_);
+  }
+}
+
+CefString CefRequestContextImpl::GetCachePath()
+{
+  return cache_path_.value();
+}
+
+BrowserRequestContext* CefRequestContextImpl::GetBrowserRequestContext()
+{
+  REQUIRE_IOT();
+
+  if (!request_context_.get()) {
+    if (g_context_list.Get().shut_down)
+      return NULL;
+
+    scoped_refptr<BrowserRequestContext> parent = _Context->request_context();
+    if (!parent.get())
+      return NULL;
+    request_context_ = new BrowserRequestContext(cache_path_, parent.get(),
+                                                 cookie_cache_.get());
+  }
+  return request_context_.get();
+}
@@ -0,0 +1,56 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#ifndef _REQUEST_CONTEXT_IMPL_H
+#define _REQUEST_CONTEXT_IMPL_H
+
+#include "include/cef.h"
+#include "base/file_path.h"
+#include "base/memory/ref_counted.h"
+
+#include <vector>
+
+class BrowserCookieCache;
+class BrowserRequestContext;
+
+// Implementation of CefRequestContext. The BrowserRequestContext is created on
+// the IO thread the first time that it is used and released on the IO thread
+// when this object is destroyed or, if this object outlives CefShutdown(), when
+// the IO thread is cleaned up.
+class CefRequestContextImpl : public CefRequestContext
+{
+public:
+  explicit CefRequestContextImpl(const FilePath& cache_path);
+  virtual ~CefRequestContextImpl();
+
+  // Release the network state of all request contexts, which also releases
+  // their references to the global request context. Contexts can no longer be
+  // used afterwards. Called on the IO thread before it is cleaned up.
+  static void ShutdownOnIOThread();
+
+  // Add the network state of each request context that has created it to
+  // |request_contexts|. Must be called on the IO thread.
+  static void GetBrowserRequestContexts(
+      std::vector<scoped_refptr<BrowserRequestContext> >* request_contexts);
+
+  virtual CefString GetCachePath() OVERRIDE;
+
+  // Returns the network state for this context, or NULL after
+  // ShutdownOnIOThread(). Must be called on the IO thread.
+  BrowserRequestContext* GetBrowserRequestContext();
+
+  // May be used on any thread.
+  BrowserCookieCache* cookie_cache() const { return cookie_cache_.get(); }
+
+protected:
+  FilePath cache_path_;
+  scoped_refptr<BrowserCookieCache> cookie_cache_;
+
+  // Only accessed on the IO thread.
+  scoped_refptr<BrowserRequestContext> request_context_;
+
+  IMPLEMENT_REFCOUNTING(CefRequestContextImpl);
+};
+
+#endif // _REQUEST_CONTEXT_IMPL_H
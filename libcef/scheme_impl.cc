@@ -5,6 +5,7 @@
 
 #include "include/cef.h"
 #include "cef_context.h"
+#include "cef_trace.h"
 #include "request_impl.h"
 #include "response_impl.h"
 
@@ -129,7 +130,11 @@ public:
     static_cast<CefRequestImpl*>(req.get())->Set(request());
     
     // Handler can decide whether to process the request.
-    bool rv = handler_->ProcessRequest(req, redirectUrl, callback_.get());
+    bool rv;
+    {
+      CEF_TRACE_EVENT0("client", "CefSchemeHandler::ProcessRequest");
+      rv = handler_->ProcessRequest(req, redirectUrl, callback_.get());
+    }
     if (!rv) {
       // Cancel the request.
       NotifyStartError(URLRequestStatus(URLRequestStatus::FAILED, ERR_ABORTED));
@@ -176,8 +181,13 @@ public:
     }
 
     // Read response data from the handler.
-    bool rv = handler_->ReadResponse(dest->data(), dest_size, *bytes_read,
-                                     callback_.get());
+    bool rv;
+    {
+      CEF_TRACE_EVENT1("client", "CefSchemeHandler::ReadResponse", "size",
+                       dest_size);
+      rv = handler_->ReadResponse(dest->data(), dest_size, *bytes_read,
+                                  callback_.get());
+    }
     if (!rv) {
       // The handler has indicated completion of the request.
       *bytes_read = 0;
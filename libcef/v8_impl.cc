@@ -5,6 +5,7 @@
 #include "browser_impl.h"
 #include "v8_impl.h"
 #include "cef_context.h"
+#include "cef_trace.h"
 #include "tracker.h"
 #include "base/lazy_instance.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebKit.h"
@@ -134,6 +135,7 @@ v8::Handle<v8::Value> FunctionCallbackImpl(const v8::Arguments& args)
   CefString exception;
   v8::Handle<v8::Value> value = v8::Null();
 
+  CEF_TRACE_EVENT0("v8", "CefV8Handler::Execute");
   if(handler->Execute(func_name, object, params, retval, exception)) {
     if(!exception.empty())
       value = v8::ThrowException(GetV8String(exception));
@@ -167,6 +169,7 @@ v8::Handle<v8::Value> AccessorGetterCallbackImpl(v8::Local<v8::String> property,
     CefRefPtr<CefV8Value> retval;
     CefRefPtr<CefV8Value> object = new CefV8ValueImpl(obj);
     CefString name = GetString(property);
+    CEF_TRACE_EVENT0("v8", "CefV8Accessor::Get");
     if (accessorPtr->Get(name, object, retval)) {
       CefV8ValueImpl* rv = static_cast<CefV8ValueImpl*>(retval.get());
       if (rv)
@@ -195,6 +198,7 @@ void AccessorSetterCallbackImpl(v8::Local<v8::String> property,
     CefRefPtr<CefV8Value> object = new CefV8ValueImpl(obj);
     CefRefPtr<CefV8Value> cefValue = new CefV8ValueImpl(value);
     CefString name = GetString(property);
+    CEF_TRACE_EVENT0("v8", "CefV8Accessor::Set");
     accessorPtr->Set(name, object, cefValue);
   }
 }
@@ -3,6 +3,7 @@
 // found in the LICENSE file.
 
 #import "web_drag_utils_mac.h"
+#include "browser_webkit_glue.h"
 
 #include "base/basictypes.h"
 #include "base/logging.h"
@@ -80,7 +81,7 @@ static BOOL IsSupportedFileURL(const GURL& url) {
   // Check whether there is a plugin that supports the mime type. (e.g. PDF)
   bool allow_wildcard = false;
   std::vector<webkit::WebPluginInfo> plugins;
-  webkit::npapi::PluginList::Singleton()->GetPluginInfoArray(
+  webkit_glue::GetLoadedPluginList()->GetPluginInfoArray(
       GURL(), mime_type, allow_wildcard, NULL, &plugins, NULL);
 
   // If any associated plugins exist and are enabled don't allow the download.
@@ -26,8 +26,12 @@ WebViewHost* WebViewHost::Create(GtkWidget* parent_view,
                                  const WebPreferences& prefs) {
   WebViewHost* host = new WebViewHost();
 
-  host->view_ = WebWidgetHost::CreateWidget(parent_view, host);
-  host->plugin_container_manager_.set_host_widget(host->view_);
+  if (!paint_delegate) {
+    host->view_ = WebWidgetHost::CreateWidget(parent_view, host);
+    host->plugin_container_manager_.set_host_widget(host->view_);
+  } else {
+    host->paint_delegate_ = paint_delegate;
+  }
 
 #if defined(WEBKIT_HAS_WEB_AUTO_FILL_CLIENT)
   host->webwidget_ = WebView::create(delegate, NULL);
@@ -47,9 +51,12 @@ WebView* WebViewHost::webview() const {
 }
 
 void WebViewHost::CreatePluginContainer(gfx::PluginWindowHandle id) {
-  plugin_container_manager_.CreatePluginContainer(id);
+  // Windowed plugins are not supported when window rendering is disabled.
+  if (view_)
+    plugin_container_manager_.CreatePluginContainer(id);
 }
 
 void WebViewHost::DestroyPluginContainer(gfx::PluginWindowHandle id) {
-  plugin_container_manager_.DestroyPluginContainer(id);
+  if (view_)
+    plugin_container_manager_.DestroyPluginContainer(id);
 }
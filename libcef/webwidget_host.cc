@@ -4,6 +4,7 @@
 
 #include "webwidget_host.h"
 #include "cef_thread.h"
+#include "pixel_convert.h"
 
 #include "base/message_loop.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebSize.h"
@@ -12,10 +13,52 @@
 using webkit::npapi::WebPluginGeometry;
 using WebKit::WebSize;
 
+namespace {
+
+// Delay between animation frames in milliseconds.
+const int kAnimationDelayMs = 10;
+const int kHiddenAnimationDelayMs = 1000;
+
+} // namespace
 
 void WebWidgetHost::ScheduleAnimation() {
   MessageLoop::current()->PostDelayedTask(FROM_HERE,
-      factory_.NewRunnableMethod(&WebWidgetHost::ScheduleComposite), 10);
+      factory_.NewRunnableMethod(&WebWidgetHost::DoAnimate),
+      is_hidden_ ? kHiddenAnimationDelayMs : kAnimationDelayMs);
+}
+
+void WebWidgetHost::DoAnimate() {
+  if (!is_hidden_) {
+    ScheduleComposite();
+    return;
+  }
+
+  // Service animation callbacks without painting. Another frame will be
+  // scheduled if the page is still animating.
+#ifdef WEBWIDGET_HAS_ANIMATE_CHANGES
+  webwidget_->animate(0.0);
+#else
+  webwidget_->animate();
+#endif
+}
+
+void WebWidgetHost::SetHidden(bool hidden) {
+  if (hidden == is_hidden_)
+    return;
+
+  is_hidden_ = hidden;
+
+  if (is_hidden_) {
+    // Release the backing store. It is reallocated by the repaint on show.
+    DiscardBackingStore();
+    converted_pixels_.reset();
+    converted_size_ = gfx::Size();
+    ResetScrollRect();
+    paint_rect_ = gfx::Rect();
+    update_rect_ = gfx::Rect();
+  } else {
+    ScheduleComposite();
+  }
 }
 
 void WebWidgetHost::DiscardBackingStore() {
@@ -68,6 +111,52 @@ void WebWidgetHost::MoveWindowedPlugin(const WebPluginGeometry& move)
   it->second.visible = move.visible;
 }
 
+void WebWidgetHost::SetPixelFormat(int format)
+{
+  if (format == pixel_format_)
+    return;
+
+  pixel_format_ = format;
+  converted_pixels_.reset();
+  converted_size_ = gfx::Size();
+
+  // Deliver the whole view in the new format.
+  if (!view_ && canvas_.get()) {
+    int width, height;
+    GetSize(width, height);
+    InvalidateRect(gfx::Rect(width, height));
+  }
+}
+
+const void* WebWidgetHost::GetPaintPixels(gfx::Rect* dirty_rect)
+{
+  DCHECK(canvas_.get());
+  const SkBitmap& bitmap = canvas_->getDevice()->accessBitmap(false);
+  DCHECK(bitmap.config() == SkBitmap::kARGB_8888_Config);
+  const void* pixels = bitmap.getPixels();
+
+  if (pixel_format_ == PF_DEFAULT)
+    return pixels;
+
+  const int width = bitmap.width();
+  const int height = bitmap.height();
+  const int stride = width * 4;
+  gfx::Rect bounds(width, height);
+
+  if (!converted_pixels_.get() || converted_size_ != bounds.size()) {
+    converted_pixels_.reset(new uint8[stride * height]);
+    converted_size_ = bounds.size();
+    *dirty_rect = bounds;
+  }
+
+  gfx::Rect rect = bounds.Intersect(*dirty_rect);
+  PixelConvert::ConvertRect(pixels, static_cast<int>(bitmap.rowBytes()),
+                            converted_pixels_.get(), stride, height,
+                            rect.x(), rect.y(), rect.width(), rect.height(),
+                            pixel_format_);
+  return converted_pixels_.get();
+}
+
 gfx::PluginWindowHandle WebWidgetHost::GetWindowedPluginAt(int x, int y)
 {
   if (!plugin_map_.empty()) {
@@ -103,6 +192,9 @@ void WebWidgetHost::DoPaint() {
     CefThread::PostTask(CefThread::UI, FROM_HERE, update_task_);
   }
 #else
-  NOTIMPLEMENTED();
+  // Coalescing already happens through |update_rect_| so paint immediately.
+  UpdatePaintRect(update_rect_);
+  update_rect_ = gfx::Rect();
+  Paint();
 #endif
 }
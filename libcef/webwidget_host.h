@@ -16,6 +16,7 @@
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebTextInputType.h"
 #include "ui/gfx/native_widget_types.h"
 #include "ui/gfx/rect.h"
+#include "ui/gfx/size.h"
 #include "webkit/plugins/npapi/webplugin.h"
 #include <map>
 
@@ -82,6 +83,16 @@ class WebWidgetHost {
 
   bool GetImage(int width, int height, void* buffer);
 
+  // Set the format of image data passed to the paint delegate and returned by
+  // GetImage(). |format| is a combination of cef_pixel_format_t flags.
+  void SetPixelFormat(int format);
+  int pixel_format() const { return pixel_format_; }
+
+  // Hidden widgets do not paint, release their backing store and run
+  // animations at a reduced rate. Showing the widget forces a full repaint.
+  void SetHidden(bool hidden);
+  bool is_hidden() const { return is_hidden_; }
+
   void SetSize(int width, int height);
   void GetSize(int& width, int& height);
 
@@ -184,6 +195,16 @@ class WebWidgetHost {
   void EnsureTooltip();
   void ResetTooltip();
 
+  // Run a scheduled animation frame. Visible widgets repaint, which animates,
+  // while hidden widgets only animate.
+  void DoAnimate();
+
+  // Returns the canvas pixels in the current pixel format for delivery to the
+  // paint delegate. Only |dirty_rect| is converted unless the conversion
+  // buffer was reallocated, in which case |dirty_rect| is expanded to the
+  // whole canvas.
+  const void* GetPaintPixels(gfx::Rect* dirty_rect);
+
   gfx::NativeView view_;
 
   // The paint delegate is used instead of the view when window rendering is
@@ -193,9 +214,18 @@ class WebWidgetHost {
   WebKit::WebWidget* webwidget_;
   scoped_ptr<skia::PlatformCanvas> canvas_;
 
+  // Format of image data passed to the paint delegate. When not PF_DEFAULT the
+  // canvas contents are converted into |converted_pixels_|.
+  int pixel_format_;
+  scoped_array<uint8> converted_pixels_;
+  gfx::Size converted_size_;
+
   // True if this widget is a popup widget.
   bool popup_;
 
+  // True if this widget is hidden.
+  bool is_hidden_;
+
   // Specifies the portion of the webwidget that needs painting.
   gfx::Rect paint_rect_;
 
@@ -243,6 +273,10 @@ class WebWidgetHost {
   // Since GtkWindow resize is asynchronous, we have to stash the dimensions,
   // so that the backing store doesn't have to wait for sizing to take place.
   gfx::Size logical_size_;
+
+  // The mouse button that is currently pressed when window rendering is
+  // disabled.
+  WebKit::WebMouseEvent::Button mouse_button_down_;
 #endif
 
   WebKit::WebKeyboardEvent last_key_event_;
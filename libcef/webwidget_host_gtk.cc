@@ -3,6 +3,9 @@
 // found in the LICENSE file.
 
 #include "webwidget_host.h"
+#include "cef_thread.h"
+#include "cef_trace.h"
+#include "pixel_convert.h"
 
 #include <cairo/cairo.h>
 #include <gdk/gdkx.h>
@@ -10,6 +13,7 @@
 
 #include "base/basictypes.h"
 #include "base/logging.h"
+#include "base/time.h"
 #include "skia/ext/bitmap_platform_device.h"
 #include "skia/ext/platform_canvas.h"
 #include "skia/ext/platform_device.h"
@@ -20,6 +24,7 @@
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebScreenInfo.h"
 #include "third_party/WebKit/Source/WebKit/chromium/public/WebSize.h"
 
+using WebKit::WebInputEvent;
 using WebKit::WebInputEventFactory;
 using WebKit::WebKeyboardEvent;
 using WebKit::WebMouseEvent;
@@ -263,17 +268,32 @@ class WebWidgetHostGtkWidget {
   DISALLOW_IMPLICIT_CONSTRUCTORS(WebWidgetHostGtkWidget);
 };
 
-// Return an Xlib Display pointer for the given widget.
-Display* GtkWidgetGetDisplay(GtkWidget* widget) {
-  GdkDisplay* gdk_display = gtk_widget_get_display(widget);
-  return gdk_x11_display_get_xdisplay(gdk_display);
+// Convert a GdkModifierType mask to WebInputEvent modifiers.
+int GetWebInputModifiers(int state) {
+  int modifiers = 0;
+  if (state & GDK_SHIFT_MASK)
+    modifiers |= WebInputEvent::ShiftKey;
+  if (state & GDK_CONTROL_MASK)
+    modifiers |= WebInputEvent::ControlKey;
+  if (state & GDK_MOD1_MASK)
+    modifiers |= WebInputEvent::AltKey;
+  if (state & GDK_META_MASK)
+    modifiers |= WebInputEvent::MetaKey;
+  return modifiers;
 }
 
-// Return the screen number for the given widget.
-int GtkWidgetGetScreenNum(GtkWidget* widget) {
-  GdkDisplay* gdk_display = gtk_widget_get_display(widget);
-  GdkScreen* gdk_screen = gdk_display_get_default_screen(gdk_display);
-  return gdk_x11_screen_get_screen_number(gdk_screen);
+// Returns the WebInputEvent modifier for a pressed mouse button.
+int GetButtonModifier(WebMouseEvent::Button button) {
+  switch (button) {
+    case WebMouseEvent::ButtonLeft:
+      return WebInputEvent::LeftButtonDown;
+    case WebMouseEvent::ButtonMiddle:
+      return WebInputEvent::MiddleButtonDown;
+    case WebMouseEvent::ButtonRight:
+      return WebInputEvent::RightButtonDown;
+    default:
+      return 0;
+  }
 }
 
 }  // namespace
@@ -290,11 +310,16 @@ WebWidgetHost* WebWidgetHost::Create(GtkWidget* parent_view,
                                      WebWidgetClient* client,
                                      PaintDelegate* paint_delegate) {
   WebWidgetHost* host = new WebWidgetHost();
-  host->view_ = CreateWidget(parent_view, host);
+  if (!paint_delegate) {
+    host->view_ = CreateWidget(parent_view, host);
+    // We manage our own double buffering because we need to be able to update
+    // the expose area in an ExposeEvent within the lifetime of the event
+    // handler.
+    gtk_widget_set_double_buffered(GTK_WIDGET(host->view_), false);
+  } else {
+    host->paint_delegate_ = paint_delegate;
+  }
   host->webwidget_ = WebPopupMenu::create(client);
-  // We manage our own double buffering because we need to be able to update
-  // the expose area in an ExposeEvent within the lifetime of the event handler.
-  gtk_widget_set_double_buffered(GTK_WIDGET(host->view_), false);
 
   return host;
 }
@@ -304,7 +329,10 @@ void WebWidgetHost::DidInvalidateRect(const gfx::Rect& damaged_rect) {
 
   UpdatePaintRect(damaged_rect);
 
-  if (!g_handling_expose) {
+  if (!view_) {
+    // The update rectangle will be painted by DoPaint().
+    InvalidateRect(damaged_rect);
+  } else if (!g_handling_expose) {
     gtk_widget_queue_draw_area(GTK_WIDGET(view_), damaged_rect.x(),
         damaged_rect.y(), damaged_rect.width(), damaged_rect.height());
   }
@@ -317,6 +345,14 @@ void WebWidgetHost::DidScrollRect(int dx, int dy, const gfx::Rect& clip_rect) {
 }
 
 void WebWidgetHost::ScheduleComposite() {
+  if (!view_) {
+    if (!webwidget_)
+      return;
+    WebSize size = webwidget_->size();
+    InvalidateRect(gfx::Rect(0, 0, size.width, size.height));
+    return;
+  }
+
   int width = logical_size_.width();
   int height = logical_size_.height();
   GdkRectangle grect = {
@@ -333,15 +369,22 @@ WebWidgetHost::WebWidgetHost()
     : view_(NULL),
       paint_delegate_(NULL),
       webwidget_(NULL),
+      pixel_format_(PF_DEFAULT),
       popup_(false),
+      is_hidden_(false),
       scroll_dx_(0),
       scroll_dy_(0),
       update_task_(NULL),
+      mouse_button_down_(WebMouseEvent::ButtonNone),
       ALLOW_THIS_IN_INITIALIZER_LIST(factory_(this)) {
   set_painting(false);
 }
 
 WebWidgetHost::~WebWidgetHost() {
+  // When window rendering is disabled the owner closes the web widget.
+  if (!view_)
+    return;
+
   // We may be deleted before the view_. Clear out the signals so that we don't
   // attempt to invoke something on a deleted object.
   g_object_set_data(G_OBJECT(view_), kWebWidgetHostKey, NULL);
@@ -356,8 +399,20 @@ void WebWidgetHost::Resize(const gfx::Size &newsize) {
 }
 
 void WebWidgetHost::Paint() {
-  int width = logical_size_.width();
-  int height = logical_size_.height();
+  CEF_TRACE_EVENT0("paint", "WebWidgetHost::Paint");
+  if (is_hidden_) {
+    // Nothing is painted while hidden. SetHidden(false) repaints everything.
+    paint_rect_ = gfx::Rect();
+    return;
+  }
+
+  int width, height;
+  if (view_) {
+    width = logical_size_.width();
+    height = logical_size_.height();
+  } else {
+    GetSize(width, height);
+  }
   gfx::Rect client_rect(width, height);
 
   // Allocate a canvas if necessary
@@ -400,6 +455,16 @@ void WebWidgetHost::Paint() {
   }
   //DCHECK(paint_rect_.IsEmpty());
 
+  if (!view_) {
+    // Paint to the delegate.
+    DCHECK(paint_delegate_);
+    if (total_paint.IsEmpty())
+      return;
+    const void* pixels = GetPaintPixels(&total_paint);
+    paint_delegate_->Paint(popup_, total_paint, pixels);
+    return;
+  }
+
   // Invalidate the paint region on the widget's underlying gdk window. Note
   // that gdk_window_invalidate_* will generate extra expose events, which
   // we wish to avoid. So instead we use calls to begin_paint/end_paint.
@@ -431,24 +496,56 @@ void WebWidgetHost::SetTooltipText(const CefString& tooltip_text)
 
 void WebWidgetHost::InvalidateRect(const gfx::Rect& rect)
 {
-  // TODO(port): Implement this method as part of off-screen rendering support.
-  NOTIMPLEMENTED();
+  if (rect.IsEmpty() || is_hidden_)
+    return;
+
+  if (view_) {
+    // Let the widget handle painting.
+    gtk_widget_queue_draw_area(GTK_WIDGET(view_), rect.x(), rect.y(),
+                               rect.width(), rect.height());
+  } else {
+    // The update rectangle will be painted by DoPaint().
+    update_rect_ = update_rect_.Union(rect);
+    if (!update_task_) {
+      update_task_ = factory_.NewRunnableMethod(&WebWidgetHost::DoPaint);
+      CefThread::PostTask(CefThread::UI, FROM_HERE, update_task_);
+    }
+  }
 }
 
-bool WebWidgetHost::GetImage(int width, int height, void* rgba_buffer)
+bool WebWidgetHost::GetImage(int width, int height, void* buffer)
 {
   if (!canvas_.get())
     return false;
 
-  // TODO(port): Implement this method as part of off-screen rendering support.
-  NOTIMPLEMENTED();
-  return false;
+  DCHECK(width == canvas_->getDevice()->width());
+  DCHECK(height == canvas_->getDevice()->height());
+
+  const SkBitmap& bitmap = canvas_->getDevice()->accessBitmap(false);
+  DCHECK(bitmap.config() == SkBitmap::kARGB_8888_Config);
+  const void* pixels = bitmap.getPixels();
+  PixelConvert::ConvertRect(pixels, static_cast<int>(bitmap.rowBytes()),
+                            buffer, width * 4, height, 0, 0, width, height,
+                            pixel_format_);
+  return true;
 }
 
 WebScreenInfo WebWidgetHost::GetScreenInfo() {
-  Display* display = GtkWidgetGetDisplay(view_);
-  int screen_num = GtkWidgetGetScreenNum(view_);
-  return WebScreenInfoFactory::screenInfo(display, screen_num);
+  GdkDisplay* gdk_display =
+      view_ ? gtk_widget_get_display(view_) : gdk_display_get_default();
+  if (!gdk_display) {
+    // GTK may not be initialized when window rendering is disabled. The
+    // screen rectangle is then provided by CefRenderHandler::GetScreenRect().
+    WebScreenInfo info;
+    info.depth = 24;
+    info.depthPerComponent = 8;
+    return info;
+  }
+
+  GdkScreen* gdk_screen = gdk_display_get_default_screen(gdk_display);
+  return WebScreenInfoFactory::screenInfo(
+      gdk_x11_display_get_xdisplay(gdk_display),
+      gdk_x11_screen_get_screen_number(gdk_screen));
 }
 
 void WebWidgetHost::ResetScrollRect() {
@@ -469,40 +566,112 @@ void WebWidgetHost::WindowDestroyed() {
 void WebWidgetHost::SendKeyEvent(cef_key_type_t type, int key, int modifiers,
                                  bool sysChar, bool imeChar)
 {
-  // TODO(port): Implement this method as part of off-screen rendering support.
-  NOTIMPLEMENTED();
+  WebKeyboardEvent event;
+  if (type == KT_KEYUP) {
+    event.type = WebInputEvent::KeyUp;
+  } else if (type == KT_KEYDOWN) {
+    event.type = WebInputEvent::RawKeyDown;
+  } else if (type == KT_CHAR) {
+    event.type = WebInputEvent::Char;
+  } else {
+    NOTREACHED();
+    return;
+  }
+
+  // |key| is a Windows virtual key code for key up and down events and a
+  // character for char events. |modifiers| is a GdkModifierType mask.
+  event.modifiers = GetWebInputModifiers(modifiers);
+  event.timeStampSeconds = base::Time::Now().ToDoubleT();
+  event.windowsKeyCode = key;
+  event.nativeKeyCode = key;
+  if (event.type == WebInputEvent::Char) {
+    event.text[0] = static_cast<WebKit::WebUChar>(key);
+    event.unmodifiedText[0] = static_cast<WebKit::WebUChar>(key);
+  } else {
+    event.setKeyIdentifierFromWindowsKeyCode();
+  }
+  last_key_event_ = event;
+
+  webwidget_->handleInputEvent(event);
 }
 
 void WebWidgetHost::SendMouseClickEvent(int x, int y,
                                         cef_mouse_button_type_t type,
                                         bool mouseUp, int clickCount)
 {
-  // TODO(port): Implement this method as part of off-screen rendering support.
-  NOTIMPLEMENTED();
+  DCHECK(clickCount >=1 && clickCount <= 2);
+
+  WebMouseEvent event;
+  if (type == MBT_LEFT) {
+    event.button = WebMouseEvent::ButtonLeft;
+  } else if (type == MBT_MIDDLE) {
+    event.button = WebMouseEvent::ButtonMiddle;
+  } else if (type == MBT_RIGHT) {
+    event.button = WebMouseEvent::ButtonRight;
+  } else {
+    NOTREACHED();
+    return;
+  }
+
+  event.type = mouseUp ? WebInputEvent::MouseUp : WebInputEvent::MouseDown;
+  event.x = event.windowX = event.globalX = x;
+  event.y = event.windowY = event.globalY = y;
+  event.clickCount = clickCount;
+  event.timeStampSeconds = base::Time::Now().ToDoubleT();
+
+  // Track the pressed button so that mouse moves can report drags.
+  if (mouseUp) {
+    mouse_button_down_ = WebMouseEvent::ButtonNone;
+  } else {
+    mouse_button_down_ = event.button;
+    event.modifiers = GetButtonModifier(event.button);
+  }
+
+  webwidget_->handleInputEvent(event);
 }
 
 void WebWidgetHost::SendMouseMoveEvent(int x, int y, bool mouseLeave)
 {
-  // TODO(port): Implement this method as part of off-screen rendering support.
-  NOTIMPLEMENTED();
+  WebMouseEvent event;
+  event.type = mouseLeave ? WebInputEvent::MouseLeave :
+                            WebInputEvent::MouseMove;
+  event.button = mouse_button_down_;
+  event.modifiers = GetButtonModifier(mouse_button_down_);
+  event.x = event.windowX = event.globalX = x;
+  event.y = event.windowY = event.globalY = y;
+  event.timeStampSeconds = base::Time::Now().ToDoubleT();
+
+  webwidget_->handleInputEvent(event);
 }
 
 void WebWidgetHost::SendMouseWheelEvent(int x, int y, int delta)
 {
-  // TODO(port): Implement this method as part of off-screen rendering support.
-  NOTIMPLEMENTED();
+  // |delta| uses the Windows convention of 120 units per wheel tick.
+  static const float kWheelDelta = 120.0f;
+  static const float kScrollbarPixelsPerTick = 40.0f;
+
+  WebMouseWheelEvent event;
+  event.type = WebInputEvent::MouseWheel;
+  event.button = WebMouseEvent::ButtonNone;
+  event.modifiers = GetButtonModifier(mouse_button_down_);
+  event.x = event.windowX = event.globalX = x;
+  event.y = event.windowY = event.globalY = y;
+  event.wheelTicksY = delta / kWheelDelta;
+  event.deltaY = event.wheelTicksY * kScrollbarPixelsPerTick;
+  event.timeStampSeconds = base::Time::Now().ToDoubleT();
+
+  webwidget_->handleInputEvent(event);
 }
 
 void WebWidgetHost::SendFocusEvent(bool setFocus)
 {
-  // TODO(port): Implement this method as part of off-screen rendering support.
-  NOTIMPLEMENTED();
+  webwidget_->setFocus(setFocus);
 }
 
 void WebWidgetHost::SendCaptureLostEvent()
 {
-  // TODO(port): Implement this method as part of off-screen rendering support.
-  NOTIMPLEMENTED();
+  mouse_button_down_ = WebMouseEvent::ButtonNone;
+  webwidget_->mouseCaptureLost();
 }
 
 void WebWidgetHost::EnsureTooltip()
@@ -5,6 +5,7 @@
 #import <Cocoa/Cocoa.h>
 
 #include "webwidget_host.h"
+#include "cef_trace.h"
 
 #include "base/logging.h"
 #include "skia/ext/platform_canvas.h"
@@ -98,7 +99,9 @@ WebWidgetHost::WebWidgetHost()
     : view_(NULL),
       paint_delegate_(NULL),
       webwidget_(NULL),
+      pixel_format_(PF_DEFAULT),
       popup_(false),
+      is_hidden_(false),
       scroll_dx_(0),
       scroll_dy_(0),
       update_task_(NULL),
@@ -110,6 +113,13 @@ WebWidgetHost::~WebWidgetHost() {
 }
 
 void WebWidgetHost::Paint() {
+  CEF_TRACE_EVENT0("paint", "WebWidgetHost::Paint");
+  if (is_hidden_) {
+    // Nothing is painted while hidden. SetHidden(false) repaints everything.
+    paint_rect_ = gfx::Rect();
+    return;
+  }
+
   gfx::Rect client_rect(NSRectToCGRect([view_ frame]));
   NSGraphicsContext* view_context = [NSGraphicsContext currentContext];
   CGContextRef context = static_cast<CGContextRef>([view_context graphicsPort]);
@@ -5,6 +5,7 @@
 
 #include "webwidget_host.h"
 #include "cef_thread.h"
+#include "cef_trace.h"
 
 #include "ui/gfx/rect.h"
 #include "base/logging.h"
@@ -314,7 +315,9 @@ WebWidgetHost::WebWidgetHost()
     : view_(NULL),
       paint_delegate_(NULL),
       webwidget_(NULL),
+      pixel_format_(PF_DEFAULT),
       popup_(false),
+      is_hidden_(false),
       track_mouse_leave_(false),
       ime_notification_(false),
       input_method_is_active_(false),
@@ -350,6 +353,15 @@ bool WebWidgetHost::WndProc(UINT message, WPARAM wparam, LPARAM lparam) {
 }
 
 void WebWidgetHost::Paint() {
+  CEF_TRACE_EVENT0("paint", "WebWidgetHost::Paint");
+  if (is_hidden_) {
+    // Nothing is painted while hidden. SetHidden(false) repaints everything.
+    paint_rect_ = gfx::Rect();
+    if (view_)
+      ValidateRect(view_, NULL);
+    return;
+  }
+
   if (canvas_.get() && paint_rect_.IsEmpty())
     return;
 
@@ -470,16 +482,14 @@ void WebWidgetHost::Paint() {
   } else {
     // Paint to the delegate.
     DCHECK(paint_delegate_);
-    const SkBitmap& bitmap = canvas_->getDevice()->accessBitmap(false);
-    DCHECK(bitmap.config() == SkBitmap::kARGB_8888_Config);
-    const void* pixels = bitmap.getPixels();
+    const void* pixels = GetPaintPixels(&damaged_rect);
     paint_delegate_->Paint(popup_, damaged_rect, pixels);
   }
 }
 
 void WebWidgetHost::InvalidateRect(const gfx::Rect& rect)
 {
-  if (rect.IsEmpty())
+  if (rect.IsEmpty() || is_hidden_)
     return;
   
   if (view_) {
@@ -508,7 +518,9 @@ bool WebWidgetHost::GetImage(int width, int height, void* buffer)
   const SkBitmap& bitmap = canvas_->getDevice()->accessBitmap(false);
   DCHECK(bitmap.config() == SkBitmap::kARGB_8888_Config);
   const void* pixels = bitmap.getPixels();
-  memcpy(buffer, pixels, width * height * 4);
+  PixelConvert::ConvertRect(pixels, static_cast<int>(bitmap.rowBytes()),
+                            buffer, width * 4, height, 0, 0, width, height,
+                            pixel_format_);
   return true;
 }
 
@@ -12,7 +12,11 @@
 
 #include "libcef_dll/cpptoc/browser_cpptoc.h"
 #include "libcef_dll/cpptoc/frame_cpptoc.h"
+#include "libcef_dll/cpptoc/request_context_cpptoc.h"
+#include "libcef_dll/cpptoc/stream_writer_cpptoc.h"
 #include "libcef_dll/ctocpp/client_ctocpp.h"
+#include "libcef_dll/ctocpp/image_capture_callback_ctocpp.h"
+#include "libcef_dll/ctocpp/page_capture_handler_ctocpp.h"
 #include "libcef_dll/transfer_util.h"
 
 
@@ -40,6 +44,32 @@ CEF_EXPORT int cef_browser_create(cef_window_info_t* windowInfo,
       browserSettingsObj);
 }
 
+CEF_EXPORT int cef_browser_create_with_context(cef_window_info_t* windowInfo,
+    struct _cef_client_t* client, const cef_string_t* url,
+    const struct _cef_browser_settings_t* settings,
+    cef_request_context_t* requestContext)
+{
+  DCHECK(windowInfo);
+  if (!windowInfo)
+    return 0;
+
+  CefRefPtr<CefClient> clientPtr;
+  CefRefPtr<CefRequestContext> requestContextPtr;
+  CefWindowInfo windowInfoObj;
+  CefBrowserSettings browserSettingsObj;
+  
+  windowInfoObj.Set(*windowInfo, false);
+  if(client)
+    clientPtr = CefClientCToCpp::Wrap(client);
+  if (settings)
+    browserSettingsObj.Set(*settings, false);
+  if (requestContext)
+    requestContextPtr = CefRequestContextCppToC::Unwrap(requestContext);
+ 
+  return CefBrowser::CreateBrowser(windowInfoObj, clientPtr, CefString(url),
+      browserSettingsObj, requestContextPtr);
+}
+
 CEF_EXPORT cef_browser_t* cef_browser_create_sync(cef_window_info_t* windowInfo,
     struct _cef_client_t* client, const cef_string_t* url,
     const struct _cef_browser_settings_t* settings)
@@ -66,6 +96,36 @@ CEF_EXPORT cef_browser_t* cef_browser_create_sync(cef_window_info_t* windowInfo,
   return NULL;
 }
 
+CEF_EXPORT cef_browser_t* cef_browser_create_sync_with_context(
+    cef_window_info_t* windowInfo, struct _cef_client_t* client,
+    const cef_string_t* url, const struct _cef_browser_settings_t* settings,
+    cef_request_context_t* requestContext)
+{
+  DCHECK(windowInfo);
+  if (!windowInfo)
+    return NULL;
+
+  CefRefPtr<CefClient> clientPtr;
+  CefRefPtr<CefRequestContext> requestContextPtr;
+  CefWindowInfo windowInfoObj;
+  CefBrowserSettings browserSettingsObj;
+  
+  windowInfoObj.Set(*windowInfo, false);
+  if(client)
+    clientPtr = CefClientCToCpp::Wrap(client);
+  if (settings)
+    browserSettingsObj.Set(*settings, false);
+  if (requestContext)
+    requestContextPtr = CefRequestContextCppToC::Unwrap(requestContext);
+  
+  CefRefPtr<CefBrowser> browserPtr(
+      CefBrowser::CreateBrowserSync(windowInfoObj, clientPtr, CefString(url),
+                                    browserSettingsObj, requestContextPtr));
+  if(browserPtr.get())
+    return CefBrowserCppToC::Wrap(browserPtr);
+  return NULL;
+}
+
 
 // MEMBER FUNCTIONS - Body may be edited by hand.
 
@@ -388,6 +448,24 @@ void CEF_CALLBACK browser_invalidate(struct _cef_browser_t* self,
   CefBrowserCppToC::Get(self)->Invalidate(rect);
 }
 
+void CEF_CALLBACK browser_was_hidden(struct _cef_browser_t* self, int hidden)
+{
+  DCHECK(self);
+  if (!self)
+    return;
+
+  CefBrowserCppToC::Get(self)->WasHidden(hidden?true:false);
+}
+
+int CEF_CALLBACK browser_is_hidden(struct _cef_browser_t* self)
+{
+  DCHECK(self);
+  if (!self)
+    return 0;
+
+  return CefBrowserCppToC::Get(self)->IsHidden();
+}
+
 int CEF_CALLBACK browser_get_image(struct _cef_browser_t* self,
     enum cef_paint_element_type_t type, int width, int height, void* buffer)
 {
@@ -399,6 +477,66 @@ int CEF_CALLBACK browser_get_image(struct _cef_browser_t* self,
   return CefBrowserCppToC::Get(self)->GetImage(type, width, height, buffer);
 }
 
+void CEF_CALLBACK browser_set_pixel_format(struct _cef_browser_t* self,
+    enum cef_pixel_format_t format)
+{
+  DCHECK(self);
+  if (!self)
+    return;
+
+  CefBrowserCppToC::Get(self)->SetPixelFormat(format);
+}
+
+enum cef_pixel_format_t CEF_CALLBACK browser_get_pixel_format(
+    struct _cef_browser_t* self)
+{
+  DCHECK(self);
+  if (!self)
+    return PF_DEFAULT;
+
+  return CefBrowserCppToC::Get(self)->GetPixelFormat();
+}
+
+void CEF_CALLBACK browser_capture_image(struct _cef_browser_t* self,
+    enum cef_paint_element_type_t type, const cef_rect_t* srcRect, int width,
+    int height, enum cef_image_encoding_t encoding, int quality,
+    cef_image_capture_callback_t* callback)
+{
+  DCHECK(self);
+  DCHECK(srcRect);
+  DCHECK(callback);
+  if (!self || !srcRect || !callback)
+    return;
+
+  CefRect rect(*srcRect);
+  CefBrowserCppToC::Get(self)->CaptureImage(type, rect, width, height,
+      encoding, quality, CefImageCaptureCallbackCToCpp::Wrap(callback));
+}
+
+int CEF_CALLBACK browser_capture_page(struct _cef_browser_t* self,
+    int tileHeight, cef_page_capture_handler_t* handler)
+{
+  DCHECK(self);
+  DCHECK(handler);
+  if (!self || !handler)
+    return 0;
+
+  return CefBrowserCppToC::Get(self)->CapturePage(tileHeight,
+      CefPageCaptureHandlerCToCpp::Wrap(handler));
+}
+
+int CEF_CALLBACK browser_capture_page_to_stream(struct _cef_browser_t* self,
+    int tileHeight, struct _cef_stream_writer_t* stream)
+{
+  DCHECK(self);
+  DCHECK(stream);
+  if (!self || !stream)
+    return 0;
+
+  return CefBrowserCppToC::Get(self)->CapturePageToStream(tileHeight,
+      CefStreamWriterCppToC::Unwrap(stream));
+}
+
 void CEF_CALLBACK browser_send_key_event(struct _cef_browser_t* self,
     enum cef_key_type_t type, int key, int modifiers, int sysChar,
     int imeChar)
@@ -462,6 +600,22 @@ void CEF_CALLBACK browser_send_capture_lost_event(struct _cef_browser_t* self)
   CefBrowserCppToC::Get(self)->SendCaptureLostEvent();
 }
 
+void CEF_CALLBACK browser_send_input_events(struct _cef_browser_t* self,
+    size_t eventCount, const cef_input_event_t* events)
+{
+  DCHECK(self);
+  DCHECK(eventCount == 0 || events);
+  if (!self || (eventCount > 0 && !events))
+    return;
+
+  std::vector<CefInputEvent> eventList;
+  eventList.reserve(eventCount);
+  for (size_t i = 0; i < eventCount; ++i)
+    eventList.push_back(CefInputEvent(events[i]));
+
+  CefBrowserCppToC::Get(self)->SendInputEvents(eventList);
+}
+
 
 // CONSTRUCTOR - Do not edit by hand.
 
@@ -500,13 +654,21 @@ CefBrowserCppToC::CefBrowserCppToC(CefBrowser* cls)
   struct_.struct_.is_popup_visible = browser_is_popup_visible;
   struct_.struct_.hide_popup = browser_hide_popup;
   struct_.struct_.invalidate = browser_invalidate;
+  struct_.struct_.was_hidden = browser_was_hidden;
+  struct_.struct_.is_hidden = browser_is_hidden;
   struct_.struct_.get_image = browser_get_image;
+  struct_.struct_.set_pixel_format = browser_set_pixel_format;
+  struct_.struct_.get_pixel_format = browser_get_pixel_format;
+  struct_.struct_.capture_image = browser_capture_image;
+  struct_.struct_.capture_page = browser_capture_page;
+  struct_.struct_.capture_page_to_stream = browser_capture_page_to_stream;
   struct_.struct_.send_key_event = browser_send_key_event;
   struct_.struct_.send_mouse_click_event = browser_send_mouse_click_event;
   struct_.struct_.send_mouse_move_event = browser_send_mouse_move_event;
   struct_.struct_.send_mouse_wheel_event = browser_send_mouse_wheel_event;
   struct_.struct_.send_focus_event = browser_send_focus_event;
   struct_.struct_.send_capture_lost_event = browser_send_capture_lost_event;
+  struct_.struct_.send_input_events = browser_send_input_events;
 }
 
 #ifndef NDEBUG
@@ -0,0 +1,110 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+//
+// ---------------------------------------------------------------------------
+//
+// A portion of this file was generated by the CEF translator tool.  When
+// making changes by hand only do so within the body of existing function
+// implementations. See the translator.README.txt file in the tools directory
+// for more information.
+//
+
+#include "libcef_dll/cpptoc/browser_cpptoc.h"
+#include "libcef_dll/cpptoc/browser_pool_cpptoc.h"
+#include "libcef_dll/ctocpp/client_ctocpp.h"
+
+
+// GLOBAL FUNCTIONS - Body may be edited by hand.
+
+CEF_EXPORT cef_browser_pool_t* cef_browser_pool_create(
+    cef_window_info_t* windowInfo, int size,
+    const struct _cef_browser_settings_t* settings)
+{
+  DCHECK(windowInfo);
+  if (!windowInfo)
+    return NULL;
+
+  CefWindowInfo windowInfoObj;
+  CefBrowserSettings browserSettingsObj;
+
+  windowInfoObj.Set(*windowInfo, false);
+  if (settings)
+    browserSettingsObj.Set(*settings, false);
+
+  CefRefPtr<CefBrowserPool> impl =
+      CefBrowserPool::Create(windowInfoObj, size, browserSettingsObj);
+  if(impl.get())
+    return CefBrowserPoolCppToC::Wrap(impl);
+  return NULL;
+}
+
+
+// MEMBER FUNCTIONS - Body may be edited by hand.
+
+cef_browser_t* CEF_CALLBACK browser_pool_take_browser(
+    struct _cef_browser_pool_t* self, struct _cef_client_t* client,
+    const cef_string_t* url)
+{
+  DCHECK(self);
+  if (!self)
+    return NULL;
+
+  CefRefPtr<CefClient> clientPtr;
+  if (client)
+    clientPtr = CefClientCToCpp::Wrap(client);
+
+  CefRefPtr<CefBrowser> browserPtr =
+      CefBrowserPoolCppToC::Get(self)->TakeBrowser(clientPtr, CefString(url));
+  if(browserPtr.get())
+    return CefBrowserCppToC::Wrap(browserPtr);
+  return NULL;
+}
+
+int CEF_CALLBACK browser_pool_return_browser(struct _cef_browser_pool_t* self,
+    cef_browser_t* browser)
+{
+  DCHECK(self);
+  DCHECK(browser);
+  if (!self || !browser)
+    return 0;
+
+  return CefBrowserPoolCppToC::Get(self)->ReturnBrowser(
+      CefBrowserCppToC::Unwrap(browser));
+}
+
+int CEF_CALLBACK browser_pool_get_idle_count(struct _cef_browser_pool_t* self)
+{
+  DCHECK(self);
+  if (!self)
+    return 0;
+
+  return CefBrowserPoolCppToC::Get(self)->GetIdleCount();
+}
+
+void CEF_CALLBACK browser_pool_close(struct _cef_browser_pool_t* self)
+{
+  DCHECK(self);
+  if (!self)
+    return;
+
+  CefBrowserPoolCppToC::Get(self)->Close();
+}
+
+
+// CONSTRUCTOR - Do not edit by hand.
+
+CefBrowserPoolCppToC::CefBrowserPoolCppToC(CefBrowserPool* cls)
+    : CefCppToC<CefBrowserPoolCppToC, CefBrowserPool, cef_browser_pool_t>(cls)
+{
+  struct_.struct_.take_browser = browser_pool_take_browser;
+  struct_.struct_.return_browser = browser_pool_return_browser;
+  struct_.struct_.get_idle_count = browser_pool_get_idle_count;
+  struct_.struct_.close = browser_pool_close;
+}
+
+#ifndef NDEBUG
+template<> long CefCppToC<CefBrowserPoolCppToC, CefBrowserPool,
+    cef_browser_pool_t>::DebugObjCt = 0;
+#endif
+
@@ -51,6 +51,16 @@ void CEF_CALLBACK content_filter_drain(struct _cef_content_filter_t* self,
       *remainder = CefStreamReaderCToCpp::Unwrap(remainderPtr);
 }
 
+int CEF_CALLBACK content_filter_use_worker_thread(
+    struct _cef_content_filter_t* self)
+{
+  DCHECK(self);
+  if (!self)
+    return 0;
+
+  return CefContentFilterCppToC::Get(self)->UseWorkerThread();
+}
+
 
 // CONSTRUCTOR - Do not edit by hand.
 
@@ -60,6 +70,7 @@ CefContentFilterCppToC::CefContentFilterCppToC(CefContentFilter* cls)
 {
   struct_.struct_.process_data = content_filter_process_data;
   struct_.struct_.drain = content_filter_drain;
+  struct_.struct_.use_worker_thread = content_filter_use_worker_thread;
 }
 
 #ifndef NDEBUG
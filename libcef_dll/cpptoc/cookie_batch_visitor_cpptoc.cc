@@ -0,0 +1,51 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+//
+// ---------------------------------------------------------------------------
+//
+// A portion of this file was generated by the CEF translator tool.  When
+// making changes by hand only do so within the body of existing function
+// implementations. See the translator.README.txt file in the tools directory
+// for more information.
+//
+
+#include "libcef_dll/cpptoc/cookie_batch_visitor_cpptoc.h"
+
+
+// MEMBER FUNCTIONS - Body may be edited by hand.
+
+int CEF_CALLBACK cookie_batch_visitor_visit(
+    struct _cef_cookie_batch_visitor_t* self, size_t cookieCount,
+    const cef_cookie_t* cookies, int offset, int total)
+{
+  DCHECK(self);
+  DCHECK(cookieCount == 0 || cookies);
+  if(!self || (cookieCount > 0 && !cookies))
+    return 0;
+
+  // Reference the existing values without copying.
+  std::vector<CefCookie> cookieList(cookieCount);
+  for(size_t i = 0; i < cookieCount; ++i)
+    cookieList[i].Set(cookies[i], false);
+
+  return CefCookieBatchVisitorCppToC::Get(self)->Visit(cookieList, offset,
+      total);
+}
+
+
+// CONSTRUCTOR - Do not edit by hand.
+
+CefCookieBatchVisitorCppToC::CefCookieBatchVisitorCppToC(
+    CefCookieBatchVisitor* cls)
+    : CefCppToC<CefCookieBatchVisitorCppToC, CefCookieBatchVisitor,
+        cef_cookie_batch_visitor_t>(cls)
+{
+  struct_.struct_.visit = cookie_batch_visitor_visit;
+}
+
+#ifndef NDEBUG
+template<> long CefCppToC<CefCookieBatchVisitorCppToC, CefCookieBatchVisitor,
+    cef_cookie_batch_visitor_t>::DebugObjCt = 0;
+#endif
+
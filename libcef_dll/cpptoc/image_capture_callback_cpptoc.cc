@@ -0,0 +1,47 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+//
+// ---------------------------------------------------------------------------
+//
+// A portion of this file was generated by the CEF translator tool.  When
+// making changes by hand only do so within the body of existing function
+// implementations. See the translator.README.txt file in the tools directory
+// for more information.
+//
+
+#include "libcef_dll/cpptoc/image_capture_callback_cpptoc.h"
+#include "libcef_dll/ctocpp/browser_ctocpp.h"
+
+
+// MEMBER FUNCTIONS - Body may be edited by hand.
+
+void CEF_CALLBACK image_capture_callback_on_image_captured(
+    struct _cef_image_capture_callback_t* self, struct _cef_browser_t* browser,
+    int success, const void* data, size_t dataSize)
+{
+  DCHECK(self);
+  DCHECK(browser);
+  if (!self || !browser)
+    return;
+
+  CefImageCaptureCallbackCppToC::Get(self)->OnImageCaptured(
+      CefBrowserCToCpp::Wrap(browser), success?true:false, data, dataSize);
+}
+
+
+// CONSTRUCTOR - Do not edit by hand.
+
+CefImageCaptureCallbackCppToC::CefImageCaptureCallbackCppToC(
+    CefImageCaptureCallback* cls)
+    : CefCppToC<CefImageCaptureCallbackCppToC, CefImageCaptureCallback,
+        cef_image_capture_callback_t>(cls)
+{
+  struct_.struct_.on_image_captured = image_capture_callback_on_image_captured;
+}
+
+#ifndef NDEBUG
+template<> long CefCppToC<CefImageCaptureCallbackCppToC,
+    CefImageCaptureCallback, cef_image_capture_callback_t>::DebugObjCt = 0;
+#endif
+
@@ -0,0 +1,50 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+//
+// ---------------------------------------------------------------------------
+//
+// A portion of this file was generated by the CEF translator tool.  When
+// making changes by hand only do so within the body of existing function
+// implementations. See the translator.README.txt file in the tools directory
+// for more information.
+//
+
+#include "libcef_dll/cpptoc/local_storage_visitor_cpptoc.h"
+#include "libcef_dll/transfer_util.h"
+
+
+// MEMBER FUNCTIONS - Body may be edited by hand.
+
+void CEF_CALLBACK local_storage_visitor_visit(
+    struct _cef_local_storage_visitor_t* self, const cef_string_t* origin,
+    cef_string_map_t items)
+{
+  DCHECK(self);
+  DCHECK(origin);
+  if (!self || !origin)
+    return;
+
+  CefLocalStorageItemMap map;
+  if (items)
+    transfer_string_map_contents(items, map);
+
+  CefLocalStorageVisitorCppToC::Get(self)->Visit(CefString(origin), map);
+}
+
+
+// CONSTRUCTOR - Do not edit by hand.
+
+CefLocalStorageVisitorCppToC::CefLocalStorageVisitorCppToC(
+    CefLocalStorageVisitor* cls)
+    : CefCppToC<CefLocalStorageVisitorCppToC, CefLocalStorageVisitor,
+        cef_local_storage_visitor_t>(cls)
+{
+  struct_.struct_.visit = local_storage_visitor_visit;
+}
+
+#ifndef NDEBUG
+template<> long CefCppToC<CefLocalStorageVisitorCppToC, CefLocalStorageVisitor,
+    cef_local_storage_visitor_t>::DebugObjCt = 0;
+#endif
+
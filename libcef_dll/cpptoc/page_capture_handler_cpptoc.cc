@@ -0,0 +1,64 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+//
+// ---------------------------------------------------------------------------
+//
+// A portion of this file was generated by the CEF translator tool.  When
+// making changes by hand only do so within the body of existing function
+// implementations. See the translator.README.txt file in the tools directory
+// for more information.
+//
+
+#include "libcef_dll/cpptoc/page_capture_handler_cpptoc.h"
+#include "libcef_dll/ctocpp/browser_ctocpp.h"
+
+
+// MEMBER FUNCTIONS - Body may be edited by hand.
+
+int CEF_CALLBACK page_capture_handler_on_capture_start(
+    struct _cef_page_capture_handler_t* self, struct _cef_browser_t* browser,
+    int width, int height)
+{
+  DCHECK(self);
+  DCHECK(browser);
+  if (!self || !browser)
+    return 0;
+
+  return CefPageCaptureHandlerCppToC::Get(self)->OnCaptureStart(
+      CefBrowserCToCpp::Wrap(browser), width, height);
+}
+
+int CEF_CALLBACK page_capture_handler_on_capture_tile(
+    struct _cef_page_capture_handler_t* self, struct _cef_browser_t* browser,
+    const cef_rect_t* tileRect, const void* buffer)
+{
+  DCHECK(self);
+  DCHECK(browser);
+  DCHECK(tileRect);
+  DCHECK(buffer);
+  if (!self || !browser || !tileRect || !buffer)
+    return 0;
+
+  CefRect rect(*tileRect);
+  return CefPageCaptureHandlerCppToC::Get(self)->OnCaptureTile(
+      CefBrowserCToCpp::Wrap(browser), rect, buffer);
+}
+
+
+// CONSTRUCTOR - Do not edit by hand.
+
+CefPageCaptureHandlerCppToC::CefPageCaptureHandlerCppToC(
+    CefPageCaptureHandler* cls)
+    : CefCppToC<CefPageCaptureHandlerCppToC, CefPageCaptureHandler,
+        cef_page_capture_handler_t>(cls)
+{
+  struct_.struct_.on_capture_start = page_capture_handler_on_capture_start;
+  struct_.struct_.on_capture_tile = page_capture_handler_on_capture_tile;
+}
+
+#ifndef NDEBUG
+template<> long CefCppToC<CefPageCaptureHandlerCppToC, CefPageCaptureHandler,
+    cef_page_capture_handler_t>::DebugObjCt = 0;
+#endif
+
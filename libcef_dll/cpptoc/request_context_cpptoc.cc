@@ -0,0 +1,56 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+//
+// ---------------------------------------------------------------------------
+//
+// A portion of this file was generated by the CEF translator tool.  When
+// making changes by hand only do so within the body of existing function
+// implementations. See the translator.README.txt file in the tools directory
+// for more information.
+//
+
+#include "libcef_dll/cpptoc/request_context_cpptoc.h"
+
+
+// GLOBAL FUNCTIONS - Body may be edited by hand.
+
+CEF_EXPORT cef_request_context_t* cef_request_context_create_context(
+    const cef_string_t* cache_path)
+{
+  CefRefPtr<CefRequestContext> impl =
+      CefRequestContext::CreateContext(CefString(cache_path));
+  if(impl.get())
+    return CefRequestContextCppToC::Wrap(impl);
+  return NULL;
+}
+
+
+// MEMBER FUNCTIONS - Body may be edited by hand.
+
+cef_string_userfree_t CEF_CALLBACK request_context_get_cache_path(
+    struct _cef_request_context_t* self)
+{
+  DCHECK(self);
+  if (!self)
+    return NULL;
+
+  CefString pathStr = CefRequestContextCppToC::Get(self)->GetCachePath();
+  return pathStr.DetachToUserFree();
+}
+
+
+// CONSTRUCTOR - Do not edit by hand.
+
+CefRequestContextCppToC::CefRequestContextCppToC(CefRequestContext* cls)
+    : CefCppToC<CefRequestContextCppToC, CefRequestContext,
+        cef_request_context_t>(cls)
+{
+  struct_.struct_.get_cache_path = request_context_get_cache_path;
+}
+
+#ifndef NDEBUG
+template<> long CefCppToC<CefRequestContextCppToC, CefRequestContext,
+    cef_request_context_t>::DebugObjCt = 0;
+#endif
+
@@ -0,0 +1,82 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+//
+// ---------------------------------------------------------------------------
+//
+// A portion of this file was generated by the CEF translator tool.  When
+// making changes by hand only do so within the body of existing function
+// implementations. See the translator.README.txt file in the tools directory
+// for more information.
+//
+
+#include "libcef_dll/cpptoc/sequenced_task_runner_cpptoc.h"
+#include "libcef_dll/ctocpp/task_ctocpp.h"
+
+
+// GLOBAL FUNCTIONS - Body may be edited by hand.
+
+CEF_EXPORT cef_sequenced_task_runner_t* cef_sequenced_task_runner_create()
+{
+  CefRefPtr<CefSequencedTaskRunner> impl = CefSequencedTaskRunner::Create();
+  if(impl.get())
+    return CefSequencedTaskRunnerCppToC::Wrap(impl);
+  return NULL;
+}
+
+
+// MEMBER FUNCTIONS - Body may be edited by hand.
+
+int CEF_CALLBACK sequenced_task_runner_post_task(
+    struct _cef_sequenced_task_runner_t* self, cef_task_t* task)
+{
+  DCHECK(self);
+  DCHECK(task);
+  if (!self || !task)
+    return 0;
+
+  return CefSequencedTaskRunnerCppToC::Get(self)->PostTask(
+      CefTaskCToCpp::Wrap(task));
+}
+
+int CEF_CALLBACK sequenced_task_runner_post_delayed_task(
+    struct _cef_sequenced_task_runner_t* self, cef_task_t* task, long delay_ms)
+{
+  DCHECK(self);
+  DCHECK(task);
+  if (!self || !task)
+    return 0;
+
+  return CefSequencedTaskRunnerCppToC::Get(self)->PostDelayedTask(
+      CefTaskCToCpp::Wrap(task), delay_ms);
+}
+
+int CEF_CALLBACK sequenced_task_runner_runs_tasks_on_current_thread(
+    struct _cef_sequenced_task_runner_t* self)
+{
+  DCHECK(self);
+  if (!self)
+    return 0;
+
+  return CefSequencedTaskRunnerCppToC::Get(self)->RunsTasksOnCurrentThread();
+}
+
+
+// CONSTRUCTOR - Do not edit by hand.
+
+CefSequencedTaskRunnerCppToC::CefSequencedTaskRunnerCppToC(
+    CefSequencedTaskRunner* cls)
+    : CefCppToC<CefSequencedTaskRunnerCppToC, CefSequencedTaskRunner,
+        cef_sequenced_task_runner_t>(cls)
+{
+  struct_.struct_.post_task = sequenced_task_runner_post_task;
+  struct_.struct_.post_delayed_task = sequenced_task_runner_post_delayed_task;
+  struct_.struct_.runs_tasks_on_current_thread =
+      sequenced_task_runner_runs_tasks_on_current_thread;
+}
+
+#ifndef NDEBUG
+template<> long CefCppToC<CefSequencedTaskRunnerCppToC, CefSequencedTaskRunner,
+    cef_sequenced_task_runner_t>::DebugObjCt = 0;
+#endif
+
@@ -0,0 +1,35 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+//
+// ---------------------------------------------------------------------------
+//
+// This file was generated by the CEF translator tool and should not edited
+// by hand. See the translator.README.txt file in the tools directory for
+// more information.
+//
+#ifndef _SEQUENCEDTASKRUNNER_CPPTOC_H
+#define _SEQUENCEDTASKRUNNER_CPPTOC_H
+
+#ifndef BUILDING_CEF_SHARED
+#pragma message("Warning: "__FILE__" may be accessed DLL-side only")
+#else // BUILDING_CEF_SHARED
+
+#include "include/cef.h"
+#include "include/cef_capi.h"
+#include "libcef_dll/cpptoc/cpptoc.h"
+
+// Wrap a C++ class with a C structure.
+// This class may be instantiated and accessed DLL-side only.
+class CefSequencedTaskRunnerCppToC
+    : public CefCppToC<CefSequencedTaskRunnerCppToC, CefSequencedTaskRunner,
+        cef_sequenced_task_runner_t>
+{
+public:
+  CefSequencedTaskRunnerCppToC(CefSequencedTaskRunner* cls);
+  virtual ~CefSequencedTaskRunnerCppToC() {}
+};
+
+#endif // BUILDING_CEF_SHARED
+#endif // _SEQUENCEDTASKRUNNER_CPPTOC_H
+
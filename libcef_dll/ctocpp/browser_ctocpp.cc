@@ -11,8 +11,12 @@
 //
 
 #include "libcef_dll/cpptoc/client_cpptoc.h"
+#include "libcef_dll/cpptoc/image_capture_callback_cpptoc.h"
+#include "libcef_dll/cpptoc/page_capture_handler_cpptoc.h"
 #include "libcef_dll/ctocpp/browser_ctocpp.h"
 #include "libcef_dll/ctocpp/frame_ctocpp.h"
+#include "libcef_dll/ctocpp/request_context_ctocpp.h"
+#include "libcef_dll/ctocpp/stream_writer_ctocpp.h"
 #include "libcef_dll/transfer_util.h"
 
 
@@ -26,6 +30,20 @@ bool CefBrowser::CreateBrowser(CefWindowInfo& windowInfo,
       url.GetStruct(), &settings)?true:false;
 }
 
+bool CefBrowser::CreateBrowser(CefWindowInfo& windowInfo,
+    CefRefPtr<CefClient> client, const CefString& url,
+    const CefBrowserSettings& settings,
+    CefRefPtr<CefRequestContext> requestContext)
+{
+  cef_request_context_t* requestContextStruct = NULL;
+  if (requestContext.get())
+    requestContextStruct = CefRequestContextCToCpp::Unwrap(requestContext);
+
+  return cef_browser_create_with_context(&windowInfo,
+      CefClientCppToC::Wrap(client), url.GetStruct(), &settings,
+      requestContextStruct)?true:false;
+}
+
 CefRefPtr<CefBrowser> CefBrowser::CreateBrowserSync(CefWindowInfo& windowInfo,
     CefRefPtr<CefClient> client, const CefString& url,
     const CefBrowserSettings& settings)
@@ -37,6 +55,23 @@ CefRefPtr<CefBrowser> CefBrowser::CreateBrowserSync(CefWindowInfo& windowInfo,
   return NULL;
 }
 
+CefRefPtr<CefBrowser> CefBrowser::CreateBrowserSync(CefWindowInfo& windowInfo,
+    CefRefPtr<CefClient> client, const CefString& url,
+    const CefBrowserSettings& settings,
+    CefRefPtr<CefRequestContext> requestContext)
+{
+  cef_request_context_t* requestContextStruct = NULL;
+  if (requestContext.get())
+    requestContextStruct = CefRequestContextCToCpp::Unwrap(requestContext);
+
+  cef_browser_t* impl = cef_browser_create_sync_with_context(&windowInfo,
+      CefClientCppToC::Wrap(client), url.GetStruct(), &settings,
+      requestContextStruct);
+  if(impl)
+    return CefBrowserCToCpp::Wrap(impl);
+  return NULL;
+}
+
 
 // VIRTUAL METHODS - Body may be edited by hand.
 
@@ -310,6 +345,22 @@ void CefBrowserCToCpp::Invalidate(const CefRect& dirtyRect)
   struct_->invalidate(struct_, &dirtyRect);
 }
 
+void CefBrowserCToCpp::WasHidden(bool hidden)
+{
+  if (CEF_MEMBER_MISSING(struct_, was_hidden))
+    return;
+
+  struct_->was_hidden(struct_, hidden);
+}
+
+bool CefBrowserCToCpp::IsHidden()
+{
+  if (CEF_MEMBER_MISSING(struct_, is_hidden))
+    return false;
+
+  return struct_->is_hidden(struct_)?true:false;
+}
+
 bool CefBrowserCToCpp::GetImage(PaintElementType type, int width, int height,
     void* buffer)
 {
@@ -319,6 +370,53 @@ bool CefBrowserCToCpp::GetImage(PaintElementType type, int width, int height,
   return struct_->get_image(struct_, type, width, height, buffer)?true:false;
 }
 
+void CefBrowserCToCpp::SetPixelFormat(PixelFormat format)
+{
+  if (CEF_MEMBER_MISSING(struct_, set_pixel_format))
+    return;
+
+  struct_->set_pixel_format(struct_, format);
+}
+
+CefBrowser::PixelFormat CefBrowserCToCpp::GetPixelFormat()
+{
+  if (CEF_MEMBER_MISSING(struct_, get_pixel_format))
+    return PF_DEFAULT;
+
+  return struct_->get_pixel_format(struct_);
+}
+
+void CefBrowserCToCpp::CaptureImage(PaintElementType type,
+    const CefRect& srcRect, int width, int height, ImageEncoding encoding,
+    int quality, CefRefPtr<CefImageCaptureCallback> callback)
+{
+  if (CEF_MEMBER_MISSING(struct_, capture_image))
+    return;
+
+  struct_->capture_image(struct_, type, &srcRect, width, height, encoding,
+      quality, CefImageCaptureCallbackCppToC::Wrap(callback));
+}
+
+bool CefBrowserCToCpp::CapturePage(int tileHeight,
+    CefRefPtr<CefPageCaptureHandler> handler)
+{
+  if (CEF_MEMBER_MISSING(struct_, capture_page))
+    return false;
+
+  return struct_->capture_page(struct_, tileHeight,
+      CefPageCaptureHandlerCppToC::Wrap(handler)) ? true : false;
+}
+
+bool CefBrowserCToCpp::CapturePageToStream(int tileHeight,
+    CefRefPtr<CefStreamWriter> stream)
+{
+  if (CEF_MEMBER_MISSING(struct_, capture_page_to_stream))
+    return false;
+
+  return struct_->capture_page_to_stream(struct_, tileHeight,
+      CefStreamWriterCToCpp::Unwrap(stream)) ? true : false;
+}
+
 void CefBrowserCToCpp::SendKeyEvent(KeyType type, int key, int modifiers,
     bool sysChar, bool imeChar)
 {
@@ -366,6 +464,19 @@ void CefBrowserCToCpp::SendCaptureLostEvent()
   struct_->send_capture_lost_event(struct_);
 }
 
+void CefBrowserCToCpp::SendInputEvents(const std::vector<CefInputEvent>& events)
+{
+  if (CEF_MEMBER_MISSING(struct_, send_input_events))
+    return;
+
+  if (events.empty())
+    return;
+
+  // Copy the values into a contiguous array of C structures.
+  std::vector<cef_input_event_t> eventList(events.begin(), events.end());
+  struct_->send_input_events(struct_, eventList.size(), &eventList[0]);
+}
+
 
 #ifndef NDEBUG
 template<> long CefCToCpp<CefBrowserCToCpp, CefBrowser,
@@ -63,8 +63,19 @@ public:
   virtual bool IsPopupVisible() OVERRIDE;
   virtual void HidePopup() OVERRIDE;
   virtual void Invalidate(const CefRect& dirtyRect) OVERRIDE;
+  virtual void WasHidden(bool hidden) OVERRIDE;
+  virtual bool IsHidden() OVERRIDE;
   virtual bool GetImage(PaintElementType type, int width, int height,
       void* buffer) OVERRIDE;
+  virtual void SetPixelFormat(PixelFormat format) OVERRIDE;
+  virtual PixelFormat GetPixelFormat() OVERRIDE;
+  virtual void CaptureImage(PaintElementType type, const CefRect& srcRect,
+      int width, int height, ImageEncoding encoding, int quality,
+      CefRefPtr<CefImageCaptureCallback> callback) OVERRIDE;
+  virtual bool CapturePage(int tileHeight,
+      CefRefPtr<CefPageCaptureHandler> handler) OVERRIDE;
+  virtual bool CapturePageToStream(int tileHeight,
+      CefRefPtr<CefStreamWriter> stream) OVERRIDE;
   virtual void SendKeyEvent(KeyType type, int key, int modifiers, bool sysChar,
       bool imeChar) OVERRIDE;
   virtual void SendMouseClickEvent(int x, int y, MouseButtonType type,
@@ -73,6 +84,8 @@ public:
   virtual void SendMouseWheelEvent(int x, int y, int delta) OVERRIDE;
   virtual void SendFocusEvent(bool setFocus) OVERRIDE;
   virtual void SendCaptureLostEvent() OVERRIDE;
+  virtual void SendInputEvents(
+      const std::vector<CefInputEvent>& events) OVERRIDE;
 };
 
 #endif // USING_CEF_SHARED
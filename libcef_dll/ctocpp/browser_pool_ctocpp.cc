@@ -0,0 +1,80 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+//
+// ---------------------------------------------------------------------------
+//
+// A portion of this file was generated by the CEF translator tool.  When
+// making changes by hand only do so within the body of existing static and
+// virtual method implementations. See the translator.README.txt file in the
+// tools directory for more information.
+//
+
+#include "libcef_dll/cpptoc/client_cpptoc.h"
+#include "libcef_dll/ctocpp/browser_ctocpp.h"
+#include "libcef_dll/ctocpp/browser_pool_ctocpp.h"
+
+
+// STATIC METHODS - Body may be edited by hand.
+
+CefRefPtr<CefBrowserPool> CefBrowserPool::Create(CefWindowInfo& windowInfo,
+    int size, const CefBrowserSettings& settings)
+{
+  cef_browser_pool_t* impl =
+      cef_browser_pool_create(&windowInfo, size, &settings);
+  if(impl)
+    return CefBrowserPoolCToCpp::Wrap(impl);
+  return NULL;
+}
+
+
+// VIRTUAL METHODS - Body may be edited by hand.
+
+CefRefPtr<CefBrowser> CefBrowserPoolCToCpp::TakeBrowser(
+    CefRefPtr<CefClient> client, const CefString& url)
+{
+  if (CEF_MEMBER_MISSING(struct_, take_browser))
+    return NULL;
+
+  cef_client_t* clientStruct = NULL;
+  if (client.get())
+    clientStruct = CefClientCppToC::Wrap(client);
+
+  cef_browser_t* browserStruct =
+      struct_->take_browser(struct_, clientStruct, url.GetStruct());
+  if(browserStruct)
+    return CefBrowserCToCpp::Wrap(browserStruct);
+  return NULL;
+}
+
+bool CefBrowserPoolCToCpp::ReturnBrowser(CefRefPtr<CefBrowser> browser)
+{
+  if (CEF_MEMBER_MISSING(struct_, return_browser))
+    return false;
+
+  return struct_->return_browser(struct_,
+      CefBrowserCToCpp::Unwrap(browser))?true:false;
+}
+
+int CefBrowserPoolCToCpp::GetIdleCount()
+{
+  if (CEF_MEMBER_MISSING(struct_, get_idle_count))
+    return 0;
+
+  return struct_->get_idle_count(struct_);
+}
+
+void CefBrowserPoolCToCpp::Close()
+{
+  if (CEF_MEMBER_MISSING(struct_, close))
+    return;
+
+  struct_->close(struct_);
+}
+
+
+#ifndef NDEBUG
+template<> long CefCToCpp<CefBrowserPoolCToCpp, CefBrowserPool,
+    cef_browser_pool_t>::DebugObjCt = 0;
+#endif
+
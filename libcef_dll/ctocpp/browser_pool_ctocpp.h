@@ -0,0 +1,44 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+//
+// -------------------------------------------------------------------------
+//
+// This file was generated by the CEF translator tool and should not edited
+// by hand. See the translator.README.txt file in the tools directory for
+// more information.
+//
+
+#ifndef _BROWSERPOOL_CTOCPP_H
+#define _BROWSERPOOL_CTOCPP_H
+
+#ifndef USING_CEF_SHARED
+#pragma message("Warning: "__FILE__" may be accessed wrapper-side only")
+#else // USING_CEF_SHARED
+
+#include "include/cef.h"
+#include "include/cef_capi.h"
+#include "libcef_dll/ctocpp/ctocpp.h"
+
+// Wrap a C structure with a C++ class.
+// This class may be instantiated and accessed wrapper-side only.
+class CefBrowserPoolCToCpp
+    : public CefCToCpp<CefBrowserPoolCToCpp, CefBrowserPool, cef_browser_pool_t>
+{
+public:
+  CefBrowserPoolCToCpp(cef_browser_pool_t* str)
+      : CefCToCpp<CefBrowserPoolCToCpp, CefBrowserPool, cef_browser_pool_t>(
+          str) {}
+  virtual ~CefBrowserPoolCToCpp() {}
+
+  // CefBrowserPool methods
+  virtual CefRefPtr<CefBrowser> TakeBrowser(CefRefPtr<CefClient> client,
+      const CefString& url) OVERRIDE;
+  virtual bool ReturnBrowser(CefRefPtr<CefBrowser> browser) OVERRIDE;
+  virtual int GetIdleCount() OVERRIDE;
+  virtual void Close() OVERRIDE;
+};
+
+#endif // USING_CEF_SHARED
+#endif // _BROWSERPOOL_CTOCPP_H
+
@@ -41,6 +41,14 @@ void CefContentFilterCToCpp::Drain(CefRefPtr<CefStreamReader>& remainder)
     remainder = CefStreamReaderCppToC::Unwrap(streamRet);
 }
 
+bool CefContentFilterCToCpp::UseWorkerThread()
+{
+  if (CEF_MEMBER_MISSING(struct_, use_worker_thread))
+    return false;
+
+  return struct_->use_worker_thread(struct_) ? true : false;
+}
+
 
 #ifndef NDEBUG
 template<> long CefCToCpp<CefContentFilterCToCpp, CefContentFilter,
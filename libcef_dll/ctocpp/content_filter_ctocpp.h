@@ -36,6 +36,7 @@ public:
   virtual void ProcessData(const void* data, int data_size,
       CefRefPtr<CefStreamReader>& substitute_data) OVERRIDE;
   virtual void Drain(CefRefPtr<CefStreamReader>& remainder) OVERRIDE;
+  virtual bool UseWorkerThread() OVERRIDE;
 };
 
 #endif // BUILDING_CEF_SHARED
@@ -0,0 +1,39 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+//
+// ---------------------------------------------------------------------------
+//
+// A portion of this file was generated by the CEF translator tool.  When
+// making changes by hand only do so within the body of existing static and
+// virtual method implementations. See the translator.README.txt file in the
+// tools directory for more information.
+//
+
+#include "libcef_dll/ctocpp/cookie_batch_visitor_ctocpp.h"
+
+
+// VIRTUAL METHODS - Body may be edited by hand.
+
+bool CefCookieBatchVisitorCToCpp::Visit(const std::vector<CefCookie>& cookies,
+    int offset, int total)
+{
+  if(CEF_MEMBER_MISSING(struct_, visit))
+    return false;
+
+  if(cookies.empty())
+    return true;
+
+  // Copy the values into a contiguous array of C structures. The strings are
+  // referenced without copying.
+  std::vector<cef_cookie_t> cookieList(cookies.begin(), cookies.end());
+  return struct_->visit(struct_, cookieList.size(), &cookieList[0], offset,
+      total) ? true : false;
+}
+
+
+#ifndef NDEBUG
+template<> long CefCToCpp<CefCookieBatchVisitorCToCpp, CefCookieBatchVisitor,
+    cef_cookie_batch_visitor_t>::DebugObjCt = 0;
+#endif
+
@@ -0,0 +1,42 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+//
+// -------------------------------------------------------------------------
+//
+// This file was generated by the CEF translator tool and should not edited
+// by hand. See the translator.README.txt file in the tools directory for
+// more information.
+//
+
+#ifndef _COOKIEBATCHVISITOR_CTOCPP_H
+#define _COOKIEBATCHVISITOR_CTOCPP_H
+
+#ifndef BUILDING_CEF_SHARED
+#pragma message("Warning: "__FILE__" may be accessed DLL-side only")
+#else // BUILDING_CEF_SHARED
+
+#include "include/cef.h"
+#include "include/cef_capi.h"
+#include "libcef_dll/ctocpp/ctocpp.h"
+
+// Wrap a C structure with a C++ class.
+// This class may be instantiated and accessed DLL-side only.
+class CefCookieBatchVisitorCToCpp
+    : public CefCToCpp<CefCookieBatchVisitorCToCpp, CefCookieBatchVisitor,
+        cef_cookie_batch_visitor_t>
+{
+public:
+  CefCookieBatchVisitorCToCpp(cef_cookie_batch_visitor_t* str)
+      : CefCToCpp<CefCookieBatchVisitorCToCpp, CefCookieBatchVisitor,
+          cef_cookie_batch_visitor_t>(str) {}
+  virtual ~CefCookieBatchVisitorCToCpp() {}
+
+  // CefCookieBatchVisitor methods
+  virtual bool Visit(const std::vector<CefCookie>& cookies, int offset,
+      int total) OVERRIDE;
+};
+
+#endif // BUILDING_CEF_SHARED
+#endif // _COOKIEBATCHVISITOR_CTOCPP_H
+
@@ -0,0 +1,35 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+//
+// ---------------------------------------------------------------------------
+//
+// A portion of this file was generated by the CEF translator tool.  When
+// making changes by hand only do so within the body of existing static and
+// virtual method implementations. See the translator.README.txt file in the
+// tools directory for more information.
+//
+
+#include "libcef_dll/cpptoc/browser_cpptoc.h"
+#include "libcef_dll/ctocpp/image_capture_callback_ctocpp.h"
+
+
+// VIRTUAL METHODS - Body may be edited by hand.
+
+void CefImageCaptureCallbackCToCpp::OnImageCaptured(
+    CefRefPtr<CefBrowser> browser, bool success, const void* data,
+    size_t dataSize)
+{
+  if (CEF_MEMBER_MISSING(struct_, on_image_captured))
+    return;
+
+  struct_->on_image_captured(struct_, CefBrowserCppToC::Wrap(browser), success,
+      data, dataSize);
+}
+
+
+#ifndef NDEBUG
+template<> long CefCToCpp<CefImageCaptureCallbackCToCpp,
+    CefImageCaptureCallback, cef_image_capture_callback_t>::DebugObjCt = 0;
+#endif
+
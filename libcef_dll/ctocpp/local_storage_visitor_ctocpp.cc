@@ -0,0 +1,44 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+//
+// ---------------------------------------------------------------------------
+//
+// A portion of this file was generated by the CEF translator tool.  When
+// making changes by hand only do so within the body of existing static and
+// virtual method implementations. See the translator.README.txt file in the
+// tools directory for more information.
+//
+
+#include "libcef_dll/ctocpp/local_storage_visitor_ctocpp.h"
+#include "libcef_dll/transfer_util.h"
+
+
+// VIRTUAL METHODS - Body may be edited by hand.
+
+void CefLocalStorageVisitorCToCpp::Visit(const CefString& origin,
+    const CefLocalStorageItemMap& items)
+{
+  if (CEF_MEMBER_MISSING(struct_, visit))
+    return;
+
+  cef_string_map_t map = NULL;
+  if (!items.empty()) {
+    map = cef_string_map_alloc();
+    if (!map)
+      return;
+    transfer_string_map_contents(items, map);
+  }
+
+  struct_->visit(struct_, origin.GetStruct(), map);
+
+  if (map)
+    cef_string_map_free(map);
+}
+
+
+#ifndef NDEBUG
+template<> long CefCToCpp<CefLocalStorageVisitorCToCpp, CefLocalStorageVisitor,
+    cef_local_storage_visitor_t>::DebugObjCt = 0;
+#endif
+
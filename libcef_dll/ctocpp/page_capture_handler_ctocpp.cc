@@ -0,0 +1,44 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+//
+// ---------------------------------------------------------------------------
+//
+// A portion of this file was generated by the CEF translator tool.  When
+// making changes by hand only do so within the body of existing static and
+// virtual method implementations. See the translator.README.txt file in the
+// tools directory for more information.
+//
+
+#include "libcef_dll/cpptoc/browser_cpptoc.h"
+#include "libcef_dll/ctocpp/page_capture_handler_ctocpp.h"
+
+
+// VIRTUAL METHODS - Body may be edited by hand.
+
+bool CefPageCaptureHandlerCToCpp::OnCaptureStart(CefRefPtr<CefBrowser> browser,
+    int width, int height)
+{
+  if (CEF_MEMBER_MISSING(struct_, on_capture_start))
+    return true;
+
+  return struct_->on_capture_start(struct_, CefBrowserCppToC::Wrap(browser),
+      width, height) ? true : false;
+}
+
+bool CefPageCaptureHandlerCToCpp::OnCaptureTile(CefRefPtr<CefBrowser> browser,
+    const CefRect& tileRect, const void* buffer)
+{
+  if (CEF_MEMBER_MISSING(struct_, on_capture_tile))
+    return false;
+
+  return struct_->on_capture_tile(struct_, CefBrowserCppToC::Wrap(browser),
+      &tileRect, buffer) ? true : false;
+}
+
+
+#ifndef NDEBUG
+template<> long CefCToCpp<CefPageCaptureHandlerCToCpp, CefPageCaptureHandler,
+    cef_page_capture_handler_t>::DebugObjCt = 0;
+#endif
+
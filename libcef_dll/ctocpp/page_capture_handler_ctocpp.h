@@ -0,0 +1,44 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+//
+// -------------------------------------------------------------------------
+//
+// This file was generated by the CEF translator tool and should not edited
+// by hand. See the translator.README.txt file in the tools directory for
+// more information.
+//
+
+#ifndef _PAGECAPTUREHANDLER_CTOCPP_H
+#define _PAGECAPTUREHANDLER_CTOCPP_H
+
+#ifndef BUILDING_CEF_SHARED
+#pragma message("Warning: "__FILE__" may be accessed DLL-side only")
+#else // BUILDING_CEF_SHARED
+
+#include "include/cef.h"
+#include "include/cef_capi.h"
+#include "libcef_dll/ctocpp/ctocpp.h"
+
+// Wrap a C structure with a C++ class.
+// This class may be instantiated and accessed DLL-side only.
+class CefPageCaptureHandlerCToCpp
+    : public CefCToCpp<CefPageCaptureHandlerCToCpp, CefPageCaptureHandler,
+        cef_page_capture_handler_t>
+{
+public:
+  CefPageCaptureHandlerCToCpp(cef_page_capture_handler_t* str)
+      : CefCToCpp<CefPageCaptureHandlerCToCpp, CefPageCaptureHandler,
+          cef_page_capture_handler_t>(str) {}
+  virtual ~CefPageCaptureHandlerCToCpp() {}
+
+  // CefPageCaptureHandler methods
+  virtual bool OnCaptureStart(CefRefPtr<CefBrowser> browser, int width,
+      int height) OVERRIDE;
+  virtual bool OnCaptureTile(CefRefPtr<CefBrowser> browser,
+      const CefRect& tileRect, const void* buffer) OVERRIDE;
+};
+
+#endif // BUILDING_CEF_SHARED
+#endif // _PAGECAPTUREHANDLER_CTOCPP_H
+
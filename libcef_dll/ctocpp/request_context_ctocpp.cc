@@ -0,0 +1,47 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+//
+// ---------------------------------------------------------------------------
+//
+// A portion of this file was generated by the CEF translator tool.  When
+// making changes by hand only do so within the body of existing static and
+// virtual method implementations. See the translator.README.txt file in the
+// tools directory for more information.
+//
+
+#include "libcef_dll/ctocpp/request_context_ctocpp.h"
+
+
+// STATIC METHODS - Body may be edited by hand.
+
+CefRefPtr<CefRequestContext> CefRequestContext::CreateContext(
+    const CefString& cache_path)
+{
+  cef_request_context_t* impl =
+      cef_request_context_create_context(cache_path.GetStruct());
+  if(impl)
+    return CefRequestContextCToCpp::Wrap(impl);
+  return NULL;
+}
+
+
+// VIRTUAL METHODS - Body may be edited by hand.
+
+CefString CefRequestContextCToCpp::GetCachePath()
+{
+  CefString str;
+  if(CEF_MEMBER_MISSING(struct_, get_cache_path))
+    return str;
+
+  cef_string_userfree_t strPtr = struct_->get_cache_path(struct_);
+  str.AttachToUserFree(strPtr);
+  return str;
+}
+
+
+#ifndef NDEBUG
+template<> long CefCToCpp<CefRequestContextCToCpp, CefRequestContext,
+    cef_request_context_t>::DebugObjCt = 0;
+#endif
+
@@ -0,0 +1,61 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+//
+// ---------------------------------------------------------------------------
+//
+// A portion of this file was generated by the CEF translator tool.  When
+// making changes by hand only do so within the body of existing static and
+// virtual method implementations. See the translator.README.txt file in the
+// tools directory for more information.
+//
+
+#include "libcef_dll/cpptoc/task_cpptoc.h"
+#include "libcef_dll/ctocpp/sequenced_task_runner_ctocpp.h"
+
+
+// STATIC METHODS - Body may be edited by hand.
+
+CefRefPtr<CefSequencedTaskRunner> CefSequencedTaskRunner::Create()
+{
+  cef_sequenced_task_runner_t* impl = cef_sequenced_task_runner_create();
+  if(impl)
+    return CefSequencedTaskRunnerCToCpp::Wrap(impl);
+  return NULL;
+}
+
+
+// VIRTUAL METHODS - Body may be edited by hand.
+
+bool CefSequencedTaskRunnerCToCpp::PostTask(CefRefPtr<CefTask> task)
+{
+  if (CEF_MEMBER_MISSING(struct_, post_task))
+    return false;
+
+  return struct_->post_task(struct_, CefTaskCppToC::Wrap(task))?true:false;
+}
+
+bool CefSequencedTaskRunnerCToCpp::PostDelayedTask(CefRefPtr<CefTask> task,
+    long delay_ms)
+{
+  if (CEF_MEMBER_MISSING(struct_, post_delayed_task))
+    return false;
+
+  return struct_->post_delayed_task(struct_, CefTaskCppToC::Wrap(task),
+      delay_ms)?true:false;
+}
+
+bool CefSequencedTaskRunnerCToCpp::RunsTasksOnCurrentThread()
+{
+  if (CEF_MEMBER_MISSING(struct_, runs_tasks_on_current_thread))
+    return false;
+
+  return struct_->runs_tasks_on_current_thread(struct_)?true:false;
+}
+
+
+#ifndef NDEBUG
+template<> long CefCToCpp<CefSequencedTaskRunnerCToCpp, CefSequencedTaskRunner,
+    cef_sequenced_task_runner_t>::DebugObjCt = 0;
+#endif
+
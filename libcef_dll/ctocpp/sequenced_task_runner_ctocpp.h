@@ -0,0 +1,43 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+//
+// -------------------------------------------------------------------------
+//
+// This file was generated by the CEF translator tool and should not edited
+// by hand. See the translator.README.txt file in the tools directory for
+// more information.
+//
+
+#ifndef _SEQUENCEDTASKRUNNER_CTOCPP_H
+#define _SEQUENCEDTASKRUNNER_CTOCPP_H
+
+#ifndef USING_CEF_SHARED
+#pragma message("Warning: "__FILE__" may be accessed wrapper-side only")
+#else // USING_CEF_SHARED
+
+#include "include/cef.h"
+#include "include/cef_capi.h"
+#include "libcef_dll/ctocpp/ctocpp.h"
+
+// Wrap a C structure with a C++ class.
+// This class may be instantiated and accessed wrapper-side only.
+class CefSequencedTaskRunnerCToCpp
+    : public CefCToCpp<CefSequencedTaskRunnerCToCpp, CefSequencedTaskRunner,
+        cef_sequenced_task_runner_t>
+{
+public:
+  CefSequencedTaskRunnerCToCpp(cef_sequenced_task_runner_t* str)
+      : CefCToCpp<CefSequencedTaskRunnerCToCpp, CefSequencedTaskRunner,
+          cef_sequenced_task_runner_t>(str) {}
+  virtual ~CefSequencedTaskRunnerCToCpp() {}
+
+  // CefSequencedTaskRunner methods
+  virtual bool PostTask(CefRefPtr<CefTask> task) OVERRIDE;
+  virtual bool PostDelayedTask(CefRefPtr<CefTask> task, long delay_ms) OVERRIDE;
+  virtual bool RunsTasksOnCurrentThread() OVERRIDE;
+};
+
+#endif // USING_CEF_SHARED
+#endif // _SEQUENCEDTASKRUNNER_CTOCPP_H
+
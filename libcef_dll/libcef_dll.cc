@@ -8,12 +8,15 @@
 #include "include/cef_nplugin_capi.h"
 #include "cef_logging.h"
 #include "cpptoc/browser_cpptoc.h"
+#include "cpptoc/browser_pool_cpptoc.h"
 #include "cpptoc/domdocument_cpptoc.h"
 #include "cpptoc/domevent_cpptoc.h"
 #include "cpptoc/domnode_cpptoc.h"
 #include "cpptoc/post_data_cpptoc.h"
 #include "cpptoc/post_data_element_cpptoc.h"
 #include "cpptoc/request_cpptoc.h"
+#include "cpptoc/request_context_cpptoc.h"
+#include "cpptoc/sequenced_task_runner_cpptoc.h"
 #include "cpptoc/stream_reader_cpptoc.h"
 #include "cpptoc/stream_writer_cpptoc.h"
 #include "cpptoc/v8context_cpptoc.h"
@@ -22,10 +25,14 @@
 #include "cpptoc/xml_reader_cpptoc.h"
 #include "cpptoc/zip_reader_cpptoc.h"
 #include "ctocpp/content_filter_ctocpp.h"
+#include "ctocpp/cookie_batch_visitor_ctocpp.h"
 #include "ctocpp/cookie_visitor_ctocpp.h"
 #include "ctocpp/domevent_listener_ctocpp.h"
 #include "ctocpp/domvisitor_ctocpp.h"
 #include "ctocpp/download_handler_ctocpp.h"
+#include "ctocpp/image_capture_callback_ctocpp.h"
+#include "ctocpp/local_storage_visitor_ctocpp.h"
+#include "ctocpp/page_capture_handler_ctocpp.h"
 #include "ctocpp/read_handler_ctocpp.h"
 #include "ctocpp/scheme_handler_ctocpp.h"
 #include "ctocpp/scheme_handler_factory_ctocpp.h"
@@ -34,6 +41,7 @@
 #include "ctocpp/v8handler_ctocpp.h"
 #include "ctocpp/web_urlrequest_client_ctocpp.h"
 #include "ctocpp/write_handler_ctocpp.h"
+#include "transfer_util.h"
 #include "base/string_split.h"
 
 
@@ -57,12 +65,15 @@ CEF_EXPORT void cef_shutdown()
 #ifndef NDEBUG
   // Check that all wrapper objects have been destroyed
   DCHECK(CefBrowserCppToC::DebugObjCt == 0);
+  DCHECK(CefBrowserPoolCppToC::DebugObjCt == 0);
   DCHECK(CefDOMDocumentCppToC::DebugObjCt == 0);
   DCHECK(CefDOMEventCppToC::DebugObjCt == 0);
   DCHECK(CefDOMNodeCppToC::DebugObjCt == 0);
   DCHECK(CefRequestCppToC::DebugObjCt == 0);
+  DCHECK(CefRequestContextCppToC::DebugObjCt == 0);
   DCHECK(CefPostDataCppToC::DebugObjCt == 0);
   DCHECK(CefPostDataElementCppToC::DebugObjCt == 0);
+  DCHECK(CefSequencedTaskRunnerCppToC::DebugObjCt == 0);
   DCHECK(CefStreamReaderCppToC::DebugObjCt == 0);
   DCHECK(CefStreamWriterCppToC::DebugObjCt == 0);
   DCHECK(CefV8ContextCppToC::DebugObjCt == 0);
@@ -71,10 +82,14 @@ CEF_EXPORT void cef_shutdown()
   DCHECK(CefXmlReaderCppToC::DebugObjCt == 0);
   DCHECK(CefZipReaderCppToC::DebugObjCt == 0);
   DCHECK(CefContentFilterCToCpp::DebugObjCt == 0);
+  DCHECK(CefCookieBatchVisitorCToCpp::DebugObjCt == 0);
   DCHECK(CefCookieVisitorCToCpp::DebugObjCt == 0);
   DCHECK(CefDOMEventListenerCToCpp::DebugObjCt == 0);
   DCHECK(CefDOMVisitorCToCpp::DebugObjCt == 0);
   DCHECK(CefDownloadHandlerCToCpp::DebugObjCt == 0);
+  DCHECK(CefImageCaptureCallbackCToCpp::DebugObjCt == 0);
+  DCHECK(CefLocalStorageVisitorCToCpp::DebugObjCt == 0);
+  DCHECK(CefPageCaptureHandlerCToCpp::DebugObjCt == 0);
   DCHECK(CefReadHandlerCToCpp::DebugObjCt == 0);
   DCHECK(CefSchemeHandlerCToCpp::DebugObjCt == 0);
   DCHECK(CefSchemeHandlerFactoryCToCpp::DebugObjCt == 0);
@@ -85,11 +100,38 @@ CEF_EXPORT void cef_shutdown()
 #endif // !NDEBUG
 }
 
+CEF_EXPORT int cef_fast_shutdown(int timeout_ms,
+    struct _cef_shutdown_report_t* report)
+{
+  DCHECK(report);
+  if (!report)
+    return 0;
+
+  // Wrapper objects are intentionally not checked because nothing is
+  // destroyed.
+  CefShutdownReport reportObj;
+  bool ret = CefFastShutdown(timeout_ms, reportObj);
+
+  reportObj.DetachTo(*report);
+
+  return ret;
+}
+
 CEF_EXPORT void cef_do_message_loop_work()
 {
   CefDoMessageLoopWork();
 }
 
+CEF_EXPORT int cef_get_message_loop_wakeup_fd()
+{
+  return CefGetMessageLoopWakeupFd();
+}
+
+CEF_EXPORT long cef_get_message_loop_work_delay()
+{
+  return CefGetMessageLoopWorkDelay();
+}
+
 CEF_EXPORT void cef_run_message_loop()
 {
   CefRunMessageLoop();
@@ -210,6 +252,72 @@ CEF_EXPORT int cef_post_delayed_task(cef_thread_id_t threadId,
   return CefPostDelayedTask(threadId, CefTaskCToCpp::Wrap(task), delay_ms);
 }
 
+CEF_EXPORT int cef_post_tasks(cef_thread_id_t threadId, size_t taskCount,
+    struct _cef_task_t* const* tasks)
+{
+  DCHECK(tasks || taskCount == 0);
+  if(!tasks && taskCount > 0)
+    return 0;
+
+  std::vector<CefRefPtr<CefTask> > taskList;
+  taskList.reserve(taskCount);
+  for(size_t i = 0; i < taskCount; ++i) {
+    DCHECK(tasks[i]);
+    if(tasks[i])
+      taskList.push_back(CefTaskCToCpp::Wrap(tasks[i]));
+  }
+
+  return CefPostTasks(threadId, taskList);
+}
+
+CEF_EXPORT int cef_get_thread_stats(cef_thread_id_t threadId,
+    struct _cef_thread_stats_t* stats)
+{
+  DCHECK(stats);
+  if(!stats)
+    return 0;
+
+  CefThreadStats statsObj;
+  bool ret = CefGetThreadStats(threadId, statsObj);
+
+  statsObj.DetachTo(*stats);
+
+  return ret;
+}
+
+CEF_EXPORT void cef_set_thread_stats_enabled(int enabled)
+{
+  CefSetThreadStatsEnabled(enabled ? true : false);
+}
+
+CEF_EXPORT int cef_begin_tracing()
+{
+  return CefBeginTracing();
+}
+
+CEF_EXPORT int cef_end_tracing(const cef_string_t* tracing_file)
+{
+  DCHECK(tracing_file);
+  if (!tracing_file)
+    return 0;
+
+  return CefEndTracing(CefString(tracing_file));
+}
+
+CEF_EXPORT int cef_get_startup_timings(struct _cef_startup_timings_t* timings)
+{
+  DCHECK(timings);
+  if(!timings)
+    return 0;
+
+  CefStartupTimings timingsObj;
+  bool ret = CefGetStartupTimings(timingsObj);
+
+  timingsObj.DetachTo(*timings);
+
+  return ret;
+}
+
 CEF_EXPORT int cef_parse_url(const cef_string_t* url,
     struct _cef_urlparts_t* parts)
 {
@@ -261,6 +369,17 @@ CEF_EXPORT int cef_visit_url_cookies(const cef_string_t* url,
       CefCookieVisitorCToCpp::Wrap(visitor));
 }
 
+CEF_EXPORT int cef_visit_all_cookies_in_batches(int batchSize,
+    struct _cef_cookie_batch_visitor_t* visitor)
+{
+  DCHECK(visitor);
+  if (!visitor)
+    return 0;
+
+  return CefVisitAllCookiesInBatches(batchSize,
+      CefCookieBatchVisitorCToCpp::Wrap(visitor));
+}
+
 CEF_EXPORT int cef_set_cookie(const cef_string_t* url,
     const struct _cef_cookie_t* cookie)
 {
@@ -276,6 +395,20 @@ CEF_EXPORT int cef_set_cookie(const cef_string_t* url,
   return CefSetCookie(CefString(url), cookieObj);
 }
 
+CEF_EXPORT int cef_set_cookies(size_t cookieCount, const cef_cookie_t* cookies)
+{
+  DCHECK(cookies || cookieCount == 0);
+  if (!cookies && cookieCount > 0)
+    return 0;
+
+  // Reference the existing values without copying.
+  std::vector<CefCookie> cookieList(cookieCount);
+  for (size_t i = 0; i < cookieCount; ++i)
+    cookieList[i].Set(cookies[i], false);
+
+  return CefSetCookies(cookieList);
+}
+
 CEF_EXPORT int cef_delete_cookies(const cef_string_t* url,
     const cef_string_t* cookie_name)
 {
@@ -288,3 +421,122 @@ CEF_EXPORT int cef_delete_cookies(const cef_string_t* url,
 
   return CefDeleteCookies(urlStr, cookieNameStr);
 }
+
+CEF_EXPORT int cef_flush_cookie_store(struct _cef_task_t* completionTask)
+{
+  CefRefPtr<CefTask> completionTaskPtr;
+  if (completionTask)
+    completionTaskPtr = CefTaskCToCpp::Wrap(completionTask);
+
+  return CefFlushCookieStore(completionTaskPtr);
+}
+
+CEF_EXPORT int cef_get_cookie_store_stats(
+    struct _cef_cookie_store_stats_t* stats)
+{
+  DCHECK(stats);
+  if(!stats)
+    return 0;
+
+  CefCookieStoreStats statsObj;
+  bool ret = CefGetCookieStoreStats(statsObj);
+
+  statsObj.DetachTo(*stats);
+
+  return ret;
+}
+
+CEF_EXPORT int cef_save_cookies(const cef_string_t* domain,
+    struct _cef_stream_writer_t* writer)
+{
+  DCHECK(writer);
+  if (!writer)
+    return 0;
+
+  CefString domainStr;
+  if (domain)
+    domainStr = domain;
+
+  return CefSaveCookies(domainStr, CefStreamWriterCppToC::Unwrap(writer));
+}
+
+CEF_EXPORT int cef_restore_cookies(struct _cef_stream_reader_t* reader)
+{
+  DCHECK(reader);
+  if (!reader)
+    return 0;
+
+  return CefRestoreCookies(CefStreamReaderCppToC::Unwrap(reader));
+}
+
+CEF_EXPORT int cef_visit_local_storage(const cef_string_t* origin,
+    struct _cef_local_storage_visitor_t* visitor)
+{
+  DCHECK(origin);
+  DCHECK(visitor);
+  if (!origin || !visitor)
+    return 0;
+
+  return CefVisitLocalStorage(CefString(origin),
+      CefLocalStorageVisitorCToCpp::Wrap(visitor));
+}
+
+CEF_EXPORT int cef_set_local_storage(const cef_string_t* origin,
+    cef_string_map_t items, int clear)
+{
+  DCHECK(origin);
+  if (!origin)
+    return 0;
+
+  CefLocalStorageItemMap map;
+  if (items)
+    transfer_string_map_contents(items, map);
+
+  return CefSetLocalStorage(CefString(origin), map, clear ? true : false);
+}
+
+CEF_EXPORT int cef_get_http_cache_stats(struct _cef_http_cache_stats_t* stats)
+{
+  DCHECK(stats);
+  if(!stats)
+    return 0;
+
+  CefHttpCacheStats statsObj;
+  bool ret = CefGetHttpCacheStats(statsObj);
+
+  statsObj.DetachTo(*stats);
+
+  return ret;
+}
+
+CEF_EXPORT int cef_purge_http_cache(const cef_string_t* url_prefix,
+    int max_age, struct _cef_task_t* completionTask)
+{
+  CefString urlPrefixStr;
+  if (url_prefix)
+    urlPrefixStr = url_prefix;
+
+  CefRefPtr<CefTask> completionTaskPtr;
+  if (completionTask)
+    completionTaskPtr = CefTaskCToCpp::Wrap(completionTask);
+
+  return CefPurgeHttpCache(urlPrefixStr, max_age, completionTaskPtr);
+}
+
+CEF_EXPORT int cef_import_http_cache_entry(const cef_string_t* url,
+    const cef_string_t* headers, struct _cef_stream_reader_t* data,
+    struct _cef_task_t* completionTask)
+{
+  DCHECK(url);
+  DCHECK(headers);
+  DCHECK(data);
+  if (!url || !headers || !data)
+    return 0;
+
+  CefRefPtr<CefTask> completionTaskPtr;
+  if (completionTask)
+    completionTaskPtr = CefTaskCToCpp::Wrap(completionTask);
+
+  return CefImportHttpCacheEntry(CefString(url), CefString(headers),
+      CefStreamReaderCppToC::Unwrap(data), completionTaskPtr);
+}
@@ -39,6 +39,35 @@ private:
   IMPLEMENT_REFCOUNTING(CefZipFile);
 };
 
+// Loads a zip archive on the WORKER pool and then posts the callback.
+class CefZipLoadTask : public CefTask
+{
+public:
+  CefZipLoadTask(CefRefPtr<CefZipArchive> archive,
+                 CefRefPtr<CefStreamReader> stream, bool overwriteExisting,
+                 CefThreadId callbackThreadId, CefRefPtr<CefTask> callback)
+    : archive_(archive), stream_(stream),
+      overwrite_existing_(overwriteExisting),
+      callback_thread_id_(callbackThreadId), callback_(callback) {}
+
+  virtual void Execute(CefThreadId threadId) {
+    archive_->Load(stream_, overwrite_existing_);
+    stream_ = NULL;
+
+    if (callback_.get())
+      CefPostTask(callback_thread_id_, callback_);
+  }
+
+private:
+  CefRefPtr<CefZipArchive> archive_;
+  CefRefPtr<CefStreamReader> stream_;
+  bool overwrite_existing_;
+  CefThreadId callback_thread_id_;
+  CefRefPtr<CefTask> callback_;
+
+  IMPLEMENT_REFCOUNTING(CefZipLoadTask);
+};
+
 } // namespace
 
 // CefZipArchive implementation
@@ -111,6 +140,19 @@ size_t CefZipArchive::Load(CefRefPtr<CefStreamReader> stream,
   return count;
 }
 
+bool CefZipArchive::LoadAsync(CefRefPtr<CefStreamReader> stream,
+                              bool overwriteExisting,
+                              CefThreadId callbackThreadId,
+                              CefRefPtr<CefTask> callback)
+{
+  if (!stream.get())
+    return false;
+
+  return CefPostTask(TID_WORKER,
+      new CefZipLoadTask(this, stream, overwriteExisting, callbackThreadId,
+                         callback));
+}
+
 void CefZipArchive::Clear()
 {
   AutoLock lock_scope(this);
@@ -166,3 +208,127 @@ size_t CefZipArchive::GetFiles(FileMap& map)
    map = contents_;
    return contents_.size();
 }
+
+namespace {
+
+// Executes the completion task of CefImportHttpCache() on the IO thread after
+// the last imported entry has been written. One pending count is held while
+// the manifest is parsed.
+class CefHttpCacheImportTask : public CefTask
+{
+public:
+  CefHttpCacheImportTask(CefRefPtr<CefTask> completionTask)
+    : completion_task_(completionTask), pending_count_(1) {}
+
+  void AddPending()
+  {
+    AutoLock lock_scope(this);
+    pending_count_++;
+  }
+
+  // Called when an entry has been written or when parsing has finished.
+  virtual void Execute(CefThreadId threadId)
+  {
+    {
+      AutoLock lock_scope(this);
+      if (--pending_count_ > 0)
+        return;
+    }
+    CefPostTask(TID_IO, completion_task_);
+  }
+
+private:
+  CefRefPtr<CefTask> completion_task_;
+  int pending_count_;
+
+  IMPLEMENT_REFCOUNTING(CefHttpCacheImportTask);
+  IMPLEMENT_LOCKING(CefHttpCacheImportTask);
+};
+
+// Import a single entry from the HTTP cache manifest.
+bool ImportHttpCacheEntry(CefRefPtr<CefZipArchive> archive,
+                          const std::vector<std::string>& lines,
+                          CefRefPtr<CefHttpCacheImportTask> task)
+{
+  if (lines.size() < 2)
+    return false;
+
+  size_t pos = lines[0].find(' ');
+  if (pos == std::string::npos)
+    return false;
+
+  CefRefPtr<CefZipArchive::File> file =
+      archive->GetFile(lines[0].substr(pos + 1));
+  if (!file.get())
+    return false;
+
+  std::string headers;
+  for (size_t i = 1; i < lines.size(); ++i) {
+    headers.append(lines[i]);
+    headers.append("\n");
+  }
+
+  if (task.get())
+    task->AddPending();
+  if (CefImportHttpCacheEntry(lines[0].substr(0, pos), headers,
+                              file->GetStreamReader(), task.get())) {
+    return true;
+  }
+  if (task.get())
+    task->Execute(TID_IO);
+  return false;
+}
+
+} // namespace
+
+size_t CefImportHttpCache(CefRefPtr<CefZipArchive> archive,
+                          const CefString& manifestName,
+                          CefRefPtr<CefTask> completionTask)
+{
+  CefRefPtr<CefHttpCacheImportTask> task;
+  if (completionTask.get())
+    task = new CefHttpCacheImportTask(completionTask);
+
+  CefRefPtr<CefZipArchive::File> manifest = archive->GetFile(manifestName);
+  if (!manifest.get()) {
+    if (task.get())
+      task->Execute(TID_IO);
+    return 0;
+  }
+
+  std::string contents(reinterpret_cast<const char*>(manifest->GetData()),
+                       manifest->GetDataSize());
+
+  size_t count = 0;
+  std::vector<std::string> lines;
+  size_t start = 0;
+  while (start <= contents.size()) {
+    size_t end = contents.find('\n', start);
+    if (end == std::string::npos)
+      end = contents.size();
+
+    std::string line = contents.substr(start, end - start);
+    if (!line.empty() && line[line.size() - 1] == '\r')
+      line.erase(line.size() - 1);
+    start = end + 1;
+
+    // A blank line or the end of the manifest finishes the current entry.
+    if (!line.empty()) {
+      lines.push_back(line);
+      if (start <= contents.size())
+        continue;
+    }
+
+    if (!lines.empty()) {
+      if (ImportHttpCacheEntry(archive, lines, task))
+        count++;
+      lines.clear();
+    }
+  }
+
+  // Release the pending count held while parsing.
+  if (task.get())
+    task->Execute(TID_IO);
+
+  return count;
+}
@@ -7,10 +7,14 @@
 #include "include/cef_nplugin.h"
 #include "include/cef_nplugin_capi.h"
 #include "libcef_dll/cpptoc/content_filter_cpptoc.h"
+#include "libcef_dll/cpptoc/cookie_batch_visitor_cpptoc.h"
 #include "libcef_dll/cpptoc/cookie_visitor_cpptoc.h"
 #include "libcef_dll/cpptoc/domevent_listener_cpptoc.h"
 #include "libcef_dll/cpptoc/domvisitor_cpptoc.h"
 #include "libcef_dll/cpptoc/download_handler_cpptoc.h"
+#include "libcef_dll/cpptoc/image_capture_callback_cpptoc.h"
+#include "libcef_dll/cpptoc/local_storage_visitor_cpptoc.h"
+#include "libcef_dll/cpptoc/page_capture_handler_cpptoc.h"
 #include "libcef_dll/cpptoc/read_handler_cpptoc.h"
 #include "libcef_dll/cpptoc/scheme_handler_cpptoc.h"
 #include "libcef_dll/cpptoc/scheme_handler_factory_cpptoc.h"
@@ -20,12 +24,15 @@
 #include "libcef_dll/cpptoc/web_urlrequest_client_cpptoc.h"
 #include "libcef_dll/cpptoc/write_handler_cpptoc.h"
 #include "libcef_dll/ctocpp/browser_ctocpp.h"
+#include "libcef_dll/ctocpp/browser_pool_ctocpp.h"
 #include "libcef_dll/ctocpp/domdocument_ctocpp.h"
 #include "libcef_dll/ctocpp/domevent_ctocpp.h"
 #include "libcef_dll/ctocpp/domnode_ctocpp.h"
 #include "libcef_dll/ctocpp/post_data_ctocpp.h"
 #include "libcef_dll/ctocpp/post_data_element_ctocpp.h"
 #include "libcef_dll/ctocpp/request_ctocpp.h"
+#include "libcef_dll/ctocpp/request_context_ctocpp.h"
+#include "libcef_dll/ctocpp/sequenced_task_runner_ctocpp.h"
 #include "libcef_dll/ctocpp/stream_reader_ctocpp.h"
 #include "libcef_dll/ctocpp/stream_writer_ctocpp.h"
 #include "libcef_dll/ctocpp/v8value_ctocpp.h"
@@ -33,6 +40,7 @@
 #include "libcef_dll/ctocpp/web_urlrequest_ctocpp.h"
 #include "libcef_dll/ctocpp/xml_reader_ctocpp.h"
 #include "libcef_dll/ctocpp/zip_reader_ctocpp.h"
+#include "libcef_dll/transfer_util.h"
 
 
 bool CefInitialize(const CefSettings& settings)
@@ -47,10 +55,14 @@ void CefShutdown()
 #ifndef NDEBUG
   // Check that all wrapper objects have been destroyed
   DCHECK(CefContentFilterCppToC::DebugObjCt == 0);
+  DCHECK(CefCookieBatchVisitorCppToC::DebugObjCt == 0);
   DCHECK(CefCookieVisitorCppToC::DebugObjCt == 0);
   DCHECK(CefDOMEventListenerCppToC::DebugObjCt == 0);
   DCHECK(CefDOMVisitorCppToC::DebugObjCt == 0);
   DCHECK(CefDownloadHandlerCppToC::DebugObjCt == 0);
+  DCHECK(CefImageCaptureCallbackCppToC::DebugObjCt == 0);
+  DCHECK(CefLocalStorageVisitorCppToC::DebugObjCt == 0);
+  DCHECK(CefPageCaptureHandlerCppToC::DebugObjCt == 0);
   DCHECK(CefReadHandlerCppToC::DebugObjCt == 0);
   DCHECK(CefSchemeHandlerCppToC::DebugObjCt == 0);
   DCHECK(CefSchemeHandlerFactoryCppToC::DebugObjCt == 0);
@@ -59,12 +71,15 @@ void CefShutdown()
   DCHECK(CefWebURLRequestClientCppToC::DebugObjCt == 0);
   DCHECK(CefWriteHandlerCppToC::DebugObjCt == 0);
   DCHECK(CefBrowserCToCpp::DebugObjCt == 0);
+  DCHECK(CefBrowserPoolCToCpp::DebugObjCt == 0);
   DCHECK(CefDOMDocumentCToCpp::DebugObjCt == 0);
   DCHECK(CefDOMEventCToCpp::DebugObjCt == 0);
   DCHECK(CefDOMNodeCToCpp::DebugObjCt == 0);
   DCHECK(CefRequestCToCpp::DebugObjCt == 0);
+  DCHECK(CefRequestContextCToCpp::DebugObjCt == 0);
   DCHECK(CefPostDataCToCpp::DebugObjCt == 0);
   DCHECK(CefPostDataElementCToCpp::DebugObjCt == 0);
+  DCHECK(CefSequencedTaskRunnerCToCpp::DebugObjCt == 0);
   DCHECK(CefStreamReaderCToCpp::DebugObjCt == 0);
   DCHECK(CefStreamWriterCToCpp::DebugObjCt == 0);
   DCHECK(CefV8ContextCToCpp::DebugObjCt == 0);
@@ -75,11 +90,26 @@ void CefShutdown()
 #endif // !NDEBUG
 }
 
+bool CefFastShutdown(int timeout_ms, CefShutdownReport& report)
+{
+  return cef_fast_shutdown(timeout_ms, &report) ? true : false;
+}
+
 void CefDoMessageLoopWork()
 {
   cef_do_message_loop_work();
 }
 
+int CefGetMessageLoopWakeupFd()
+{
+  return cef_get_message_loop_wakeup_fd();
+}
+
+long CefGetMessageLoopWorkDelay()
+{
+  return cef_get_message_loop_work_delay();
+}
+
 void CefRunMessageLoop()
 {
   cef_run_message_loop();
@@ -167,6 +197,44 @@ bool CefPostDelayedTask(CefThreadId threadId, CefRefPtr<CefTask> task,
       true:false;
 }
 
+bool CefPostTasks(CefThreadId threadId,
+                  const std::vector<CefRefPtr<CefTask> >& tasks)
+{
+  std::vector<cef_task_t*> taskList;
+  taskList.reserve(tasks.size());
+  std::vector<CefRefPtr<CefTask> >::const_iterator it = tasks.begin();
+  for(; it != tasks.end(); ++it)
+    taskList.push_back(CefTaskCppToC::Wrap(*it));
+
+  return cef_post_tasks(threadId, taskList.size(),
+      taskList.empty() ? NULL : &taskList[0])?true:false;
+}
+
+bool CefGetThreadStats(CefThreadId threadId, CefThreadStats& stats)
+{
+  return cef_get_thread_stats(threadId, &stats) ? true : false;
+}
+
+void CefSetThreadStatsEnabled(bool enabled)
+{
+  cef_set_thread_stats_enabled(enabled);
+}
+
+bool CefBeginTracing()
+{
+  return cef_begin_tracing() ? true : false;
+}
+
+bool CefEndTracing(const CefString& tracing_file)
+{
+  return cef_end_tracing(tracing_file.GetStruct()) ? true : false;
+}
+
+bool CefGetStartupTimings(CefStartupTimings& timings)
+{
+  return cef_get_startup_timings(&timings) ? true : false;
+}
+
 bool CefParseURL(const CefString& url,
                  CefURLParts& parts)
 {
@@ -192,13 +260,111 @@ bool CefVisitUrlCookies(const CefString& url, bool includeHttpOnly,
       CefCookieVisitorCppToC::Wrap(visitor)) ? true : false;
 }
 
+bool CefVisitAllCookiesInBatches(int batchSize,
+                                 CefRefPtr<CefCookieBatchVisitor> visitor)
+{
+  return cef_visit_all_cookies_in_batches(batchSize,
+      CefCookieBatchVisitorCppToC::Wrap(visitor)) ? true : false;
+}
+
 bool CefSetCookie(const CefString& url, const CefCookie& cookie)
 {
   return cef_set_cookie(url.GetStruct(), &cookie) ? true : false;
 }
 
+bool CefSetCookies(const std::vector<CefCookie>& cookies)
+{
+  // Copy the values into a contiguous array of C structures. The strings are
+  // referenced without copying.
+  std::vector<cef_cookie_t> cookieList(cookies.begin(), cookies.end());
+  return cef_set_cookies(cookieList.size(),
+      cookieList.empty() ? NULL : &cookieList[0]) ? true : false;
+}
+
 bool CefDeleteCookies(const CefString& url, const CefString& cookie_name)
 {
   return cef_delete_cookies(url.GetStruct(), cookie_name.GetStruct()) ?
       true : false;
 }
+
+bool CefGetCookieStoreStats(CefCookieStoreStats& stats)
+{
+  return cef_get_cookie_store_stats(&stats) ? true : false;
+}
+
+bool CefFlushCookieStore(CefRefPtr<CefTask> completionTask)
+{
+  cef_task_t* completionTaskStruct = NULL;
+  if (completionTask.get())
+    completionTaskStruct = CefTaskCppToC::Wrap(completionTask);
+
+  return cef_flush_cookie_store(completionTaskStruct) ? true : false;
+}
+
+bool CefSaveCookies(const CefString& domain, CefRefPtr<CefStreamWriter> writer)
+{
+  return cef_save_cookies(domain.GetStruct(),
+      CefStreamWriterCToCpp::Unwrap(writer)) ? true : false;
+}
+
+bool CefRestoreCookies(CefRefPtr<CefStreamReader> reader)
+{
+  return cef_restore_cookies(CefStreamReaderCToCpp::Unwrap(reader)) ?
+      true : false;
+}
+
+bool CefVisitLocalStorage(const CefString& origin,
+                          CefRefPtr<CefLocalStorageVisitor> visitor)
+{
+  return cef_visit_local_storage(origin.GetStruct(),
+      CefLocalStorageVisitorCppToC::Wrap(visitor)) ? true : false;
+}
+
+bool CefSetLocalStorage(const CefString& origin,
+                        const CefLocalStorageItemMap& items, bool clear)
+{
+  cef_string_map_t map = NULL;
+  if (!items.empty()) {
+    map = cef_string_map_alloc();
+    if (!map)
+      return false;
+    transfer_string_map_contents(items, map);
+  }
+
+  bool ret = cef_set_local_storage(origin.GetStruct(), map, clear) ?
+      true : false;
+
+  if (map)
+    cef_string_map_free(map);
+
+  return ret;
+}
+
+bool CefGetHttpCacheStats(CefHttpCacheStats& stats)
+{
+  return cef_get_http_cache_stats(&stats) ? true : false;
+}
+
+bool CefPurgeHttpCache(const CefString& url_prefix, int max_age,
+                       CefRefPtr<CefTask> completionTask)
+{
+  cef_task_t* completionTaskStruct = NULL;
+  if (completionTask.get())
+    completionTaskStruct = CefTaskCppToC::Wrap(completionTask);
+
+  return cef_purge_http_cache(url_prefix.GetStruct(), max_age,
+      completionTaskStruct) ? true : false;
+}
+
+bool CefImportHttpCacheEntry(const CefString& url, const CefString& headers,
+                             CefRefPtr<CefStreamReader> data,
+                             CefRefPtr<CefTask> completionTask)
+{
+  cef_task_t* completionTaskStruct = NULL;
+  if (completionTask.get())
+    completionTaskStruct = CefTaskCppToC::Wrap(completionTask);
+
+  return cef_import_http_cache_entry(url.GetStruct(), headers.GetStruct(),
+      CefStreamReaderCToCpp::Unwrap(data), completionTaskStruct) ?
+      true : false;
+}
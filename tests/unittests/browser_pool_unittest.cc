@@ -0,0 +1,164 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "include/cef.h"
+#include "include/cef_runnable.h"
+#include "test_handler.h"
+
+// Only off-screen browsers can be pooled and they are not supported on Mac.
+#if !defined(OS_MACOSX)
+
+namespace {
+
+const char* kFirstUrl = "http://tests/pool_first.html";
+const char* kSecondUrl = "http://tests/pool_second.html";
+const char* kNextTenantUrl = "http://tests/pool_next.html";
+
+// Reports the history length and the sessionStorage value left by a previous
+// page using the document title.
+const char* kReportHtml =
+    "<html><body><script>"
+    "document.title = 'report:' + history.length + ':' +"
+    "    sessionStorage.getItem('tenant');"
+    "</script></body></html>";
+
+// A client of a browser taken from a CefBrowserPool. The first tenant
+// navigates twice, writes sessionStorage and returns the browser to the pool,
+// which immediately hands it to the next tenant.
+class PoolTenantHandler : public TestHandler
+{
+public:
+  PoolTenantHandler(CefRefPtr<CefBrowserPool>* pool,
+                    CefRefPtr<PoolTenantHandler> next_tenant)
+    : pool_(pool), next_tenant_(next_tenant), can_go_back_(false)
+  {
+    // Added here because the next tenant's browser is loaded before its
+    // RunTest() is called.
+    AddResource(kFirstUrl,
+        "<html><body><script>"
+        "sessionStorage.setItem('tenant', 'first');"
+        "</script></body></html>", "text/html");
+    AddResource(kSecondUrl, kReportHtml, "text/html");
+    AddResource(kNextTenantUrl, kReportHtml, "text/html");
+  }
+
+  virtual void RunTest() OVERRIDE
+  {
+    // The next tenant is started by the first tenant's handler.
+    if (next_tenant_.get())
+      CefPostTask(TID_UI, NewCefRunnableMethod(this, &PoolTenantHandler::Take));
+  }
+
+  virtual void OnLoadEnd(CefRefPtr<CefBrowser> browser,
+                         CefRefPtr<CefFrame> frame,
+                         int httpStatusCode) OVERRIDE
+  {
+    if (!frame->IsMain())
+      return;
+
+    std::string url = frame->GetURL();
+    if (url == kFirstUrl) {
+      frame->LoadURL(kSecondUrl);
+    } else if (url == kSecondUrl) {
+      can_go_back_ = browser->CanGoBack();
+      // Don't return the browser from inside the load callback.
+      CefPostTask(TID_UI,
+          NewCefRunnableMethod(this, &PoolTenantHandler::ReturnToPool));
+    } else if (url == kNextTenantUrl) {
+      can_go_back_ = browser->CanGoBack();
+      // Close the browser instead of returning it. The window handle of an
+      // off-screen browser can't be used by DestroyTest() on all platforms.
+      CefPostTask(TID_UI,
+          NewCefRunnableMethod(browser.get(), &CefBrowser::CloseBrowser));
+    }
+  }
+
+  virtual void OnTitleChange(CefRefPtr<CefBrowser> browser,
+                             const CefString& title) OVERRIDE
+  {
+    // The title is set while the page is parsed, before OnLoadEnd().
+    std::string titleStr = title;
+    if (titleStr.find("report:") == 0)
+      report_ = titleStr.substr(7);
+  }
+
+  // Take the first browser from the pool.
+  void Take()
+  {
+    CefWindowInfo windowInfo;
+    windowInfo.SetAsOffScreen(NULL);
+    *pool_ = CefBrowserPool::Create(windowInfo, 1, CefBrowserSettings());
+    ASSERT_TRUE(pool_->get());
+    EXPECT_EQ(1, (*pool_)->GetIdleCount());
+
+    taken_ = (*pool_)->TakeBrowser(this, kFirstUrl);
+    ASSERT_TRUE(taken_.get());
+    EXPECT_EQ(0, (*pool_)->GetIdleCount());
+  }
+
+  // Return the browser while the pool is empty so that it is scrubbed and kept
+  // instead of closed, and give it to the next tenant.
+  void ReturnToPool()
+  {
+    CefRefPtr<CefBrowserPool> pool = *pool_;
+
+    // Drain the refilled pool.
+    CefRefPtr<CefBrowser> other = pool->TakeBrowser(NULL, CefString());
+    ASSERT_TRUE(other.get());
+    EXPECT_EQ(0, pool->GetIdleCount());
+
+    EXPECT_TRUE(pool->ReturnBrowser(taken_));
+    EXPECT_EQ(1, pool->GetIdleCount());
+    // A browser can only be returned once.
+    EXPECT_FALSE(pool->ReturnBrowser(taken_));
+
+    CefRefPtr<CefBrowser> next = pool->TakeBrowser(next_tenant_.get(),
+                                                   kNextTenantUrl);
+    EXPECT_EQ(taken_.get(), next.get());
+    EXPECT_EQ(0, pool->GetIdleCount());
+
+    EXPECT_TRUE(pool->ReturnBrowser(other));
+    taken_ = NULL;
+  }
+
+  CefRefPtr<CefBrowserPool>* pool_;
+  CefRefPtr<PoolTenantHandler> next_tenant_;
+  CefRefPtr<CefBrowser> taken_;
+  bool can_go_back_;
+  std::string report_;
+};
+
+void UIT_ClosePool(CefRefPtr<CefBrowserPool> pool)
+{
+  pool->Close();
+}
+
+} // namespace
+
+// Verify that browsers are taken from and returned to the pool and that the
+// next tenant of a returned browser does not see the previous tenant's history
+// or sessionStorage.
+TEST(BrowserPoolTest, TakeAndReturn)
+{
+  CefRefPtr<CefBrowserPool> pool;
+  CefRefPtr<PoolTenantHandler> next_tenant =
+      new PoolTenantHandler(&pool, NULL);
+  CefRefPtr<PoolTenantHandler> first_tenant =
+      new PoolTenantHandler(&pool, next_tenant);
+
+  // Completes when the browser is returned to the pool.
+  first_tenant->ExecuteTest();
+  EXPECT_TRUE(first_tenant->can_go_back_);
+  EXPECT_EQ("2:first", first_tenant->report_);
+
+  // Completes when the next tenant closes the browser.
+  next_tenant->ExecuteTest();
+  EXPECT_FALSE(next_tenant->can_go_back_);
+  EXPECT_EQ("1:null", next_tenant->report_);
+
+  ASSERT_TRUE(pool.get());
+  CefPostTask(TID_UI, NewCefRunnableFunction(UIT_ClosePool, pool));
+}
+
+#endif  // !defined(OS_MACOSX)
@@ -0,0 +1,285 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "include/cef.h"
+#include "include/cef_runnable.h"
+#include "test_handler.h"
+#include <stdlib.h>
+
+namespace {
+
+const char* kHiddenUrl = "http://tests/hidden.html";
+
+// Hides the browser after it loads and shows it again after a delay. The page
+// reports its visibility state and the number of 10ms interval timer callbacks
+// that ran while it was hidden using the document title.
+class HiddenTestHandler : public TestHandler
+{
+public:
+  HiddenTestHandler() : hidden_ticks_(-1) {}
+
+  virtual void RunTest() OVERRIDE
+  {
+    std::string html =
+        "<html><body><script>"
+        "var ticks = 0;"
+        "setInterval(function() { ticks++; }, 10);"
+        "document.addEventListener('webkitvisibilitychange', function() {"
+        "  if (document.webkitHidden) {"
+        "    ticks = 0;"
+        "    document.title = 'hidden';"
+        "  } else {"
+        "    document.title = 'visible:' + ticks;"
+        "  }"
+        "}, false);"
+        "</script></body></html>";
+    AddResource(kHiddenUrl, html, "text/html");
+    CreateBrowser(kHiddenUrl);
+  }
+
+  virtual void OnLoadEnd(CefRefPtr<CefBrowser> browser,
+                         CefRefPtr<CefFrame> frame,
+                         int httpStatusCode) OVERRIDE
+  {
+    if (!frame->IsMain())
+      return;
+
+    EXPECT_FALSE(browser->IsHidden());
+    browser->WasHidden(true);
+    EXPECT_TRUE(browser->IsHidden());
+  }
+
+  virtual void OnTitleChange(CefRefPtr<CefBrowser> browser,
+                             const CefString& title) OVERRIDE
+  {
+    std::string titleStr = title;
+    if (titleStr == "hidden") {
+      got_hidden_.yes();
+      // Stay hidden long enough for an unthrottled timer to run ~50 times.
+      CefPostDelayedTask(TID_UI,
+          NewCefRunnableMethod(this, &HiddenTestHandler::Show), 500);
+    } else if (titleStr.find("visible:") == 0) {
+      got_visible_.yes();
+      hidden_ticks_ = atoi(titleStr.substr(8).c_str());
+      DestroyTest();
+    }
+  }
+
+  void Show()
+  {
+    GetBrowser()->WasHidden(false);
+    EXPECT_FALSE(GetBrowser()->IsHidden());
+  }
+
+  TrackCallback got_hidden_;
+  TrackCallback got_visible_;
+  int hidden_ticks_;
+};
+
+const char* kInputUrl = "http://tests/input.html";
+
+// Sends a sequence of input events in a single UI thread task and verifies the
+// events seen by the page. The page records each event and reports the log
+// using the document title.
+class InputTestHandler : public TestHandler
+{
+public:
+  explicit InputTestHandler(bool batched) : batched_(batched) {}
+
+  virtual void RunTest() OVERRIDE
+  {
+    std::string html =
+        "<html><body style=\"margin:0;width:100px;height:100px\"><script>"
+        "var log = [];"
+        "var wheels = [];"
+        "document.addEventListener('mousemove', function(e) {"
+        "  log.push('m' + e.clientX); }, false);"
+        "document.addEventListener('mousedown', function(e) {"
+        "  log.push('d'); }, false);"
+        "document.addEventListener('mouseup', function(e) {"
+        "  log.push('u'); }, false);"
+        "document.addEventListener('mousewheel', function(e) {"
+        "  log.push('w'); wheels.push(e.wheelDelta); }, false);"
+        "document.addEventListener('keypress', function(e) {"
+        "  log.push('k' + e.charCode); }, false);"
+        "function report() {"
+        "  document.title = 'log:' + log.join(',') + '|' +"
+        "      (wheels.length == 2 && wheels[0] == 2 * wheels[1]);"
+        "}"
+        "</script></body></html>";
+    AddResource(kInputUrl, html, "text/html");
+    CreateBrowser(kInputUrl);
+  }
+
+  virtual void OnLoadEnd(CefRefPtr<CefBrowser> browser,
+                         CefRefPtr<CefFrame> frame,
+                         int httpStatusCode) OVERRIDE
+  {
+    if (!frame->IsMain())
+      return;
+
+#if defined(OS_LINUX)
+    // Windowless browsers have no size until one is set.
+    browser->SetSize(PET_VIEW, 100, 100);
+#endif
+
+    CefPostTask(TID_UI,
+        NewCefRunnableMethod(this, &InputTestHandler::SendEvents));
+  }
+
+  void SendEvents()
+  {
+    std::vector<CefInputEvent> events;
+    AddFocus(events);
+    AddMove(events, 10);
+    AddMove(events, 20);
+    AddMove(events, 30);
+    AddClick(events, 30, false);
+    AddClick(events, 30, true);
+    AddMove(events, 40);
+    AddMove(events, 50);
+    AddWheel(events, 50);
+    AddWheel(events, 50);
+    AddKey(events, 'a');
+    AddKey(events, 'b');
+    AddWheel(events, 50);
+    AddMove(events, 60);
+
+    CefRefPtr<CefBrowser> browser = GetBrowser();
+    if (batched_) {
+      browser->SendInputEvents(events);
+    } else {
+      for (size_t i = 0; i < events.size(); ++i) {
+        const CefInputEvent& event = events[i];
+        switch (event.type) {
+          case IET_FOCUS:
+            browser->SendFocusEvent(event.set_focus);
+            break;
+          case IET_MOUSE_MOVE:
+            browser->SendMouseMoveEvent(event.x, event.y, event.mouse_leave);
+            break;
+          case IET_MOUSE_CLICK:
+            browser->SendMouseClickEvent(event.x, event.y, event.button_type,
+                                         event.mouse_up, event.click_count);
+            break;
+          case IET_MOUSE_WHEEL:
+            browser->SendMouseWheelEvent(event.x, event.y, event.delta);
+            break;
+          case IET_KEY:
+            browser->SendKeyEvent(event.key_type, event.key, event.modifiers,
+                                  event.sys_char, event.ime_char);
+            break;
+          default:
+            break;
+        }
+      }
+    }
+
+    // Runs after the events have been dispatched.
+    browser->GetMainFrame()->ExecuteJavaScript("report();", kInputUrl, 0);
+  }
+
+  virtual void OnTitleChange(CefRefPtr<CefBrowser> browser,
+                             const CefString& title) OVERRIDE
+  {
+    std::string titleStr = title;
+    if (titleStr.find("log:") == 0) {
+      log_ = titleStr.substr(4);
+      DestroyTest();
+    }
+  }
+
+  std::string log_;
+
+private:
+  static void AddFocus(std::vector<CefInputEvent>& events)
+  {
+    CefInputEvent event;
+    event.type = IET_FOCUS;
+    event.set_focus = true;
+    events.push_back(event);
+  }
+
+  static void AddMove(std::vector<CefInputEvent>& events, int pos)
+  {
+    CefInputEvent event;
+    event.type = IET_MOUSE_MOVE;
+    event.x = pos;
+    event.y = pos;
+    events.push_back(event);
+  }
+
+  static void AddClick(std::vector<CefInputEvent>& events, int pos,
+                       bool mouseUp)
+  {
+    CefInputEvent event;
+    event.type = IET_MOUSE_CLICK;
+    event.x = pos;
+    event.y = pos;
+    event.button_type = MBT_LEFT;
+    event.mouse_up = mouseUp;
+    event.click_count = 1;
+    events.push_back(event);
+  }
+
+  static void AddWheel(std::vector<CefInputEvent>& events, int pos)
+  {
+    CefInputEvent event;
+    event.type = IET_MOUSE_WHEEL;
+    event.x = pos;
+    event.y = pos;
+    event.delta = 120;
+    events.push_back(event);
+  }
+
+  static void AddKey(std::vector<CefInputEvent>& events, int key)
+  {
+    CefInputEvent event;
+    event.type = IET_KEY;
+    event.key_type = KT_CHAR;
+    event.key = key;
+    events.push_back(event);
+  }
+
+  bool batched_;
+};
+
+// Consecutive moves are replaced by the last one and consecutive wheel events
+// are summed. Clicks and keys are never merged or reordered.
+const char* kExpectedInputLog = "m30,d,u,m50,w,k97,k98,w,m60|true";
+
+} // namespace
+
+// Verify that hidden browsers report the hidden visibility state to the page
+// and throttle JavaScript timers.
+TEST(BrowserTest, WasHidden)
+{
+  CefRefPtr<HiddenTestHandler> handler = new HiddenTestHandler();
+  handler->ExecuteTest();
+
+  EXPECT_TRUE(handler->got_hidden_);
+  EXPECT_TRUE(handler->got_visible_);
+  // Timers are clamped to one second while hidden.
+  EXPECT_GE(handler->hidden_ticks_, 0);
+  EXPECT_LE(handler->hidden_ticks_, 2);
+}
+
+// Verify that input events sent with SendInputEvents() are coalesced.
+TEST(BrowserTest, SendInputEventsCoalesced)
+{
+  CefRefPtr<InputTestHandler> handler = new InputTestHandler(true);
+  handler->ExecuteTest();
+
+  EXPECT_EQ(kExpectedInputLog, handler->log_);
+}
+
+// Verify that individually sent input events that are waiting to be
+// dispatched are coalesced in the same way.
+TEST(BrowserTest, SendEventsCoalesced)
+{
+  CefRefPtr<InputTestHandler> handler = new InputTestHandler(false);
+  handler->ExecuteTest();
+
+  EXPECT_EQ(kExpectedInputLog, handler->log_);
+}
@@ -15,7 +15,8 @@ bool g_ContentFilterDrainCalled;
 class TestContentFilter : public CefContentFilter
 {
 public:
-    TestContentFilter()
+    explicit TestContentFilter(bool use_worker_thread)
+      : use_worker_thread_(use_worker_thread)
     {
       look_for_ = "FAILURE!";
       replace_with_ = "BIG SUCCESS!";
@@ -25,7 +26,7 @@ public:
                              CefRefPtr<CefStreamReader>& substitute_data)
                              OVERRIDE
     {
-      EXPECT_TRUE(CefCurrentlyOn(TID_UI));
+      ExpectFilterThread();
 
       g_ContentFilterProcessDataCalled = true;
 
@@ -96,7 +97,7 @@ public:
 
     virtual void Drain(CefRefPtr<CefStreamReader>& remainder) OVERRIDE
     {
-        EXPECT_TRUE(CefCurrentlyOn(TID_UI));
+        ExpectFilterThread();
       
         g_ContentFilterDrainCalled = true;
 
@@ -107,10 +108,27 @@ public:
                                                    remainder_.size());
     }
 
+    virtual bool UseWorkerThread() OVERRIDE
+    {
+        EXPECT_TRUE(CefCurrentlyOn(TID_UI));
+        return use_worker_thread_;
+    }
+
 protected:
     IMPLEMENT_REFCOUNTING(TestContentFilter);
 
 private:
+    void ExpectFilterThread()
+    {
+        if (use_worker_thread_) {
+          EXPECT_TRUE(CefCurrentlyOn(TID_WORKER));
+          EXPECT_FALSE(CefCurrentlyOn(TID_UI));
+        } else {
+          EXPECT_TRUE(CefCurrentlyOn(TID_UI));
+        }
+    }
+
+    bool use_worker_thread_;
     std::string look_for_;
     std::string replace_with_;
     std::string remainder_;
@@ -151,7 +169,8 @@ public:
     IMPLEMENT_REFCOUNTING(Visitor);
  };
 
-  ContentFilterTestHandler()
+  explicit ContentFilterTestHandler(bool use_worker_thread)
+    : use_worker_thread_(use_worker_thread)
   {
     visitor_ = new Visitor(this);
   }
@@ -188,7 +207,7 @@ public:
     ASSERT_EQ(status_code, 200);
     ASSERT_EQ(status_text, "OK");
 
-    filter = new TestContentFilter();
+    filter = new TestContentFilter(use_worker_thread_);
   }
 
   virtual void OnLoadEnd(CefRefPtr<CefBrowser> browser,
@@ -206,6 +225,7 @@ public:
   TrackCallback got_visitor_called_;
 
 private:
+  bool use_worker_thread_;
   CefRefPtr<Visitor> visitor_;
 };
 
@@ -219,7 +239,24 @@ TEST(ContentFilterTest, ContentFilter)
   g_ContentFilterDrainCalled = false;
 
   CefRefPtr<ContentFilterTestHandler> handler =
-      new ContentFilterTestHandler();
+      new ContentFilterTestHandler(false);
+  handler->ExecuteTest();
+
+  ASSERT_TRUE(handler->got_visitor_called_);
+  ASSERT_TRUE(g_ContentFilterTestHandlerHandleResourceResponseCalled);
+  ASSERT_TRUE(g_ContentFilterProcessDataCalled);
+  ASSERT_TRUE(g_ContentFilterDrainCalled);
+}
+
+// Verify that a filter that opts in to the WORKER pool is called there.
+TEST(ContentFilterTest, ContentFilterWorkerThread)
+{
+  g_ContentFilterTestHandlerHandleResourceResponseCalled = false;
+  g_ContentFilterProcessDataCalled = false;
+  g_ContentFilterDrainCalled = false;
+
+  CefRefPtr<ContentFilterTestHandler> handler =
+      new ContentFilterTestHandler(true);
   handler->ExecuteTest();
 
   ASSERT_TRUE(handler->got_visitor_called_);
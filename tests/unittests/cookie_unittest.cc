@@ -4,8 +4,16 @@
 
 #include "include/cef.h"
 #include "include/cef_runnable.h"
+#include "base/environment.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/pickle.h"
+#include "base/string_number_conversions.h"
 #include "base/synchronization/waitable_event.h"
+#include "base/time.h"
 #include "testing/gtest/include/gtest/gtest.h"
+#include "test_handler.h"
+#include "test_suite.h"
+#include <stdlib.h>
 #include <vector>
 
 namespace {
@@ -32,6 +40,12 @@ void IOT_Delete(const CefString& url, const CefString& cookie_name,
   event->Signal();
 }
 
+void FILE_Signal(base::WaitableEvent* event)
+{
+  EXPECT_TRUE(CefCurrentlyOn(TID_FILE));
+  event->Signal();
+}
+
 class TestVisitor : public CefCookieVisitor
 {
 public:
@@ -61,6 +75,166 @@ public:
   IMPLEMENT_REFCOUNTING(TestVisitor);
 };
 
+class TestBatchVisitor : public CefCookieBatchVisitor
+{
+public:
+  TestBatchVisitor(CookieVector* cookies, std::vector<int>* offsets,
+                   base::WaitableEvent* event)
+    : cookies_(cookies), offsets_(offsets), event_(event)
+  {
+  }
+  virtual ~TestBatchVisitor()
+  {
+    event_->Signal();
+  }
+
+  virtual bool Visit(const std::vector<CefCookie>& cookies, int offset,
+                     int total)
+  {
+    EXPECT_EQ(static_cast<int>(cookies_->size()), offset);
+    cookies_->insert(cookies_->end(), cookies.begin(), cookies.end());
+    offsets_->push_back(offset);
+    return true;
+  }
+
+  CookieVector* cookies_;
+  std::vector<int>* offsets_;
+  base::WaitableEvent* event_;
+
+  IMPLEMENT_REFCOUNTING(TestBatchVisitor);
+};
+
+// Counts the visited cookies.
+class CountVisitor : public CefCookieVisitor
+{
+public:
+  CountVisitor(int* count, int* total, base::WaitableEvent* event)
+    : count_(count), total_(total), event_(event)
+  {
+    *count_ = 0;
+    *total_ = 0;
+  }
+  virtual ~CountVisitor()
+  {
+    event_->Signal();
+  }
+
+  virtual bool Visit(const CefCookie& cookie, int count, int total,
+                     bool& deleteCookie)
+  {
+    EXPECT_EQ(*count_, count);
+    (*count_)++;
+    *total_ = total;
+    return true;
+  }
+
+  int* count_;
+  int* total_;
+  base::WaitableEvent* event_;
+
+  IMPLEMENT_REFCOUNTING(CountVisitor);
+};
+
+// Collects the data written to a stream.
+class StringWriteHandler : public CefWriteHandler
+{
+public:
+  StringWriteHandler(std::string* data) : data_(data) {}
+
+  virtual size_t Write(const void* ptr, size_t size, size_t n)
+  {
+    data_->append(static_cast<const char*>(ptr), size * n);
+    return n;
+  }
+  virtual int Seek(long offset, int whence) { return -1; }
+  virtual long Tell() { return static_cast<long>(data_->size()); }
+  virtual int Flush() { return 0; }
+
+private:
+  std::string* data_;
+
+  IMPLEMENT_REFCOUNTING(StringWriteHandler);
+};
+
+void IOT_Save(const CefString& domain, std::string* data,
+              base::WaitableEvent* event)
+{
+  EXPECT_TRUE(CefSaveCookies(domain,
+      CefStreamWriter::CreateForHandler(new StringWriteHandler(data))));
+  event->Signal();
+}
+
+void IOT_Restore(std::string* data, bool expected,
+                 base::WaitableEvent* event)
+{
+  EXPECT_EQ(expected, CefRestoreCookies(
+      CefStreamReader::CreateForData((void*)data->data(), data->size())));
+  event->Signal();
+}
+
+const char* kCacheMainUrl = "http://www.cachetest.com/main.html";
+const char* kCacheFrameUrl = "http://sub.cachetest.com/frame.html";
+
+// Reads document.cookie immediately after writing it so that the reads are
+// answered by the UI thread cookie cache before the IO thread reports the
+// change. The frame shares the main page's document.domain so that its
+// cookies can be read synchronously. The results are reported using the
+// document title.
+class CookieCacheTestHandler : public TestHandler
+{
+public:
+  CookieCacheTestHandler() {}
+
+  virtual void RunTest() OVERRIDE
+  {
+    std::string mainHtml =
+        "<html><body>"
+        "<iframe src=\"" + std::string(kCacheFrameUrl) + "\" "
+        "    onload=\"run()\"></iframe>"
+        "<script>"
+        "document.domain = 'cachetest.com';"
+        "function has(line, cookie) {"
+        "  return (' ' + line + ';').indexOf(' ' + cookie + ';') >= 0;"
+        "}"
+        "function run() {"
+        "  var frame = frames[0];"
+        "  document.cookie = 'a=1';"
+        "  var readAfterWrite = has(document.cookie, 'a=1');"
+        "  var before = has(frame.readCookie(), 'b=2');"
+        "  document.cookie = 'b=2; domain=.cachetest.com';"
+        "  var parentDomain = !before && has(frame.readCookie(), 'b=2');"
+        "  document.cookie = 'c=3; max-age=1';"
+        "  var beforeExpiry = has(document.cookie, 'c=3');"
+        "  setTimeout(function() {"
+        "    var expired = beforeExpiry && !has(document.cookie, 'c=3');"
+        "    document.title = 'result:' + readAfterWrite + ',' +"
+        "        parentDomain + ',' + expired;"
+        "  }, 1500);"
+        "}"
+        "</script></body></html>";
+    std::string frameHtml =
+        "<html><body><script>"
+        "document.domain = 'cachetest.com';"
+        "function readCookie() { return document.cookie; }"
+        "</script></body></html>";
+    AddResource(kCacheMainUrl, mainHtml, "text/html");
+    AddResource(kCacheFrameUrl, frameHtml, "text/html");
+    CreateBrowser(kCacheMainUrl);
+  }
+
+  virtual void OnTitleChange(CefRefPtr<CefBrowser> browser,
+                             const CefString& title) OVERRIDE
+  {
+    std::string titleStr = title;
+    if (titleStr.find("result:") == 0) {
+      result_ = titleStr.substr(7);
+      DestroyTest();
+    }
+  }
+
+  std::string result_;
+};
+
 } // anonymous
 
 // Test creation of a domain cookie.
@@ -375,3 +549,363 @@ TEST(CookieTest, AllCookies)
 
   EXPECT_EQ((CookieVector::size_type)0, cookies.size());
 }
+
+// Test import of multiple cookies and visiting cookies in batches.
+TEST(CookieTest, BatchedCookies)
+{
+  base::WaitableEvent event(false, false);
+  CookieVector cookies;
+  std::vector<int> offsets;
+
+  // Delete all system cookies just in case something is left over from a
+  // different test.
+  CefPostTask(TID_IO, NewCefRunnableFunction(IOT_Delete, CefString(),
+                                             CefString(), &event));
+  event.Wait();
+
+  // Import 5 host cookies for 2 hosts. The import is performed on the IO
+  // thread before the visitor runs.
+  for (int i = 0; i < 5; ++i) {
+    CefCookie cookie;
+    CefString(&cookie.name).FromString(
+        std::string("my_cookie") + static_cast<char>('0' + i));
+    CefString(&cookie.value).FromASCII("My Value");
+    CefString(&cookie.domain).FromASCII(i < 3 ? "www.foo.com" : "www.bar.com");
+    CefString(&cookie.path).FromASCII("/");
+    cookies.push_back(cookie);
+  }
+  EXPECT_TRUE(CefSetCookies(cookies));
+  cookies.clear();
+
+  // Importing no cookies succeeds.
+  EXPECT_TRUE(CefSetCookies(cookies));
+
+  // Domain cookies for a public suffix or an IP address and cookies with
+  // disallowed characters are skipped. A batch that is entirely skipped fails.
+  const char* kInvalidDomains[] =
+      {".com", ".co.uk", ".127.0.0.1", "www.foo.com"};
+  for (int i = 0; i < 4; ++i) {
+    CefCookie cookie;
+    CefString(&cookie.name).FromASCII(i < 3 ? "bad_cookie" : "bad;cookie");
+    CefString(&cookie.value).FromASCII("My Value");
+    CefString(&cookie.domain).FromASCII(kInvalidDomains[i]);
+    CefString(&cookie.path).FromASCII("/");
+    cookies.push_back(cookie);
+  }
+  EXPECT_FALSE(CefSetCookies(cookies));
+  cookies.clear();
+
+  // Visit the cookies in batches of 2.
+  EXPECT_TRUE(CefVisitAllCookiesInBatches(2,
+      new TestBatchVisitor(&cookies, &offsets, &event)));
+  event.Wait();
+
+  EXPECT_EQ((CookieVector::size_type)5, cookies.size());
+  EXPECT_EQ((std::vector<int>::size_type)3, offsets.size());
+  EXPECT_EQ(0, offsets[0]);
+  EXPECT_EQ(2, offsets[1]);
+  EXPECT_EQ(4, offsets[2]);
+  cookies.clear();
+
+  // Verify that the imported cookies can be retrieved by URL.
+  EXPECT_TRUE(CefVisitUrlCookies("http://www.foo.com", false,
+      new TestVisitor(&cookies, false, &event)));
+  event.Wait();
+
+  EXPECT_EQ((CookieVector::size_type)3, cookies.size());
+  EXPECT_EQ(CefString(&cookies[0].domain), "www.foo.com");
+  cookies.clear();
+
+  // Verify that the domain of an imported cookie is canonicalized.
+  CefCookie cookie;
+  CefString(&cookie.name).FromASCII("my_cookie5");
+  CefString(&cookie.value).FromASCII("My Value");
+  CefString(&cookie.domain).FromASCII(".Bar.COM");
+  CefString(&cookie.path).FromASCII("/");
+  cookies.push_back(cookie);
+  EXPECT_TRUE(CefSetCookies(cookies));
+  cookies.clear();
+
+  EXPECT_TRUE(CefVisitUrlCookies("http://www.bar.com", false,
+      new TestVisitor(&cookies, false, &event)));
+  event.Wait();
+
+  EXPECT_EQ((CookieVector::size_type)3, cookies.size());
+  bool found = false;
+  for (size_t i = 0; i < cookies.size(); ++i) {
+    if (CefString(&cookies[i].name) == "my_cookie5") {
+      EXPECT_EQ(CefString(&cookies[i].domain), ".bar.com");
+      found = true;
+    }
+  }
+  EXPECT_TRUE(found);
+  cookies.clear();
+
+  // Delete all of the system cookies.
+  CefPostTask(TID_IO, NewCefRunnableFunction(IOT_Delete, CefString(),
+                                             CefString(), &event));
+  event.Wait();
+}
+
+// Test saving and restoring a snapshot of the cookies for a domain.
+TEST(CookieTest, SnapshotCookies)
+{
+  base::WaitableEvent event(false, false);
+  CookieVector cookies;
+  std::string snapshot;
+
+  // Delete all system cookies just in case something is left over from a
+  // different test.
+  CefPostTask(TID_IO, NewCefRunnableFunction(IOT_Delete, CefString(),
+                                             CefString(), &event));
+  event.Wait();
+
+  // Import 2 cookies for a domain and its subdomain and 1 cookie for a
+  // different domain.
+  const char* kDomains[] = {"foo.com", "www.foo.com", "www.bar.com"};
+  for (int i = 0; i < 3; ++i) {
+    CefCookie cookie;
+    CefString(&cookie.name).FromString(
+        std::string("my_cookie") + static_cast<char>('0' + i));
+    CefString(&cookie.value).FromASCII("My Value");
+    CefString(&cookie.domain).FromASCII(kDomains[i]);
+    CefString(&cookie.path).FromASCII("/");
+    cookie.httponly = true;
+    cookies.push_back(cookie);
+  }
+  EXPECT_TRUE(CefSetCookies(cookies));
+  cookies.clear();
+
+  // Save the cookies for the domain.
+  CefPostTask(TID_IO, NewCefRunnableFunction(IOT_Save, CefString("foo.com"),
+                                             &snapshot, &event));
+  event.Wait();
+  EXPECT_FALSE(snapshot.empty());
+
+  // Replace the cookies for the domain.
+  CefPostTask(TID_IO, NewCefRunnableFunction(IOT_Delete,
+      CefString("http://www.foo.com"), CefString(), &event));
+  event.Wait();
+
+  CefCookie cookie;
+  CefString(&cookie.name).FromASCII("my_cookie3");
+  CefString(&cookie.value).FromASCII("My Value");
+  CefString(&cookie.domain).FromASCII("www.foo.com");
+  CefString(&cookie.path).FromASCII("/");
+  cookies.push_back(cookie);
+  EXPECT_TRUE(CefSetCookies(cookies));
+  cookies.clear();
+
+  // Restore the snapshot. The cookies for the other domain are not changed.
+  CefPostTask(TID_IO, NewCefRunnableFunction(IOT_Restore, &snapshot, true,
+                                             &event));
+  event.Wait();
+
+  EXPECT_TRUE(CefVisitAllCookies(new TestVisitor(&cookies, false, &event)));
+  event.Wait();
+
+  EXPECT_EQ((CookieVector::size_type)3, cookies.size());
+  for (size_t i = 0; i < cookies.size(); ++i) {
+    EXPECT_NE(CefString(&cookies[i].name), "my_cookie3");
+    EXPECT_TRUE(cookies[i].httponly);
+  }
+  cookies.clear();
+
+  // An invalid snapshot leaves the cookies unchanged.
+  std::string invalid = snapshot.substr(0, snapshot.size() / 2);
+  CefPostTask(TID_IO, NewCefRunnableFunction(IOT_Restore, &invalid, false,
+                                             &event));
+  event.Wait();
+
+  EXPECT_TRUE(CefVisitAllCookies(new TestVisitor(&cookies, false, &event)));
+  event.Wait();
+  EXPECT_EQ((CookieVector::size_type)3, cookies.size());
+  cookies.clear();
+
+  // A snapshot for a domain that contains a cookie for a different domain is
+  // rejected. The format matches the version 1 snapshots written by
+  // CefSaveCookies().
+  Pickle pickle;
+  pickle.WriteInt(1);
+  pickle.WriteString("foo.com");
+  pickle.WriteInt(1);
+  pickle.WriteString("my_cookie4");
+  pickle.WriteString("My Value");
+  pickle.WriteString("www.bar.com");
+  pickle.WriteString("/");
+  pickle.WriteInt64(base::Time::Now().ToInternalValue());
+  pickle.WriteInt64(0);
+  pickle.WriteInt64(base::Time::Now().ToInternalValue());
+  pickle.WriteBool(false);
+  pickle.WriteBool(false);
+  pickle.WriteBool(false);
+  std::string mismatched(static_cast<const char*>(pickle.data()),
+                         pickle.size());
+  CefPostTask(TID_IO, NewCefRunnableFunction(IOT_Restore, &mismatched, false,
+                                             &event));
+  event.Wait();
+
+  EXPECT_TRUE(CefVisitAllCookies(new TestVisitor(&cookies, false, &event)));
+  event.Wait();
+  EXPECT_EQ((CookieVector::size_type)3, cookies.size());
+  cookies.clear();
+
+  // Delete all of the system cookies.
+  CefPostTask(TID_IO, NewCefRunnableFunction(IOT_Delete, CefString(),
+                                             CefString(), &event));
+  event.Wait();
+}
+
+namespace {
+
+// Runs in the death test child process that CookieTest.LazyLoadedCookies
+// starts with cookies loaded on demand. Failures are reported with the exit
+// code.
+void LazyLoadedCookiesAndExit()
+{
+  base::WaitableEvent event(false, false);
+  CookieVector cookies;
+  int count, total;
+
+  // Delete all system cookies just in case something is left over from a
+  // different test.
+  CefPostTask(TID_IO, NewCefRunnableFunction(IOT_Delete, CefString(),
+                                             CefString(), &event));
+  event.Wait();
+
+  // Import 10 cookies for each of 350 domains. This is more than the 3300
+  // cookies that the cookie monster keeps before deleting the oldest.
+  const int kDomainCount = 350;
+  const int kCookiesPerDomain = 10;
+  for (int i = 0; i < kDomainCount; ++i) {
+    std::string domain = "www.lazy" + base::IntToString(i) + ".com";
+    for (int j = 0; j < kCookiesPerDomain; ++j) {
+      CefCookie cookie;
+      CefString(&cookie.name).FromString("my_cookie" + base::IntToString(j));
+      CefString(&cookie.value).FromASCII("My Value");
+      CefString(&cookie.domain).FromString(domain);
+      CefString(&cookie.path).FromASCII("/");
+      cookies.push_back(cookie);
+    }
+  }
+  EXPECT_TRUE(CefSetCookies(cookies));
+  cookies.clear();
+
+  // Verify that no cookie was lost when the least recently used domains were
+  // released from memory.
+  EXPECT_TRUE(CefVisitAllCookies(new CountVisitor(&count, &total, &event)));
+  event.Wait();
+  EXPECT_EQ(kDomainCount * kCookiesPerDomain, count);
+  EXPECT_EQ(kDomainCount * kCookiesPerDomain, total);
+
+  // Verify that the batches are filled across the domains read from the
+  // database.
+  std::vector<int> offsets;
+  EXPECT_TRUE(CefVisitAllCookiesInBatches(256,
+      new TestBatchVisitor(&cookies, &offsets, &event)));
+  event.Wait();
+  EXPECT_EQ(static_cast<size_t>(kDomainCount * kCookiesPerDomain),
+            cookies.size());
+  ASSERT_EQ(static_cast<size_t>(14), offsets.size());
+  for (size_t i = 0; i < offsets.size(); ++i)
+    EXPECT_EQ(static_cast<int>(i) * 256, offsets[i]);
+  cookies.clear();
+
+  // Verify that the cookies for a released domain are read again.
+  EXPECT_TRUE(CefVisitUrlCookies("http://www.lazy0.com", false,
+      new TestVisitor(&cookies, false, &event)));
+  event.Wait();
+  EXPECT_EQ(static_cast<size_t>(kCookiesPerDomain), cookies.size());
+  cookies.clear();
+
+  // Delete all of the system cookies, including those that are not in memory.
+  CefPostTask(TID_IO, NewCefRunnableFunction(IOT_Delete, CefString(),
+                                             CefString(), &event));
+  event.Wait();
+
+  EXPECT_TRUE(CefVisitAllCookies(new CountVisitor(&count, &total, &event)));
+  event.Wait();
+  EXPECT_EQ(0, count);
+
+  EXPECT_TRUE(CefVisitUrlCookies("http://www.lazy0.com", false,
+      new TestVisitor(&cookies, false, &event)));
+  event.Wait();
+  EXPECT_EQ((CookieVector::size_type)0, cookies.size());
+}
+
+} // namespace
+
+// Test import and visiting of more cookies than the lazy cookie store keeps in
+// memory.
+TEST(CookieTest, LazyLoadedCookies)
+{
+  // The rest of the suite uses the default cookie load mode, so re-run the
+  // test executable with cookies loaded on demand. The child process also
+  // gets its own cache directory.
+  scoped_ptr<base::Environment> env(base::Environment::Create());
+  ASSERT_TRUE(env->SetVar(kCookieLoadOnDemandVar, "1"));
+  testing::GTEST_FLAG(death_test_style) = "threadsafe";
+  EXPECT_EXIT({
+    LazyLoadedCookiesAndExit();
+    exit(testing::Test::HasFailure() ? 1 : 0);
+  }, testing::ExitedWithCode(0), "");
+  env->UnSetVar(kCookieLoadOnDemandVar);
+}
+
+// Test that flushing the cookie store commits pending changes.
+TEST(CookieTest, FlushCookieStore)
+{
+  base::WaitableEvent event(false, false);
+  CookieVector cookies;
+
+  CefCookieStoreStats before;
+  EXPECT_TRUE(CefGetCookieStoreStats(before));
+
+  CefCookie cookie;
+  CefString(&cookie.name).FromASCII("my_cookie");
+  CefString(&cookie.value).FromASCII("My Value");
+  cookies.push_back(cookie);
+  CefPostTask(TID_IO, NewCefRunnableFunction(IOT_Set, kTestUrl, &cookies,
+                                             &event));
+  event.Wait();
+  cookies.clear();
+
+  EXPECT_TRUE(CefFlushCookieStore(NewCefRunnableFunction(FILE_Signal,
+                                                         &event)));
+  event.Wait();
+
+  CefCookieStoreStats after;
+  EXPECT_TRUE(CefGetCookieStoreStats(after));
+  EXPECT_GT(after.commit_count, 0);
+  EXPECT_GT(after.committed_operations, before.committed_operations);
+
+  // Delete all of the system cookies.
+  CefPostTask(TID_IO, NewCefRunnableFunction(IOT_Delete, CefString(),
+                                             CefString(), &event));
+  event.Wait();
+}
+
+// Test that document.cookie reads served from the cookie cache see writes
+// from the same page and from other hosts of the same domain, and that
+// cached cookies expire.
+TEST(CookieTest, CookieCache)
+{
+  base::WaitableEvent event(false, false);
+
+  // Delete all system cookies just in case something is left over from a
+  // different test.
+  CefPostTask(TID_IO, NewCefRunnableFunction(IOT_Delete, CefString(),
+                                             CefString(), &event));
+  event.Wait();
+
+  CefRefPtr<CookieCacheTestHandler> handler = new CookieCacheTestHandler();
+  handler->ExecuteTest();
+
+  // Read after write, parent domain write and expiry.
+  EXPECT_EQ("true,true,true", handler->result_);
+
+  // Delete all of the system cookies.
+  CefPostTask(TID_IO, NewCefRunnableFunction(IOT_Delete, CefString(),
+                                             CefString(), &event));
+  event.Wait();
+}
@@ -0,0 +1,58 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "libcef/http_cache_size.h"
+#include "base/memory/ref_counted.h"
+#include "base/memory/scoped_ptr.h"
+#include "net/base/io_buffer.h"
+#include "net/base/net_errors.h"
+#include "net/disk_cache/disk_cache.h"
+#include "net/disk_cache/mem_backend_impl.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include <string.h>
+
+namespace {
+
+const char* kEntryA = "http://www.test.com/a.html";
+const char* kEntryB = "http://www.test.com/b.html";
+
+// Write |size| bytes to stream |index| of |entry|. The in-memory backend
+// completes writes synchronously.
+void WriteStream(disk_cache::Entry* entry, int index, int size)
+{
+  scoped_refptr<net::IOBuffer> buffer(new net::IOBuffer(size));
+  memset(buffer->data(), 'x', size);
+  EXPECT_EQ(size, entry->WriteData(index, 0, buffer, size, NULL, false));
+}
+
+} // namespace
+
+// Verify that the size of the in-memory cache, which reports no statistics,
+// is the total size of the streams of its entries.
+TEST(HttpCacheSizeTest, MemoryCache)
+{
+  scoped_ptr<disk_cache::Backend> backend(
+      disk_cache::MemBackendImpl::CreateBackend(0, NULL));
+  ASSERT_TRUE(backend.get());
+  EXPECT_EQ(0, HttpCacheSize::GetBytesUsed(backend.get(), net::MEMORY_CACHE));
+
+  disk_cache::Entry* entry = NULL;
+  ASSERT_EQ(net::OK, backend->CreateEntry(kEntryA, &entry, NULL));
+  WriteStream(entry, 0, 100);
+  WriteStream(entry, 1, 1000);
+  entry->Close();
+
+  ASSERT_EQ(net::OK, backend->CreateEntry(kEntryB, &entry, NULL));
+  WriteStream(entry, 1, 500);
+  WriteStream(entry, 2, 20);
+  entry->Close();
+
+  EXPECT_EQ(2, backend->GetEntryCount());
+  EXPECT_EQ(1620,
+            HttpCacheSize::GetBytesUsed(backend.get(), net::MEMORY_CACHE));
+
+  // Removed entries are no longer counted.
+  EXPECT_EQ(net::OK, backend->DoomEntry(kEntryA, NULL));
+  EXPECT_EQ(520, HttpCacheSize::GetBytesUsed(backend.get(), net::MEMORY_CACHE));
+}
@@ -0,0 +1,551 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "include/cef.h"
+#include "include/cef_runnable.h"
+#include "include/cef_wrapper.h"
+#include "base/memory/ref_counted.h"
+#include "base/string_number_conversions.h"
+#include "base/string_util.h"
+#include "base/synchronization/lock.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/task.h"
+#include "base/threading/thread.h"
+#include "net/server/http_server.h"
+#include "net/server/http_server_request_info.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include <map>
+
+namespace {
+
+const int kServerPort = 8099;
+const char* kServerUrl = "http://127.0.0.1:8099/";
+
+// Serves the responses used by the tests on its own IO thread and records the
+// requests that it receives. The HTTP cache is only used for network requests
+// so the responses can't be provided by a CefSchemeHandler.
+class TestHttpServer : public net::HttpServer::Delegate
+{
+public:
+  TestHttpServer() : thread_("TestHttpServer") {}
+
+  // Add a response for |path|. If |etag| is specified a request with a
+  // matching If-None-Match header receives a 304 response.
+  void AddResponse(const std::string& path, const std::string& cacheControl,
+                   const std::string& etag, const std::string& body)
+  {
+    base::AutoLock lock_scope(lock_);
+    Response& response = responses_[path];
+    response.cache_control = cacheControl;
+    response.etag = etag;
+    response.body = body;
+  }
+
+  // Returns the number of requests received for |path|.
+  int GetRequestCount(const std::string& path)
+  {
+    base::AutoLock lock_scope(lock_);
+    return request_counts_[path];
+  }
+
+  // Returns the If-None-Match header of the last request for |path|.
+  std::string GetIfNoneMatch(const std::string& path)
+  {
+    base::AutoLock lock_scope(lock_);
+    return if_none_match_[path];
+  }
+
+  bool Start()
+  {
+    base::Thread::Options options(MessageLoop::TYPE_IO, 0);
+    if (!thread_.StartWithOptions(options))
+      return false;
+
+    base::WaitableEvent event(false, false);
+    thread_.message_loop()->PostTask(FROM_HERE,
+        NewRunnableFunction(CreateServer, this, &event));
+    event.Wait();
+    return true;
+  }
+
+  void Stop()
+  {
+    base::WaitableEvent event(false, false);
+    thread_.message_loop()->PostTask(FROM_HERE,
+        NewRunnableFunction(DestroyServer, this, &event));
+    event.Wait();
+    thread_.Stop();
+  }
+
+  // net::HttpServer::Delegate methods.
+
+  virtual void OnHttpRequest(int connection_id,
+                             const net::HttpServerRequestInfo& info) OVERRIDE
+  {
+    std::string ifNoneMatch;
+    std::map<std::string, std::string>::const_iterator header =
+        info.headers.begin();
+    for (; header != info.headers.end(); ++header) {
+      if (LowerCaseEqualsASCII(header->first, "if-none-match"))
+        TrimWhitespaceASCII(header->second, TRIM_ALL, &ifNoneMatch);
+    }
+
+    std::string headers, body;
+    {
+      base::AutoLock lock_scope(lock_);
+      request_counts_[info.path]++;
+      if_none_match_[info.path] = ifNoneMatch;
+
+      ResponseMap::const_iterator it = responses_.find(info.path);
+      if (it == responses_.end()) {
+        headers = "HTTP/1.1 404 Not Found\r\n"
+                  "Content-Length: 0\r\n";
+      } else if (!it->second.etag.empty() && ifNoneMatch == it->second.etag) {
+        headers = "HTTP/1.1 304 Not Modified\r\n"
+                  "ETag: " + it->second.etag + "\r\n";
+      } else {
+        body = it->second.body;
+        headers = "HTTP/1.1 200 OK\r\n"
+                  "Content-Type: text/html\r\n"
+                  "Content-Length: " +
+                  base::IntToString(static_cast<int>(body.size())) + "\r\n";
+        if (!it->second.cache_control.empty())
+          headers += "Cache-Control: " + it->second.cache_control + "\r\n";
+        if (!it->second.etag.empty())
+          headers += "ETag: " + it->second.etag + "\r\n";
+      }
+    }
+
+    server_->Send(connection_id, headers + "Connection: close\r\n\r\n" + body);
+  }
+
+  virtual void OnWebSocketRequest(
+      int connection_id, const net::HttpServerRequestInfo& info) OVERRIDE {}
+  virtual void OnWebSocketMessage(int connection_id,
+                                  const std::string& data) OVERRIDE {}
+  virtual void OnClose(int connection_id) OVERRIDE {}
+
+private:
+  static void CreateServer(TestHttpServer* server,
+                           base::WaitableEvent* event)
+  {
+    server->server_ = new net::HttpServer("127.0.0.1", kServerPort, server);
+    event->Signal();
+  }
+
+  static void DestroyServer(TestHttpServer* server,
+                            base::WaitableEvent* event)
+  {
+    server->server_ = NULL;
+    event->Signal();
+  }
+
+  struct Response {
+    std::string cache_control;
+    std::string etag;
+    std::string body;
+  };
+  typedef std::map<std::string, Response> ResponseMap;
+
+  base::Thread thread_;
+  scoped_refptr<net::HttpServer> server_;
+
+  base::Lock lock_;
+  ResponseMap responses_;
+  std::map<std::string, int> request_counts_;
+  std::map<std::string, std::string> if_none_match_;
+};
+
+// Loads a URL using CefWebURLRequest and signals when the load completes.
+class LoadClient : public CefWebURLRequestClient
+{
+public:
+  LoadClient() : event_(true, false), status_(0) {}
+
+  virtual void OnStateChange(CefRefPtr<CefWebURLRequest> requester,
+                             RequestState state) OVERRIDE
+  {
+    if (state == WUR_STATE_DONE || state == WUR_STATE_ABORT)
+      event_.Signal();
+  }
+
+  virtual void OnRedirect(CefRefPtr<CefWebURLRequest> requester,
+                          CefRefPtr<CefRequest> request,
+                          CefRefPtr<CefResponse> response) OVERRIDE {}
+
+  virtual void OnHeadersReceived(CefRefPtr<CefWebURLRequest> requester,
+                                 CefRefPtr<CefResponse> response) OVERRIDE
+  {
+    status_ = response->GetStatus();
+  }
+
+  virtual void OnProgress(CefRefPtr<CefWebURLRequest> requester,
+                          uint64 bytesSent,
+                          uint64 totalBytesToBeSent) OVERRIDE {}
+
+  virtual void OnData(CefRefPtr<CefWebURLRequest> requester, const void* data,
+                      int dataLength) OVERRIDE
+  {
+    data_.append(static_cast<const char*>(data), dataLength);
+  }
+
+  virtual void OnError(CefRefPtr<CefWebURLRequest> requester,
+                       ErrorCode errorCode) OVERRIDE
+  {
+    event_.Signal();
+  }
+
+  base::WaitableEvent event_;
+  int status_;
+  std::string data_;
+
+  IMPLEMENT_REFCOUNTING(LoadClient);
+};
+
+// Load |path| from the test server and return the response status. The
+// response body is returned in |data| if non-NULL.
+int Load(const std::string& path, std::string* data = NULL)
+{
+  CefRefPtr<CefRequest> request = CefRequest::CreateRequest();
+  request->SetURL(kServerUrl + path);
+  request->SetMethod("GET");
+
+  CefRefPtr<LoadClient> client = new LoadClient();
+  CefRefPtr<CefWebURLRequest> requester =
+      CefWebURLRequest::CreateWebURLRequest(request, client.get());
+  EXPECT_TRUE(requester.get());
+  client->event_.Wait();
+
+  if (data)
+    *data = client->data_;
+  return client->status_;
+}
+
+void IOT_GetStats(CefHttpCacheStats* stats, base::WaitableEvent* event)
+{
+  // The cache is created by the first request that uses it. Until then there
+  // are no entries and no requests to report.
+  CefGetHttpCacheStats(*stats);
+  event->Signal();
+}
+
+CefHttpCacheStats GetStats()
+{
+  CefHttpCacheStats stats;
+  base::WaitableEvent event(false, false);
+  CefPostTask(TID_IO, NewCefRunnableFunction(IOT_GetStats, &stats, &event));
+  event.Wait();
+  return stats;
+}
+
+void IOT_Signal(base::WaitableEvent* event)
+{
+  EXPECT_TRUE(CefCurrentlyOn(TID_IO));
+  event->Signal();
+}
+
+// Remove the entries for URLs that start with |prefix| and wait until they
+// have been removed.
+void Purge(const std::string& prefix)
+{
+  base::WaitableEvent event(false, false);
+  EXPECT_TRUE(CefPurgeHttpCache(prefix, 0,
+      NewCefRunnableFunction(IOT_Signal, &event)));
+  event.Wait();
+}
+
+const char* kImportHeaders =
+    "HTTP/1.1 200 OK\n"
+    "Content-Type: text/html\n";
+
+// Import |body| for |path| on the test server and wait until the entry has
+// been written.
+void Import(const std::string& path, const std::string& headers,
+            const std::string& body)
+{
+  base::WaitableEvent event(false, false);
+  EXPECT_TRUE(CefImportHttpCacheEntry(kServerUrl + path, headers,
+      CefStreamReader::CreateForData(const_cast<char*>(body.data()),
+                                     body.size()),
+      NewCefRunnableFunction(IOT_Signal, &event)));
+  event.Wait();
+}
+
+// A stored zip archive containing fresh.html, stale.html and manifest.txt:
+// <pre>
+//   http://127.0.0.1:8099/archive/fresh.html fresh.html
+//   HTTP/1.1 200 OK
+//   Content-Type: text/html
+//   Cache-Control: max-age=3600
+//
+//   http://127.0.0.1:8099/archive/stale.html stale.html
+//   HTTP/1.1 200 OK
+//   Content-Type: text/html
+//   Cache-Control: no-cache
+//   ETag: "s1"
+//
+//   http://127.0.0.1:8099/archive/missing.html missing.html
+//   HTTP/1.1 200 OK
+//
+//   http://127.0.0.1:8099/archive/error.html fresh.html
+//   HTTP/1.1 404 Not Found
+// </pre>
+// The stale.html entry uses CRLF line endings and the manifest does not end
+// with a newline. The last two entries are rejected.
+unsigned char kImportArchive[] = {
+  0x50, 0x4b, 0x03, 0x04, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60,
+  0x43, 0x3f, 0x74, 0x80, 0x6b, 0x4a, 0x92, 0x01, 0x00, 0x00, 0x92, 0x01,
+  0x00, 0x00, 0x0c, 0x00, 0x00, 0x00, 0x6d, 0x61, 0x6e, 0x69, 0x66, 0x65,
+  0x73, 0x74, 0x2e, 0x74, 0x78, 0x74, 0x68, 0x74, 0x74, 0x70, 0x3a, 0x2f,
+  0x2f, 0x31, 0x32, 0x37, 0x2e, 0x30, 0x2e, 0x30, 0x2e, 0x31, 0x3a, 0x38,
+  0x30, 0x39, 0x39, 0x2f, 0x61, 0x72, 0x63, 0x68, 0x69, 0x76, 0x65, 0x2f,
+  0x66, 0x72, 0x65, 0x73, 0x68, 0x2e, 0x68, 0x74, 0x6d, 0x6c, 0x20, 0x66,
+  0x72, 0x65, 0x73, 0x68, 0x2e, 0x68, 0x74, 0x6d, 0x6c, 0x0a, 0x48, 0x54,
+  0x54, 0x50, 0x2f, 0x31, 0x2e, 0x31, 0x20, 0x32, 0x30, 0x30, 0x20, 0x4f,
+  0x4b, 0x0a, 0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74, 0x2d, 0x54, 0x79,
+  0x70, 0x65, 0x3a, 0x20, 0x74, 0x65, 0x78, 0x74, 0x2f, 0x68, 0x74, 0x6d,
+  0x6c, 0x0a, 0x43, 0x61, 0x63, 0x68, 0x65, 0x2d, 0x43, 0x6f, 0x6e, 0x74,
+  0x72, 0x6f, 0x6c, 0x3a, 0x20, 0x6d, 0x61, 0x78, 0x2d, 0x61, 0x67, 0x65,
+  0x3d, 0x33, 0x36, 0x30, 0x30, 0x0a, 0x0a, 0x68, 0x74, 0x74, 0x70, 0x3a,
+  0x2f, 0x2f, 0x31, 0x32, 0x37, 0x2e, 0x30, 0x2e, 0x30, 0x2e, 0x31, 0x3a,
+  0x38, 0x30, 0x39, 0x39, 0x2f, 0x61, 0x72, 0x63, 0x68, 0x69, 0x76, 0x65,
+  0x2f, 0x73, 0x74, 0x61, 0x6c, 0x65, 0x2e, 0x68, 0x74, 0x6d, 0x6c, 0x20,
+  0x73, 0x74, 0x61, 0x6c, 0x65, 0x2e, 0x68, 0x74, 0x6d, 0x6c, 0x0d, 0x0a,
+  0x48, 0x54, 0x54, 0x50, 0x2f, 0x31, 0x2e, 0x31, 0x20, 0x32, 0x30, 0x30,
+  0x20, 0x4f, 0x4b, 0x0d, 0x0a, 0x43, 0x6f, 0x6e, 0x74, 0x65, 0x6e, 0x74,
+  0x2d, 0x54, 0x79, 0x70, 0x65, 0x3a, 0x20, 0x74, 0x65, 0x78, 0x74, 0x2f,
+  0x68, 0x74, 0x6d, 0x6c, 0x0d, 0x0a, 0x43, 0x61, 0x63, 0x68, 0x65, 0x2d,
+  0x43, 0x6f, 0x6e, 0x74, 0x72, 0x6f, 0x6c, 0x3a, 0x20, 0x6e, 0x6f, 0x2d,
+  0x63, 0x61, 0x63, 0x68, 0x65, 0x0d, 0x0a, 0x45, 0x54, 0x61, 0x67, 0x3a,
+  0x20, 0x22, 0x73, 0x31, 0x22, 0x0d, 0x0a, 0x0d, 0x0a, 0x68, 0x74, 0x74,
+  0x70, 0x3a, 0x2f, 0x2f, 0x31, 0x32, 0x37, 0x2e, 0x30, 0x2e, 0x30, 0x2e,
+  0x31, 0x3a, 0x38, 0x30, 0x39, 0x39, 0x2f, 0x61, 0x72, 0x63, 0x68, 0x69,
+  0x76, 0x65, 0x2f, 0x6d, 0x69, 0x73, 0x73, 0x69, 0x6e, 0x67, 0x2e, 0x68,
+  0x74, 0x6d, 0x6c, 0x20, 0x6d, 0x69, 0x73, 0x73, 0x69, 0x6e, 0x67, 0x2e,
+  0x68, 0x74, 0x6d, 0x6c, 0x0a, 0x48, 0x54, 0x54, 0x50, 0x2f, 0x31, 0x2e,
+  0x31, 0x20, 0x32, 0x30, 0x30, 0x20, 0x4f, 0x4b, 0x0a, 0x0a, 0x68, 0x74,
+  0x74, 0x70, 0x3a, 0x2f, 0x2f, 0x31, 0x32, 0x37, 0x2e, 0x30, 0x2e, 0x30,
+  0x2e, 0x31, 0x3a, 0x38, 0x30, 0x39, 0x39, 0x2f, 0x61, 0x72, 0x63, 0x68,
+  0x69, 0x76, 0x65, 0x2f, 0x65, 0x72, 0x72, 0x6f, 0x72, 0x2e, 0x68, 0x74,
+  0x6d, 0x6c, 0x20, 0x66, 0x72, 0x65, 0x73, 0x68, 0x2e, 0x68, 0x74, 0x6d,
+  0x6c, 0x0a, 0x48, 0x54, 0x54, 0x50, 0x2f, 0x31, 0x2e, 0x31, 0x20, 0x34,
+  0x30, 0x34, 0x20, 0x4e, 0x6f, 0x74, 0x20, 0x46, 0x6f, 0x75, 0x6e, 0x64,
+  0x50, 0x4b, 0x03, 0x04, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60,
+  0x43, 0x3f, 0x14, 0xc6, 0xed, 0x73, 0x12, 0x00, 0x00, 0x00, 0x12, 0x00,
+  0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x66, 0x72, 0x65, 0x73, 0x68, 0x2e,
+  0x68, 0x74, 0x6d, 0x6c, 0x3c, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0x66, 0x72,
+  0x65, 0x73, 0x68, 0x3c, 0x2f, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0x50, 0x4b,
+  0x03, 0x04, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x43, 0x3f,
+  0xb0, 0xae, 0x74, 0xee, 0x12, 0x00, 0x00, 0x00, 0x12, 0x00, 0x00, 0x00,
+  0x0a, 0x00, 0x00, 0x00, 0x73, 0x74, 0x61, 0x6c, 0x65, 0x2e, 0x68, 0x74,
+  0x6d, 0x6c, 0x3c, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0x73, 0x74, 0x61, 0x6c,
+  0x65, 0x3c, 0x2f, 0x68, 0x74, 0x6d, 0x6c, 0x3e, 0x50, 0x4b, 0x01, 0x02,
+  0x14, 0x00, 0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x43, 0x3f,
+  0x74, 0x80, 0x6b, 0x4a, 0x92, 0x01, 0x00, 0x00, 0x92, 0x01, 0x00, 0x00,
+  0x0c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x80, 0x01, 0x00, 0x00, 0x00, 0x00, 0x6d, 0x61, 0x6e, 0x69, 0x66, 0x65,
+  0x73, 0x74, 0x2e, 0x74, 0x78, 0x74, 0x50, 0x4b, 0x01, 0x02, 0x14, 0x00,
+  0x14, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x60, 0x43, 0x3f, 0x14, 0xc6,
+  0xed, 0x73, 0x12, 0x00, 0x00, 0x00, 0x12, 0x00, 0x00, 0x00, 0x0a, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01,
+  0xbc, 0x01, 0x00, 0x00, 0x66, 0x72, 0x65, 0x73, 0x68, 0x2e, 0x68, 0x74,
+  0x6d, 0x6c, 0x50, 0x4b, 0x01, 0x02, 0x14, 0x00, 0x14, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x60, 0x43, 0x3f, 0xb0, 0xae, 0x74, 0xee, 0x12, 0x00,
+  0x00, 0x00, 0x12, 0x00, 0x00, 0x00, 0x0a, 0x00, 0x00, 0x00, 0x00, 0x00,
+  0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x80, 0x01, 0xf6, 0x01, 0x00, 0x00,
+  0x73, 0x74, 0x61, 0x6c, 0x65, 0x2e, 0x68, 0x74, 0x6d, 0x6c, 0x50, 0x4b,
+  0x05, 0x06, 0x00, 0x00, 0x00, 0x00, 0x03, 0x00, 0x03, 0x00, 0xaa, 0x00,
+  0x00, 0x00, 0x30, 0x02, 0x00, 0x00, 0x00, 0x00
+};
+
+} // namespace
+
+// Verify that a fresh response is read from the cache on the second load.
+TEST(HttpCacheTest, Hit)
+{
+  TestHttpServer server;
+  server.AddResponse("/hit.html", "max-age=3600", "", "<html>hit</html>");
+  ASSERT_TRUE(server.Start());
+
+  CefHttpCacheStats before = GetStats();
+
+  std::string data;
+  EXPECT_EQ(200, Load("hit.html", &data));
+  EXPECT_EQ("<html>hit</html>", data);
+  EXPECT_EQ(200, Load("hit.html", &data));
+  EXPECT_EQ("<html>hit</html>", data);
+
+  CefHttpCacheStats after = GetStats();
+  EXPECT_EQ(1, server.GetRequestCount("/hit.html"));
+  // The test suite uses a disk cache, which reports its size.
+  EXPECT_GT(after.bytes_used, 0);
+  EXPECT_EQ(before.hit_count + 1, after.hit_count);
+  EXPECT_EQ(before.miss_count + 1, after.miss_count);
+  EXPECT_EQ(before.validation_count, after.validation_count);
+
+  Purge(kServerUrl);
+  server.Stop();
+}
+
+// Verify that a response that must be revalidated is read from the cache
+// after the server responds to the conditional request with a 304.
+TEST(HttpCacheTest, Validation)
+{
+  TestHttpServer server;
+  server.AddResponse("/validate.html", "no-cache", "\"v1\"",
+                     "<html>validate</html>");
+  ASSERT_TRUE(server.Start());
+
+  CefHttpCacheStats before = GetStats();
+
+  std::string data;
+  EXPECT_EQ(200, Load("validate.html", &data));
+  EXPECT_EQ("", server.GetIfNoneMatch("/validate.html"));
+  EXPECT_EQ(200, Load("validate.html", &data));
+  EXPECT_EQ("<html>validate</html>", data);
+  EXPECT_EQ("\"v1\"", server.GetIfNoneMatch("/validate.html"));
+
+  CefHttpCacheStats after = GetStats();
+  EXPECT_EQ(2, server.GetRequestCount("/validate.html"));
+  EXPECT_EQ(before.hit_count, after.hit_count);
+  EXPECT_EQ(before.miss_count + 1, after.miss_count);
+  EXPECT_EQ(before.validation_count + 1, after.validation_count);
+
+  Purge(kServerUrl);
+  server.Stop();
+}
+
+// Verify that purging by URL prefix only removes the matching entries.
+TEST(HttpCacheTest, PurgeByPrefix)
+{
+  TestHttpServer server;
+  server.AddResponse("/purge/a.html", "max-age=3600", "", "<html>a</html>");
+  server.AddResponse("/purge/b.html", "max-age=3600", "", "<html>b</html>");
+  server.AddResponse("/keep.html", "max-age=3600", "", "<html>keep</html>");
+  ASSERT_TRUE(server.Start());
+
+  CefHttpCacheStats before = GetStats();
+  EXPECT_EQ(200, Load("purge/a.html"));
+  EXPECT_EQ(200, Load("purge/b.html"));
+  EXPECT_EQ(200, Load("keep.html"));
+
+  CefHttpCacheStats loaded = GetStats();
+  EXPECT_EQ(before.entry_count + 3, loaded.entry_count);
+
+  Purge(std::string(kServerUrl) + "purge/");
+
+  CefHttpCacheStats purged = GetStats();
+  EXPECT_EQ(before.entry_count + 1, purged.entry_count);
+
+  // The purged entry is requested again and the kept entry is not.
+  EXPECT_EQ(200, Load("purge/a.html"));
+  EXPECT_EQ(200, Load("keep.html"));
+  EXPECT_EQ(2, server.GetRequestCount("/purge/a.html"));
+  EXPECT_EQ(1, server.GetRequestCount("/keep.html"));
+
+  Purge(kServerUrl);
+  EXPECT_EQ(before.entry_count, GetStats().entry_count);
+  server.Stop();
+}
+
+// Test validation of imported HTTP cache entries.
+TEST(HttpCacheTest, ImportEntryValidation)
+{
+  char data[] = "<html><body>Cached</body></html>";
+  const char* headers =
+      "HTTP/1.1 200 OK\n"
+      "Content-Type: text/html\n"
+      "Cache-Control: max-age=3600\n"
+      "ETag: \"1234\"\n";
+
+  // Only http and https URLs can be imported.
+  EXPECT_FALSE(CefImportHttpCacheEntry("invalid", headers,
+      CefStreamReader::CreateForData(data, sizeof(data) - 1), NULL));
+  EXPECT_FALSE(CefImportHttpCacheEntry("file:///tmp/test.html", headers,
+      CefStreamReader::CreateForData(data, sizeof(data) - 1), NULL));
+
+  // Only 200 responses can be imported.
+  EXPECT_FALSE(CefImportHttpCacheEntry(std::string(kServerUrl) + "test.html",
+      "HTTP/1.1 404 Not Found\n",
+      CefStreamReader::CreateForData(data, sizeof(data) - 1), NULL));
+}
+
+// Verify that an imported entry is served from the cache while it is fresh
+// and revalidated with its ETag after that.
+TEST(HttpCacheTest, ImportEntry)
+{
+  TestHttpServer server;
+  server.AddResponse("/import/fresh.html", "max-age=3600", "",
+                     "<html>server</html>");
+  server.AddResponse("/import/stale.html", "no-cache", "\"i1\"",
+                     "<html>server</html>");
+  ASSERT_TRUE(server.Start());
+
+  Import("import/fresh.html",
+         std::string(kImportHeaders) + "Cache-Control: max-age=3600\n",
+         "<html>fresh</html>");
+  Import("import/stale.html",
+         std::string(kImportHeaders) + "Cache-Control: no-cache\n"
+         "ETag: \"i1\"\n",
+         "<html>stale</html>");
+
+  CefHttpCacheStats before = GetStats();
+
+  std::string data;
+  EXPECT_EQ(200, Load("import/fresh.html", &data));
+  EXPECT_EQ("<html>fresh</html>", data);
+  EXPECT_EQ(0, server.GetRequestCount("/import/fresh.html"));
+
+  EXPECT_EQ(200, Load("import/stale.html", &data));
+  EXPECT_EQ("<html>stale</html>", data);
+  EXPECT_EQ(1, server.GetRequestCount("/import/stale.html"));
+  EXPECT_EQ("\"i1\"", server.GetIfNoneMatch("/import/stale.html"));
+
+  CefHttpCacheStats after = GetStats();
+  EXPECT_EQ(before.hit_count + 1, after.hit_count);
+  EXPECT_EQ(before.miss_count, after.miss_count);
+  EXPECT_EQ(before.validation_count + 1, after.validation_count);
+
+  Purge(kServerUrl);
+  server.Stop();
+}
+
+// Verify that the entries listed in an archive manifest are imported.
+TEST(HttpCacheTest, ImportArchive)
+{
+  TestHttpServer server;
+  server.AddResponse("/archive/stale.html", "no-cache", "\"s1\"",
+                     "<html>server</html>");
+  ASSERT_TRUE(server.Start());
+
+  CefRefPtr<CefZipArchive> archive = new CefZipArchive();
+  ASSERT_EQ((size_t)3, archive->Load(CefStreamReader::CreateForData(
+      kImportArchive, sizeof(kImportArchive)), false));
+
+  CefHttpCacheStats before = GetStats();
+
+  // A missing manifest imports nothing but still completes.
+  base::WaitableEvent event(false, false);
+  EXPECT_EQ((size_t)0, CefImportHttpCache(archive, "missing.txt",
+      NewCefRunnableFunction(IOT_Signal, &event)));
+  event.Wait();
+
+  EXPECT_EQ((size_t)2, CefImportHttpCache(archive, "manifest.txt",
+      NewCefRunnableFunction(IOT_Signal, &event)));
+  event.Wait();
+  EXPECT_EQ(before.entry_count + 2, GetStats().entry_count);
+
+  std::string data;
+  EXPECT_EQ(200, Load("archive/fresh.html", &data));
+  EXPECT_EQ("<html>fresh</html>", data);
+  EXPECT_EQ(0, server.GetRequestCount("/archive/fresh.html"));
+
+  EXPECT_EQ(200, Load("archive/stale.html", &data));
+  EXPECT_EQ("<html>stale</html>", data);
+  EXPECT_EQ("\"s1\"", server.GetIfNoneMatch("/archive/stale.html"));
+
+  Purge(kServerUrl);
+  EXPECT_EQ(before.entry_count, GetStats().entry_count);
+  server.Stop();
+}
@@ -0,0 +1,267 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "include/cef.h"
+#include "include/cef_runnable.h"
+#include "libcef/image_encoder.h"
+#include "third_party/skia/include/core/SkBitmap.h"
+#include "third_party/skia/include/core/SkColorPriv.h"
+#include "ui/gfx/codec/png_codec.h"
+#include "test_handler.h"
+#include <string.h>
+
+namespace {
+
+const char* kCaptureUrl = "http://tests/capture.html";
+
+// Decode |data| and return the RGBA value of the pixel at (|x|, |y|) in
+// |rgba|. Returns false if the image could not be decoded.
+bool DecodePixel(const void* data, size_t size, int x, int y,
+                 unsigned char rgba[4])
+{
+  std::vector<unsigned char> pixels;
+  int width = 0, height = 0;
+  if (!gfx::PNGCodec::Decode(static_cast<const unsigned char*>(data), size,
+                             gfx::PNGCodec::FORMAT_RGBA, &pixels, &width,
+                             &height)) {
+    return false;
+  }
+  if (x >= width || y >= height)
+    return false;
+
+  memcpy(rgba, &pixels[(y * width + x) * 4], 4);
+  return true;
+}
+
+class CaptureTestHandler : public TestHandler
+{
+public:
+  class Callback : public CefImageCaptureCallback
+  {
+  public:
+    Callback(CaptureTestHandler* handler) : handler_(handler) {}
+
+    virtual void OnImageCaptured(CefRefPtr<CefBrowser> browser, bool success,
+                                 const void* data, size_t dataSize) OVERRIDE
+    {
+      EXPECT_FALSE(CefCurrentlyOn(TID_UI));
+      handler_->got_image_.yes();
+
+      EXPECT_TRUE(success);
+      if (success) {
+        unsigned char rgba[4];
+        EXPECT_TRUE(DecodePixel(data, dataSize, 5, 5, rgba));
+        EXPECT_EQ(10, rgba[0]);
+        EXPECT_EQ(200, rgba[1]);
+        EXPECT_EQ(30, rgba[2]);
+        EXPECT_EQ(255, rgba[3]);
+      }
+
+      CefPostTask(TID_UI,
+          NewCefRunnableMethod(handler_, &CaptureTestHandler::Finish));
+    }
+
+  private:
+    CaptureTestHandler* handler_;
+    IMPLEMENT_REFCOUNTING(Callback);
+  };
+
+  CaptureTestHandler() {}
+
+  virtual void RunTest() OVERRIDE
+  {
+    std::string html =
+        "<html><body style=\"margin:0;background:rgb(10,200,30)\">"
+        "</body></html>";
+    AddResource(kCaptureUrl, html, "text/html");
+    CreateBrowser(kCaptureUrl);
+  }
+
+  virtual void OnLoadEnd(CefRefPtr<CefBrowser> browser,
+                         CefRefPtr<CefFrame> frame,
+                         int httpStatusCode) OVERRIDE
+  {
+    if (!frame->IsMain())
+      return;
+
+#if defined(OS_LINUX)
+    // Windowless browsers have no size until one is set.
+    browser->SetSize(PET_VIEW, 100, 100);
+#endif
+
+    // Give the view a chance to paint before capturing it.
+    CefPostDelayedTask(TID_UI,
+        NewCefRunnableMethod(this, &CaptureTestHandler::Capture), 200);
+  }
+
+  void Capture()
+  {
+    GetBrowser()->CaptureImage(PET_VIEW, CefRect(0, 0, 20, 20), 0, 0,
+                               IMAGE_ENCODING_PNG, 0, new Callback(this));
+  }
+
+  void Finish()
+  {
+    DestroyTest();
+  }
+
+  TrackCallback got_image_;
+};
+
+const char* kPageCaptureUrl = "http://tests/capture_page.html";
+const int kPageCaptureTileHeight = 64;
+
+// Returns the premultiplied BGRA pixel at column |x| of row |y| in |buffer|.
+uint32 GetPixel(const void* buffer, int width, int x, int y)
+{
+  return static_cast<const uint32*>(buffer)[y * width + x];
+}
+
+class PageCaptureTestHandler : public TestHandler
+{
+public:
+  class Handler : public CefPageCaptureHandler
+  {
+  public:
+    Handler(PageCaptureTestHandler* handler) : handler_(handler) {}
+
+    virtual bool OnCaptureStart(CefRefPtr<CefBrowser> browser, int width,
+                                int height) OVERRIDE
+    {
+      EXPECT_TRUE(CefCurrentlyOn(TID_UI));
+      handler_->page_width_ = width;
+      handler_->page_height_ = height;
+      return true;
+    }
+
+    virtual bool OnCaptureTile(CefRefPtr<CefBrowser> browser,
+                               const CefRect& tileRect,
+                               const void* buffer) OVERRIDE
+    {
+      EXPECT_TRUE(CefCurrentlyOn(TID_UI));
+
+      // Tiles span the page width and are delivered in order.
+      EXPECT_EQ(0, tileRect.x);
+      EXPECT_EQ(handler_->page_width_, tileRect.width);
+      EXPECT_EQ(handler_->captured_height_, tileRect.y);
+      EXPECT_LE(tileRect.height, kPageCaptureTileHeight);
+      handler_->captured_height_ += tileRect.height;
+      handler_->tile_count_++;
+
+      // The top half of the page is red and the bottom half is blue.
+      for (int y = 0; y < tileRect.height; y += 8) {
+        uint32 expected = (tileRect.y + y < 500) ? 0xFFFF0000 : 0xFF0000FF;
+        uint32 pixel = GetPixel(buffer, tileRect.width, 10, y);
+        if (pixel != expected) {
+          ADD_FAILURE() << "pixel at row " << (tileRect.y + y) << " is " <<
+              std::hex << pixel;
+          return false;
+        }
+      }
+      return true;
+    }
+
+  private:
+    PageCaptureTestHandler* handler_;
+    IMPLEMENT_REFCOUNTING(Handler);
+  };
+
+  PageCaptureTestHandler()
+    : page_width_(0), page_height_(0), captured_height_(0), tile_count_(0),
+      result_(false)
+  {
+  }
+
+  virtual void RunTest() OVERRIDE
+  {
+    std::string html =
+        "<html><body style=\"margin:0\">"
+        "<div style=\"height:500px;background:rgb(255,0,0)\"></div>"
+        "<div style=\"height:500px;background:rgb(0,0,255)\"></div>"
+        "</body></html>";
+    AddResource(kPageCaptureUrl, html, "text/html");
+    CreateBrowser(kPageCaptureUrl);
+  }
+
+  virtual void OnLoadEnd(CefRefPtr<CefBrowser> browser,
+                         CefRefPtr<CefFrame> frame,
+                         int httpStatusCode) OVERRIDE
+  {
+    if (!frame->IsMain())
+      return;
+
+#if defined(OS_LINUX)
+    // Windowless browsers have no size until one is set.
+    browser->SetSize(PET_VIEW, 100, 100);
+#endif
+
+    CefPostTask(TID_UI,
+        NewCefRunnableMethod(this, &PageCaptureTestHandler::Capture));
+  }
+
+  void Capture()
+  {
+    result_ = GetBrowser()->CapturePage(kPageCaptureTileHeight,
+                                        new Handler(this));
+    DestroyTest();
+  }
+
+  int page_width_;
+  int page_height_;
+  int captured_height_;
+  int tile_count_;
+  bool result_;
+};
+
+} // namespace
+
+// Verify that translucent pixels are unpremultiplied when encoded as PNG.
+TEST(ImageCaptureTest, EncodePNG)
+{
+  SkBitmap bitmap;
+  bitmap.setConfig(SkBitmap::kARGB_8888_Config, 2, 1);
+  ASSERT_TRUE(bitmap.allocPixels());
+  *bitmap.getAddr32(0, 0) = SkPreMultiplyARGB(255, 10, 200, 30);
+  *bitmap.getAddr32(1, 0) = SkPreMultiplyARGB(128, 255, 0, 0);
+
+  std::vector<unsigned char> output;
+  ASSERT_TRUE(ImageEncoder::Encode(bitmap, IMAGE_ENCODING_PNG, 0, &output));
+
+  unsigned char rgba[4];
+  ASSERT_TRUE(DecodePixel(&output[0], output.size(), 0, 0, rgba));
+  EXPECT_EQ(10, rgba[0]);
+  EXPECT_EQ(200, rgba[1]);
+  EXPECT_EQ(30, rgba[2]);
+  EXPECT_EQ(255, rgba[3]);
+
+  ASSERT_TRUE(DecodePixel(&output[0], output.size(), 1, 0, rgba));
+  EXPECT_EQ(255, rgba[0]);
+  EXPECT_EQ(0, rgba[1]);
+  EXPECT_EQ(0, rgba[2]);
+  EXPECT_EQ(128, rgba[3]);
+}
+
+// Verify that CaptureImage() delivers an encoded image of the view.
+TEST(ImageCaptureTest, CaptureImage)
+{
+  CefRefPtr<CaptureTestHandler> handler = new CaptureTestHandler();
+  handler->ExecuteTest();
+
+  EXPECT_TRUE(handler->got_image_);
+}
+
+// Verify that CapturePage() delivers the whole page, including content outside
+// of the visible area, in order.
+TEST(ImageCaptureTest, CapturePage)
+{
+  CefRefPtr<PageCaptureTestHandler> handler = new PageCaptureTestHandler();
+  handler->ExecuteTest();
+
+  EXPECT_TRUE(handler->result_);
+  EXPECT_GT(handler->page_width_, 0);
+  EXPECT_EQ(1000, handler->page_height_);
+  EXPECT_EQ(1000, handler->captured_height_);
+  EXPECT_EQ((1000 + kPageCaptureTileHeight - 1) / kPageCaptureTileHeight,
+            handler->tile_count_);
+}
@@ -0,0 +1,174 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "include/cef.h"
+#include "include/cef_runnable.h"
+#include "libcef/cef_message_loop.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/synchronization/waitable_event.h"
+#include "base/task.h"
+#include "base/threading/thread.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+#if defined(OS_LINUX)
+#include <poll.h>
+#endif
+
+namespace {
+
+void Increment(int* count)
+{
+  (*count)++;
+}
+
+void PostIncrement(MessageLoop* loop, int* count, base::WaitableEvent* event)
+{
+  loop->PostTask(FROM_HERE, NewRunnableFunction(Increment, count));
+  event->Signal();
+}
+
+// Post a task to |loop| from another thread and wait until it has been posted.
+void PostFromOtherThread(MessageLoop* loop, int* count)
+{
+  base::Thread thread("MessageLoopTestThread");
+  ASSERT_TRUE(thread.Start());
+
+  base::WaitableEvent event(false, false);
+  thread.message_loop()->PostTask(FROM_HERE,
+      NewRunnableFunction(PostIncrement, loop, count, &event));
+  event.Wait();
+}
+
+#if defined(OS_LINUX)
+// Wait up to |timeout_ms| for |fd| to become readable.
+bool WaitReadable(int fd, int timeout_ms)
+{
+  struct pollfd pfd = { fd, POLLIN, 0 };
+  return poll(&pfd, 1, timeout_ms) == 1 && (pfd.revents & POLLIN);
+}
+
+bool IsReadable(int fd)
+{
+  return WaitReadable(fd, 0);
+}
+#endif
+
+const int kUITaskCount = 100;
+const int kWaitMs = 10000;
+
+void UIT_Count(int* count, int expected, base::WaitableEvent* event)
+{
+  EXPECT_TRUE(CefCurrentlyOn(TID_UI));
+
+  // Only the UI thread modifies |count| so no lock is required.
+  if (++(*count) == expected)
+    event->Signal();
+}
+
+// Post a task to the UI thread from the current thread.
+void PostToUI(int* count, int expected, base::WaitableEvent* event)
+{
+  CefPostTask(TID_UI, NewCefRunnableFunction(UIT_Count, count, expected,
+                                             event));
+}
+
+#if defined(OS_LINUX)
+// Reply to an application message loop from the UI thread.
+void UIT_Reply(MessageLoop* loop, int* count)
+{
+  EXPECT_TRUE(CefCurrentlyOn(TID_UI));
+  loop->PostTask(FROM_HERE, NewRunnableFunction(Increment, count));
+}
+#endif
+
+} // namespace
+
+// Verify that work posted from another thread signals the wakeup descriptor
+// and is reported as ready before the loop has looked at it.
+TEST(MessageLoopTest, WakeupFd)
+{
+  scoped_ptr<CefMessageLoopForUI> loop(CefMessageLoopForUI::Create());
+  EXPECT_EQ(-1, loop->GetWorkDelay());
+
+  int fd = loop->GetWakeupFd();
+#if defined(OS_LINUX)
+  ASSERT_GE(fd, 0);
+  EXPECT_FALSE(IsReadable(fd));
+#else
+  EXPECT_EQ(-1, fd);
+#endif
+
+  int count = 0;
+  PostFromOtherThread(loop.get(), &count);
+#if defined(OS_LINUX)
+  EXPECT_TRUE(IsReadable(fd));
+#endif
+  EXPECT_EQ(0, loop->GetWorkDelay());
+
+  loop->DoMessageLoopIteration();
+  EXPECT_EQ(1, count);
+#if defined(OS_LINUX)
+  EXPECT_FALSE(IsReadable(fd));
+#endif
+  EXPECT_EQ(-1, loop->GetWorkDelay());
+}
+
+// Verify that delayed work is reported once the loop has queued it.
+TEST(MessageLoopTest, WorkDelay)
+{
+  scoped_ptr<CefMessageLoopForUI> loop(CefMessageLoopForUI::Create());
+
+  int count = 0;
+  loop->PostDelayedTask(FROM_HERE, NewRunnableFunction(Increment, &count),
+                        10000);
+  // The task is still in the incoming queue.
+  EXPECT_EQ(0, loop->GetWorkDelay());
+
+  loop->DoMessageLoopIteration();
+  EXPECT_EQ(0, count);
+  int64 delay = loop->GetWorkDelay();
+  EXPECT_GT(delay, 0);
+  EXPECT_LE(delay, 10000);
+}
+
+// The test suite runs with CefSettings.multi_threaded_message_loop enabled.
+// Verify that the separate UI thread wakes for tasks posted from the other CEF
+// threads. On Linux also verify that it can reply to an application message
+// loop that waits for the wakeup descriptor, as a service with its own event
+// loop would.
+TEST(MessageLoopTest, MultiThreadedUIThread)
+{
+  EXPECT_FALSE(CefCurrentlyOn(TID_UI));
+
+  base::WaitableEvent event(false, false);
+  int count = 0;
+  const int expected = kUITaskCount + 3;
+  for (int i = 0; i < kUITaskCount; ++i)
+    PostToUI(&count, expected, &event);
+  EXPECT_TRUE(CefPostTask(TID_IO,
+      NewCefRunnableFunction(PostToUI, &count, expected, &event)));
+  EXPECT_TRUE(CefPostTask(TID_FILE,
+      NewCefRunnableFunction(PostToUI, &count, expected, &event)));
+  EXPECT_TRUE(CefPostTask(TID_WORKER,
+      NewCefRunnableFunction(PostToUI, &count, expected, &event)));
+
+  // A missed wakeup leaves tasks waiting on the UI thread.
+  ASSERT_TRUE(event.TimedWait(base::TimeDelta::FromMilliseconds(kWaitMs)));
+  EXPECT_EQ(expected, count);
+
+#if defined(OS_LINUX)
+  scoped_ptr<CefMessageLoopForUI> loop(CefMessageLoopForUI::Create());
+  int fd = loop->GetWakeupFd();
+  ASSERT_GE(fd, 0);
+
+  // The reply from the UI thread signals the descriptor.
+  int replies = 0;
+  EXPECT_TRUE(CefPostTask(TID_UI,
+      NewCefRunnableFunction(UIT_Reply, loop.get(), &replies)));
+  ASSERT_TRUE(WaitReadable(fd, kWaitMs));
+  loop->DoMessageLoopIteration();
+  EXPECT_EQ(1, replies);
+  EXPECT_FALSE(IsReadable(fd));
+#endif
+}
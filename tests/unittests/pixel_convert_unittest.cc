@@ -0,0 +1,144 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "libcef/pixel_convert.h"
+#include "base/time.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include <stdio.h>
+#include <vector>
+
+using PixelConvert::Kernel;
+
+namespace {
+
+const Kernel kSimdKernels[] = {
+  PixelConvert::KERNEL_SSE2,
+  PixelConvert::KERNEL_AVX2
+};
+
+// Every premultiplied alpha and channel combination, including invalid values
+// where a channel exceeds alpha.
+void CreateExhaustiveImage(std::vector<uint32>& pixels)
+{
+  pixels.resize(256 * 256);
+  for (uint32 a = 0; a < 256; ++a) {
+    for (uint32 c = 0; c < 256; ++c) {
+      pixels[a * 256 + c] =
+          (a << 24) | (c << 16) | (((c * 7) & 0xFF) << 8) | (255 - c);
+    }
+  }
+}
+
+void Convert(const std::vector<uint32>& src, std::vector<uint32>& dst,
+             int width, int height, int x, int y, int w, int h, int format,
+             Kernel kernel)
+{
+  PixelConvert::ConvertRect(&src[0], width * 4, &dst[0], width * 4, height,
+                            x, y, w, h, format, kernel);
+}
+
+// Mostly opaque content with translucent regions, similar to a web page.
+void CreateFrame(std::vector<uint32>& pixels, int width, int height)
+{
+  pixels.resize(width * height);
+  uint32 seed = 1;
+  for (int y = 0; y < height; ++y) {
+    for (int x = 0; x < width; ++x) {
+      seed = seed * 1103515245 + 12345;
+      uint32 a = (y % 64 < 8) ? ((seed >> 24) & 0xFF) : 0xFF;
+      uint32 c = (seed >> 8) % (a + 1);
+      pixels[y * width + x] = (a << 24) | (c << 16) | (c << 8) | c;
+    }
+  }
+}
+
+// Returns the average time in milliseconds to convert a full frame.
+double BenchmarkKernel(const std::vector<uint32>& src,
+                       std::vector<uint32>& dst, int width, int height,
+                       int format, Kernel kernel)
+{
+  const int kIterations = 10;
+  base::TimeTicks start = base::TimeTicks::Now();
+  for (int i = 0; i < kIterations; ++i)
+    Convert(src, dst, width, height, 0, 0, width, height, format, kernel);
+  return (base::TimeTicks::Now() - start).InMillisecondsF() / kIterations;
+}
+
+void RunBenchmark(const char* name, int width, int height)
+{
+  std::vector<uint32> src, dst(width * height);
+  CreateFrame(src, width, height);
+
+  const int format = PF_RGBA | PF_UNPREMULTIPLY | PF_BOTTOM_UP;
+  printf("PixelConvert %s (%dx%d): scalar %.2f ms", name, width, height,
+         BenchmarkKernel(src, dst, width, height, format,
+                         PixelConvert::KERNEL_SCALAR));
+  for (size_t k = 0; k < arraysize(kSimdKernels); ++k) {
+    if (!PixelConvert::IsKernelSupported(kSimdKernels[k]))
+      continue;
+    printf(", kernel %d %.2f ms", kSimdKernels[k],
+           BenchmarkKernel(src, dst, width, height, format, kSimdKernels[k]));
+  }
+  printf("\n");
+}
+
+} // namespace
+
+// Verify that the scalar kernel swizzles, unpremultiplies and flips.
+TEST(PixelConvertTest, Scalar)
+{
+  // Premultiplied BGRA for 50% opaque red.
+  std::vector<uint32> src(2, 0x80800000);
+  src[1] = 0xFF0000FF;  // Opaque blue.
+  std::vector<uint32> dst(2);
+
+  Convert(src, dst, 1, 2, 0, 0, 1, 2, PF_DEFAULT,
+          PixelConvert::KERNEL_SCALAR);
+  EXPECT_EQ(src, dst);
+
+  Convert(src, dst, 1, 2, 0, 0, 1, 2, PF_RGBA | PF_UNPREMULTIPLY,
+          PixelConvert::KERNEL_SCALAR);
+  EXPECT_EQ(0x800000FFU, dst[0]);
+  EXPECT_EQ(0xFFFF0000U, dst[1]);
+
+  Convert(src, dst, 1, 2, 0, 0, 1, 2, PF_BOTTOM_UP,
+          PixelConvert::KERNEL_SCALAR);
+  EXPECT_EQ(src[1], dst[0]);
+  EXPECT_EQ(src[0], dst[1]);
+}
+
+// Verify that the SIMD kernels exactly match the scalar kernel for every
+// format and only write the requested region.
+TEST(PixelConvertTest, SimdMatchesScalar)
+{
+  std::vector<uint32> src;
+  CreateExhaustiveImage(src);
+  const int size = 256;
+
+  for (size_t k = 0; k < arraysize(kSimdKernels); ++k) {
+    if (!PixelConvert::IsKernelSupported(kSimdKernels[k]))
+      continue;
+
+    for (int format = 0; format <= (PF_RGBA | PF_UNPREMULTIPLY | PF_BOTTOM_UP);
+         ++format) {
+      std::vector<uint32> expected(size * size, 0x12345678);
+      std::vector<uint32> actual(size * size, 0x12345678);
+      // Use an odd region so that the scalar tail of each row is exercised.
+      Convert(src, expected, size, size, 3, 5, 250, 240, format,
+              PixelConvert::KERNEL_SCALAR);
+      Convert(src, actual, size, size, 3, 5, 250, 240, format,
+              kSimdKernels[k]);
+      EXPECT_TRUE(expected == actual) << "kernel " << kSimdKernels[k] <<
+          " format " << format;
+    }
+  }
+}
+
+// Measure each supported kernel for full frames. Disabled by default because
+// it only reports timings. Run with --gtest_also_run_disabled_tests.
+TEST(PixelConvertTest, DISABLED_Benchmark)
+{
+  RunBenchmark("1080p", 1920, 1080);
+  RunBenchmark("4K", 3840, 2160);
+}
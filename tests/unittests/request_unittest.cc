@@ -3,6 +3,8 @@
 // can be found in the LICENSE file.
 
 #include "include/cef.h"
+#include "include/cef_runnable.h"
+#include "base/synchronization/waitable_event.h"
 #include "testing/gtest/include/gtest/gtest.h"
 #include "test_handler.h"
 
@@ -296,6 +298,134 @@ TEST(RequestTest, SendRecv)
   ASSERT_TRUE(g_RequestSendRecvTestHandlerHandleBeforeResourceLoadCalled);
 }
 
+// Verify that request contexts report their cache path.
+TEST(RequestTest, RequestContext)
+{
+  CefRefPtr<CefRequestContext> context =
+      CefRequestContext::CreateContext(CefString());
+  ASSERT_TRUE(context.get());
+  EXPECT_TRUE(context->GetCachePath().empty());
+
+  context = CefRequestContext::CreateContext("request_context_test");
+  ASSERT_TRUE(context.get());
+  EXPECT_EQ(context->GetCachePath(), "request_context_test");
+}
+
+static const char* kContextSetUrl = "http://www.contexttest.com/set.html";
+static const char* kContextPopupUrl = "http://www.contexttest.com/popup.html";
+static const char* kContextGetUrl = "http://www.contexttest.com/get.html";
+
+// Loads a page in a browser that uses |requestContext| and reports the value
+// of document.cookie using the document title. If |setCookie| is true the page
+// first sets a cookie and reports the value seen by a popup that it opens.
+class RequestContextCookieTestHandler : public TestHandler
+{
+public:
+  RequestContextCookieTestHandler(CefRefPtr<CefRequestContext> requestContext,
+                                  bool setCookie)
+    : request_context_(requestContext), set_cookie_(setCookie) {}
+
+  virtual void RunTest() OVERRIDE
+  {
+    AddResource(kContextSetUrl,
+        "<html><body><script>"
+        "document.cookie = 'context=a';"
+        "window.open('" + std::string(kContextPopupUrl) + "');"
+        "</script></body></html>", "text/html");
+    AddResource(kContextPopupUrl,
+        "<html><body><script>"
+        "document.title = 'cookie:' + document.cookie;"
+        "</script></body></html>", "text/html");
+    AddResource(kContextGetUrl,
+        "<html><body><script>"
+        "document.title = 'cookie:' + document.cookie;"
+        "</script></body></html>", "text/html");
+    CreateBrowser(set_cookie_ ? kContextSetUrl : kContextGetUrl,
+                  request_context_);
+  }
+
+  virtual void OnTitleChange(CefRefPtr<CefBrowser> browser,
+                             const CefString& title) OVERRIDE
+  {
+    std::string titleStr = title;
+    if (titleStr.find("cookie:") != 0)
+      return;
+
+    // With |setCookie| only the popup reports.
+    EXPECT_EQ(set_cookie_, browser->IsPopup());
+    cookie_ = titleStr.substr(7);
+    if (browser->IsPopup()) {
+      CefPostTask(TID_UI,
+          NewCefRunnableMethod(browser.get(), &CefBrowser::CloseBrowser));
+    }
+    DestroyTest();
+  }
+
+  CefRefPtr<CefRequestContext> request_context_;
+  bool set_cookie_;
+  std::string cookie_;
+};
+
+class GlobalCookieCountVisitor : public CefCookieVisitor
+{
+public:
+  GlobalCookieCountVisitor(int* count, base::WaitableEvent* event)
+    : count_(count), event_(event)
+  {
+    *count_ = 0;
+  }
+  virtual ~GlobalCookieCountVisitor()
+  {
+    event_->Signal();
+  }
+
+  virtual bool Visit(const CefCookie& cookie, int count, int total,
+                     bool& deleteCookie) OVERRIDE
+  {
+    (*count_)++;
+    return true;
+  }
+
+  int* count_;
+  base::WaitableEvent* event_;
+
+  IMPLEMENT_REFCOUNTING(GlobalCookieCountVisitor);
+};
+
+// Verify that cookies set in a request context are visible to popups opened
+// from a browser using that context but not to other request contexts or the
+// global cookie store.
+TEST(RequestTest, RequestContextCookies)
+{
+  CefRefPtr<CefRequestContext> context_a =
+      CefRequestContext::CreateContext(CefString());
+  CefRefPtr<CefRequestContext> context_b =
+      CefRequestContext::CreateContext(CefString());
+  ASSERT_TRUE(context_a.get());
+  ASSERT_TRUE(context_b.get());
+
+  // The popup inherits the opener's context.
+  CefRefPtr<RequestContextCookieTestHandler> handler =
+      new RequestContextCookieTestHandler(context_a, true);
+  handler->ExecuteTest();
+  EXPECT_EQ("context=a", handler->cookie_);
+
+  handler = new RequestContextCookieTestHandler(context_b, false);
+  handler->ExecuteTest();
+  EXPECT_EQ("", handler->cookie_);
+
+  handler = new RequestContextCookieTestHandler(NULL, false);
+  handler->ExecuteTest();
+  EXPECT_EQ("", handler->cookie_);
+
+  base::WaitableEvent event(false, false);
+  int count = 0;
+  EXPECT_TRUE(CefVisitUrlCookies("http://www.contexttest.com", true,
+      new GlobalCookieCountVisitor(&count, &event)));
+  event.Wait();
+  EXPECT_EQ(0, count);
+}
+
 // Enable this test if you have applied the patches for issue #42.
 #if 0
 
@@ -0,0 +1,96 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "include/cef.h"
+#include "include/cef_runnable.h"
+#include "base/synchronization/waitable_event.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+const size_t kValueCount = 100;
+
+void FILE_CheckPassed(const std::vector<int>& values, const CefString& str,
+                      base::WaitableEvent* event)
+{
+  EXPECT_TRUE(CefCurrentlyOn(TID_FILE));
+  EXPECT_EQ(kValueCount, values.size());
+  EXPECT_EQ("payload", str.ToString());
+  event->Signal();
+}
+
+void FILE_Wait(base::WaitableEvent* event)
+{
+  event->Wait();
+}
+
+void FILE_CheckString(const CefString& str, const std::string& expected,
+                      base::WaitableEvent* event)
+{
+  EXPECT_TRUE(CefCurrentlyOn(TID_FILE));
+  EXPECT_TRUE(str.IsOwner());
+  EXPECT_EQ(expected, str.ToString());
+  event->Signal();
+}
+
+} // namespace
+
+// Verify that arguments wrapped with CefPass are transferred to the task
+// instead of being copied.
+TEST(RunnableTest, PassArguments)
+{
+  base::WaitableEvent event(false, false);
+  std::vector<int> values(kValueCount, 1);
+  CefString str("payload");
+
+  EXPECT_TRUE(CefPostTask(TID_FILE,
+      NewCefRunnableFunction(FILE_CheckPassed, CefPass(&values),
+                             CefPass(&str), &event)));
+  EXPECT_TRUE(values.empty());
+  EXPECT_TRUE(str.empty());
+
+  event.Wait();
+}
+
+// Verify that a string that references data it does not own is copied when it
+// is transferred, so that the task doesn't use the caller's freed buffer.
+TEST(RunnableTest, PassNonOwningString)
+{
+  base::WaitableEvent start(false, false);
+  base::WaitableEvent referenced_event(false, false);
+  base::WaitableEvent borrowed_event(false, false);
+
+  // Hold the FILE thread until the caller's buffer has been freed.
+  EXPECT_TRUE(CefPostTask(TID_FILE, NewCefRunnableFunction(FILE_Wait, &start)));
+
+  CefString* owner = new CefString("payload");
+
+  // References the structure of |owner|.
+  CefString referenced(owner->GetStruct());
+  EXPECT_FALSE(referenced.IsOwner());
+  // References the data of |owner|.
+  CefString borrowed(owner->c_str(), owner->length(), false);
+
+  EXPECT_TRUE(CefPostTask(TID_FILE,
+      NewCefRunnableFunction(FILE_CheckString, CefPass(&referenced),
+                             std::string("payload"), &referenced_event)));
+  EXPECT_TRUE(CefPostTask(TID_FILE,
+      NewCefRunnableFunction(FILE_CheckString, CefPass(&borrowed),
+                             std::string("payload"), &borrowed_event)));
+  EXPECT_TRUE(referenced.empty());
+  EXPECT_TRUE(borrowed.empty());
+
+  // Overwrite the buffer before freeing it so that a dangling reference is
+  // more likely to be noticed.
+  std::fill(const_cast<CefString::char_type*>(owner->c_str()),
+            const_cast<CefString::char_type*>(owner->c_str()) +
+                owner->length(), 'x');
+  delete owner;
+  start.Signal();
+
+  referenced_event.Wait();
+  borrowed_event.Wait();
+}
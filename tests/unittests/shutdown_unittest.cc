@@ -0,0 +1,91 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "include/cef.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "test_handler.h"
+#include <stdlib.h>
+
+namespace {
+
+const char* kShutdownUrl = "http://tests/shutdown.html";
+
+// Loads a page that sets a cookie in a browser that uses |requestContext|.
+class RequestContextLoadHandler : public TestHandler
+{
+public:
+  explicit RequestContextLoadHandler(
+      CefRefPtr<CefRequestContext> requestContext)
+    : request_context_(requestContext) {}
+
+  virtual void RunTest() OVERRIDE
+  {
+    AddResource(kShutdownUrl,
+        "<html><body><script>"
+        "document.cookie = 'shutdown=1';"
+        "</script></body></html>", "text/html");
+    CreateBrowser(kShutdownUrl, request_context_);
+  }
+
+  virtual void OnLoadEnd(CefRefPtr<CefBrowser> browser,
+                         CefRefPtr<CefFrame> frame,
+                         int httpStatusCode) OVERRIDE
+  {
+    if (frame->IsMain())
+      DestroyTest();
+  }
+
+  CefRefPtr<CefRequestContext> request_context_;
+};
+
+// Runs in the death test child process because CEF can't be used after
+// CefFastShutdown() returns. If |useRequestContext| is true a request context
+// is used by a browser first. Failures are reported with the exit code.
+void FastShutdownAndExit(bool useRequestContext)
+{
+  CefRefPtr<CefRequestContext> context;
+  if (useRequestContext) {
+    context = CefRequestContext::CreateContext(CefString());
+    if (!context.get())
+      exit(4);
+    CefRefPtr<RequestContextLoadHandler> handler =
+        new RequestContextLoadHandler(context);
+    handler->ExecuteTest();
+  }
+
+  CefShutdownReport report;
+  if (!CefFastShutdown(10000, report))
+    exit(1);
+  if (report.timed_out != 0 || report.cookies < 0 ||
+      report.dom_storage < 0 || report.cache < 0) {
+    exit(2);
+  }
+  if (report.cookies > report.total || report.dom_storage > report.total ||
+      report.cache > report.total) {
+    exit(3);
+  }
+  if (report.request_contexts != (useRequestContext ? 1 : 0))
+    exit(5);
+  exit(0);
+}
+
+} // namespace
+
+// Verify that CefFastShutdown() waits for each subsystem and reports the time
+// taken by each one within the total.
+TEST(ShutdownTest, FastShutdown)
+{
+  // Re-run the test executable for the child process instead of forking a
+  // process that has the CEF threads running.
+  testing::GTEST_FLAG(death_test_style) = "threadsafe";
+  EXPECT_EXIT(FastShutdownAndExit(false), testing::ExitedWithCode(0), "");
+}
+
+// Verify that CefFastShutdown() also writes the cookie store and cache of a
+// CefRequestContext that has been used by a browser.
+TEST(ShutdownTest, FastShutdownRequestContext)
+{
+  testing::GTEST_FLAG(death_test_style) = "threadsafe";
+  EXPECT_EXIT(FastShutdownAndExit(true), testing::ExitedWithCode(0), "");
+}
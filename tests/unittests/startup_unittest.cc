@@ -0,0 +1,21 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "include/cef.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+// Verify that the startup phases are timed and nested as expected.
+TEST(StartupTest, Timings)
+{
+  CefStartupTimings timings;
+  ASSERT_TRUE(CefGetStartupTimings(timings));
+
+  EXPECT_GT(timings.initialize, 0);
+  EXPECT_GT(timings.ui_thread_init, 0);
+  EXPECT_GT(timings.webkit_init, 0);
+  EXPECT_GT(timings.io_thread_init, 0);
+  EXPECT_LE(timings.ui_thread_init, timings.initialize);
+  EXPECT_LE(timings.io_thread_init, timings.initialize);
+  EXPECT_LE(timings.webkit_init, timings.ui_thread_init);
+}
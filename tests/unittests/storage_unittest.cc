@@ -0,0 +1,338 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "include/cef.h"
+#include "include/cef_runnable.h"
+#include "base/file_path.h"
+#include "base/file_util.h"
+#include "base/string_number_conversions.h"
+#include "base/synchronization/waitable_event.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include "test_handler.h"
+#include <stdlib.h>
+#include <vector>
+
+namespace {
+
+const char* kTestOrigin = "http://www.test.com";
+
+class TestVisitor : public CefLocalStorageVisitor
+{
+public:
+  TestVisitor(CefLocalStorageItemMap* items, base::WaitableEvent* event,
+              const char* origin = kTestOrigin)
+    : items_(items), event_(event), origin_(origin)
+  {
+  }
+  virtual ~TestVisitor()
+  {
+    event_->Signal();
+  }
+
+  virtual void Visit(const CefString& origin,
+                     const CefLocalStorageItemMap& items)
+  {
+    EXPECT_TRUE(CefCurrentlyOn(TID_UI));
+    EXPECT_EQ(origin, origin_);
+    *items_ = items;
+  }
+
+  CefLocalStorageItemMap* items_;
+  base::WaitableEvent* event_;
+  const char* origin_;
+
+  IMPLEMENT_REFCOUNTING(TestVisitor);
+};
+
+const char* kLimitOriginA = "http://www.storagelimita.com";
+const char* kLimitOriginB = "http://www.storagelimitb.com";
+const char* kLimitUrl = "http://www.storagelimita.com/page.html";
+
+// Each origin is filled with 40KB, which together exceed the 64KB
+// localStorage memory limit used by the test suite.
+const int kLimitItemCount = 2;
+const size_t kLimitValueLength = 10 * 1024;
+
+CefLocalStorageItemMap GetLimitItems()
+{
+  CefLocalStorageItemMap items;
+  std::string value(kLimitValueLength, 'x');
+  for (int i = 0; i < kLimitItemCount; ++i)
+    items.insert(std::make_pair("key" + std::string(1, '0' + i), value));
+  return items;
+}
+
+// Loads a page that uses localStorage, fills two origins past the memory
+// limit while the page is loaded and then lets the page use localStorage
+// again. The page reports the results using the document title.
+class MemoryLimitTestHandler : public TestHandler
+{
+public:
+  MemoryLimitTestHandler() {}
+
+  virtual void RunTest() OVERRIDE
+  {
+    std::string html =
+        "<html><body><script>"
+        "localStorage.setItem('live', 'before');"
+        "function report() {"
+        "  var before = localStorage.getItem('live');"
+        "  localStorage.setItem('live', 'after');"
+        "  document.title = 'result:' + before + ',' +"
+        "      localStorage.getItem('live') + ',' +"
+        "      localStorage.getItem('key0').length;"
+        "}"
+        "</script></body></html>";
+    AddResource(kLimitUrl, html, "text/html");
+    CreateBrowser(kLimitUrl);
+  }
+
+  virtual void OnLoadEnd(CefRefPtr<CefBrowser> browser,
+                         CefRefPtr<CefFrame> frame,
+                         int httpStatusCode) OVERRIDE
+  {
+    if (!frame->IsMain())
+      return;
+
+    CefPostTask(TID_UI,
+        NewCefRunnableMethod(this, &MemoryLimitTestHandler::Fill));
+  }
+
+  void Fill()
+  {
+    // Called on the UI thread so the items are written immediately and the
+    // purge runs after this task.
+    CefLocalStorageItemMap items = GetLimitItems();
+    EXPECT_TRUE(CefSetLocalStorage(kLimitOriginA, items, false));
+    EXPECT_TRUE(CefSetLocalStorage(kLimitOriginB, items, true));
+
+    // Runs after the purge.
+    GetBrowser()->GetMainFrame()->ExecuteJavaScript("report();", kLimitUrl,
+                                                    0);
+  }
+
+  virtual void OnTitleChange(CefRefPtr<CefBrowser> browser,
+                             const CefString& title) OVERRIDE
+  {
+    std::string titleStr = title;
+    if (titleStr.find("result:") == 0) {
+      result_ = titleStr.substr(7);
+      DestroyTest();
+    }
+  }
+
+  std::string result_;
+};
+
+const char* kSessionOpenerUrl = "http://tests/session_opener.html";
+const char* kSessionPopupUrl = "http://tests/session_popup.html";
+
+// Loads a page that writes sessionStorage and opens a popup. The popup reads
+// the opener's item, writes its own items and calls the opener, which writes
+// an item and reads both sides. The opener reports the results using the
+// document title.
+class SessionStorageCopyTestHandler : public TestHandler
+{
+public:
+  SessionStorageCopyTestHandler() {}
+
+  virtual void RunTest() OVERRIDE
+  {
+    AddResource(kSessionOpenerUrl,
+        "<html><body><script>"
+        "sessionStorage.setItem('shared', 'opener');"
+        "var popup = window.open('" + std::string(kSessionPopupUrl) + "');"
+        "function check(popupShared) {"
+        "  var shared = sessionStorage.getItem('shared');"
+        "  var popupItem = sessionStorage.getItem('popup');"
+        "  sessionStorage.setItem('opener', '1');"
+        "  document.title = 'result:' + popupShared + ',' + shared + ',' +"
+        "      popupItem + ',' + popup.getOpenerItem();"
+        "}"
+        "</script></body></html>", "text/html");
+    AddResource(kSessionPopupUrl,
+        "<html><body><script>"
+        "var shared = sessionStorage.getItem('shared');"
+        "sessionStorage.setItem('shared', 'popup');"
+        "sessionStorage.setItem('popup', '1');"
+        "function getOpenerItem() {"
+        "  return sessionStorage.getItem('opener');"
+        "}"
+        "window.opener.check(shared);"
+        "</script></body></html>", "text/html");
+    CreateBrowser(kSessionOpenerUrl);
+  }
+
+  virtual void OnAfterCreated(CefRefPtr<CefBrowser> browser) OVERRIDE
+  {
+    TestHandler::OnAfterCreated(browser);
+    if (browser->IsPopup())
+      popup_ = browser;
+  }
+
+  virtual void OnTitleChange(CefRefPtr<CefBrowser> browser,
+                             const CefString& title) OVERRIDE
+  {
+    std::string titleStr = title;
+    if (titleStr.find("result:") != 0)
+      return;
+
+    EXPECT_FALSE(browser->IsPopup());
+    result_ = titleStr.substr(7);
+    if (popup_.get()) {
+      CefPostTask(TID_UI,
+          NewCefRunnableMethod(popup_.get(), &CefBrowser::CloseBrowser));
+      popup_ = NULL;
+    }
+    DestroyTest();
+  }
+
+  CefRefPtr<CefBrowser> popup_;
+  std::string result_;
+};
+
+// Returns the values of the |name| counter in the order they were recorded.
+std::vector<int> GetCounterValues(const std::string& trace, const char* name)
+{
+  std::vector<int> values;
+  std::string prefix = "\"ph\":\"C\",\"name\":\"" + std::string(name) +
+                       "\",\"args\":{\"value\":";
+  size_t pos = 0;
+  while ((pos = trace.find(prefix, pos)) != std::string::npos) {
+    pos += prefix.length();
+    values.push_back(atoi(trace.c_str() + pos));
+  }
+  return values;
+}
+
+bool Contains(const std::string& str, const char* value)
+{
+  return str.find(value) != std::string::npos;
+}
+
+} // namespace
+
+// Test writing and reading localStorage items for an origin.
+TEST(StorageTest, LocalStorage)
+{
+  base::WaitableEvent event(false, false);
+  CefLocalStorageItemMap items;
+
+  EXPECT_FALSE(CefVisitLocalStorage("invalid",
+      new TestVisitor(&items, &event)));
+  event.Wait();
+
+  // Replace the items. The origin is normalized.
+  items.insert(std::make_pair("key1", "value1"));
+  items.insert(std::make_pair("key2", "value2"));
+  EXPECT_TRUE(CefSetLocalStorage("http://www.test.com/path/to/page.html",
+                                 items, true));
+  items.clear();
+
+  EXPECT_TRUE(CefVisitLocalStorage(kTestOrigin,
+      new TestVisitor(&items, &event)));
+  event.Wait();
+
+  EXPECT_EQ((CefLocalStorageItemMap::size_type)2, items.size());
+  EXPECT_EQ(items["key1"], "value1");
+  EXPECT_EQ(items["key2"], "value2");
+
+  // Add an item without clearing the existing items.
+  CefLocalStorageItemMap new_items;
+  new_items.insert(std::make_pair("key2", "value3"));
+  EXPECT_TRUE(CefSetLocalStorage(kTestOrigin, new_items, false));
+  items.clear();
+
+  EXPECT_TRUE(CefVisitLocalStorage(kTestOrigin,
+      new TestVisitor(&items, &event)));
+  event.Wait();
+
+  EXPECT_EQ((CefLocalStorageItemMap::size_type)2, items.size());
+  EXPECT_EQ(items["key1"], "value1");
+  EXPECT_EQ(items["key2"], "value3");
+
+  // Remove all of the items.
+  EXPECT_TRUE(CefSetLocalStorage(kTestOrigin, CefLocalStorageItemMap(), true));
+  items.clear();
+
+  EXPECT_TRUE(CefVisitLocalStorage(kTestOrigin,
+      new TestVisitor(&items, &event)));
+  event.Wait();
+
+  EXPECT_TRUE(items.empty());
+}
+
+// Test that localStorage is purged from memory when two origins exceed the
+// memory limit, that the purged items are read from disk again and that a
+// loaded page keeps working.
+TEST(StorageTest, LocalStorageMemoryLimit)
+{
+  base::WaitableEvent event(false, false);
+  CefLocalStorageItemMap items;
+
+  FilePath path;
+  ASSERT_TRUE(file_util::CreateTemporaryFile(&path));
+  EXPECT_TRUE(CefBeginTracing());
+
+  CefRefPtr<MemoryLimitTestHandler> handler = new MemoryLimitTestHandler();
+  handler->ExecuteTest();
+
+  EXPECT_TRUE(CefEndTracing(path.value()));
+  std::string trace;
+  EXPECT_TRUE(file_util::ReadFileToString(path, &trace));
+  file_util::Delete(path, false);
+
+  // The purge happened.
+  EXPECT_TRUE(Contains(trace,
+      "\"ph\":\"I\",\"name\":\"LocalStorageMemoryLimitPurge\""));
+
+  // The page read the items written before the purge and could still write.
+  EXPECT_EQ("before,after," +
+                base::IntToString(static_cast<int>(kLimitValueLength)),
+            handler->result_);
+
+  // The purged items are read from disk again.
+  const char* kOrigins[] = {kLimitOriginA, kLimitOriginB};
+  for (int i = 0; i < 2; ++i) {
+    EXPECT_TRUE(CefVisitLocalStorage(kOrigins[i],
+        new TestVisitor(&items, &event, kOrigins[i])));
+    event.Wait();
+
+    EXPECT_EQ(i == 0 ? kLimitItemCount + 1 : kLimitItemCount,
+              static_cast<int>(items.size()));
+    EXPECT_EQ(kLimitValueLength, items["key1"].length());
+    items.clear();
+
+    EXPECT_TRUE(CefSetLocalStorage(kOrigins[i], CefLocalStorageItemMap(),
+                                   true));
+  }
+}
+
+// Test that a popup sees the opener's sessionStorage items and that writes on
+// either side are not seen by the other side.
+TEST(StorageTest, SessionStorageCopy)
+{
+  FilePath path;
+  ASSERT_TRUE(file_util::CreateTemporaryFile(&path));
+  EXPECT_TRUE(CefBeginTracing());
+
+  CefRefPtr<SessionStorageCopyTestHandler> handler =
+      new SessionStorageCopyTestHandler();
+  handler->ExecuteTest();
+
+  EXPECT_TRUE(CefEndTracing(path.value()));
+  std::string trace;
+  EXPECT_TRUE(file_util::ReadFileToString(path, &trace));
+  file_util::Delete(path, false);
+
+  EXPECT_EQ("opener,opener,null,null", handler->result_);
+
+  // The opener's item was shared with the popup until the popup wrote to it.
+  // Keys and values are counted as UTF-16.
+  const int kSharedSize = (6 + 6) * 2;
+  std::vector<int> shared =
+      GetCounterValues(trace, "SessionStorageBytesShared");
+  ASSERT_GE(shared.size(), 2U);
+  EXPECT_EQ(shared[0] - kSharedSize, shared[1]);
+}
@@ -26,6 +26,7 @@ protected:
 class TestHandler : public CefClient,
                     public CefLifeSpanHandler,
                     public CefLoadHandler,
+                    public CefDisplayHandler,
                     public CefRequestHandler,
                     public CefJSBindingHandler
 {
@@ -46,6 +47,8 @@ public:
       { return this; }
   virtual CefRefPtr<CefLoadHandler> GetLoadHandler() OVERRIDE
       { return this; }
+  virtual CefRefPtr<CefDisplayHandler> GetDisplayHandler() OVERRIDE
+      { return this; }
   virtual CefRefPtr<CefRequestHandler> GetRequestHandler() OVERRIDE
       { return this; }
   virtual CefRefPtr<CefJSBindingHandler> GetJSBindingHandler() OVERRIDE
@@ -67,7 +70,12 @@ public:
   virtual void OnBeforeClose(CefRefPtr<CefBrowser> browser) OVERRIDE
   {
     AutoLock lock_scope(this);
+#if defined(OS_LINUX)
+    // Windowless browsers don't have a window handle.
+    if(browser_.get() == browser.get())
+#else
     if(browser_hwnd_ == browser->GetWindowHandle())
+#endif
     {
       // Free the browser pointer so that the browser can be destroyed
       browser_ = NULL;
@@ -137,19 +145,27 @@ protected:
 #if defined(OS_WIN)
     if(browser_hwnd_ != NULL)
       PostMessage(browser_hwnd_, WM_CLOSE, 0, 0);
+#elif defined(OS_LINUX)
+    if(browser_.get())
+      browser_->CloseBrowser();
 #endif
     Unlock();
   }
 
-  void CreateBrowser(const CefString& url)
+  void CreateBrowser(const CefString& url,
+                     CefRefPtr<CefRequestContext> requestContext = NULL)
   {
     CefWindowInfo windowInfo;
     CefBrowserSettings settings;
 #if defined(OS_WIN)
     windowInfo.SetAsPopup(NULL, "CefUnitTest");
     windowInfo.m_dwStyle |= WS_VISIBLE;
+#elif defined(OS_LINUX)
+    // Disable window rendering so that tests don't require a display.
+    windowInfo.SetAsOffScreen(NULL);
 #endif
-    CefBrowser::CreateBrowser(windowInfo, this, url, settings);
+    CefBrowser::CreateBrowser(windowInfo, this, url, settings,
+                              requestContext);
   }
 
   void AddResource(const CefString& key, const std::string& value,
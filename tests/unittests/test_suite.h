@@ -6,10 +6,19 @@
 #define _CEF_TEST_SUITE_H
 
 #include "build/build_config.h"
+#include "base/environment.h"
+#include "base/logging.h"
+#include "base/memory/scoped_ptr.h"
+#include "base/scoped_temp_dir.h"
 #include "base/threading/platform_thread.h"
 #include "base/test/test_suite.h"
 #include "include/cef.h"
 
+// Environment variable that selects COOKIE_LOAD_ON_DEMAND for the cookie store.
+// Tests of the lazy cookie store set it before starting a death test child
+// process so that the rest of the suite keeps the default load mode.
+const char kCookieLoadOnDemandVar[] = "CEF_TEST_COOKIE_LOAD_ON_DEMAND";
+
 class CefTestSuite : public TestSuite {
  public:
   CefTestSuite(int argc, char** argv) : TestSuite(argc, argv) {
@@ -20,8 +29,17 @@ class CefTestSuite : public TestSuite {
   virtual void Initialize() {
     TestSuite::Initialize();
     
+    // Persistent storage is only available with a cache path.
+    CHECK(cache_dir_.CreateUniqueTempDir());
+
     CefSettings settings;
     settings.multi_threaded_message_loop = true;
+    CefString(&settings.cache_path).FromString(cache_dir_.path().value());
+    scoped_ptr<base::Environment> env(base::Environment::Create());
+    if (env->HasVar(kCookieLoadOnDemandVar))
+      settings.cookie_load_mode = COOKIE_LOAD_ON_DEMAND;
+    // Small enough for StorageTest.LocalStorageMemoryLimit to exceed.
+    settings.local_storage_memory_limit = 64 * 1024;
     CefInitialize(settings);
   }
 
@@ -33,6 +51,10 @@ class CefTestSuite : public TestSuite {
     CefShutdown();
     TestSuite::Shutdown();
   }
+
+ private:
+  // Deleted after CefShutdown() has closed the databases.
+  ScopedTempDir cache_dir_;
 };
 
 #endif  // _CEF_TEST_SUITE_H
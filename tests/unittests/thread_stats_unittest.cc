@@ -0,0 +1,72 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "include/cef.h"
+#include "include/cef_runnable.h"
+#include "base/synchronization/waitable_event.h"
+#include "testing/gtest/include/gtest/gtest.h"
+
+namespace {
+
+const int kTaskCount = 100;
+
+void FILE_Count(int* count, base::WaitableEvent* event)
+{
+  EXPECT_TRUE(CefCurrentlyOn(TID_FILE));
+
+  if (++(*count) == kTaskCount)
+    event->Signal();
+}
+
+void FILE_Signal(base::WaitableEvent* event)
+{
+  event->Signal();
+}
+
+// Wait for the tasks already posted to the FILE thread to finish recording
+// their statistics. Statistics are recorded after each task runs.
+void WaitForFileThread()
+{
+  base::WaitableEvent event(false, false);
+  EXPECT_TRUE(CefPostTask(TID_FILE, NewCefRunnableFunction(FILE_Signal,
+                                                           &event)));
+  event.Wait();
+}
+
+} // namespace
+
+// Verify that tasks posted to a named thread are counted in its statistics.
+TEST(ThreadStatsTest, FileThread)
+{
+  CefThreadStats stats;
+  EXPECT_FALSE(CefGetThreadStats(TID_FILE, stats));
+
+  CefSetThreadStatsEnabled(true);
+  EXPECT_FALSE(CefGetThreadStats(TID_WORKER, stats));
+
+  base::WaitableEvent event(false, false);
+  int count = 0;
+  for (int i = 0; i < kTaskCount; ++i) {
+    EXPECT_TRUE(CefPostTask(TID_FILE,
+        NewCefRunnableFunction(FILE_Count, &count, &event)));
+  }
+  event.Wait();
+  WaitForFileThread();
+
+  ASSERT_TRUE(CefGetThreadStats(TID_FILE, stats));
+  EXPECT_GE(stats.task_count, kTaskCount);
+  EXPECT_GE(stats.max_queue_depth, 1);
+  EXPECT_LE(stats.max_queue_latency, stats.total_queue_latency);
+
+  int64 latency_count = 0, run_time_count = 0;
+  for (int i = 0; i < CEF_THREAD_STATS_BUCKET_COUNT; ++i) {
+    latency_count += stats.queue_latency_histogram[i];
+    run_time_count += stats.run_time_histogram[i];
+  }
+  EXPECT_EQ(stats.task_count, latency_count);
+  EXPECT_EQ(stats.task_count, run_time_count);
+
+  CefSetThreadStatsEnabled(false);
+  EXPECT_FALSE(CefGetThreadStats(TID_FILE, stats));
+}
@@ -0,0 +1,123 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "include/cef.h"
+#include "base/file_path.h"
+#include "base/file_util.h"
+#include "test_handler.h"
+#include <string>
+
+namespace {
+
+const char* kTracingUrl = "http://tests/tracing.html";
+
+const char* kLoadEndBegin =
+    "\"ph\":\"B\",\"name\":\"CefLoadHandler::OnLoadEnd\"";
+const char* kLoadEndEnd =
+    "\"ph\":\"E\",\"name\":\"CefLoadHandler::OnLoadEnd\"";
+const char* kLoadBegin = "\"ph\":\"S\",\"name\":\"RequestProxy::Load\"";
+const char* kLoadEnd = "\"ph\":\"F\",\"name\":\"RequestProxy::Load\"";
+
+bool Contains(const std::string& str, const char* value)
+{
+  return str.find(value) != std::string::npos;
+}
+
+// Loads a page while tracing is started. If |restart_path| is not empty the
+// trace is stopped, written to |restart_path| and started again from within
+// the OnLoadEnd() callback.
+class TracingTestHandler : public TestHandler
+{
+public:
+  explicit TracingTestHandler(const FilePath& restart_path)
+    : restart_path_(restart_path) {}
+
+  virtual void RunTest() OVERRIDE
+  {
+    AddResource(kTracingUrl, "<html><body>Tracing</body></html>",
+                "text/html");
+    CreateBrowser(kTracingUrl);
+  }
+
+  virtual void OnLoadEnd(CefRefPtr<CefBrowser> browser,
+                         CefRefPtr<CefFrame> frame,
+                         int httpStatusCode) OVERRIDE
+  {
+    if (!frame->IsMain())
+      return;
+
+    if (!restart_path_.empty()) {
+      EXPECT_TRUE(CefEndTracing(restart_path_.value()));
+      EXPECT_TRUE(CefBeginTracing());
+    }
+
+    DestroyTest();
+  }
+
+private:
+  FilePath restart_path_;
+};
+
+} // namespace
+
+// Verify that tracing can be started and stopped and that the trace file is
+// written in the Chrome trace event format.
+TEST(TracingTest, BeginEnd)
+{
+  FilePath path;
+  ASSERT_TRUE(file_util::CreateTemporaryFile(&path));
+
+  EXPECT_FALSE(CefEndTracing(path.value()));
+  EXPECT_TRUE(CefBeginTracing());
+  EXPECT_FALSE(CefBeginTracing());
+  EXPECT_FALSE(CefEndTracing(CefString()));
+
+  // Load a page so that instrumented code runs.
+  CefRefPtr<TracingTestHandler> handler = new TracingTestHandler(FilePath());
+  handler->ExecuteTest();
+
+  EXPECT_TRUE(CefEndTracing(path.value()));
+  EXPECT_FALSE(CefEndTracing(path.value()));
+
+  std::string contents;
+  EXPECT_TRUE(file_util::ReadFileToString(path, &contents));
+  EXPECT_EQ(0U, contents.find("{\"traceEvents\":["));
+  EXPECT_EQ(contents.size() - 2, contents.rfind("]}"));
+
+  // Scoped events on the UI thread and async events on the IO thread.
+  EXPECT_TRUE(Contains(contents, kLoadEndBegin));
+  EXPECT_TRUE(Contains(contents, kLoadEndEnd));
+  EXPECT_TRUE(Contains(contents, kLoadBegin));
+  EXPECT_TRUE(Contains(contents, kLoadEnd));
+
+  file_util::Delete(path, false);
+}
+
+// Verify that a scope that is open when tracing stops does not record its end
+// event in the next trace.
+TEST(TracingTest, RestartInScope)
+{
+  FilePath first_path, second_path;
+  ASSERT_TRUE(file_util::CreateTemporaryFile(&first_path));
+  ASSERT_TRUE(file_util::CreateTemporaryFile(&second_path));
+
+  EXPECT_TRUE(CefBeginTracing());
+
+  CefRefPtr<TracingTestHandler> handler = new TracingTestHandler(first_path);
+  handler->ExecuteTest();
+
+  EXPECT_TRUE(CefEndTracing(second_path.value()));
+
+  std::string first, second;
+  EXPECT_TRUE(file_util::ReadFileToString(first_path, &first));
+  EXPECT_TRUE(file_util::ReadFileToString(second_path, &second));
+
+  EXPECT_TRUE(Contains(first, kLoadEndBegin));
+  EXPECT_FALSE(Contains(first, kLoadEndEnd));
+  EXPECT_FALSE(Contains(second, kLoadEndBegin));
+  EXPECT_FALSE(Contains(second, kLoadEndEnd));
+
+  file_util::Delete(first_path, false);
+  file_util::Delete(second_path, false);
+}
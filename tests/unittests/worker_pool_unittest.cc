@@ -0,0 +1,126 @@
+// Copyright (c) 2011 The Chromium Embedded Framework Authors. All rights
+// reserved. Use of this source code is governed by a BSD-style license that
+// can be found in the LICENSE file.
+
+#include "include/cef.h"
+#include "include/cef_runnable.h"
+#include "base/synchronization/lock.h"
+#include "base/synchronization/waitable_event.h"
+#include "testing/gtest/include/gtest/gtest.h"
+#include <vector>
+
+namespace {
+
+const int kTaskCount = 100;
+
+void WORKER_Count(base::Lock* lock, int* count, base::WaitableEvent* event)
+{
+  EXPECT_TRUE(CefCurrentlyOn(TID_WORKER));
+  EXPECT_FALSE(CefCurrentlyOn(TID_UI));
+
+  base::AutoLock lock_scope(*lock);
+  if (++(*count) == kTaskCount)
+    event->Signal();
+}
+
+void WORKER_Append(CefRefPtr<CefSequencedTaskRunner> runner,
+                   std::vector<int>* order, int value,
+                   base::WaitableEvent* event)
+{
+  EXPECT_TRUE(CefCurrentlyOn(TID_WORKER));
+  EXPECT_TRUE(runner->RunsTasksOnCurrentThread());
+
+  // Tasks in a sequence never run concurrently so no lock is required.
+  order->push_back(value);
+  if (order->size() == static_cast<size_t>(kTaskCount))
+    event->Signal();
+}
+
+void FILE_Append(std::vector<int>* order, int value,
+                 base::WaitableEvent* event)
+{
+  EXPECT_TRUE(CefCurrentlyOn(TID_FILE));
+
+  order->push_back(value);
+  if (order->size() == static_cast<size_t>(kTaskCount))
+    event->Signal();
+}
+
+} // namespace
+
+// Verify that tasks posted to the worker pool all run on worker threads.
+TEST(WorkerPoolTest, PostTask)
+{
+  base::WaitableEvent event(false, false);
+  base::Lock lock;
+  int count = 0;
+
+  EXPECT_FALSE(CefCurrentlyOn(TID_WORKER));
+
+  for (int i = 0; i < kTaskCount; ++i) {
+    EXPECT_TRUE(CefPostTask(TID_WORKER,
+        NewCefRunnableFunction(WORKER_Count, &lock, &count, &event)));
+  }
+
+  event.Wait();
+  EXPECT_EQ(kTaskCount, count);
+}
+
+// Verify that a sequenced task runner runs tasks in the order they were
+// posted.
+TEST(WorkerPoolTest, SequencedTaskRunner)
+{
+  base::WaitableEvent event(false, false);
+  std::vector<int> order;
+
+  CefRefPtr<CefSequencedTaskRunner> runner = CefSequencedTaskRunner::Create();
+  ASSERT_TRUE(runner.get());
+  EXPECT_FALSE(runner->RunsTasksOnCurrentThread());
+
+  for (int i = 0; i < kTaskCount; ++i) {
+    EXPECT_TRUE(runner->PostTask(
+        NewCefRunnableFunction(WORKER_Append, runner, &order, i, &event)));
+  }
+
+  event.Wait();
+  ASSERT_EQ(static_cast<size_t>(kTaskCount), order.size());
+  for (int i = 0; i < kTaskCount; ++i)
+    EXPECT_EQ(i, order[i]);
+}
+
+// Verify that a batch of tasks posted to the worker pool all run.
+TEST(WorkerPoolTest, PostTasks)
+{
+  base::WaitableEvent event(false, false);
+  base::Lock lock;
+  int count = 0;
+
+  std::vector<CefRefPtr<CefTask> > tasks;
+  for (int i = 0; i < kTaskCount; ++i) {
+    tasks.push_back(
+        NewCefRunnableFunction(WORKER_Count, &lock, &count, &event));
+  }
+  EXPECT_TRUE(CefPostTasks(TID_WORKER, tasks));
+
+  event.Wait();
+  EXPECT_EQ(kTaskCount, count);
+}
+
+// Verify that a batch of tasks posted to a named thread runs in order.
+TEST(WorkerPoolTest, PostTasksInOrder)
+{
+  base::WaitableEvent event(false, false);
+  std::vector<int> order;
+
+  std::vector<CefRefPtr<CefTask> > tasks;
+  for (int i = 0; i < kTaskCount; ++i)
+    tasks.push_back(NewCefRunnableFunction(FILE_Append, &order, i, &event));
+  EXPECT_TRUE(CefPostTasks(TID_FILE, tasks));
+  // An empty batch is accepted, as with CefSetCookies().
+  EXPECT_TRUE(CefPostTasks(TID_FILE, std::vector<CefRefPtr<CefTask> >()));
+
+  event.Wait();
+  ASSERT_EQ(static_cast<size_t>(kTaskCount), order.size());
+  for (int i = 0; i < kTaskCount; ++i)
+    EXPECT_EQ(i, order[i]);
+}
@@ -1107,7 +1107,7 @@ class obj_analysis:
             }
 
         # check for CEF structure types
-        if value[0:3] == 'Cef' and value[-4:] != 'List':
+        if value[0:3] == 'Cef' and value[-4:] != 'List' and value[-3:] != 'Map':
             return {
                 'result_type' : 'structure',
                 'result_value' : get_capi_name(value, True)
@@ -1240,6 +1240,12 @@ class obj_analysis:
             if self.is_const():
                 str += ' const*'
             result['value'] = str
+        elif type == 'structure':
+            str = ''
+            if self.is_const():
+                str += 'const '
+            str += value+'*'
+            result['value'] = str
         else:
             raise Exception('Unsupported vector type: '+type)
         